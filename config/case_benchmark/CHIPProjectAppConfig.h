@@ -0,0 +1,38 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Project configuration for the host_gcc_case_benchmark build, which
+ *      sizes the session pools for a storm of concurrent CASE handshakes.
+ */
+
+#pragma once
+
+// Number of handshakes run at once by the CASE establishment benchmark
+#ifndef CHIP_CASE_BENCHMARK_SESSION_COUNT
+#define CHIP_CASE_BENCHMARK_SESSION_COUNT 1000
+#endif // CHIP_CASE_BENCHMARK_SESSION_COUNT
+
+// Both ends of every handshake are in the same process, and each holds an exchange, an unauthenticated
+// session and, once established, a secure session.
+#define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS (2 * CHIP_CASE_BENCHMARK_SESSION_COUNT + 16)
+#define CHIP_CONFIG_UNAUTHENTICATED_CONNECTION_POOL_SIZE (2 * CHIP_CASE_BENCHMARK_SESSION_COUNT + 4)
+#define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (2 * CHIP_CASE_BENCHMARK_SESSION_COUNT + 16)
+
+// include the CHIPProjectConfig from config/standalone
+#include <CHIPProjectConfig.h>
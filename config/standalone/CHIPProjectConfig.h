@@ -91,6 +91,31 @@
 #define CONFIG_BUILD_FOR_HOST_UNIT_TEST 1
 #endif
 
+// Exercise the indexed SetDirty path in host builds and unit tests.
+#ifndef CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+#define CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX 1
+#endif
+
+// Share attribute encodings between read handlers in host builds and unit tests.
+#ifndef CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE
+#define CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE 2048
+#endif
+
+// Exercise the indexed secure session lookups in host builds and unit tests.
+#ifndef CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+#define CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX 1
+#endif
+
+// Exercise the indexed exchange lookups in host builds and unit tests.
+#ifndef CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+#define CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX 1
+#endif
+
+// Exercise the indexed access control checks in host builds and unit tests.
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX 1
+#endif
+
 #ifndef CHIP_DEVICE_ENABLE_PORT_PARAMS
 #define CHIP_DEVICE_ENABLE_PORT_PARAMS 1
 #endif
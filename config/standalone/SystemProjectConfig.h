@@ -29,4 +29,10 @@
 // #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX 9050
 #endif
 
+// Exercise the bitmap pool active word summary in host builds and unit tests.
+#define CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY 1
+
+// Host builds may run with many timers active at once.
+#define CHIP_SYSTEM_CONFIG_TIMER_HEAP 1
+
 #endif /* SYSTEMPROJECTCONFIG_H */
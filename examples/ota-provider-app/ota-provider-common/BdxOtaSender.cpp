@@ -75,20 +75,23 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
     case TransferSession::OutputEventType::kNone:
         break;
     case TransferSession::OutputEventType::kMsgToSend: {
+        // All messages sent from the Sender expect a response, except for a StatusReport which would indicate an error and the
+        // end of the transfer.
+        const bool isStatusReport = event.msgTypeData.HasMessageType(chip::Protocols::SecureChannel::MsgType::StatusReport);
+        VerifyOrReturn(mExchangeCtx != nullptr);
+
         chip::Messaging::SendFlags sendFlags;
-        if (!event.msgTypeData.HasMessageType(chip::Protocols::SecureChannel::MsgType::StatusReport))
+        // In a windowed transfer the next queries may already be on their way, and the exchange waits for one of them only
+        if (!isStatusReport && !mExchangeCtx->IsResponseExpected())
         {
-            // All messages sent from the Sender expect a response, except for a StatusReport which would indicate an error and the
-            // end of the transfer.
             sendFlags.Set(chip::Messaging::SendMessageFlags::kExpectResponse);
         }
-        VerifyOrReturn(mExchangeCtx != nullptr);
         err = mExchangeCtx->SendMessage(event.msgTypeData.ProtocolId, event.msgTypeData.MessageType, std::move(event.MsgData),
                                         sendFlags);
 
         if (err == CHIP_NO_ERROR)
         {
-            if (!sendFlags.Has(chip::Messaging::SendMessageFlags::kExpectResponse))
+            if (isStatusReport)
             {
                 // After sending the StatusReport, exchange context gets closed so, set mExchangeCtx to null
                 mExchangeCtx = nullptr;
@@ -111,6 +114,9 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         acceptData.MaxBlockSize = mTransfer.GetTransferBlockSize();
         acceptData.StartOffset  = mTransfer.GetStartOffset();
         acceptData.Length       = mTransfer.GetTransferLength();
+        // Windowing is only accepted on sessions without MRP, which allows a single unacknowledged message per exchange
+        acceptData.Windowed = event.transferInitData.Windowed && (mExchangeCtx != nullptr) &&
+            mExchangeCtx->HasSessionHandle() && !mExchangeCtx->GetSessionHandle()->AllowsMRP();
         VerifyOrReturn(mTransfer.AcceptTransfer(acceptData) == CHIP_NO_ERROR,
                        ChipLogError(BDX, "AcceptTransfer failed: %" CHIP_ERROR_FORMAT, err.Format()));
 
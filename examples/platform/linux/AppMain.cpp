@@ -150,6 +150,7 @@
 #endif // CHIP_DEVICE_LAYER_TARGET_DARWIN
 
 #if CHIP_DEVICE_LAYER_TARGET_LINUX
+#include <platform/Linux/EventSpillStorageImpl.h>
 #include <platform/Linux/NetworkCommissioningDriver.h>
 #endif // CHIP_DEVICE_LAYER_TARGET_LINUX
 
@@ -339,6 +340,10 @@ LinuxCommissionableDataProvider gCommissionableDataProvider;
 chip::DeviceLayer::DeviceInfoProviderImpl gExampleDeviceInfoProvider;
 chip::DeviceLayer::AllClustersExampleDeviceInfoProviderImpl gAllClustersExampleDeviceInfoProvider;
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+chip::DeviceLayer::EventSpillStorageImpl gEventSpillStorage;
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+
 void EventHandler(const DeviceLayer::ChipDeviceEvent * event, intptr_t arg)
 {
     (void) arg;
@@ -966,6 +971,18 @@ void ChipLinuxAppMainLoop(chip::ServerInitParams & initParams, AppMainLoopImplem
 
     initParams.testEventTriggerDelegate = &sTestEventTriggerDelegate;
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+    {
+        // Keep the spilled events next to the KVS file. Without them, events are dropped as usual.
+        const char * kvsPath        = LinuxDeviceOptions::GetInstance().KVS;
+        std::string spillPathPrefix = std::string(kvsPath != nullptr ? kvsPath : CHIP_CONFIG_KVS_PATH) + "-events";
+        if (gEventSpillStorage.Init(spillPathPrefix.c_str()) == CHIP_NO_ERROR)
+        {
+            initParams.eventSpillStorage = &gEventSpillStorage;
+        }
+    }
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+
     chip::app::RuntimeOptionsProvider::Instance().SetSimulateNoInternalTime(
         LinuxDeviceOptions::GetInstance().mSimulateNoInternalTime);
 
@@ -1103,6 +1120,10 @@ void ChipLinuxAppMainLoop(chip::ServerInitParams & initParams, AppMainLoopImplem
 
     Server::GetInstance().Shutdown();
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+    gEventSpillStorage.Shutdown();
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+
 #if CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
     ShutdownCommissioner();
 #endif // CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
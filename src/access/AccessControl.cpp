@@ -225,6 +225,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        InvalidateIndex();
     }
 
     return retval;
@@ -439,6 +440,27 @@ CHIP_ERROR AccessControl::CheckACL(const SubjectDescriptor & subjectDescriptor,
         return CHIP_NO_ERROR;
     }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    if (mIndex.IsStale())
+    {
+        CHIP_ERROR err = BuildIndex();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogDetail(DataManagement, "AccessControl: not indexing entries %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+    if (mIndex.IsUsable())
+    {
+        return CheckIndex(subjectDescriptor, requestPath, requestPrivilege);
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
+    return CheckEntries(subjectDescriptor, requestPath, requestPrivilege);
+}
+
+CHIP_ERROR AccessControl::CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                       Privilege requestPrivilege)
+{
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -553,6 +575,113 @@ CHIP_ERROR AccessControl::CheckACL(const SubjectDescriptor & subjectDescriptor,
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+CHIP_ERROR AccessControl::BuildIndex()
+{
+    mIndex.Clear();
+
+    EntryIterator iterator;
+    ReturnErrorOnFailure(Entries(iterator));
+
+    Entry entry;
+    CHIP_ERROR err;
+    while ((err = iterator.Next(entry)) == CHIP_NO_ERROR)
+    {
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        AuthMode authMode       = AuthMode::kNone;
+        Privilege privilege     = Privilege::kView;
+        ReturnErrorOnFailure(entry.GetFabricIndex(fabricIndex));
+        ReturnErrorOnFailure(entry.GetAuthMode(authMode));
+        ReturnErrorOnFailure(entry.GetPrivilege(privilege));
+
+        // Entries that CheckEntries would report as errors are left to it.
+        VerifyOrReturnError(authMode == AuthMode::kCase || authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+
+        uint8_t grantedPrivileges = 0;
+        for (Privilege requestPrivilege :
+             { Privilege::kView, Privilege::kProxyView, Privilege::kOperate, Privilege::kManage, Privilege::kAdminister })
+        {
+            if (CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, privilege))
+            {
+                grantedPrivileges |= to_underlying(requestPrivilege);
+            }
+        }
+        ReturnErrorOnFailure(mIndex.AddEntry(fabricIndex, authMode, grantedPrivileges));
+
+        size_t subjectCount = 0;
+        ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+        for (size_t i = 0; i < subjectCount; ++i)
+        {
+            NodeId subject = kUndefinedNodeId;
+            ReturnErrorOnFailure(entry.GetSubject(i, subject));
+            const bool isCaseSubject  = IsOperationalNodeId(subject) || IsCASEAuthTag(subject);
+            const bool isGroupSubject = IsGroupId(subject);
+            VerifyOrReturnError((isCaseSubject && authMode == AuthMode::kCase) || (isGroupSubject && authMode == AuthMode::kGroup),
+                                CHIP_ERROR_INCORRECT_STATE);
+            ReturnErrorOnFailure(mIndex.AddSubject(subject));
+        }
+
+        size_t targetCount = 0;
+        ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+        for (size_t i = 0; i < targetCount; ++i)
+        {
+            Entry::Target target;
+            ReturnErrorOnFailure(entry.GetTarget(i, target));
+            AccessControlIndex::TargetFlags flags = 0;
+            if (target.flags & Entry::Target::kCluster)
+            {
+                flags |= AccessControlIndex::kCluster;
+            }
+            if (target.flags & Entry::Target::kEndpoint)
+            {
+                flags |= AccessControlIndex::kEndpoint;
+            }
+            if (target.flags & Entry::Target::kDeviceType)
+            {
+                flags |= AccessControlIndex::kDeviceType;
+            }
+            ReturnErrorOnFailure(mIndex.AddTarget(flags, target.cluster, target.endpoint, target.deviceType));
+        }
+    }
+    VerifyOrReturnError(err == CHIP_ERROR_SENTINEL, err);
+
+    mIndex.Finalize();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControl::CheckIndex(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                     Privilege requestPrivilege)
+{
+    const AccessControlIndex::DecisionKey key(subjectDescriptor, requestPath, requestPrivilege);
+
+    std::optional<bool> allowed = mIndex.FindDecision(key);
+    if (!allowed.has_value())
+    {
+        auto isDeviceTypeOnEndpoint = [this](DeviceTypeId deviceType, EndpointId endpoint) {
+            return mDeviceTypeResolver->IsDeviceTypeOnEndpoint(deviceType, endpoint);
+        };
+        bool dependsOnDeviceTypes = false;
+
+        allowed = mIndex.IsAllowed(subjectDescriptor, requestPath, requestPrivilege, isDeviceTypeOnEndpoint, dependsOnDeviceTypes);
+        if (!dependsOnDeviceTypes)
+        {
+            mIndex.AddDecision(key, *allowed);
+        }
+    }
+
+    if (*allowed)
+    {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+        ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+        return CHIP_NO_ERROR;
+    }
+
+    ChipLogProgress(DataManagement, "AccessControl: denied");
+    return CHIP_ERROR_ACCESS_DENIED;
+}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
 CHIP_ERROR AccessControl::CheckARL(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
                                    Privilege requestPrivilege)
@@ -767,6 +896,8 @@ exit:
 void AccessControl::NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
                                        const Entry * entry, EntryListener::ChangeType changeType)
 {
+    InvalidateIndex();
+
     for (EntryListener * listener = mEntryListener; listener != nullptr; listener = listener->mNext)
     {
         listener->OnEntryChanged(subjectDescriptor, fabric, index, entry, changeType);
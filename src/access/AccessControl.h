@@ -24,6 +24,7 @@
 #include "AccessRestrictionProvider.h"
 #endif
 
+#include "AccessControlIndex.h"
 #include "AuxiliaryType.h"
 #include "Privilege.h"
 #include "RequestPath.h"
@@ -525,6 +526,7 @@ public:
     {
         VerifyOrReturnError(entry.IsValid(), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateIndex();
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -575,6 +577,7 @@ public:
     {
         VerifyOrReturnError(entry.IsValid(), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateIndex();
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -596,6 +599,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateIndex();
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -736,8 +740,18 @@ public:
 #endif
 
 private:
+    friend class TestAccessControl_TestCheckWithCATAfterEntryChanges_Test;
+    friend class TestAccessControl_BenchmarkWildcardRead_Test;
+
     bool IsInitialized() const { return (mDelegate != nullptr); }
 
+    void InvalidateIndex()
+    {
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+        mIndex.Invalidate();
+#endif
+    }
+
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
@@ -747,6 +761,24 @@ private:
      */
     CHIP_ERROR CheckACL(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege);
 
+    /**
+     * Check the entries of the ACL, as read from the delegate, for whether access should be allowed or denied.
+     */
+    CHIP_ERROR CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                            Privilege requestPrivilege);
+
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    /**
+     * Rebuild the index from the delegate's entries. On failure, the index stays unusable until the next change.
+     */
+    CHIP_ERROR BuildIndex();
+
+    /**
+     * Check the index, which must be usable, for whether access should be allowed or denied.
+     */
+    CHIP_ERROR CheckIndex(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege);
+#endif
+
     /**
      * Check CommissioningARL or ARL (as appropriate) for whether access (by a
      * subject descriptor, to a request path, requiring a privilege) should
@@ -770,6 +802,10 @@ private:
 
     EntryListener * mEntryListener = nullptr;
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    AccessControlIndex mIndex;
+#endif
+
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     AccessRestrictionProvider * mAccessRestrictionProvider;
 #endif
@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "AccessControlIndex.h"
+
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
+namespace chip {
+namespace Access {
+
+void AccessControlIndex::Clear()
+{
+    mEntryCount    = 0;
+    mSubjectCount  = 0;
+    mTargetCount   = 0;
+    mDecisionCount = 0;
+    mState         = State::kBuilding;
+}
+
+CHIP_ERROR AccessControlIndex::AddEntry(FabricIndex fabricIndex, AuthMode authMode, uint8_t grantedPrivileges)
+{
+    VerifyOrReturnError(mState == State::kBuilding, CHIP_ERROR_INCORRECT_STATE);
+    if (mEntryCount >= kMaxEntries)
+    {
+        mState = State::kOverflow;
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    Entry & entry            = mEntries[mEntryCount++];
+    entry.mFirstSubject      = static_cast<uint16_t>(mSubjectCount);
+    entry.mSubjectCount      = 0;
+    entry.mFirstTarget       = static_cast<uint16_t>(mTargetCount);
+    entry.mTargetCount       = 0;
+    entry.mFabricIndex       = fabricIndex;
+    entry.mAuthMode          = authMode;
+    entry.mGrantedPrivileges = grantedPrivileges;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControlIndex::AddSubject(NodeId subject)
+{
+    VerifyOrReturnError(mState == State::kBuilding && mEntryCount > 0, CHIP_ERROR_INCORRECT_STATE);
+    if (mSubjectCount >= kMaxSubjects)
+    {
+        mState = State::kOverflow;
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    mSubjects[mSubjectCount++] = subject;
+    mEntries[mEntryCount - 1].mSubjectCount++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControlIndex::AddTarget(TargetFlags flags, ClusterId cluster, EndpointId endpoint, DeviceTypeId deviceType)
+{
+    VerifyOrReturnError(mState == State::kBuilding && mEntryCount > 0, CHIP_ERROR_INCORRECT_STATE);
+    if (mTargetCount >= kMaxTargets)
+    {
+        mState = State::kOverflow;
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    mTargets[mTargetCount++] = { cluster, deviceType, endpoint, flags };
+    mEntries[mEntryCount - 1].mTargetCount++;
+    return CHIP_NO_ERROR;
+}
+
+void AccessControlIndex::Finalize()
+{
+    VerifyOrReturn(mState == State::kBuilding);
+    mState = State::kReady;
+}
+
+std::optional<bool> AccessControlIndex::FindDecision(const DecisionKey & key)
+{
+    for (size_t i = 0; i < mDecisionCount; i++)
+    {
+        if (mDecisions[i].mKey == key)
+        {
+            mDecisions[i].mLastUse = ++mUseCounter;
+            return mDecisions[i].mAllowed;
+        }
+    }
+    return std::nullopt;
+}
+
+void AccessControlIndex::AddDecision(const DecisionKey & key, bool allowed)
+{
+    size_t slot = mDecisionCount;
+    if (mDecisionCount < kMaxDecisionCount)
+    {
+        mDecisionCount++;
+    }
+    else
+    {
+        // Unsigned differences keep the order right when the use counter wraps around.
+        slot = 0;
+        for (size_t i = 1; i < mDecisionCount; i++)
+        {
+            if (static_cast<uint32_t>(mUseCounter - mDecisions[i].mLastUse) >
+                static_cast<uint32_t>(mUseCounter - mDecisions[slot].mLastUse))
+            {
+                slot = i;
+            }
+        }
+    }
+
+    mDecisions[slot] = { key, ++mUseCounter, allowed };
+}
+
+} // namespace Access
+} // namespace chip
+
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
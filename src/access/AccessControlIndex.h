@@ -0,0 +1,276 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "AuthMode.h"
+#include "Privilege.h"
+#include "RequestPath.h"
+#include "SubjectDescriptor.h"
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/NodeId.h>
+#include <lib/support/CodeUtils.h>
+
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
+namespace chip {
+namespace Access {
+
+/**
+ * Flattened copy of the access control list, used by AccessControl::Check instead of the delegate's entries.
+ *
+ * Entries of an AccessControl::Delegate can only be read one field at a time through virtual getters, so checking a
+ * request walks tens of virtual calls per entry. The index keeps the same entries in flat arrays, with the set of
+ * request privileges each entry grants precomputed as a bitmask, and also remembers the most recent decisions.
+ *
+ * Like ReadHandlerPathIndex, the index is marked stale whenever the access control list changes and is rebuilt lazily
+ * (Clear, AddEntry/AddSubject/AddTarget, Finalize). If the list does not fit, the index stays unusable until the next
+ * invalidation and the caller has to walk the delegate's entries instead.
+ */
+class AccessControlIndex
+{
+public:
+    static constexpr size_t kMaxEntries       = CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_ENTRIES;
+    static constexpr size_t kMaxSubjects      = CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_SUBJECTS;
+    static constexpr size_t kMaxTargets       = CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_TARGETS;
+    static constexpr size_t kMaxDecisionCount = CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE;
+
+    using TargetFlags                        = uint8_t;
+    static constexpr TargetFlags kCluster    = 1 << 0;
+    static constexpr TargetFlags kEndpoint   = 1 << 1;
+    static constexpr TargetFlags kDeviceType = 1 << 2;
+
+    static_assert(kMaxSubjects <= UINT16_MAX && kMaxTargets <= UINT16_MAX, "Subject and target positions must fit in 16 bits");
+    static_assert(kMaxDecisionCount > 0, "The decision cache needs at least one slot");
+
+    /**
+     * The inputs of an access control list decision. The request type and entity id are not part of it, since the
+     * list does not depend on them.
+     */
+    struct DecisionKey
+    {
+        NodeId mSubject          = kUndefinedNodeId;
+        CATValues mCats          = kUndefinedCATs;
+        ClusterId mCluster       = 0;
+        EndpointId mEndpoint     = 0;
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        AuthMode mAuthMode       = AuthMode::kNone;
+        Privilege mPrivilege     = Privilege::kView;
+
+        DecisionKey() = default;
+        DecisionKey(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege privilege) :
+            mSubject(subjectDescriptor.subject), mCats(subjectDescriptor.cats), mCluster(requestPath.cluster),
+            mEndpoint(requestPath.endpoint), mFabricIndex(subjectDescriptor.fabricIndex), mAuthMode(subjectDescriptor.authMode),
+            mPrivilege(privilege)
+        {}
+
+        bool operator==(const DecisionKey & other) const
+        {
+            return mSubject == other.mSubject && mCluster == other.mCluster && mEndpoint == other.mEndpoint &&
+                mFabricIndex == other.mFabricIndex && mAuthMode == other.mAuthMode && mPrivilege == other.mPrivilege &&
+                mCats == other.mCats;
+        }
+    };
+
+    /**
+     * Mark the index as out of date and drop all remembered decisions. Must be called whenever an entry is created,
+     * updated or deleted.
+     */
+    void Invalidate()
+    {
+        mState         = State::kStale;
+        mDecisionCount = 0;
+    }
+
+    /**
+     * Whether the index must be rebuilt (via Clear/Add.../Finalize) before it can be used.
+     */
+    bool IsStale() const { return mState == State::kStale; }
+
+    /**
+     * Whether the index can answer checks. False when stale, or when the last rebuild ran out of space.
+     */
+    bool IsUsable() const { return mState == State::kReady; }
+
+    /**
+     * Start a rebuild.
+     */
+    void Clear();
+
+    /**
+     * Add an entry to the index being rebuilt. Its subjects and targets are added by the AddSubject and AddTarget
+     * calls that follow.
+     *
+     * @param grantedPrivileges The bitwise OR of all request privileges that the entry's privilege grants.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if the index is full; the index stays unusable until the next invalidation.
+     */
+    CHIP_ERROR AddEntry(FabricIndex fabricIndex, AuthMode authMode, uint8_t grantedPrivileges);
+    CHIP_ERROR AddSubject(NodeId subject);
+    CHIP_ERROR AddTarget(TargetFlags flags, ClusterId cluster, EndpointId endpoint, DeviceTypeId deviceType);
+
+    /**
+     * Complete a rebuild started by Clear().
+     */
+    void Finalize();
+
+    /**
+     * Check whether any indexed entry of the subject's fabric allows the request. Must only be called while
+     * IsUsable().
+     *
+     * @param isDeviceTypeOnEndpoint Called as isDeviceTypeOnEndpoint(deviceType, endpoint) for targets that name a
+     *                               device type.
+     * @param dependsOnDeviceTypes   Set to true if the outcome depended on a device type target, in which case it must
+     *                               not be remembered, since endpoints can change their device types.
+     */
+    template <typename DeviceTypeMatcher>
+    bool IsAllowed(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                   DeviceTypeMatcher && isDeviceTypeOnEndpoint, bool & dependsOnDeviceTypes) const
+    {
+        VerifyOrDie(IsUsable());
+
+        dependsOnDeviceTypes = false;
+        for (size_t i = 0; i < mEntryCount; i++)
+        {
+            const Entry & entry = mEntries[i];
+            if (entry.mFabricIndex != subjectDescriptor.fabricIndex || entry.mAuthMode != subjectDescriptor.authMode ||
+                (entry.mGrantedPrivileges & static_cast<uint8_t>(requestPrivilege)) == 0 ||
+                !MatchesSubject(entry, subjectDescriptor))
+            {
+                continue;
+            }
+
+            bool targetMatched = (entry.mTargetCount == 0);
+            for (size_t t = entry.mFirstTarget; t < entry.mFirstTarget + entry.mTargetCount && !targetMatched; t++)
+            {
+                const Target & target = mTargets[t];
+                if (((target.mFlags & kCluster) && target.mCluster != requestPath.cluster) ||
+                    ((target.mFlags & kEndpoint) && target.mEndpoint != requestPath.endpoint))
+                {
+                    continue;
+                }
+                if (target.mFlags & kDeviceType)
+                {
+                    dependsOnDeviceTypes = true;
+                    if (!isDeviceTypeOnEndpoint(target.mDeviceType, requestPath.endpoint))
+                    {
+                        continue;
+                    }
+                }
+                targetMatched = true;
+            }
+            if (targetMatched)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Look up a remembered decision, making it the most recently used one.
+     *
+     * @return std::nullopt if there is none, or whether the request was allowed.
+     */
+    std::optional<bool> FindDecision(const DecisionKey & key);
+
+    /**
+     * Remember a decision, evicting the least recently used one if there is no room left.
+     */
+    void AddDecision(const DecisionKey & key, bool allowed);
+
+    size_t GetEntryCount() const { return mEntryCount; }
+    size_t GetDecisionCount() const { return mDecisionCount; }
+
+private:
+    enum class State : uint8_t
+    {
+        kStale,
+        kBuilding,
+        kReady,
+        kOverflow,
+    };
+
+    struct Entry
+    {
+        uint16_t mFirstSubject;
+        uint16_t mSubjectCount;
+        uint16_t mFirstTarget;
+        uint16_t mTargetCount;
+        FabricIndex mFabricIndex;
+        AuthMode mAuthMode;
+        uint8_t mGrantedPrivileges;
+    };
+
+    struct Target
+    {
+        ClusterId mCluster;
+        DeviceTypeId mDeviceType;
+        EndpointId mEndpoint;
+        TargetFlags mFlags;
+    };
+
+    struct Decision
+    {
+        DecisionKey mKey;
+        uint32_t mLastUse;
+        bool mAllowed;
+    };
+
+    bool MatchesSubject(const Entry & entry, const SubjectDescriptor & subjectDescriptor) const
+    {
+        if (entry.mSubjectCount == 0)
+        {
+            return true;
+        }
+        for (size_t s = entry.mFirstSubject; s < entry.mFirstSubject + entry.mSubjectCount; s++)
+        {
+            // Entries are validated on creation, so CATs only appear in CASE entries.
+            if (IsCASEAuthTag(mSubjects[s]) ? subjectDescriptor.cats.CheckSubjectAgainstCATs(mSubjects[s])
+                                            : mSubjects[s] == subjectDescriptor.subject)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Entry mEntries[kMaxEntries];
+    NodeId mSubjects[kMaxSubjects];
+    Target mTargets[kMaxTargets];
+    size_t mEntryCount   = 0;
+    size_t mSubjectCount = 0;
+    size_t mTargetCount  = 0;
+    State mState         = State::kStale;
+
+    // Decisions are few, so they are looked up by a linear scan and evicted by least recent use.
+    Decision mDecisions[kMaxDecisionCount];
+    size_t mDecisionCount = 0;
+    uint32_t mUseCounter  = 0;
+};
+
+} // namespace Access
+} // namespace chip
+
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
@@ -35,7 +35,9 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/tests/ExtraPwTestMacros.h>
+#include <system/SystemClock.h>
 
 namespace {
 
@@ -1990,6 +1992,203 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+TEST_F(TestAccessControl, TestCheckAfterEntryChanges)
+{
+    const SubjectDescriptor subjectDescriptor = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId1 };
+    RequestPath requestPath                   = { .cluster = kOnOffCluster, .endpoint = 1 };
+#if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
+    requestPath.requestType = Access::RequestType::kAttributeReadRequest;
+#endif
+
+    constexpr EntryData entryData[] = {
+        {
+            .fabricIndex = 1,
+            .privilege   = Privilege::kOperate,
+            .authMode    = AuthMode::kCase,
+            .subjects    = { kOperationalNodeId1 },
+            .targets     = { { .flags = Target::kCluster, .cluster = kOnOffCluster } },
+        },
+    };
+    EXPECT_SUCCESS(LoadAccessControl(accessControl, entryData, MATTER_ARRAY_SIZE(entryData)));
+
+    // Repeated checks must keep following the entries as they are updated, deleted and created again.
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage), CHIP_ERROR_ACCESS_DENIED);
+    }
+
+    Entry entry;
+    EXPECT_SUCCESS(accessControl.ReadEntry(0, entry));
+    EXPECT_SUCCESS(entry.SetPrivilege(Privilege::kManage));
+    EXPECT_SUCCESS(accessControl.UpdateEntry(0, entry));
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage), CHIP_NO_ERROR);
+
+    EXPECT_SUCCESS(entry.SetSubject(0, kOperationalNodeId2));
+    EXPECT_SUCCESS(accessControl.UpdateEntry(0, entry));
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_ERROR_ACCESS_DENIED);
+
+    EXPECT_SUCCESS(entry.SetSubject(0, kOperationalNodeId1));
+    EXPECT_SUCCESS(accessControl.UpdateEntry(0, entry));
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_NO_ERROR);
+
+    EXPECT_SUCCESS(accessControl.DeleteEntry(0));
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_ERROR_ACCESS_DENIED);
+
+    EXPECT_SUCCESS(LoadAccessControl(accessControl, entryData, MATTER_ARRAY_SIZE(entryData)));
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_NO_ERROR);
+
+    // The same subject on another fabric is a different decision.
+    SubjectDescriptor otherFabric = subjectDescriptor;
+    otherFabric.fabricIndex       = 2;
+    EXPECT_EQ(accessControl.Check(otherFabric, requestPath, Privilege::kOperate), CHIP_ERROR_ACCESS_DENIED);
+}
+
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
+TEST_F(TestAccessControl, TestCheckWithCATAfterEntryChanges)
+{
+    SubjectDescriptor subjectDescriptor = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId1 };
+    subjectDescriptor.cats.values[0]    = kCASEAuthTag0;
+    RequestPath requestPath             = { .cluster = kOnOffCluster, .endpoint = 1 };
+#if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
+    requestPath.requestType = Access::RequestType::kAttributeReadRequest;
+#endif
+
+    constexpr EntryData entryData[] = {
+        {
+            .fabricIndex = 1,
+            .privilege   = Privilege::kView,
+            .authMode    = AuthMode::kCase,
+            .subjects    = { kCASEAuthTagAsNodeId0 },
+        },
+    };
+    EXPECT_SUCCESS(LoadAccessControl(accessControl, entryData, MATTER_ARRAY_SIZE(entryData)));
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_NO_ERROR);
+    EXPECT_EQ(accessControl.mIndex.GetDecisionCount(), 1u);
+
+    // The same subject holding another CAT must not reuse the decision.
+    SubjectDescriptor otherCats = subjectDescriptor;
+    otherCats.cats.values[0]    = kCASEAuthTag1;
+    EXPECT_EQ(accessControl.Check(otherCats, requestPath, Privilege::kView), CHIP_ERROR_ACCESS_DENIED);
+    EXPECT_EQ(accessControl.mIndex.GetDecisionCount(), 2u);
+
+    EXPECT_SUCCESS(accessControl.DeleteEntry(0));
+    EXPECT_EQ(accessControl.mIndex.GetDecisionCount(), 0u);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_ERROR_ACCESS_DENIED);
+}
+
+TEST_F(TestAccessControl, BenchmarkWildcardRead)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    constexpr EndpointId kEndpointCount    = 100;
+    constexpr ClusterId kClusters[]        = { 0x0003, 0x0004, 0x0006, 0x0008, 0x001D, 0x0028, 0x0300, 0x0406 };
+    constexpr size_t kAttributesPerCluster = 10;
+    constexpr size_t kChecksPerRead        = kEndpointCount * MATTER_ARRAY_SIZE(kClusters) * kAttributesPerCluster;
+    SubjectDescriptor subjectDescriptor    = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId1 };
+    subjectDescriptor.cats.values[0]       = kCASEAuthTag0;
+
+    // A typical fabric: an administrator, a group with operate rights on a few clusters, and the reader's view entry,
+    // granted through a CAT, last.
+    constexpr EntryData entryData[] = {
+        {
+            .fabricIndex = 1,
+            .privilege   = Privilege::kAdminister,
+            .authMode    = AuthMode::kCase,
+            .subjects    = { kOperationalNodeId3 },
+        },
+        {
+            .fabricIndex = 1,
+            .privilege   = Privilege::kOperate,
+            .authMode    = AuthMode::kGroup,
+            .subjects    = { kGroup2, kGroup4 },
+            .targets     = { { .flags = Target::kCluster, .cluster = kOnOffCluster },
+                             { .flags = Target::kCluster, .cluster = kLevelControlCluster } },
+        },
+        {
+            .fabricIndex = 1,
+            .privilege   = Privilege::kManage,
+            .authMode    = AuthMode::kCase,
+            .subjects    = { kOperationalNodeId2, kOperationalNodeId4 },
+            .targets     = { { .flags = Target::kEndpoint, .endpoint = 0 } },
+        },
+        {
+            .fabricIndex = 1,
+            .privilege   = Privilege::kView,
+            .authMode    = AuthMode::kCase,
+            .subjects    = { kCASEAuthTagAsNodeId2, kCASEAuthTagAsNodeId0 },
+        },
+        {
+            .fabricIndex = 2,
+            .privilege   = Privilege::kAdminister,
+            .authMode    = AuthMode::kCase,
+            .subjects    = { kOperationalNodeId4 },
+        },
+        {
+            .fabricIndex = 2,
+            .privilege   = Privilege::kView,
+            .authMode    = AuthMode::kCase,
+            .subjects    = { kOperationalNodeId5 },
+        },
+    };
+    EXPECT_SUCCESS(LoadAccessControl(accessControl, entryData, MATTER_ARRAY_SIZE(entryData)));
+
+#if CHIP_LOG_FILTERING
+    // Every check is logged; keep that out of the measurement.
+    const uint8_t logFilter = Logging::GetLogFilter();
+    Logging::SetLogFilter(Logging::kLogCategory_Error);
+#endif
+
+    size_t entriesAllowed = 0;
+    Testing::BenchmarkTimer timer;
+    for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+    {
+        for (ClusterId cluster : kClusters)
+        {
+            for (size_t attribute = 0; attribute < kAttributesPerCluster; attribute++)
+            {
+                RequestPath requestPath = { .cluster = cluster, .endpoint = endpoint };
+                entriesAllowed += (accessControl.CheckEntries(subjectDescriptor, requestPath, Privilege::kView) == CHIP_NO_ERROR);
+            }
+        }
+    }
+    const System::Clock::Microseconds64 entriesTime = timer.Elapsed();
+
+    size_t indexAllowed = 0;
+    timer.Restart();
+    for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+    {
+        for (ClusterId cluster : kClusters)
+        {
+            for (size_t attribute = 0; attribute < kAttributesPerCluster; attribute++)
+            {
+                RequestPath requestPath = { .cluster = cluster, .endpoint = endpoint };
+#if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
+                requestPath.requestType = Access::RequestType::kAttributeReadRequest;
+#endif
+                indexAllowed += (accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_NO_ERROR);
+            }
+        }
+    }
+    const System::Clock::Microseconds64 indexTime = timer.Elapsed();
+
+#if CHIP_LOG_FILTERING
+    Logging::SetLogFilter(logFilter);
+#endif
+
+    EXPECT_EQ(entriesAllowed, kChecksPerRead);
+    EXPECT_EQ(indexAllowed, kChecksPerRead);
+    EXPECT_TRUE(accessControl.mIndex.IsUsable());
+    EXPECT_EQ(accessControl.mIndex.GetEntryCount(), MATTER_ARRAY_SIZE(entryData));
+
+    ChipLogProgress(Test, "Wildcard read of %u attributes: %u ns per check walking entries, %u ns per check with index",
+                    static_cast<unsigned>(kChecksPerRead), static_cast<unsigned>(entriesTime.count() * 1000 / kChecksPerRead),
+                    static_cast<unsigned>(indexTime.count() * 1000 / kChecksPerRead));
+}
+
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -19,6 +19,8 @@
 #include "system/SystemPacketBuffer.h"
 #include <app/ClusterStateCache.h>
 #include <app/InteractionModelEngine.h>
+#include <algorithm>
+#include <string.h>
 #include <tuple>
 
 namespace chip {
@@ -49,20 +51,139 @@ uint32_t SizeOfStatusIB(const StatusIB & aStatus)
 
 } // anonymous namespace
 
+AttributeDataArena::Slot AttributeDataArena::Append(const uint8_t * data, uint32_t size)
+{
+    Slot slot;
+    slot.mOffset = static_cast<uint32_t>(mBuffer.size());
+    slot.mSize   = size;
+    mBuffer.insert(mBuffer.end(), data, data + size);
+    return slot;
+}
+
+void AttributeDataArena::Update(Slot & slot, const uint8_t * data, uint32_t size)
+{
+    if (size <= slot.mSize)
+    {
+        memcpy(mBuffer.data() + slot.mOffset, data, size);
+        mGarbageSize += slot.mSize - size;
+        slot.mSize = size;
+        return;
+    }
+
+    Release(slot);
+    slot = Append(data, size);
+}
+
+void AttributeDataArena::Release(const Slot & slot)
+{
+    mGarbageSize += slot.mSize;
+}
+
 template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetElementTLVSize(TLV::TLVReader * apData, uint32_t & aSize)
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::CopyElement(TLV::TLVReader * apData, uint32_t & aSize)
 {
-    Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
     TLV::TLVReader reader;
     reader.Init(*apData);
     size_t totalBufSize = reader.GetTotalLength();
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
+    if (mElementBuffer.AllocatedSize() < totalBufSize)
+    {
+        mElementBuffer.Alloc(totalBufSize);
+        VerifyOrReturnError(mElementBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    TLV::TLVWriter writer;
+    writer.Init(mElementBuffer.Get(), totalBufSize);
     ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
     aSize = writer.GetLengthWritten();
-    ReturnErrorOnFailure(writer.Finalize(backingBuffer));
-    return CHIP_NO_ERROR;
+    return writer.Finalize();
+}
+
+template <bool CanEnableDataCaching>
+typename ClusterStateCacheT<CanEnableDataCaching>::NodeState::const_iterator
+ClusterStateCacheT<CanEnableDataCaching>::FindFirstCluster(EndpointId endpointId) const
+{
+    return std::lower_bound(mCache.begin(), mCache.end(), endpointId,
+                            [](const ClusterState & cluster, EndpointId endpoint) { return cluster.mEndpointId < endpoint; });
+}
+
+template <bool CanEnableDataCaching>
+typename ClusterStateCacheT<CanEnableDataCaching>::ClusterState *
+ClusterStateCacheT<CanEnableDataCaching>::FindCluster(EndpointId endpointId, ClusterId clusterId)
+{
+    CHIP_ERROR err;
+    return const_cast<ClusterState *>(GetClusterState(endpointId, clusterId, err));
+}
+
+template <bool CanEnableDataCaching>
+typename ClusterStateCacheT<CanEnableDataCaching>::ClusterState &
+ClusterStateCacheT<CanEnableDataCaching>::FindOrCreateCluster(EndpointId endpointId, ClusterId clusterId)
+{
+    auto clusterIter = std::lower_bound(mCache.begin(), mCache.end(), std::make_pair(endpointId, clusterId),
+                                        [](const ClusterState & cluster, const std::pair<EndpointId, ClusterId> & key) {
+                                            return std::make_pair(cluster.mEndpointId, cluster.mClusterId) < key;
+                                        });
+    if (clusterIter == mCache.end() || clusterIter->mEndpointId != endpointId || clusterIter->mClusterId != clusterId)
+    {
+        ClusterState clusterState;
+        clusterState.mEndpointId = endpointId;
+        clusterState.mClusterId  = clusterId;
+        clusterIter              = mCache.insert(clusterIter, std::move(clusterState));
+    }
+    return *clusterIter;
+}
+
+template <bool CanEnableDataCaching>
+typename ClusterStateCacheT<CanEnableDataCaching>::AttributeEntry &
+ClusterStateCacheT<CanEnableDataCaching>::FindOrCreateAttribute(ClusterState & clusterState, AttributeId attributeId)
+{
+    auto & attributes = clusterState.mAttributes;
+    auto attributeIter =
+        std::lower_bound(attributes.begin(), attributes.end(), attributeId,
+                         [](const AttributeEntry & attribute, AttributeId id) { return attribute.mAttributeId < id; });
+    if (attributeIter == attributes.end() || attributeIter->mAttributeId != attributeId)
+    {
+        attributeIter = attributes.insert(attributeIter, AttributeEntry{ attributeId, AttributeState() });
+    }
+    return *attributeIter;
+}
+
+template <bool CanEnableDataCaching>
+void ClusterStateCacheT<CanEnableDataCaching>::ReleaseAttributeData(const ClusterState & clusterState)
+{
+    if constexpr (CanEnableDataCaching)
+    {
+        for (const auto & attribute : clusterState.mAttributes)
+        {
+            if (attribute.mState.template Is<AttributeData>())
+            {
+                mAttributeData.Release(attribute.mState.template Get<AttributeData>());
+            }
+        }
+    }
+}
+
+template <bool CanEnableDataCaching>
+void ClusterStateCacheT<CanEnableDataCaching>::CompactAttributeData()
+{
+    if constexpr (CanEnableDataCaching)
+    {
+        VerifyOrReturn(mAttributeData.NeedsCompaction());
+
+        AttributeDataArena compacted;
+        compacted.Reserve(mAttributeData.GetLiveSize());
+        for (auto & clusterState : mCache)
+        {
+            for (auto & attribute : clusterState.mAttributes)
+            {
+                if (attribute.mState.template Is<AttributeData>())
+                {
+                    AttributeData & data = attribute.mState.template Get<AttributeData>();
+                    data                 = compacted.Append(mAttributeData.Data(data), data.mSize);
+                }
+            }
+        }
+        mAttributeData = std::move(compacted);
+    }
 }
 
 template <bool CanEnableDataCaching>
@@ -71,8 +192,10 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
 {
     AttributeState state;
     bool endpointIsNew = false;
+    uint32_t dataSize  = 0;
 
-    if (mCache.find(aPath.mEndpointId) == mCache.end())
+    auto firstCluster = FindFirstCluster(aPath.mEndpointId);
+    if (firstCluster == mCache.end() || firstCluster->mEndpointId != aPath.mEndpointId)
     {
         //
         // Since we might potentially be creating a new entry at mCache[aPath.mEndpointId][aPath.mClusterId] that
@@ -85,20 +208,14 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
     if (apData)
     {
         uint32_t elementSize = 0;
-        ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
+        ReturnErrorOnFailure(CopyElement(apData, elementSize));
 
         if constexpr (CanEnableDataCaching)
         {
             if (mCacheData)
             {
-                Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
-                backingBuffer.Calloc(elementSize);
-                VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-                TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
-                ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
-                ReturnErrorOnFailure(writer.Finalize(backingBuffer));
-
-                state.template Set<AttributeData>(std::move(backingBuffer));
+                // The element is moved from mElementBuffer into mAttributeData below, once its entry exists.
+                dataSize = elementSize;
             }
             else
             {
@@ -110,18 +227,19 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
             state = elementSize;
         }
 
-        //
-        // Clear out the committed data version and only set it again once we have received all data for this cluster.
-        // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
-        //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
-
         // This commits a pending data version if the last report path is valid and it is different from the current path.
+        // It is done first since it may insert a cluster, which would move the one for the current path.
         if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
         {
             CommitPendingDataVersion();
         }
 
+        //
+        // Clear out the committed data version and only set it again once we have received all data for this cluster.
+        // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
+        //
+        FindOrCreateCluster(aPath.mEndpointId, aPath.mClusterId).mCommittedDataVersion.ClearValue();
+
         bool foundEncompassingWildcardPath = false;
         for (const auto & path : mRequestPathSet)
         {
@@ -135,7 +253,7 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
         if (foundEncompassingWildcardPath)
         {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
+            FindOrCreateCluster(aPath.mEndpointId, aPath.mClusterId).mPendingDataVersion = aPath.mDataVersion;
         }
 
         mLastReportDataPath = aPath;
@@ -168,7 +286,30 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
-    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
+    ClusterState & clusterState = FindOrCreateCluster(aPath.mEndpointId, aPath.mClusterId);
+    AttributeEntry & attribute  = FindOrCreateAttribute(clusterState, aPath.mAttributeId);
+    if constexpr (CanEnableDataCaching)
+    {
+        if (attribute.mState.template Is<AttributeData>())
+        {
+            AttributeData data = attribute.mState.template Get<AttributeData>();
+            if (dataSize > 0)
+            {
+                // Overwrites the old value in place if the new one fits.
+                mAttributeData.Update(data, mElementBuffer.Get(), dataSize);
+                state.template Set<AttributeData>(data);
+            }
+            else
+            {
+                mAttributeData.Release(data);
+            }
+        }
+        else if (dataSize > 0)
+        {
+            state.template Set<AttributeData>(mAttributeData.Append(mElementBuffer.Get(), dataSize));
+        }
+    }
+    attribute.mState = std::move(state);
 
     if (mCacheData)
     {
@@ -250,7 +391,7 @@ void ClusterStateCacheT<CanEnableDataCaching>::CommitPendingDataVersion()
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
+    auto & lastClusterInfo = FindOrCreateCluster(mLastReportDataPath.mEndpointId, mLastReportDataPath.mClusterId);
     if (lastClusterInfo.mPendingDataVersion.HasValue())
     {
         lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
@@ -263,6 +404,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
 {
     CommitPendingDataVersion();
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+    mElementBuffer.Free();
+    CompactAttributeData();
     std::set<std::tuple<EndpointId, ClusterId>> changedClusters;
 
     //
@@ -305,7 +448,8 @@ CHIP_ERROR ClusterStateCacheT<true>::Get(const ConcreteAttributePath & path, TLV
         return CHIP_ERROR_KEY_NOT_FOUND;
     }
 
-    reader.Init(attributeState->template Get<AttributeData>().Get(), attributeState->template Get<AttributeData>().AllocatedSize());
+    const AttributeData & data = attributeState->template Get<AttributeData>();
+    reader.Init(mAttributeData.Data(data), data.mSize);
     return reader.Next();
 }
 
@@ -332,40 +476,22 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::Get(EventNumber eventNumber
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::EndpointState *
-ClusterStateCacheT<CanEnableDataCaching>::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
-{
-    auto endpointIter = mCache.find(endpointId);
-    if (endpointIter == mCache.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &endpointIter->second;
-}
-
 template <bool CanEnableDataCaching>
 const typename ClusterStateCacheT<CanEnableDataCaching>::ClusterState *
 ClusterStateCacheT<CanEnableDataCaching>::GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const
 {
-    auto endpointState = GetEndpointState(endpointId, err);
-    if (err != CHIP_NO_ERROR)
-    {
-        return nullptr;
-    }
-
-    auto clusterState = endpointState->find(clusterId);
-    if (clusterState == endpointState->end())
+    auto clusterState = std::lower_bound(mCache.begin(), mCache.end(), std::make_pair(endpointId, clusterId),
+                                         [](const ClusterState & cluster, const std::pair<EndpointId, ClusterId> & key) {
+                                             return std::make_pair(cluster.mEndpointId, cluster.mClusterId) < key;
+                                         });
+    if (clusterState == mCache.end() || clusterState->mEndpointId != endpointId || clusterState->mClusterId != clusterId)
     {
         err = CHIP_ERROR_KEY_NOT_FOUND;
         return nullptr;
     }
 
     err = CHIP_NO_ERROR;
-    return &clusterState->second;
+    return &*clusterState;
 }
 
 template <bool CanEnableDataCaching>
@@ -379,15 +505,17 @@ ClusterStateCacheT<CanEnableDataCaching>::GetAttributeState(EndpointId endpointI
         return nullptr;
     }
 
-    auto attributeState = clusterState->mAttributes.find(attributeId);
-    if (attributeState == clusterState->mAttributes.end())
+    auto & attributes  = clusterState->mAttributes;
+    auto attributeIter = std::lower_bound(attributes.begin(), attributes.end(), attributeId,
+                                          [](const AttributeEntry & entry, AttributeId id) { return entry.mAttributeId < id; });
+    if (attributeIter == attributes.end() || attributeIter->mAttributeId != attributeId)
     {
         err = CHIP_ERROR_KEY_NOT_FOUND;
         return nullptr;
     }
 
     err = CHIP_NO_ERROR;
-    return &attributeState->second;
+    return &attributeIter->mState;
 }
 
 template <bool CanEnableDataCaching>
@@ -507,62 +635,50 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetStatus(const ConcreteEve
 template <bool CanEnableDataCaching>
 void ClusterStateCacheT<CanEnableDataCaching>::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
 {
-    for (auto const & endpointIter : mCache)
+    for (auto const & clusterState : mCache)
     {
-        EndpointId endpointId = endpointIter.first;
-        for (auto const & clusterIter : endpointIter.second)
+        if (!clusterState.mCommittedDataVersion.HasValue())
         {
-            if (!clusterIter.second.mCommittedDataVersion.HasValue())
-            {
-                continue;
-            }
-            DataVersion dataVersion = clusterIter.second.mCommittedDataVersion.Value();
-            size_t clusterSize      = 0;
-            ClusterId clusterId     = clusterIter.first;
+            continue;
+        }
+        DataVersion dataVersion = clusterState.mCommittedDataVersion.Value();
+        size_t clusterSize      = 0;
 
-            for (auto const & attributeIter : clusterIter.second.mAttributes)
+        for (auto const & attribute : clusterState.mAttributes)
+        {
+            if constexpr (CanEnableDataCaching)
             {
-                if constexpr (CanEnableDataCaching)
+                if (attribute.mState.template Is<StatusIB>())
+                {
+                    clusterSize += SizeOfStatusIB(attribute.mState.template Get<StatusIB>());
+                }
+                else if (attribute.mState.template Is<uint32_t>())
                 {
-                    if (attributeIter.second.template Is<StatusIB>())
-                    {
-                        clusterSize += SizeOfStatusIB(attributeIter.second.template Get<StatusIB>());
-                    }
-                    else if (attributeIter.second.template Is<uint32_t>())
-                    {
-                        clusterSize += attributeIter.second.template Get<uint32_t>();
-                    }
-                    else
-                    {
-                        VerifyOrDie(attributeIter.second.template Is<AttributeData>());
-                        TLV::TLVReader bufReader;
-                        bufReader.Init(attributeIter.second.template Get<AttributeData>().Get(),
-                                       attributeIter.second.template Get<AttributeData>().AllocatedSize());
-                        ReturnOnFailure(bufReader.Next());
-                        // Skip to the end of the element.
-                        ReturnOnFailure(bufReader.Skip());
-
-                        // Compute the amount of value data
-                        clusterSize += bufReader.GetLengthRead();
-                    }
+                    clusterSize += attribute.mState.template Get<uint32_t>();
                 }
                 else
                 {
-                    clusterSize += attributeIter.second;
+                    VerifyOrDie(attribute.mState.template Is<AttributeData>());
+                    // The stored element is exactly the size of the value data.
+                    clusterSize += attribute.mState.template Get<AttributeData>().mSize;
                 }
             }
-
-            if (clusterSize == 0)
+            else
             {
-                // No data in this cluster, so no point in sending a dataVersion
-                // along at all.
-                continue;
+                clusterSize += attribute.mState;
             }
+        }
 
-            DataVersionFilter filter(endpointId, clusterId, dataVersion);
-
-            aVector.push_back(std::make_pair(filter, clusterSize));
+        if (clusterSize == 0)
+        {
+            // No data in this cluster, so no point in sending a dataVersion
+            // along at all.
+            continue;
         }
+
+        DataVersionFilter filter(clusterState.mEndpointId, clusterState.mClusterId, dataVersion);
+
+        aVector.push_back(std::make_pair(filter, clusterSize));
     }
 
     std::sort(aVector.begin(), aVector.end(),
@@ -649,42 +765,48 @@ exit:
 template <bool CanEnableDataCaching>
 void ClusterStateCacheT<CanEnableDataCaching>::ClearAttributes(EndpointId endpointId)
 {
-    mCache.erase(endpointId);
+    auto first = FindFirstCluster(endpointId);
+    auto last  = first;
+    for (; last != mCache.end() && last->mEndpointId == endpointId; ++last)
+    {
+        ReleaseAttributeData(*last);
+    }
+    mCache.erase(first, last);
+    CompactAttributeData();
 }
 
 template <bool CanEnableDataCaching>
 void ClusterStateCacheT<CanEnableDataCaching>::ClearAttributes(const ConcreteClusterPath & cluster)
 {
-    // Can't use GetEndpointState here, since that only handles const things.
-    auto endpointIter = mCache.find(cluster.mEndpointId);
-    if (endpointIter == mCache.end())
-    {
-        return;
-    }
+    ClusterState * clusterState = FindCluster(cluster.mEndpointId, cluster.mClusterId);
+    VerifyOrReturn(clusterState != nullptr);
 
-    auto & endpointState = endpointIter->second;
-    endpointState.erase(cluster.mClusterId);
+    ReleaseAttributeData(*clusterState);
+    mCache.erase(mCache.begin() + (clusterState - mCache.data()));
+    CompactAttributeData();
 }
 
 template <bool CanEnableDataCaching>
 void ClusterStateCacheT<CanEnableDataCaching>::ClearAttribute(const ConcreteAttributePath & attribute)
 {
-    // Can't use GetClusterState here, since that only handles const things.
-    auto endpointIter = mCache.find(attribute.mEndpointId);
-    if (endpointIter == mCache.end())
-    {
-        return;
-    }
+    ClusterState * clusterState = FindCluster(attribute.mEndpointId, attribute.mClusterId);
+    VerifyOrReturn(clusterState != nullptr);
 
-    auto & endpointState = endpointIter->second;
-    auto clusterIter     = endpointState.find(attribute.mClusterId);
-    if (clusterIter == endpointState.end())
+    auto & attributes  = clusterState->mAttributes;
+    auto attributeIter = std::lower_bound(
+        attributes.begin(), attributes.end(), attribute.mAttributeId,
+        [](const AttributeEntry & entry, AttributeId id) { return entry.mAttributeId < id; });
+    VerifyOrReturn(attributeIter != attributes.end() && attributeIter->mAttributeId == attribute.mAttributeId);
+
+    if constexpr (CanEnableDataCaching)
     {
-        return;
+        if (attributeIter->mState.template Is<AttributeData>())
+        {
+            mAttributeData.Release(attributeIter->mState.template Get<AttributeData>());
+        }
     }
-
-    auto & clusterState = clusterIter->second;
-    clusterState.mAttributes.erase(attribute.mAttributeId);
+    attributes.erase(attributeIter);
+    CompactAttributeData();
 }
 
 template <bool CanEnableDataCaching>
@@ -698,6 +820,17 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetLastReportDataPath(Concr
     return CHIP_ERROR_INCORRECT_STATE;
 }
 
+template <bool CanEnableDataCaching>
+size_t ClusterStateCacheT<CanEnableDataCaching>::GetAttributeStorageSize() const
+{
+    size_t size = mCache.capacity() * sizeof(ClusterState) + mAttributeData.GetAllocatedSize();
+    for (const auto & clusterState : mCache)
+    {
+        size += clusterState.mAttributes.capacity() * sizeof(AttributeEntry);
+    }
+    return size;
+}
+
 // Ensure that our out-of-line template methods actually get compiled.
 template class ClusterStateCacheT<true>;
 template class ClusterStateCacheT<false>;
@@ -38,6 +38,49 @@
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
 namespace chip {
 namespace app {
+
+/*
+ * Contiguous storage for the TLV elements of cached attribute values.
+ *
+ * Values are appended one after another and referred to by their offset, so caching a value costs no allocation of
+ * its own. A value that is replaced by one of the same or a smaller size is overwritten in place; otherwise the old
+ * bytes become garbage, which the owner reclaims by copying the live values into a new arena once NeedsCompaction().
+ */
+class AttributeDataArena
+{
+public:
+    struct Slot
+    {
+        uint32_t mOffset = 0;
+        uint32_t mSize   = 0;
+    };
+
+    // Below this size the garbage is not worth a compaction.
+    static constexpr size_t kMinCompactionSize = 4096;
+
+    Slot Append(const uint8_t * data, uint32_t size);
+
+    /*
+     * Store a new value for @p slot, in place if it fits.
+     */
+    void Update(Slot & slot, const uint8_t * data, uint32_t size);
+
+    void Release(const Slot & slot);
+
+    const uint8_t * Data(const Slot & slot) const { return mBuffer.data() + slot.mOffset; }
+
+    bool NeedsCompaction() const { return mGarbageSize >= kMinCompactionSize && mGarbageSize > mBuffer.size() - mGarbageSize; }
+
+    void Reserve(size_t size) { mBuffer.reserve(size); }
+
+    size_t GetLiveSize() const { return mBuffer.size() - mGarbageSize; }
+    size_t GetAllocatedSize() const { return mBuffer.capacity(); }
+
+private:
+    std::vector<uint8_t> mBuffer;
+    size_t mGarbageSize = 0;
+};
+
 /*
  * This implements a cluster state cache designed to aggregate both attribute and event data received by a client
  * from either read or subscribe interactions and keep it resident and available for clients to
@@ -261,8 +304,8 @@ public:
      * Retrieve the value of an attribute by updating a in-out TLVReader to be positioned
      * right at the attribute value.
      *
-     * The underlying TLV buffer only remains valid until the cached value for that path is updated, so it must
-     * not be held across any async call boundaries.
+     * The underlying TLV buffer is shared by all cached values and only remains valid until the cache is next updated
+     * or cleared, so it must not be held across any async call boundaries.
      *
      * Notable return values:
      *      - If neither data nor status for the specified path exist in the cache, CHIP_ERROR_KEY_NOT_FOUND
@@ -378,9 +421,9 @@ public:
         auto clusterState = GetClusterState(endpointId, clusterId, err);
         ReturnErrorOnFailure(err);
 
-        for (auto & attributeIter : clusterState->mAttributes)
+        for (auto & attributeEntry : clusterState->mAttributes)
         {
-            const ConcreteAttributePath path(endpointId, clusterId, attributeIter.first);
+            const ConcreteAttributePath path(endpointId, clusterId, attributeEntry.mAttributeId);
             ReturnErrorOnFailure(func(path));
         }
 
@@ -403,17 +446,14 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
-        for (auto & endpointIter : mCache)
+        for (auto & clusterState : mCache)
         {
-            for (auto & clusterIter : endpointIter.second)
+            if (clusterState.mClusterId == clusterId)
             {
-                if (clusterIter.first == clusterId)
+                for (auto & attributeEntry : clusterState.mAttributes)
                 {
-                    for (auto & attributeIter : clusterIter.second.mAttributes)
-                    {
-                        const ConcreteAttributePath path(endpointIter.first, clusterId, attributeIter.first);
-                        ReturnErrorOnFailure(func(path));
-                    }
+                    const ConcreteAttributePath path(clusterState.mEndpointId, clusterId, attributeEntry.mAttributeId);
+                    ReturnErrorOnFailure(func(path));
                 }
             }
         }
@@ -435,15 +475,12 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(IteratorFunc func) const
     {
-        for (const auto & [endpointId, endpointState] : mCache)
+        for (const auto & clusterState : mCache)
         {
-            for (const auto & [clusterId, clusterState] : endpointState)
+            for (const auto & attributeEntry : clusterState.mAttributes)
             {
-                for (const auto & attributeIter : clusterState.mAttributes)
-                {
-                    const ConcreteAttributePath path(endpointId, clusterId, attributeIter.first);
-                    ReturnErrorOnFailure(func(path));
-                }
+                const ConcreteAttributePath path(clusterState.mEndpointId, clusterState.mClusterId, attributeEntry.mAttributeId);
+                ReturnErrorOnFailure(func(path));
             }
         }
         return CHIP_NO_ERROR;
@@ -465,13 +502,10 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
-        auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        for (auto clusterIter = FindFirstCluster(endpointId); clusterIter != mCache.end() && clusterIter->mEndpointId == endpointId;
+             ++clusterIter)
         {
-            for (auto & clusterIter : endpointIter->second)
-            {
-                ReturnErrorOnFailure(func(clusterIter.first));
-            }
+            ReturnErrorOnFailure(func(clusterIter->mClusterId));
         }
         return CHIP_NO_ERROR;
     }
@@ -577,6 +611,11 @@ public:
      */
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
+    /*
+     * Get the number of bytes allocated for the cached attribute state, including the attribute values.
+     */
+    size_t GetAttributeStorageSize() const;
+
 private:
     // An attribute state can be one of three things:
     // * If we got a path-specific error for the attribute, the corresponding
@@ -590,21 +629,33 @@ private:
     // The data for a single attribute is not going to be gigabytes in size, so
     // using uint32_t for the size is fine; on 64-bit systems this can save
     // quite a bit of space.
-    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
+    //
+    // Data is kept in mAttributeData, and the state only refers to it.
+    using AttributeData  = AttributeDataArena::Slot;
     using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
+    struct AttributeEntry
+    {
+        AttributeId mAttributeId;
+        AttributeState mState;
+    };
     // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
     //
     // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
     // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
     // and we must not be in the middle of receiving reports for that cluster.
+    //
+    // Clusters and their attributes are kept in vectors sorted by id rather than in maps, which saves a node
+    // allocation per attribute; reports list the attributes of a cluster together and mostly in order, so they are
+    // usually appended.
     struct ClusterState
     {
-        std::map<AttributeId, AttributeState> mAttributes;
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        std::vector<AttributeEntry> mAttributes; // sorted by attribute id
         Optional<DataVersion> mPendingDataVersion;
         Optional<DataVersion> mCommittedDataVersion;
     };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    using NodeState = std::vector<ClusterState>; // sorted by endpoint id, then cluster id
 
     struct Comparator
     {
@@ -640,13 +691,22 @@ private:
      *        CHIP_ERROR_KEY_NOT_FOUND shall be returned.
      *
      */
-    const EndpointState * GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const;
     const ClusterState * GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const;
     const AttributeState * GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
                                              CHIP_ERROR & err) const;
 
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
+    // The first cluster of the endpoint, or where its first cluster would be inserted.
+    typename NodeState::const_iterator FindFirstCluster(EndpointId endpointId) const;
+    ClusterState * FindCluster(EndpointId endpointId, ClusterId clusterId);
+    ClusterState & FindOrCreateCluster(EndpointId endpointId, ClusterId clusterId);
+    AttributeEntry & FindOrCreateAttribute(ClusterState & clusterState, AttributeId attributeId);
+
+    // Release the data of attributes that are about to be removed, and compact mAttributeData when it is mostly garbage.
+    void ReleaseAttributeData(const ClusterState & clusterState);
+    void CompactAttributeData();
+
     /*
      * Updates the state of an attribute in the cache given a reader. If the reader is null, the state is updated
      * with the provided status.
@@ -716,10 +776,14 @@ private:
     // on the wire if not all filters can be applied.
     void GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
 
-    CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, uint32_t & aSize);
+    // Copy the element apData is positioned on into mElementBuffer, and return its size.
+    CHIP_ERROR CopyElement(TLV::TLVReader * apData, uint32_t & aSize);
 
     Callback & mCallback;
     NodeState mCache;
+    AttributeDataArena mAttributeData;
+    // Scratch space for incoming elements, held for the duration of a report.
+    Platform::ScopedMemoryBufferWithSize<uint8_t> mElementBuffer;
     std::set<ConcreteAttributePath> mChangedAttributeSet;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
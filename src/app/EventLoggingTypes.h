@@ -32,6 +32,8 @@ inline constexpr size_t kNumPriorityLevel = 3;
 namespace chip {
 namespace app {
 
+class EventSpillStorage;
+
 /**
  * @brief
  *   The Priority of the log entry.
@@ -168,6 +170,11 @@ struct EventLoadOutContext
     const SingleLinkedListNode<EventPathParams> * mpInterestedEventPaths = nullptr;
     bool mFirst                                                          = true;
     Access::SubjectDescriptor mSubjectDescriptor;
+    // Spilled events not yet merged into the buffered ones start at mNextSpilledEventNumber. Those numbered below
+    // mFirstEventNumberOfBoot were logged before the last reboot.
+    EventSpillStorage * mpSpillStorage  = nullptr;
+    EventNumber mNextSpilledEventNumber = 0;
+    EventNumber mFirstEventNumberOfBoot = 0;
 };
 } // namespace app
 } // namespace chip
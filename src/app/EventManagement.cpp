@@ -25,8 +25,11 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
+#include <limits>
+#include <string.h>
 
 using namespace chip::TLV;
 
@@ -66,8 +69,77 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    EventSpillStorage * mpSpillStorage  = nullptr;
+    // The epoch time of system timestamp zero, when the real time is known.
+    Optional<System::Clock::Milliseconds64> mSystemTimeEpoch;
+    // The head event of mpEventBuffer, as seen by EvictEvent.
+    EventNumber mHeadEventNumber = 0;
+    ClusterId mHeadClusterId     = 0;
 };
 
+/**
+ * @brief
+ *   A read-only TLVBackingStore over the events of a CircularEventBuffer from the one at a given offset to the tail.
+ */
+class CircularEventBufferFrom : public TLV::TLVBackingStore
+{
+public:
+    CircularEventBufferFrom(const CircularEventBuffer & aBuffer, uint32_t aOffset, uint32_t aLength) :
+        mpBuffer(&aBuffer), mOffset(aOffset), mLength(aLength)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        // Up to the end of the storage; the rest, if any, wraps around to its start.
+        aBufStart = mpBuffer->GetQueue() + mOffset;
+        aBufLen   = std::min(mLength, mpBuffer->GetTotalDataLength() - mOffset);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        // Copies of a reader share the backing store, so where a reader is has to come from the reader itself.
+        const uint32_t firstLength = mpBuffer->GetTotalDataLength() - mOffset;
+        if (aBufStart == mpBuffer->GetQueue() + mpBuffer->GetTotalDataLength() && mLength > firstLength)
+        {
+            aBufStart = mpBuffer->GetQueue();
+            aBufLen   = mLength - firstLength;
+        }
+        else
+        {
+            aBufLen = 0;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & aWriter, uint8_t *& aBufStart, uint32_t & aBufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & aWriter, uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & aWriter, uint8_t * aBufStart, uint32_t aBufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const CircularEventBuffer * mpBuffer;
+    uint32_t mOffset;
+    uint32_t mLength;
+};
+
+bool MayContainInterestedEvents(const EventBufferIndex & aIndex, const SingleLinkedListNode<EventPathParams> * apEventPathList)
+{
+    for (auto * path = apEventPathList; path != nullptr; path = path->mpNext)
+    {
+        if (path->mValue.HasWildcardClusterId() || aIndex.MayContainCluster(path->mValue.mClusterId))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief
  *  Internal structure for traversing event list.
@@ -110,8 +182,9 @@ CHIP_ERROR EventManagement::Init(Messaging::ExchangeManager * apExchangeManager,
         current->mAppData               = nullptr;
     }
 
-    mpEventNumberCounter = apEventNumberCounter;
-    mLastEventNumber     = mpEventNumberCounter->GetValue();
+    mpEventNumberCounter    = apEventNumberCounter;
+    mLastEventNumber        = mpEventNumberCounter->GetValue();
+    mFirstEventNumberOfBoot = mLastEventNumber;
 
     mpEventBuffer = apCircularEventBuffer;
     mState        = EventManagementStates::Idle;
@@ -168,6 +241,11 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
     size_t requiredSpace              = aRequiredSpace;
     CircularEventBuffer * eventBuffer = mpEventBuffer;
     ReclaimEventCtx ctx;
+    ctx.mpSpillStorage = mpSpillStorage;
+    if (mpSpillStorage != nullptr)
+    {
+        ctx.mSystemTimeEpoch = GetSystemTimeEpoch();
+    }
 
     // Check that we have this much space in all our event buffers that might
     // hold the event. If we do not, that will prevent the event from being
@@ -215,8 +293,11 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    CircularEventBuffer * nextBuffer = eventBuffer->GetNextCircularEventBuffer();
+                    const uint32_t movedEventOffset  = nextBuffer->GetTailOffset();
+                    err                              = CopyToNextBuffer(eventBuffer);
                     SuccessOrExit(err);
+                    nextBuffer->GetIndex().EventAdded(ctx.mHeadEventNumber, ctx.mHeadClusterId, movedEventOffset);
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
                     err                                 = eventBuffer->EvictHead();
@@ -226,6 +307,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    eventBuffer->GetIndex().EventEvicted(ctx.mHeadEventNumber, ctx.mHeadClusterId);
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -353,9 +435,20 @@ void EventManagement::CreateEventManagement(Messaging::ExchangeManager * apExcha
  */
 void EventManagement::DestroyEventManagement()
 {
-    sInstance.mState        = EventManagementStates::Shutdown;
-    sInstance.mpEventBuffer = nullptr;
-    sInstance.mpExchangeMgr = nullptr;
+    if (sInstance.mpSpillStorage != nullptr && sInstance.mpEventBuffer != nullptr)
+    {
+        // The buffers do not survive a reboot, so their events are kept the way dropped ones are.
+        CHIP_ERROR err = sInstance.SpillBufferedEvents();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(EventLogging, "Failed to spill buffered events: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
+    sInstance.mState         = EventManagementStates::Shutdown;
+    sInstance.mpEventBuffer  = nullptr;
+    sInstance.mpExchangeMgr  = nullptr;
+    sInstance.mpSpillStorage = nullptr;
 }
 
 CircularEventBuffer * EventManagement::GetPriorityBuffer(PriorityLevel aPriority) const
@@ -380,17 +473,18 @@ CHIP_ERROR EventManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader, si
         // Does not go on the wire.
         return CHIP_NO_ERROR;
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    // Events from earlier boots or a clock set back may go back in time, which a delta cannot express.
+    const Timestamp & currentTime  = ctx->mpContext->mCurrentTime;
+    const Timestamp & previousTime = ctx->mpContext->mPreviousTime;
+    const bool canUseDelta =
+        !ctx->mpContext->mFirst && currentTime.mType == previousTime.mType && currentTime.mValue >= previousTime.mValue;
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && canUseDelta)
     {
-        return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaSystemTimestamp),
-                                  ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
+        return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaSystemTimestamp), currentTime.mValue - previousTime.mValue);
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && canUseDelta)
     {
-        return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaEpochTimestamp),
-                                  ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
+        return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaEpochTimestamp), currentTime.mValue - previousTime.mValue);
     }
 
     return ctx->mpWriter->CopyElement(reader);
@@ -424,6 +518,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     CircularTLVWriter writer;
     CHIP_ERROR err               = CHIP_NO_ERROR;
     uint32_t requestSize         = 0;
+    uint32_t eventOffset         = 0;
     aEventNumber                 = 0;
     CircularTLVWriter checkpoint = writer;
     EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
@@ -465,8 +560,10 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
     SuccessOrExit(err);
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    eventOffset = mpEventBuffer->GetTailOffset();
+    err         = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
+    mpEventBuffer->GetIndex().EventAdded(ctxt.mCurrentEventNumber, opts.mPath.mClusterId, eventOffset);
 
     mBytesWritten += writer.GetLengthWritten();
 
@@ -589,8 +686,7 @@ bool EventManagement::IncludeEventInReport(EventLoadOutContext * eventLoadOutCon
     return true;
 }
 
-CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDepth, EventLoadOutContext * apEventLoadOutContext,
-                                          EventEnvelopeContext * event, bool & encodeEvent)
+CHIP_ERROR EventManagement::DecodeEventEnvelope(const TLVReader & aReader, EventEnvelopeContext * event)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     TLVReader innerReader;
@@ -614,7 +710,21 @@ CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDep
     {
         err = CHIP_NO_ERROR;
     }
-    ReturnErrorOnFailure(err);
+    return err;
+}
+
+CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDepth, EventLoadOutContext * apEventLoadOutContext,
+                                          EventEnvelopeContext * event, bool & encodeEvent)
+{
+    ReturnErrorOnFailure(DecodeEventEnvelope(aReader, event));
+
+    if (apEventLoadOutContext->mpSpillStorage != nullptr)
+    {
+        // Spilled events can be older or newer than the buffered ones, so they are merged in event number order.
+        ReturnErrorOnFailure(CopySpilledEventsBefore(*apEventLoadOutContext, event->mEventNumber));
+        apEventLoadOutContext->mNextSpilledEventNumber =
+            std::max(apEventLoadOutContext->mNextSpilledEventNumber, event->mEventNumber + 1);
+    }
 
     apEventLoadOutContext->mCurrentTime        = event->mCurrentTime;
     apEventLoadOutContext->mCurrentEventNumber = event->mEventNumber;
@@ -646,33 +756,123 @@ CHIP_ERROR EventManagement::CopyEventsSince(const TLVReader & aReader, size_t aD
             return err;
         }
 
-        loadOutContext->mPreviousTime.mValue = loadOutContext->mCurrentTime.mValue;
-        loadOutContext->mFirst               = false;
+        loadOutContext->mPreviousTime = loadOutContext->mCurrentTime;
+        loadOutContext->mFirst        = false;
         loadOutContext->mEventCount++;
     }
     return err;
 }
 
+CHIP_ERROR EventManagement::CopySpilledEvent(const ByteSpan & aEvent, void * apContext)
+{
+    EventLoadOutContext * const loadOutContext = static_cast<EventLoadOutContext *>(apContext);
+    TLVReader reader;
+    reader.Init(aEvent);
+    ReturnErrorOnFailure(reader.Next());
+
+    EventEnvelopeContext event;
+    ReturnErrorOnFailure(DecodeEventEnvelope(reader, &event));
+    if (event.mEventNumber < loadOutContext->mFirstEventNumberOfBoot && event.mCurrentTime.IsSystem())
+    {
+        // A system timestamp counts from the boot the event was logged in, which the current one cannot be related to.
+        loadOutContext->mCurrentEventNumber = event.mEventNumber;
+        return CHIP_NO_ERROR;
+    }
+
+    // The spill storage is unset while its events are copied, so they are not merged with themselves.
+    CHIP_ERROR err = CopyEventsSince(reader, 0, apContext);
+    return (err == CHIP_END_OF_TLV) ? CHIP_NO_ERROR : err;
+}
+
+CHIP_ERROR EventManagement::CopySpilledEventsBefore(EventLoadOutContext & aContext, EventNumber aEndEventNumber)
+{
+    VerifyOrReturnError(aContext.mNextSpilledEventNumber < aEndEventNumber, CHIP_NO_ERROR);
+
+    EventSpillStorage * const spillStorage = aContext.mpSpillStorage;
+    aContext.mpSpillStorage                = nullptr;
+    CHIP_ERROR err = spillStorage->ForEachEvent(aContext.mNextSpilledEventNumber, aEndEventNumber, CopySpilledEvent, &aContext);
+    VerifyOrReturnError(err != CHIP_ERROR_BUFFER_TOO_SMALL && err != CHIP_ERROR_NO_MEMORY, err /* the writer is full */);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Still report the events in the buffers, without retrying the storage for the rest of the fetch.
+        ChipLogError(EventLogging, "Failed to fetch spilled events: %" CHIP_ERROR_FORMAT, err.Format());
+        return CHIP_NO_ERROR;
+    }
+
+    aContext.mpSpillStorage          = spillStorage;
+    aContext.mNextSpilledEventNumber = aEndEventNumber;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::CopyEventsFromBuffer(CircularEventBuffer & aBuffer, EventLoadOutContext & aContext)
+{
+    const EventBufferIndex & index = aBuffer.GetIndex();
+    VerifyOrReturnError(aBuffer.DataLength() != 0, CHIP_NO_ERROR);
+
+    if (!index.IsEmpty() &&
+        (index.GetLastEventNumber() < aContext.mStartingEventNumber ||
+         !MayContainInterestedEvents(index, aContext.mpInterestedEventPaths)))
+    {
+        // None of the events would be copied. Account for them as if they had been read, so that the next fetch
+        // resumes after them.
+        aContext.mCurrentEventNumber = std::max(aContext.mCurrentEventNumber, index.GetLastEventNumber());
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR err;
+    uint32_t offset  = 0;
+    uint32_t skipped = 0;
+    if (index.FindRecentEvent(aContext.mStartingEventNumber, offset))
+    {
+        // The distance from the oldest event, which is always within the data as long as the index is up to date.
+        const uint32_t size       = aBuffer.GetTotalDataLength();
+        const uint32_t headOffset = static_cast<uint32_t>(aBuffer.QueueHead() - aBuffer.GetQueue()) % size;
+        skipped                   = (offset + size - headOffset) % size;
+    }
+
+    if (skipped > 0 && skipped < aBuffer.DataLength())
+    {
+        CircularEventBufferFrom backingStore(aBuffer, offset, aBuffer.DataLength() - skipped);
+        TLVReader reader;
+        ReturnErrorOnFailure(reader.Init(backingStore, aBuffer.DataLength() - skipped));
+        err = TLV::Utilities::Iterate(reader, CopyEventsSince, &aContext, false /*recurse*/);
+    }
+    else
+    {
+        CircularTLVReader reader;
+        reader.Init(aBuffer);
+        err = TLV::Utilities::Iterate(reader, CopyEventsSince, &aContext, false /*recurse*/);
+    }
+    return (err == CHIP_END_OF_TLV) ? CHIP_NO_ERROR : err;
+}
+
 CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLinkedListNode<EventPathParams> * apEventPathList,
                                              EventNumber & aEventMin, size_t & aEventCount,
                                              const Access::SubjectDescriptor & aSubjectDescriptor)
 {
     // TODO: Add particular set of event Paths in FetchEventsSince so that we can filter the interested paths
-    CHIP_ERROR err     = CHIP_NO_ERROR;
-    const bool recurse = false;
-    TLVReader reader;
-    CircularEventBufferWrapper bufWrapper;
+    CHIP_ERROR err = CHIP_NO_ERROR;
     EventLoadOutContext context(aWriter, PriorityLevel::Invalid, aEventMin);
 
-    context.mSubjectDescriptor     = aSubjectDescriptor;
-    context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
-    SuccessOrExit(err);
+    context.mSubjectDescriptor      = aSubjectDescriptor;
+    context.mpInterestedEventPaths  = apEventPathList;
+    context.mpSpillStorage          = mpSpillStorage;
+    context.mNextSpilledEventNumber = aEventMin;
+    context.mFirstEventNumberOfBoot = mFirstEventNumberOfBoot;
 
-    err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
-    if (err == CHIP_END_OF_TLV)
+    // Same order as GetEventReader: the buffers hold increasingly recent events from the last one back to the first.
+    // Spilled events are merged in between as the buffered events are read.
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
     {
-        err = CHIP_NO_ERROR;
+        err = CopyEventsFromBuffer(*buffer, context);
+        SuccessOrExit(err);
+    }
+
+    if (context.mpSpillStorage != nullptr)
+    {
+        err = CopySpilledEventsBefore(context, std::numeric_limits<EventNumber>::max());
+        SuccessOrExit(err);
     }
 
 exit:
@@ -746,6 +946,12 @@ CHIP_ERROR EventManagement::FabricRemoved(FabricIndex aFabricIndex)
     {
         err = CHIP_NO_ERROR;
     }
+    ReturnErrorOnFailure(err);
+
+    if (mpSpillStorage != nullptr)
+    {
+        err = mpSpillStorage->FabricRemoved(aFabricIndex);
+    }
     return err;
 }
 
@@ -820,6 +1026,7 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 {
     // pull out the delta time, pull out the priority
     ReturnErrorOnFailure(aReader.Next());
+    const TLVReader eventReader(aReader);
 
     TLVType containerType;
     TLVType containerType1;
@@ -842,6 +1049,8 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     ReclaimEventCtx * const ctx             = static_cast<ReclaimEventCtx *>(apAppData);
     CircularEventBuffer * const eventBuffer = ctx->mpEventBuffer;
+    ctx->mHeadEventNumber                   = context.mEventNumber;
+    ctx->mHeadClusterId                     = context.mClusterId;
     if (eventBuffer->IsFinalDestinationForPriority(imp))
     {
         ChipLogProgress(EventLogging,
@@ -850,6 +1059,20 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
                         static_cast<unsigned>(eventBuffer->GetPriority()), ChipLogValueX64(context.mEventNumber),
                         static_cast<unsigned>(imp));
         ctx->mSpaceNeededForMovedEvent = 0;
+
+        if (ctx->mpSpillStorage != nullptr)
+        {
+            // Failing to spill must not keep new events from being logged, so the event is dropped regardless.
+            err = SpillEvent(*ctx->mpSpillStorage, eventReader, context, ctx->mSystemTimeEpoch);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(EventLogging, "Failed to spill event number 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                             ChipLogValueX64(context.mEventNumber), err.Format());
+            }
+        }
+
+        // The buffer evicts the event once this returns.
+        eventBuffer->GetIndex().EventEvicted(context.mEventNumber, context.mClusterId);
         return CHIP_NO_ERROR;
     }
 
@@ -858,6 +1081,107 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
     return CHIP_END_OF_TLV;
 }
 
+CHIP_ERROR EventManagement::SpillEvent(EventSpillStorage & aSpillStorage, const TLVReader & aEventReader,
+                                       const EventEnvelopeContext & aEvent,
+                                       const Optional<System::Clock::Milliseconds64> & aSystemTimeEpoch)
+{
+    // Events never exceed kMaxEventSizeReserve, see CalculateEventSize, and replacing their timestamp adds at most a
+    // control byte, a tag and 8 bytes. The copy can live on the stack since this is only reached while evicting or
+    // shutting down, and it is needed because the event may wrap around the end of the circular buffer.
+    uint8_t event[kMaxEventSizeReserve + 10];
+    TLVReader reader(aEventReader);
+    TLVWriter writer;
+    writer.Init(event);
+    if (aEvent.mCurrentTime.IsSystem() && aSystemTimeEpoch.HasValue())
+    {
+        // A system timestamp means nothing after a reboot, an epoch timestamp still does.
+        ReturnErrorOnFailure(CopyEventWithEpochTimestamp(reader, writer, aSystemTimeEpoch.Value()));
+    }
+    else
+    {
+        ReturnErrorOnFailure(writer.CopyElement(reader));
+    }
+    ReturnErrorOnFailure(writer.Finalize());
+
+    return aSpillStorage.Append(aEvent.mEventNumber, aEvent.mPriority, aEvent.mFabricIndex.ValueOr(kUndefinedFabricIndex),
+                                ByteSpan(event, writer.GetLengthWritten()));
+}
+
+CHIP_ERROR EventManagement::CopyEventWithEpochTimestamp(const TLVReader & aReader, TLVWriter & aWriter,
+                                                        System::Clock::Milliseconds64 aSystemTimeEpoch)
+{
+    TLVReader reader(aReader);
+    TLVType containerType;
+    TLVType containerType1;
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    ReturnErrorOnFailure(aWriter.StartContainer(AnonymousTag(), kTLVType_Structure, containerType));
+
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(aWriter.StartContainer(reader.GetTag(), kTLVType_Structure, containerType1));
+    ReturnErrorOnFailure(reader.EnterContainer(containerType1));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (reader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp))
+        {
+            uint64_t systemTime;
+            ReturnErrorOnFailure(reader.Get(systemTime));
+            ReturnErrorOnFailure(
+                aWriter.Put(TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp), aSystemTimeEpoch.count() + systemTime));
+        }
+        else
+        {
+            ReturnErrorOnFailure(aWriter.CopyElement(reader));
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(aWriter.EndContainer(containerType1));
+    return aWriter.EndContainer(containerType);
+}
+
+CHIP_ERROR EventManagement::SpillBufferedEvents()
+{
+    ReclaimEventCtx ctx;
+    ctx.mpSpillStorage   = mpSpillStorage;
+    ctx.mSystemTimeEpoch = GetSystemTimeEpoch();
+
+    // Oldest first, the way FetchEventsSince reads them, so that the events of each priority are appended in order.
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
+    {
+        if (buffer->DataLength() == 0)
+        {
+            continue;
+        }
+
+        CircularTLVReader reader;
+        reader.Init(*buffer);
+        CHIP_ERROR err = TLV::Utilities::Iterate(reader, SpillBufferedEvent, &ctx, false /*recurse*/);
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::SpillBufferedEvent(const TLVReader & aReader, size_t aDepth, void * apContext)
+{
+    const ReclaimEventCtx * const ctx = static_cast<const ReclaimEventCtx *>(apContext);
+    EventEnvelopeContext event;
+    ReturnErrorOnFailure(DecodeEventEnvelope(aReader, &event));
+    return SpillEvent(*ctx->mpSpillStorage, aReader, event, ctx->mSystemTimeEpoch);
+}
+
+Optional<System::Clock::Milliseconds64> EventManagement::GetSystemTimeEpoch() const
+{
+    System::Clock::Milliseconds64 realTime;
+    VerifyOrReturnValue(System::SystemClock().GetClock_RealTimeMS(realTime) == CHIP_NO_ERROR, NullOptional);
+
+    const System::Clock::Milliseconds64 systemTime = System::SystemClock().GetMonotonicMilliseconds64() - mMonotonicStartupTime;
+    VerifyOrReturnValue(realTime >= systemTime, NullOptional);
+    return MakeOptional(realTime - systemTime);
+}
+
 void EventManagement::SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t & aInitialWrittenEventBytes) const
 {
     aEventNumber              = mLastEventNumber;
@@ -887,6 +1211,68 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
     mpPrev    = apPrev;
     mpNext    = apNext;
     mPriority = aPriorityLevel;
+    mIndex.Clear();
+}
+
+void EventBufferIndex::Clear()
+{
+    mRecentCount     = 0;
+    mRecentNext      = 0;
+    mEventCount      = 0;
+    mLastEventNumber = 0;
+    memset(mClusterCounts, 0, sizeof(mClusterCounts));
+}
+
+void EventBufferIndex::EventAdded(EventNumber aEventNumber, ClusterId aClusterId, uint32_t aOffset)
+{
+    mRecentEvents[mRecentNext] = { aEventNumber, aOffset };
+    mRecentNext                = (mRecentNext + 1) % kRecentEvents;
+    mRecentCount               = std::min(mRecentCount + 1, kRecentEvents);
+
+    uint16_t & clusterCount = mClusterCounts[ClusterBucket(aClusterId)];
+    if (clusterCount != UINT16_MAX)
+    {
+        clusterCount++;
+    }
+    mEventCount++;
+    mLastEventNumber = aEventNumber;
+}
+
+void EventBufferIndex::EventEvicted(EventNumber aEventNumber, ClusterId aClusterId)
+{
+    VerifyOrReturn(mEventCount > 0);
+    if (--mEventCount == 0)
+    {
+        Clear();
+        return;
+    }
+
+    uint16_t & clusterCount = mClusterCounts[ClusterBucket(aClusterId)];
+    if (clusterCount != UINT16_MAX && clusterCount > 0)
+    {
+        clusterCount--;
+    }
+
+    // The evicted event is the oldest one, so it can only be the oldest remembered one.
+    const size_t oldest = (mRecentNext + kRecentEvents - mRecentCount) % kRecentEvents;
+    if (mRecentCount > 0 && mRecentEvents[oldest].mEventNumber <= aEventNumber)
+    {
+        mRecentCount--;
+    }
+}
+
+bool EventBufferIndex::FindRecentEvent(EventNumber aEventNumber, uint32_t & aOffset) const
+{
+    for (size_t i = 1; i <= mRecentCount; i++)
+    {
+        const RecentEvent & event = mRecentEvents[(mRecentNext + kRecentEvents - i) % kRecentEvents];
+        if (event.mEventNumber <= aEventNumber)
+        {
+            aOffset = event.mOffset;
+            return true;
+        }
+    }
+    return false;
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -30,6 +30,7 @@
 #include <access/SubjectDescriptor.h>
 #include <app/EventLoggingTypes.h>
 #include <app/EventReporter.h>
+#include <app/EventSpillStorage.h>
 #include <app/MessageDef/EventDataIB.h>
 #include <app/MessageDef/StatusIB.h>
 #include <app/data-model-provider/EventsGenerator.h>
@@ -61,6 +62,10 @@
  * This means that LogStorageResources at a given priority level are reserved
  * for events of that priority level or higher priority.
  *
+ * If an EventSpillStorage is set, dropped events are appended to it instead of
+ * being lost, as are the buffered events on shutdown, and FetchEventsSince reports them together with the events still in
+ * the buffers, in event number order.
+ *
  * As a simple example, assume there are only two priority levels, DEBUG and
  * CRITICAL, and two LogStorageResources with those priorities.  In that case,
  * old CRITICAL events will not start getting dropped until both buffers are
@@ -78,6 +83,69 @@ inline constexpr size_t kMaxEventSizeReserve            = 512;
 inline constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
+/**
+ * @brief
+ *   A summary of the events in a CircularEventBuffer (internal API), updated as events are added to and evicted from it.
+ *
+ * Events are added to each buffer in increasing event number order, so the summary lets FetchEventsSince skip a buffer
+ * whose events are all older than the requested event number or belong to clusters that were not requested, and start
+ * reading at one of the most recent events when only those are wanted, without decoding the events in between.
+ *
+ * The cluster filter counts events per bucket of cluster ids, so it may report a cluster that is not in the buffer, but
+ * never misses one that is.
+ */
+class EventBufferIndex
+{
+public:
+    void Clear();
+
+    /**
+     * Record an event written at @p aOffset from the start of the buffer's storage.
+     */
+    void EventAdded(EventNumber aEventNumber, ClusterId aClusterId, uint32_t aOffset);
+
+    /**
+     * Record the eviction of the oldest event of the buffer.
+     */
+    void EventEvicted(EventNumber aEventNumber, ClusterId aClusterId);
+
+    bool IsEmpty() const { return mEventCount == 0; }
+    EventNumber GetLastEventNumber() const { return mLastEventNumber; }
+    bool MayContainCluster(ClusterId aClusterId) const { return mClusterCounts[ClusterBucket(aClusterId)] != 0; }
+
+    /**
+     * Find the offset of the most recent remembered event whose number is at most @p aEventNumber, where reading can
+     * start without missing any event numbered @p aEventNumber or later.
+     *
+     * @retval false if all remembered events are newer, in which case reading has to start at the oldest event.
+     */
+    bool FindRecentEvent(EventNumber aEventNumber, uint32_t & aOffset) const;
+
+private:
+    static constexpr size_t kClusterBuckets = 32;
+    static constexpr size_t kRecentEvents   = CHIP_CONFIG_EVENT_INDEX_RECENT_EVENTS;
+
+    static_assert(kRecentEvents > 0, "CHIP_CONFIG_EVENT_INDEX_RECENT_EVENTS must be positive");
+
+    static size_t ClusterBucket(ClusterId aClusterId) { return (aClusterId ^ (aClusterId >> 16)) % kClusterBuckets; }
+
+    struct RecentEvent
+    {
+        EventNumber mEventNumber;
+        uint32_t mOffset;
+    };
+
+    // A ring of the most recent events, of which mRecentCount end just before mRecentNext.
+    RecentEvent mRecentEvents[kRecentEvents];
+    size_t mRecentCount = 0;
+    size_t mRecentNext  = 0;
+
+    uint32_t mEventCount         = 0;
+    EventNumber mLastEventNumber = 0;
+    // Saturated counts are never decremented, which only makes the filter less selective until the buffer empties.
+    uint16_t mClusterCounts[kClusterBuckets] = {};
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::TLVCircularBuffer
@@ -130,6 +198,15 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    EventBufferIndex & GetIndex() { return mIndex; }
+    const EventBufferIndex & GetIndex() const { return mIndex; }
+
+    /**
+     * @brief
+     *   The offset from the start of the storage at which the next event will be written.
+     */
+    uint32_t GetTailOffset() const { return static_cast<uint32_t>(QueueTail() - GetQueue()); }
+
     ~CircularEventBuffer() override = default;
 
 private:
@@ -141,6 +218,8 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    EventBufferIndex mIndex; ///< Summary of the events in the buffer, see EventBufferIndex
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
@@ -279,6 +358,14 @@ public:
 
     static void DestroyEventManagement();
 
+    /**
+     * @brief
+     *   Set the storage that events are spilled to when they are dropped from the in-memory buffers, or nullptr to
+     *   drop them for good. The storage must outlive its use by EventManagement; DestroyEventManagement appends the
+     *   events still in the buffers to it, then unsets it.
+     */
+    void SetSpillStorage(EventSpillStorage * apSpillStorage) { mpSpillStorage = apSpillStorage; }
+
     /**
      * @brief
      *   Log an event via a EventLoggingDelegate, with options.
@@ -341,7 +428,7 @@ public:
      * specified event number.  The function will continue fetching events until
      * it runs out of space in the TLV::TLVWriter or in the log. The function
      * will terminate the event writing on event boundary. The function would filter out event based upon interested path
-     * specified by read/subscribe request.
+     * specified by read/subscribe request. Events in the spill storage, if any, are fetched before those in the buffers.
      *
      * @param[in] aWriter     The writer to use for event storage
      * @param[in] apEventPathList the interested EventPathParams list
@@ -507,6 +594,28 @@ private:
      */
     static CHIP_ERROR CopyEventsSince(const TLV::TLVReader & aReader, size_t aDepth, void * apContext);
 
+    /**
+     * @brief Copy the events of one buffer the way CopyEventsSince does, skipping those the buffer's index rules out.
+     */
+    static CHIP_ERROR CopyEventsFromBuffer(CircularEventBuffer & aBuffer, EventLoadOutContext & aContext);
+
+    /**
+     * @brief EventSpillStorage::EventHandler that copies a spilled event the way CopyEventsSince copies one from the buffers.
+     *
+     * Events from an earlier boot that carry a system timestamp are skipped, since their time cannot be reported.
+     */
+    static CHIP_ERROR CopySpilledEvent(const ByteSpan & aEvent, void * apContext);
+
+    /**
+     * @brief Copy the spilled events from aContext.mNextSpilledEventNumber up to, but excluding, @p aEndEventNumber.
+     */
+    static CHIP_ERROR CopySpilledEventsBefore(EventLoadOutContext & aContext, EventNumber aEndEventNumber);
+
+    /**
+     * @brief Decode the fields of the event @p aReader is positioned on that EventIterator filters on.
+     */
+    static CHIP_ERROR DecodeEventEnvelope(const TLV::TLVReader & aReader, EventEnvelopeContext * event);
+
     /**
      * @brief Internal iterator function used to scan and filter though event logs
      *
@@ -537,6 +646,32 @@ private:
      * requires, and return.
      */
     static CHIP_ERROR EvictEvent(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader);
+
+    /**
+     * @brief Append the event that aEventReader is positioned on, which is about to be dropped or lost, to the spill
+     * storage. Its system timestamp, if any, is replaced by an epoch timestamp when @p aSystemTimeEpoch is known.
+     */
+    static CHIP_ERROR SpillEvent(EventSpillStorage & aSpillStorage, const TLV::TLVReader & aEventReader,
+                                 const EventEnvelopeContext & aEvent,
+                                 const Optional<System::Clock::Milliseconds64> & aSystemTimeEpoch);
+
+    /**
+     * @brief Copy the event that aReader is positioned on, with its system timestamp replaced by an epoch timestamp
+     * relative to @p aSystemTimeEpoch, the epoch time of system timestamp zero.
+     */
+    static CHIP_ERROR CopyEventWithEpochTimestamp(const TLV::TLVReader & aReader, TLV::TLVWriter & aWriter,
+                                                  System::Clock::Milliseconds64 aSystemTimeEpoch);
+
+    /**
+     * @brief Append the events still in the buffers to the spill storage, before they are lost with the buffers.
+     */
+    CHIP_ERROR SpillBufferedEvents();
+    static CHIP_ERROR SpillBufferedEvent(const TLV::TLVReader & aReader, size_t aDepth, void * apContext);
+
+    /**
+     * @brief The epoch time of system timestamp zero, if the real time is known.
+     */
+    Optional<System::Clock::Milliseconds64> GetSystemTimeEpoch() const;
     static CHIP_ERROR AlwaysFail(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader)
     {
         return CHIP_ERROR_NO_MEMORY;
@@ -574,12 +709,15 @@ private:
     // The counter we're going to use for event numbers.
     MonotonicallyIncreasingCounter<EventNumber> * mpEventNumberCounter = nullptr;
 
-    EventNumber mLastEventNumber = 0; ///< Last event Number vended
-    Timestamp mLastEventTimestamp{};  ///< The timestamp of the last event in this buffer
+    EventNumber mLastEventNumber        = 0; ///< Last event Number vended
+    EventNumber mFirstEventNumberOfBoot = 0; ///< Number of the first event logged since Init
+    Timestamp mLastEventTimestamp{};         ///< The timestamp of the last event in this buffer
 
     System::Clock::Milliseconds64 mMonotonicStartupTime{};
 
     EventReporter * mpEventReporter = nullptr;
+
+    EventSpillStorage * mpSpillStorage = nullptr;
 };
 
 } // namespace app
@@ -0,0 +1,84 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/EventLoggingTypes.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Persistent storage for the events that EventManagement drops from its in-memory buffers.
+ *
+ * When one is set on EventManagement, every event that is about to be dropped for good is appended to it first, and so
+ * are the events still in memory when EventManagement is shut down. FetchEventsSince reports the stored events merged
+ * with the ones still in memory, in event number order. A subscriber that resumes with an event number older than the
+ * buffers hold, e.g. after being offline for a while or after the device rebooted, thus still receives the events it
+ * missed, for as long as the storage keeps them.
+ *
+ * Events of different priorities are dropped from different buffers, so they are not appended in event number order,
+ * but the events of each priority are. Events from an earlier boot are only reported if they carry an epoch timestamp,
+ * which EventManagement substitutes for their system timestamp when spilling them if the real time is known.
+ *
+ * Implementations bound their own size and drop their oldest events once full. All methods are called with the Matter
+ * stack lock held.
+ */
+class EventSpillStorage
+{
+public:
+    /**
+     * Called by ForEachEvent for each stored event. Any return value other than CHIP_NO_ERROR stops the iteration and
+     * is returned by ForEachEvent.
+     *
+     * @param[in] aEvent     The event, valid only for the duration of the call.
+     * @param[in] apContext  The context passed to ForEachEvent.
+     */
+    using EventHandler = CHIP_ERROR (*)(const ByteSpan & aEvent, void * apContext);
+
+    virtual ~EventSpillStorage() = default;
+
+    /**
+     * Store an event that is being dropped from memory.
+     *
+     * @param[in] aEventNumber  The number of the event.
+     * @param[in] aPriority     The priority of the event.
+     * @param[in] aFabricIndex  The fabric the event is scoped to, or kUndefinedFabricIndex.
+     * @param[in] aEvent        The event as EventManagement keeps it: an anonymous EventReportIB element, at most
+     *                          kMaxEventSizeReserve bytes long.
+     */
+    virtual CHIP_ERROR Append(EventNumber aEventNumber, PriorityLevel aPriority, FabricIndex aFabricIndex,
+                              const ByteSpan & aEvent) = 0;
+
+    /**
+     * Call @p aHandler, in increasing event number order, for the stored events numbered from @p aMinEventNumber up to,
+     * but excluding, @p aEndEventNumber, except those of removed fabrics.
+     */
+    virtual CHIP_ERROR ForEachEvent(EventNumber aMinEventNumber, EventNumber aEndEventNumber, EventHandler aHandler,
+                                    void * apContext) = 0;
+
+    /**
+     * Stop reporting the stored events scoped to @p aFabricIndex, since the index may be given to another fabric.
+     */
+    virtual CHIP_ERROR FabricRemoved(FabricIndex aFabricIndex) = 0;
+};
+
+} // namespace app
+} // namespace chip
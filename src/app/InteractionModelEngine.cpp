@@ -1664,12 +1664,14 @@ bool InteractionModelEngine::HasConflictWriteRequests(const WriteHandler * apWri
 void InteractionModelEngine::ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList)
 {
     ReleasePool(aAttributePathList, mAttributePathPool);
+    mReportingEngine.OnReadHandlerAttributePathsChanged();
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
                                                               AttributePathParams & aAttributePath)
 {
     CHIP_ERROR err = PushFront(aAttributePathList, aAttributePath, mAttributePathPool);
+    mReportingEngine.OnReadHandlerAttributePathsChanged();
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "AttributePath pool full");
@@ -1740,6 +1742,8 @@ void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(SingleLinkedLi
             path1 = prev->mpNext;
         }
     }
+
+    mReportingEngine.OnReadHandlerAttributePathsChanged();
 }
 
 void InteractionModelEngine::ReleaseEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList)
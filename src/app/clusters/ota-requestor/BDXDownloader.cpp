@@ -29,6 +29,8 @@
 #include <system/SystemPacketBuffer.h>
 #include <transport/raw/MessageHeader.h>
 
+#include <algorithm>
+
 using chip::OTADownloader;
 using chip::app::Clusters::OtaSoftwareUpdateRequestor::OTAChangeReasonEnum;
 using chip::app::DataModel::Nullable;
@@ -61,6 +63,14 @@ System::Clock::Timeout BDXDownloader::GetTimeout()
 void BDXDownloader::Reset()
 {
     mPrevBlockCounter = 0;
+    for (auto & queued : mQueuedBlocks)
+    {
+        queued.msg = nullptr;
+    }
+    mQueueHead       = 0;
+    mQueueLength     = 0;
+    mProcessingBlock = false;
+    mBytesToSkip     = 0;
     DeviceLayer::SystemLayer().CancelTimer(TransferTimeoutCheckHandler, this);
 }
 
@@ -153,8 +163,20 @@ CHIP_ERROR BDXDownloader::OnPreparedForDownload(CHIP_ERROR status)
 CHIP_ERROR BDXDownloader::FetchNextData()
 {
     VerifyOrReturnError(mState == State::kInProgress, CHIP_ERROR_INCORRECT_STATE);
-    ReturnErrorOnFailure(mBdxTransfer.PrepareBlockQuery());
-    PollTransferSession();
+
+    // The image processor is done with the previous block. No Block follows a BlockEOF that is already queued.
+    mProcessingBlock = false;
+    if (!IsBlockEofQueued())
+    {
+        ReturnErrorOnFailure(mBdxTransfer.PrepareBlockQuery());
+        PollTransferSession();
+    }
+
+    if (mQueueLength > 0)
+    {
+        ReturnErrorOnFailure(HandleNextQueuedBlock());
+        PollTransferSession();
+    }
 
     return CHIP_NO_ERROR;
 }
@@ -162,6 +184,14 @@ CHIP_ERROR BDXDownloader::FetchNextData()
 CHIP_ERROR BDXDownloader::SkipData(uint32_t numBytes)
 {
     VerifyOrReturnError(mState == State::kInProgress, CHIP_ERROR_INCORRECT_STATE);
+
+    if (mBdxTransfer.IsWindowed())
+    {
+        // A BlockQueryWithSkip can't be sent while other queries are outstanding
+        mBytesToSkip += numBytes;
+        return FetchNextData();
+    }
+
     ReturnErrorOnFailure(mBdxTransfer.PrepareBlockQueryWithSkip(numBytes));
     PollTransferSession();
 
@@ -262,7 +292,13 @@ CHIP_ERROR BDXDownloader::HandleBdxEvent(const chip::bdx::TransferSession::Outpu
     case TransferSession::OutputEventType::kMsgToSend: {
         VerifyOrReturnError(mMsgDelegate != nullptr, CHIP_ERROR_INCORRECT_STATE);
         ReturnErrorOnFailure(mMsgDelegate->SendMessage(outEvent));
-        if (outEvent.msgTypeData.HasMessageType(chip::bdx::MessageType::BlockAckEOF))
+        if (outEvent.msgTypeData.HasMessageType(chip::bdx::MessageType::BlockQuery) && mBdxTransfer.IsWindowed() &&
+            mBdxTransfer.GetNextQueryNum() < CHIP_CONFIG_BDX_WINDOW_SIZE)
+        {
+            // Fill the window at the start of a windowed transfer
+            ReturnErrorOnFailure(mBdxTransfer.PrepareBlockQuery());
+        }
+        else if (outEvent.msgTypeData.HasMessageType(chip::bdx::MessageType::BlockAckEOF))
         {
             Reset();
 
@@ -272,17 +308,17 @@ CHIP_ERROR BDXDownloader::HandleBdxEvent(const chip::bdx::TransferSession::Outpu
         break;
     }
     case TransferSession::OutputEventType::kBlockReceived: {
-        chip::ByteSpan blockData(outEvent.blockdata.Data, outEvent.blockdata.Length);
-        ReturnErrorOnFailure(mImageProcessor->ProcessBlock(blockData));
-        mStateDelegate->OnUpdateProgressChanged(mImageProcessor->GetPercentComplete());
-
-        // TODO: this will cause problems if Finalize() is not guaranteed to do its work after ProcessBlock().
-        if (outEvent.blockdata.IsEof)
+        if (mProcessingBlock)
         {
-            TEMPORARY_RETURN_IGNORED mBdxTransfer.PrepareBlockAck();
-            ReturnErrorOnFailure(mImageProcessor->Finalize());
+            VerifyOrReturnError(mQueueLength < kMaxQueuedBlocks, CHIP_ERROR_NO_MEMORY);
+            QueuedBlock & queued = mQueuedBlocks[(mQueueHead + mQueueLength) % kMaxQueuedBlocks];
+            queued.msg           = outEvent.MsgData.Retain();
+            queued.data          = outEvent.blockdata;
+            mQueueLength++;
+            break;
         }
 
+        ReturnErrorOnFailure(HandleBlock(outEvent.blockdata));
         break;
     }
     case TransferSession::OutputEventType::kStatusReceived:
@@ -309,6 +345,49 @@ CHIP_ERROR BDXDownloader::HandleBdxEvent(const chip::bdx::TransferSession::Outpu
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR BDXDownloader::HandleBlock(const TransferSession::BlockData & block)
+{
+    chip::ByteSpan blockData(block.Data, block.Length);
+
+    const size_t numBytesSkipped = static_cast<size_t>(std::min<uint64_t>(mBytesToSkip, blockData.size()));
+    blockData                    = blockData.SubSpan(numBytesSkipped);
+    mBytesToSkip -= numBytesSkipped;
+    if (blockData.empty() && !block.IsEof)
+    {
+        // Nothing left for the image processor
+        return FetchNextData();
+    }
+
+    mProcessingBlock = true;
+    ReturnErrorOnFailure(mImageProcessor->ProcessBlock(blockData));
+    mStateDelegate->OnUpdateProgressChanged(mImageProcessor->GetPercentComplete());
+
+    // TODO: this will cause problems if Finalize() is not guaranteed to do its work after ProcessBlock().
+    if (block.IsEof)
+    {
+        TEMPORARY_RETURN_IGNORED mBdxTransfer.PrepareBlockAck();
+        ReturnErrorOnFailure(mImageProcessor->Finalize());
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BDXDownloader::HandleNextQueuedBlock()
+{
+    // The message keeps the block data alive until the image processor has taken it
+    System::PacketBufferHandle msg          = std::move(mQueuedBlocks[mQueueHead].msg);
+    const TransferSession::BlockData block = mQueuedBlocks[mQueueHead].data;
+    mQueueHead                             = (mQueueHead + 1) % kMaxQueuedBlocks;
+    mQueueLength--;
+
+    return HandleBlock(block);
+}
+
+bool BDXDownloader::IsBlockEofQueued() const
+{
+    return (mQueueLength > 0) && mQueuedBlocks[(mQueueHead + mQueueLength - 1) % kMaxQueuedBlocks].data.IsEof;
+}
+
 void BDXDownloader::SetState(State state, OTAChangeReasonEnum reason)
 {
     mState = state;
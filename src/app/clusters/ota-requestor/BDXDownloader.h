@@ -27,6 +27,7 @@
 #include "OTADownloader.h"
 
 #include <app-common/zap-generated/cluster-objects.h>
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <protocols/bdx/BdxTransferSession.h>
 #include <system/SystemPacketBuffer.h>
@@ -84,6 +85,9 @@ private:
     void PollTransferSession();
     void CleanupOnError(app::Clusters::OtaSoftwareUpdateRequestor::OTAChangeReasonEnum reason);
     CHIP_ERROR HandleBdxEvent(const chip::bdx::TransferSession::OutputEvent & outEvent);
+    CHIP_ERROR HandleBlock(const chip::bdx::TransferSession::BlockData & block);
+    CHIP_ERROR HandleNextQueuedBlock();
+    bool IsBlockEofQueued() const;
     void SetState(State state, app::Clusters::OtaSoftwareUpdateRequestor::OTAChangeReasonEnum reason);
     void Reset();
 
@@ -94,6 +98,22 @@ private:
     System::Clock::Timeout mTimeout = System::Clock::kZero;
     // Tracks the last block counter used during the transfer session as of the previous check.
     uint32_t mPrevBlockCounter = 0;
+
+    // In a windowed transfer, Blocks can arrive while the image processor is busy with an earlier one. They are kept until it
+    // asks for more data, and each block it is done with makes room for one more query, so there are never more of them than
+    // the window size.
+    struct QueuedBlock
+    {
+        System::PacketBufferHandle msg;
+        chip::bdx::TransferSession::BlockData data;
+    };
+    static constexpr size_t kMaxQueuedBlocks = CHIP_CONFIG_BDX_WINDOW_SIZE;
+    QueuedBlock mQueuedBlocks[kMaxQueuedBlocks];
+    size_t mQueueHead     = 0;
+    size_t mQueueLength   = 0;
+    bool mProcessingBlock = false;
+    // Data that the image processor skipped while the queries for it were outstanding, dropped from the next blocks.
+    uint64_t mBytesToSkip = 0;
 };
 
 } // namespace chip
@@ -366,7 +366,17 @@ void DefaultOTARequestor::ConnectToProvider(OnConnectedAction onConnectedAction)
     ChipLogDetail(SoftwareUpdate, "Establishing session to provider node ID 0x" ChipLogFormatX64 " on fabric index %d",
                   ChipLogValueX64(mProviderLocation.Value().providerNodeID), mProviderLocation.Value().fabricIndex);
 
-    mCASESessionManager->FindOrEstablishSession(GetProviderScopedId(), &mOnConnectedCallback, &mOnConnectionFailureCallback);
+    TransportPayloadCapability payloadCapability = TransportPayloadCapability::kMRPPayload;
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT && CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP
+    // A download over TCP can keep several BDX queries outstanding (see StartDownload). Fall back to MRP if it fails.
+    if (onConnectedAction == kDownload && !mTcpDownloadFailed)
+    {
+        payloadCapability = TransportPayloadCapability::kLargePayload;
+    }
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT && CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP
+
+    mCASESessionManager->FindOrEstablishSession(GetProviderScopedId(), &mOnConnectedCallback, &mOnConnectionFailureCallback,
+                                                payloadCapability);
 }
 
 void DefaultOTARequestor::DisconnectFromProvider()
@@ -514,6 +524,16 @@ void DefaultOTARequestor::OnConnectionFailure(void * context, const ScopedNodeId
     ChipLogError(SoftwareUpdate, "Failed to connect to node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
                  ChipLogValueX64(peerId.GetNodeId()), error.Format());
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT && CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP
+    if (requestorCore->mOnConnectedAction == kDownload && !requestorCore->mTcpDownloadFailed)
+    {
+        ChipLogProgress(SoftwareUpdate, "Retrying the download without TCP");
+        requestorCore->mTcpDownloadFailed = true;
+        requestorCore->ConnectToProvider(kDownload);
+        return;
+    }
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT && CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP
+
     switch (requestorCore->mOnConnectedAction)
     {
     case kQueryImage:
@@ -580,6 +600,7 @@ CHIP_ERROR DefaultOTARequestor::TriggerImmediateQuery(FabricIndex fabricIndex)
 void DefaultOTARequestor::DownloadUpdate()
 {
     RecordNewUpdateState(OTAUpdateStateEnum::kDownloading, OTAChangeReasonEnum::kSuccess);
+    mTcpDownloadFailed = false;
     ConnectToProvider(kDownload);
 }
 
@@ -823,6 +844,9 @@ CHIP_ERROR DefaultOTARequestor::StartDownload(Messaging::ExchangeManager & excha
     initOptions.MaxBlockSize     = mOtaRequestorDriver->GetMaxDownloadBlockSize();
     initOptions.FileDesLength    = static_cast<uint16_t>(mFileDesignator.size());
     initOptions.FileDesignator   = reinterpret_cast<const uint8_t *>(mFileDesignator.data());
+    // MRP allows a single unacknowledged message per exchange, so queries can only be pipelined on sessions without it, such
+    // as the TCP session that ConnectToProvider() requests when CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP is set
+    initOptions.Windowed = !sessionHandle->AllowsMRP();
 
     chip::Messaging::ExchangeContext * exchangeCtx = exchangeMgr.NewContext(sessionHandle, &mBdxMessenger);
     VerifyOrReturnError(exchangeCtx != nullptr, CHIP_ERROR_NO_MEMORY);
@@ -153,8 +153,10 @@ private:
             VerifyOrReturnError(mExchangeCtx != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
             chip::Messaging::SendFlags sendFlags;
+            // A windowed transfer has several BlockQuery messages in flight, but the exchange waits for one response at a time
             if (!event.msgTypeData.HasMessageType(chip::bdx::MessageType::BlockAckEOF) &&
-                !event.msgTypeData.HasMessageType(Protocols::SecureChannel::MsgType::StatusReport))
+                !event.msgTypeData.HasMessageType(Protocols::SecureChannel::MsgType::StatusReport) &&
+                !mExchangeCtx->IsResponseExpected())
             {
                 sendFlags.Set(chip::Messaging::SendMessageFlags::kExpectResponse);
             }
@@ -341,6 +343,7 @@ private:
     OTARequestorAttributes * mAttributes                = nullptr;
     DefaultOTARequestorEventGenerator * mEventGenerator = nullptr;
     OnConnectedAction mOnConnectedAction                = kQueryImage;
+    bool mTcpDownloadFailed                             = false;   // Set once the download fell back from TCP to MRP
     BDXDownloader * mBdxDownloader                      = nullptr; // TODO: this should be OTADownloader
     BDXMessenger mBdxMessenger;                                    // TODO: ideally this is held by the application
     uint8_t mUpdateTokenBuffer[kMaxUpdateTokenLen];
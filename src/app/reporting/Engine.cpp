@@ -221,6 +221,41 @@ bool IsClusterDataVersionEqualTo(DataModel::Provider * dataModel, const Concrete
     return info.has_value() && (info->dataVersion == dataVersion);
 }
 
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+/// Returns whether the subject may read the attribute at the given path, i.e. whether RetrieveClusterData would go
+/// on to read its value rather than produce a status that is specific to this subject.
+bool IsAttributeReadAllowed(DataModel::Provider * dataModel, const SubjectDescriptor & subjectDescriptor,
+                            const ConcreteReadAttributePath & path)
+{
+    DataModel::AttributeFinder finder(dataModel);
+    std::optional<DataModel::AttributeEntry> entry = finder.Find(path);
+
+    VerifyOrReturnValue(!ValidateReadAttributeACL(subjectDescriptor, path, Privilege::kView).has_value(), false);
+    VerifyOrReturnValue(!ValidateAttributeIsReadable(dataModel, path, entry).has_value(), false);
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    return !ValidateReadAttributeACL(subjectDescriptor, path, entry->GetReadPrivilege().value()).has_value();
+}
+
+/// Appends the AttributeReportIB elements of an encoded AttributeReportIBs array to reportBuilder.
+CHIP_ERROR CopyEncodedAttributeReports(const ByteSpan & encoded, AttributeReportIBs::Builder & reportBuilder)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType outerType;
+    reader.Init(encoded);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(outerType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(reportBuilder.GetWriter()->CopyElement(reader));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return reader.ExitContainer(outerType);
+}
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
 /// Check if the given `err` is a known ACL error that can be translated into
 /// a StatusIB (UnsupportedAccess/AccessRestricted)
 ///
@@ -450,8 +485,7 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             flags.Set(ReadFlags::kFabricFiltered, apReadHandler->IsFabricFiltered());
             flags.Set(ReadFlags::kAllowsLargePayload, apReadHandler->AllowsLargePayload());
             DataModel::ActionReturnStatus status =
-                RetrieveClusterData(mpImEngine->GetDataModelProvider(), apReadHandler->GetSubjectDescriptor(), flags,
-                                    attributeReportIBs, pathForRetrieval, &encodeState);
+                RetrieveClusterDataForHandler(apReadHandler, flags, attributeReportIBs, pathForRetrieval, &encodeState);
             if (status.IsError())
             {
                 // Operation error set, since this will affect early return or override on status encoding
@@ -579,6 +613,90 @@ exit:
     return err;
 }
 
+DataModel::ActionReturnStatus Engine::RetrieveClusterDataForHandler(ReadHandler * apReadHandler, BitFlags<ReadFlags> aFlags,
+                                                                    AttributeReportIBs::Builder & aReportBuilder,
+                                                                    const ConcreteReadAttributePath & aPath,
+                                                                    AttributeEncodeState * apEncoderState)
+{
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+    // Only whole values are shared; a handler that is in the middle of a chunked list carries on by itself.
+    if (mReportEncodeCache.IsActive() && apEncoderState->CurrentEncodingListIndex() == kInvalidListIndex)
+    {
+        std::optional<DataModel::ActionReturnStatus> status =
+            RetrieveClusterDataFromCache(apReadHandler, aFlags, aReportBuilder, aPath);
+        if (status.has_value())
+        {
+            return *status;
+        }
+    }
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
+    return RetrieveClusterData(mpImEngine->GetDataModelProvider(), apReadHandler->GetSubjectDescriptor(), aFlags, aReportBuilder,
+                               aPath, apEncoderState);
+}
+
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+std::optional<DataModel::ActionReturnStatus> Engine::RetrieveClusterDataFromCache(ReadHandler * apReadHandler,
+                                                                                  BitFlags<ReadFlags> aFlags,
+                                                                                  AttributeReportIBs::Builder & aReportBuilder,
+                                                                                  const ConcreteReadAttributePath & aPath)
+{
+    DataModel::Provider * dataModel           = mpImEngine->GetDataModelProvider();
+    const SubjectDescriptor subjectDescriptor = apReadHandler->GetSubjectDescriptor();
+    DataModel::ServerClusterFinder serverClusterFinder(dataModel);
+    auto clusterInfo = serverClusterFinder.Find(aPath);
+
+    // Errors are specific to the subject reading the attribute, so those are always produced by RetrieveClusterData.
+    VerifyOrReturnValue(clusterInfo.has_value(), std::nullopt);
+    VerifyOrReturnValue(IsAttributeReadAllowed(dataModel, subjectDescriptor, aPath), std::nullopt);
+
+    const ReportEncodeCache::Key key = { aPath, clusterInfo->dataVersion, subjectDescriptor.fabricIndex, aFlags };
+    std::optional<ByteSpan> encoded = mReportEncodeCache.Find(key);
+    if (!encoded.has_value())
+    {
+        MutableByteSpan freeSpace = mReportEncodeCache.GetFreeSpace();
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        AttributeEncodeState encodeState;
+        size_t length = 0;
+
+        writer.Init(freeSpace);
+        if (builder.Init(&writer) == CHIP_NO_ERROR)
+        {
+            DataModel::ActionReturnStatus status =
+                RetrieveClusterData(dataModel, subjectDescriptor, aFlags, builder, aPath, &encodeState);
+            if (status.IsError() && !status.IsOutOfSpaceEncodingResponse())
+            {
+                return status;
+            }
+            if (status.IsSuccess() && builder.EndOfAttributeReportIBs() == CHIP_NO_ERROR && writer.Finalize() == CHIP_NO_ERROR)
+            {
+                length = writer.GetLengthWritten();
+            }
+        }
+
+        // A value that does not fit is remembered with an empty encoding, so that other handlers encode it directly right away. If
+        // the cache has no entry left, this handler still uses the value it just encoded.
+        RETURN_SAFELY_IGNORED mReportEncodeCache.Add(key, length);
+        encoded.emplace(freeSpace.data(), length);
+    }
+    VerifyOrReturnValue(!encoded->empty(), std::nullopt);
+
+    TLV::TLVWriter checkpoint;
+    aReportBuilder.Checkpoint(checkpoint);
+    if (CopyEncodedAttributeReports(*encoded, aReportBuilder) != CHIP_NO_ERROR)
+    {
+        // Most likely out of space in this report: let RetrieveClusterData handle chunking as usual.
+        aReportBuilder.Rollback(checkpoint);
+        return std::nullopt;
+    }
+
+    ChipLogDetail(DataManagement, "<RE:Run> Cluster %" PRIx32 ", Attribute %" PRIx32 " is dirty, reusing encoded value",
+                  aPath.mClusterId, aPath.mAttributeId);
+    return DataModel::ActionReturnStatus(CHIP_NO_ERROR);
+}
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
 CHIP_ERROR Engine::CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler)
 {
     using Protocols::InteractionModel::Status;
@@ -905,6 +1023,13 @@ void Engine::Run()
 {
     uint32_t numReadHandled = 0;
 
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+    // Attribute values cannot change while reports are being built, so handlers reporting the same values during this run
+    // can share their encoding.
+    mReportEncodeCache.Begin();
+    auto endReportEncodeCache = ScopeExit([this] { mReportEncodeCache.End(); });
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = mpImEngine->mReadHandlers.Allocated();
@@ -1104,7 +1229,7 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
 
     bool intersectsInterestPath     = false;
     DataModel::Provider * dataModel = mpImEngine->GetDataModelProvider();
-    mpImEngine->mReadHandlers.ForEachActiveObject([&dataModel, &aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
+    auto markHandlerDirty           = [&dataModel, &aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
         // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
         // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
         // waiting for a response to the last message chunk for read interactions.
@@ -1122,7 +1247,25 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
         }
 
         return Loop::Continue;
-    });
+    };
+
+#if CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+    // Changes to a concrete cluster only need to visit the handlers that can be interested in that cluster.
+    const bool isConcreteCluster = !aAttributePath.HasWildcardEndpointId() && !aAttributePath.HasWildcardClusterId();
+    if (isConcreteCluster)
+    {
+        RebuildReadHandlerPathIndexIfStale();
+    }
+    if (isConcreteCluster && mReadHandlerPathIndex.IsUsable())
+    {
+        mReadHandlerPathIndex.ForEachCandidate(aAttributePath.mEndpointId, aAttributePath.mClusterId, markHandlerDirty);
+    }
+    else
+#endif // CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+    {
+        mpImEngine->mReadHandlers.ForEachActiveObject(
+            [&markHandlerDirty](ReadHandler * handler) { return markHandlerDirty(handler); });
+    }
 
     if (!intersectsInterestPath)
     {
@@ -1133,6 +1276,19 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+void Engine::RebuildReadHandlerPathIndexIfStale()
+{
+    VerifyOrReturn(mReadHandlerPathIndex.IsStale());
+
+    mReadHandlerPathIndex.Clear();
+    mpImEngine->mReadHandlers.ForEachActiveObject([this](ReadHandler * handler) {
+        return mReadHandlerPathIndex.Add(*handler) == CHIP_NO_ERROR ? Loop::Continue : Loop::Break;
+    });
+    mReadHandlerPathIndex.Finalize();
+}
+#endif // CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -29,7 +29,11 @@
 #include <app/EventReporter.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/data-model-provider/ActionReturnStatus.h>
+#include <app/data-model-provider/OperationTypes.h>
 #include <app/reporting/Generations.h>
+#include <app/reporting/ReadHandlerPathIndex.h>
+#include <app/reporting/ReportEncodeCache.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -40,6 +44,8 @@
 #include <system/SystemPacketBuffer.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
+#include <optional>
+
 namespace chip {
 namespace app {
 
@@ -127,6 +133,17 @@ public:
 
     AttributeGeneration GetDirtySetGeneration() const { return mDirtyGeneration; }
 
+    /**
+     * Must be called whenever the attribute path list of any ReadHandler changes, so that SetDirty does not
+     * use a stale view of which handlers are interested in which clusters.
+     */
+    void OnReadHandlerAttributePathsChanged()
+    {
+#if CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+        mReadHandlerPathIndex.Invalidate();
+#endif // CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+    }
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
 #endif
@@ -165,6 +182,28 @@ private:
     CHIP_ERROR BuildSingleReportDataEventReports(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
                                                  bool aBufferIsUsed, bool * apHasMoreChunks, bool * apHasEncodedData);
 
+    /**
+     * Read and encode the value of a single attribute for a ReadHandler, reusing the encoding done for another handler
+     * during the same run when possible.
+     */
+    DataModel::ActionReturnStatus RetrieveClusterDataForHandler(ReadHandler * apReadHandler, BitFlags<DataModel::ReadFlags> aFlags,
+                                                                AttributeReportIBs::Builder & aReportBuilder,
+                                                                const ConcreteReadAttributePath & aPath,
+                                                                AttributeEncodeState * apEncoderState);
+
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+    /**
+     * Encode the value of a single attribute through mReportEncodeCache.
+     *
+     * Returns std::nullopt if the value cannot be shared with other handlers, in which case the caller must read and encode it
+     * directly.
+     */
+    std::optional<DataModel::ActionReturnStatus> RetrieveClusterDataFromCache(ReadHandler * apReadHandler,
+                                                                              BitFlags<DataModel::ReadFlags> aFlags,
+                                                                              AttributeReportIBs::Builder & aReportBuilder,
+                                                                              const ConcreteReadAttributePath & aPath);
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
     /**
      * Encodes StatusIB event reports for non-wildcard paths that fail to be validated:
      *   - invalid paths (invalid endpoint/cluster id)
@@ -239,6 +278,10 @@ private:
 
     inline void BumpDirtySetGeneration() { mDirtyGeneration.Increment(); }
 
+#if CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+    void RebuildReadHandlerPathIndexIfStale();
+#endif // CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+
     /**
      * Boolean to indicate if ScheduleRun is pending. This flag is used to prevent calling ScheduleRun multiple times
      * within the same execution context to avoid applying too much pressure on platforms that use small, fixed size event queues.
@@ -288,6 +331,20 @@ private:
      */
     AttributeGeneration mDirtyGeneration{ 1 };
 
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+    /**
+     * Attribute values encoded during the current Run, shared between the handlers reporting them.
+     */
+    ReportEncodeCache mReportEncodeCache;
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
+#if CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+    /**
+     * Index from concrete clusters to the ReadHandlers that may be interested in them, used by SetDirty.
+     */
+    ReadHandlerPathIndex mReadHandlerPathIndex;
+#endif // CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
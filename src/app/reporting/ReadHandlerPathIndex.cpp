@@ -0,0 +1,110 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReadHandlerPathIndex.h>
+
+#include <app/ReadHandler.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+bool ReadHandlerPathIndex::Entry::operator<(const Entry & other) const
+{
+    if (mEndpoint != other.mEndpoint)
+    {
+        return mEndpoint < other.mEndpoint;
+    }
+    if (mCluster != other.mCluster)
+    {
+        return mCluster < other.mCluster;
+    }
+    return std::less<const ReadHandler *>()(mHandler, other.mHandler);
+}
+
+bool ReadHandlerPathIndex::Entry::operator==(const Entry & other) const
+{
+    return mEndpoint == other.mEndpoint && mCluster == other.mCluster && mHandler == other.mHandler;
+}
+
+void ReadHandlerPathIndex::Clear()
+{
+    mEntryCount           = 0;
+    mWildcardHandlerCount = 0;
+    mState                = State::kBuilding;
+}
+
+CHIP_ERROR ReadHandlerPathIndex::Add(ReadHandler & handler)
+{
+    VerifyOrReturnError(mState == State::kBuilding, CHIP_ERROR_INCORRECT_STATE);
+
+    const SingleLinkedListNode<AttributePathParams> * paths = handler.GetAttributePathList();
+    VerifyOrReturnError(paths != nullptr, CHIP_NO_ERROR);
+
+    // A handler with any path that does not name a concrete cluster has to be visited for every change; its
+    // concrete paths are then redundant in the index.
+    for (auto * path = paths; path != nullptr; path = path->mpNext)
+    {
+        if (path->mValue.HasWildcardEndpointId() || path->mValue.HasWildcardClusterId())
+        {
+            if (mWildcardHandlerCount >= MATTER_ARRAY_SIZE(mWildcardHandlers))
+            {
+                mState = State::kOverflow;
+                return CHIP_ERROR_NO_MEMORY;
+            }
+            mWildcardHandlers[mWildcardHandlerCount++] = &handler;
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    for (auto * path = paths; path != nullptr; path = path->mpNext)
+    {
+        if (mEntryCount >= MATTER_ARRAY_SIZE(mEntries))
+        {
+            mState = State::kOverflow;
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        mEntries[mEntryCount++] = { path->mValue.mEndpointId, path->mValue.mClusterId, &handler };
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void ReadHandlerPathIndex::Finalize()
+{
+    VerifyOrReturn(mState == State::kBuilding);
+
+    // Sort by (endpoint, cluster, handler) and drop duplicates, so that a handler with several attribute paths in
+    // the same cluster is only visited once per change.
+    std::sort(mEntries, mEntries + mEntryCount);
+    mEntryCount = static_cast<size_t>(std::unique(mEntries, mEntries + mEntryCount) - mEntries);
+
+    mState = State::kReady;
+}
+
+size_t ReadHandlerPathIndex::LowerBound(EndpointId endpoint, ClusterId cluster) const
+{
+    const Entry key = { endpoint, cluster, nullptr };
+    return static_cast<size_t>(std::lower_bound(mEntries, mEntries + mEntryCount, key) - mEntries);
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
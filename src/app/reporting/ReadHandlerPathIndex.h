@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace app {
+
+class ReadHandler;
+
+namespace reporting {
+
+/**
+ * Maps a concrete (endpoint, cluster) pair to the ReadHandlers whose attribute path lists may intersect it.
+ *
+ * Engine::SetDirty uses this index so that an attribute change only visits the handlers that can be interested in
+ * it, instead of every active handler and all of its paths. Handlers with a path that has a wildcard endpoint or
+ * cluster cannot be keyed that way and are kept in a separate list that is visited for every change.
+ *
+ * The index is a snapshot of the handlers' path lists: it is marked stale whenever any attribute path list changes
+ * and rebuilt lazily on the next lookup. Candidates still need an exact Intersects() check, since the index does not
+ * look at attribute ids or list indices.
+ */
+class ReadHandlerPathIndex
+{
+public:
+    static constexpr size_t kMaxEntries =
+        CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS;
+    static constexpr size_t kMaxWildcardHandlers = CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
+    /**
+     * Mark the index as out of date. Must be called whenever a ReadHandler's attribute path list changes or a
+     * ReadHandler holding paths is destroyed.
+     */
+    void Invalidate() { mState = State::kStale; }
+
+    /**
+     * Whether the index must be rebuilt (via Clear/Add/Finalize) before it can be used.
+     */
+    bool IsStale() const { return mState == State::kStale; }
+
+    /**
+     * Whether the index can answer lookups. False when stale, or when the last rebuild ran out of space, in which
+     * case callers must fall back to visiting every handler until the next invalidation.
+     */
+    bool IsUsable() const { return mState == State::kReady; }
+
+    /**
+     * Start a rebuild.
+     */
+    void Clear();
+
+    /**
+     * Add all attribute paths of a handler to the index being rebuilt.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if the index is full; the index stays unusable until the next invalidation.
+     */
+    CHIP_ERROR Add(ReadHandler & handler);
+
+    /**
+     * Complete a rebuild started by Clear().
+     */
+    void Finalize();
+
+    /**
+     * Invoke @p fn for every handler that may be interested in attributes of the given concrete cluster. Each
+     * handler is visited at most once. @p fn returns Loop::Continue or Loop::Break.
+     *
+     * Must only be called while IsUsable(). Iteration stops if the index is invalidated by @p fn.
+     */
+    template <typename F>
+    Loop ForEachCandidate(EndpointId endpoint, ClusterId cluster, F && fn)
+    {
+        VerifyOrDie(IsUsable());
+
+        for (size_t i = 0; i < mWildcardHandlerCount && IsUsable(); i++)
+        {
+            VerifyOrReturnValue(fn(mWildcardHandlers[i]) == Loop::Continue, Loop::Break);
+        }
+
+        for (size_t i = LowerBound(endpoint, cluster);
+             i < mEntryCount && mEntries[i].mEndpoint == endpoint && mEntries[i].mCluster == cluster && IsUsable(); i++)
+        {
+            VerifyOrReturnValue(fn(mEntries[i].mHandler) == Loop::Continue, Loop::Break);
+        }
+
+        return Loop::Finish;
+    }
+
+    size_t GetEntryCount() const { return mEntryCount; }
+    size_t GetWildcardHandlerCount() const { return mWildcardHandlerCount; }
+
+private:
+    enum class State : uint8_t
+    {
+        kStale,
+        kBuilding,
+        kReady,
+        kOverflow,
+    };
+
+    struct Entry
+    {
+        EndpointId mEndpoint;
+        ClusterId mCluster;
+        ReadHandler * mHandler;
+
+        bool operator<(const Entry & other) const;
+        bool operator==(const Entry & other) const;
+    };
+
+    size_t LowerBound(EndpointId endpoint, ClusterId cluster) const;
+
+    Entry mEntries[kMaxEntries];
+    size_t mEntryCount = 0;
+    ReadHandler * mWildcardHandlers[kMaxWildcardHandlers];
+    size_t mWildcardHandlerCount = 0;
+    State mState                 = State::kStale;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
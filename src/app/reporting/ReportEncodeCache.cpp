@@ -0,0 +1,59 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportEncodeCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+std::optional<ByteSpan> ReportEncodeCache::Find(const Key & key) const
+{
+    VerifyOrReturnValue(mActive, std::nullopt);
+
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        if (mEntries[i].mKey == key)
+        {
+            return ByteSpan(mBuffer + mEntries[i].mOffset, mEntries[i].mLength);
+        }
+    }
+
+    return std::nullopt;
+}
+
+CHIP_ERROR ReportEncodeCache::Add(const Key & key, size_t length)
+{
+    VerifyOrReturnError(mActive, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(length <= kBufferSize - mUsed, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mEntryCount < kMaxEntries, CHIP_ERROR_NO_MEMORY);
+
+    mEntries[mEntryCount++] = { key, mUsed, length };
+    mUsed += length;
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
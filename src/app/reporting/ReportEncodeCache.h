@@ -0,0 +1,135 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/data-model-provider/OperationTypes.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/BitFlags.h>
+#include <lib/support/Span.h>
+
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * Holds the encoded AttributeReportIBs of attribute values read during a single Engine::Run, so that handlers
+ * subscribed to the same attributes do not read and encode them again.
+ *
+ * An encoded value can be reused by another handler only when it would have produced the same bytes: the key holds
+ * the concrete path, the cluster data version, the read flags, and the accessing fabric, since fabric-scoped and
+ * fabric-sensitive data depend on it. Access control must be checked by the caller for every handler before a cached
+ * value is used.
+ *
+ * The cache is only valid between Begin() and End(), during which the data model cannot change.
+ */
+class ReportEncodeCache
+{
+public:
+    static constexpr size_t kBufferSize = CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE;
+    static constexpr size_t kMaxEntries = CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_MAX_ENTRIES;
+
+    struct Key
+    {
+        ConcreteAttributePath mPath;
+        DataVersion mDataVersion;
+        FabricIndex mAccessingFabricIndex;
+        BitFlags<DataModel::ReadFlags> mReadFlags;
+
+        bool operator==(const Key & other) const
+        {
+            return mPath == other.mPath && mDataVersion == other.mDataVersion &&
+                mAccessingFabricIndex == other.mAccessingFabricIndex && mReadFlags.Raw() == other.mReadFlags.Raw();
+        }
+    };
+
+    /**
+     * Start caching. Any previously cached value is dropped.
+     */
+    void Begin()
+    {
+        Clear();
+        mActive = true;
+    }
+
+    /**
+     * Stop caching and drop all cached values.
+     */
+    void End()
+    {
+        Clear();
+        mActive = false;
+    }
+
+    bool IsActive() const { return mActive; }
+
+    /**
+     * Look up the encoding of a value.
+     *
+     * @return std::nullopt if the value has not been encoded yet, an empty span if it was found not to fit in the
+     *         cache, and the encoded AttributeReportIBs array otherwise.
+     */
+    std::optional<ByteSpan> Find(const Key & key) const;
+
+    /**
+     * The space in which the next value to be added should be encoded.
+     */
+    MutableByteSpan GetFreeSpace() { return MutableByteSpan(mBuffer + mUsed, kBufferSize - mUsed); }
+
+    /**
+     * Record that the first @p length bytes of GetFreeSpace() hold the encoding of @p key. A zero @p length records
+     * that the value does not fit, so that later handlers do not try again.
+     */
+    CHIP_ERROR Add(const Key & key, size_t length);
+
+    size_t GetEntryCount() const { return mEntryCount; }
+
+private:
+    struct Entry
+    {
+        Key mKey;
+        size_t mOffset;
+        size_t mLength;
+    };
+
+    void Clear()
+    {
+        mEntryCount = 0;
+        mUsed       = 0;
+    }
+
+    uint8_t mBuffer[kBufferSize];
+    Entry mEntries[kMaxEntries];
+    size_t mEntryCount = 0;
+    size_t mUsed       = 0;
+    bool mActive       = false;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
@@ -507,6 +507,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
                                                        &app::InteractionModelEngine::GetInstance()->GetReportingEngine());
 
         SuccessOrExit(err);
+        app::EventManagement::GetInstance().SetSpillStorage(initParams.eventSpillStorage);
     }
 #endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
 
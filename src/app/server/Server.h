@@ -27,6 +27,7 @@
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
 #include <app/DefaultSafeAttributePersistenceProvider.h>
+#include <app/EventSpillStorage.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
@@ -180,6 +181,9 @@ struct ServerInitParams
     // Session resumption storage: Optional. Support session resumption when provided.
     // Must be initialized before being provided.
     app::SubscriptionResumptionStorage * subscriptionResumptionStorage = nullptr;
+    // Event spill storage: Optional. Keeps the events dropped from the in-memory event buffers when provided.
+    // Must be initialized before being provided.
+    app::EventSpillStorage * eventSpillStorage = nullptr;
     // Certificate validity policy: Optional. If none is injected, CHIPCert
     // enforces a default policy.
     Credentials::CertificateValidityPolicy * certificateValidityPolicy = nullptr;
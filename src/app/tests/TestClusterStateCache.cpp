@@ -16,6 +16,7 @@
  *    limitations under the License.
  */
 
+#include <map>
 #include <string.h>
 #include <vector>
 
@@ -24,6 +25,7 @@
 #include "lib/core/TLVTags.h"
 #include "lib/core/TLVWriter.h"
 #include "protocols/interaction_model/Constants.h"
+#include "system/SystemClock.h"
 #include "system/SystemPacketBuffer.h"
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app-common/zap-generated/cluster-objects.h>
@@ -830,4 +832,196 @@ TEST_F(TestClusterStateCache, TestCache)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+// Counts the bytes allocated through it, to measure the memory used by standard containers.
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator(size_t & allocated) : mAllocated(&allocated) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> & other) : mAllocated(other.mAllocated)
+    {}
+
+    T * allocate(size_t n)
+    {
+        *mAllocated += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T * p, size_t n)
+    {
+        *mAllocated -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const CountingAllocator & other) const { return mAllocated == other.mAllocated; }
+    bool operator!=(const CountingAllocator & other) const { return mAllocated != other.mAllocated; }
+
+    size_t * mAllocated;
+};
+
+template <typename Key, typename Value>
+using CountingMap = std::map<Key, Value, std::less<Key>, CountingAllocator<std::pair<const Key, Value>>>;
+
+class NullCacheCallback : public ClusterStateCache::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+/*
+ * Compares the cache against the layout it used to have, one map per endpoint, cluster and attribute with a separate
+ * allocation for every value, for a node whose wildcard subscription reports 40 endpoints with 10 clusters of 20
+ * attributes each.
+ */
+TEST_F(TestClusterStateCache, BenchmarkWildcardCache)
+{
+    constexpr EndpointId kEndpointCount   = 40;
+    constexpr ClusterId kClusterCount     = 10;
+    constexpr AttributeId kAttributeCount = 20;
+    constexpr size_t kTotalAttributeCount = kEndpointCount * kClusterCount * kAttributeCount;
+    constexpr int kLookupRounds           = 20;
+    const uint8_t octets[]                = { 'c', 'h', 'i', 'p', '-', 'b', 'e', 'n', 'c', 'h', 'm', 'a', 'r', 'k' };
+
+    // Every other attribute is a uint16 or a short octet string.
+    auto encodeValue = [&octets](TLV::TLVWriter & writer, AttributeId attributeId, uint16_t value) {
+        if (attributeId % 2)
+        {
+            return DataModel::Encode(writer, TLV::AnonymousTag(), ByteSpan(octets));
+        }
+        return DataModel::Encode(writer, TLV::AnonymousTag(), value);
+    };
+
+    NullCacheCallback callback;
+    ClusterStateCache cache(callback);
+    ReadClient::Callback & readCallback = cache.GetBufferedCallback();
+
+    size_t referenceSize = 0;
+
+    using ReferenceCluster  = CountingMap<AttributeId, Platform::ScopedMemoryBufferWithSize<uint8_t>>;
+    using ReferenceEndpoint = CountingMap<ClusterId, ReferenceCluster>;
+    CountingMap<EndpointId, ReferenceEndpoint> reference{ CountingAllocator<std::pair<const EndpointId, ReferenceEndpoint>>(
+        referenceSize) };
+
+    auto report = [&](uint16_t value) {
+        readCallback.OnReportBegin();
+        for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+        {
+            for (ClusterId cluster = 0; cluster < kClusterCount; cluster++)
+            {
+                for (AttributeId attribute = 0; attribute < kAttributeCount; attribute++)
+                {
+                    uint8_t buffer[32];
+                    TLV::TLVWriter writer;
+                    writer.Init(buffer);
+                    EXPECT_SUCCESS(encodeValue(writer, attribute, value));
+                    TLV::TLVReader reader;
+                    reader.Init(buffer, writer.GetLengthWritten());
+                    EXPECT_SUCCESS(reader.Next());
+
+                    ConcreteDataAttributePath path(endpoint, cluster, attribute);
+                    path.mDataVersion.SetValue(value);
+                    readCallback.OnAttributeData(path, &reader, StatusIB());
+
+                    auto & referenceEndpoint =
+                        reference.try_emplace(endpoint, ReferenceEndpoint::allocator_type(referenceSize)).first->second;
+                    auto & referenceCluster =
+                        referenceEndpoint.try_emplace(cluster, ReferenceCluster::allocator_type(referenceSize)).first->second;
+                    auto & referenceValue = referenceCluster[attribute];
+                    referenceSize -= referenceValue.AllocatedSize();
+                    referenceValue.Calloc(writer.GetLengthWritten());
+                    memcpy(referenceValue.Get(), buffer, writer.GetLengthWritten());
+                    referenceSize += referenceValue.AllocatedSize();
+                }
+            }
+        }
+        readCallback.OnReportEnd();
+    };
+
+    report(1);
+    const size_t cacheSize = cache.GetAttributeStorageSize();
+
+    // Values of the same size are updated in place.
+    report(2);
+    EXPECT_EQ(cache.GetAttributeStorageSize(), cacheSize);
+    EXPECT_LT(cacheSize, referenceSize);
+
+    // The values of the second report were kept.
+    TLV::TLVReader valueReader;
+    uint16_t value = 0;
+    EXPECT_SUCCESS(cache.Get(ConcreteAttributePath(kEndpointCount - 1, kClusterCount - 1, 0), valueReader));
+    EXPECT_SUCCESS(DataModel::Decode(valueReader, value));
+    EXPECT_EQ(value, 2u);
+
+    // The storage comparison above always runs; the timed lookups below only when benchmarks are enabled.
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    size_t cacheFound     = 0;
+    size_t referenceFound = 0;
+
+    Testing::BenchmarkTimer timer;
+    for (int round = 0; round < kLookupRounds; round++)
+    {
+        for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+        {
+            for (ClusterId cluster = 0; cluster < kClusterCount; cluster++)
+            {
+                for (AttributeId attribute = 0; attribute < kAttributeCount; attribute++)
+                {
+                    TLV::TLVReader reader;
+                    if (cache.Get(ConcreteAttributePath(endpoint, cluster, attribute), reader) == CHIP_NO_ERROR)
+                    {
+                        cacheFound++;
+                    }
+                }
+            }
+        }
+    }
+    const System::Clock::Microseconds64 cacheTime = timer.Elapsed();
+
+    timer.Restart();
+    for (int round = 0; round < kLookupRounds; round++)
+    {
+        for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+        {
+            for (ClusterId cluster = 0; cluster < kClusterCount; cluster++)
+            {
+                for (AttributeId attribute = 0; attribute < kAttributeCount; attribute++)
+                {
+                    auto endpointIter = reference.find(endpoint);
+                    if (endpointIter == reference.end())
+                    {
+                        continue;
+                    }
+                    auto clusterIter = endpointIter->second.find(cluster);
+                    if (clusterIter == endpointIter->second.end())
+                    {
+                        continue;
+                    }
+                    auto attributeIter = clusterIter->second.find(attribute);
+                    if (attributeIter == clusterIter->second.end())
+                    {
+                        continue;
+                    }
+                    TLV::TLVReader reader;
+                    reader.Init(attributeIter->second.Get(), attributeIter->second.AllocatedSize());
+                    if (reader.Next() == CHIP_NO_ERROR)
+                    {
+                        referenceFound++;
+                    }
+                }
+            }
+        }
+    }
+    const System::Clock::Microseconds64 referenceTime = timer.Elapsed();
+
+    EXPECT_EQ(cacheFound, kTotalAttributeCount * kLookupRounds);
+    EXPECT_EQ(referenceFound, cacheFound);
+
+    ChipLogProgress(DataManagement, "Cache of %u attributes: %u bytes, %u ns per lookup; nested maps: %u bytes, %u ns per lookup",
+                    static_cast<unsigned>(kTotalAttributeCount), static_cast<unsigned>(cacheSize),
+                    static_cast<unsigned>(cacheTime.count() * 1000 / (kTotalAttributeCount * kLookupRounds)),
+                    static_cast<unsigned>(referenceSize),
+                    static_cast<unsigned>(referenceTime.count() * 1000 / (kTotalAttributeCount * kLookupRounds)));
+}
+
 } // namespace
@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/endpoint-index.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
+#include <pw_unit_test/framework.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace app {
+namespace TestEmberEndpointIndex {
+namespace {
+
+constexpr size_t kMaxEndpoints = 300;
+using Index                    = EmberEndpointIndex<kMaxEndpoints>;
+
+// Lays out endpoints the way a bridge does: a few fixed ones, followed by dynamic ones whose ids keep growing as
+// devices come and go, with some slots left empty.
+void FillBridgeTable(EndpointId (&table)[kMaxEndpoints])
+{
+    for (uint16_t i = 0; i < kMaxEndpoints; i++)
+    {
+        table[i] = (i < 2) ? i : static_cast<EndpointId>(1000 + 3 * i);
+    }
+    table[10] = kInvalidEndpointId;
+    table[20] = kInvalidEndpointId;
+}
+
+void Rebuild(Index & index, const EndpointId (&table)[kMaxEndpoints])
+{
+    index.Clear();
+    for (uint16_t i = 0; i < kMaxEndpoints; i++)
+    {
+        if (table[i] != kInvalidEndpointId)
+        {
+            EXPECT_EQ(index.Add(table[i], i), CHIP_NO_ERROR);
+        }
+    }
+    index.Finalize();
+}
+
+} // namespace
+
+TEST(TestEmberEndpointIndex, TestFindMatchesTable)
+{
+    EndpointId table[kMaxEndpoints];
+    FillBridgeTable(table);
+
+    Index index;
+    EXPECT_TRUE(index.IsStale());
+    EXPECT_FALSE(index.IsUsable());
+
+    Rebuild(index, table);
+    EXPECT_TRUE(index.IsUsable());
+    EXPECT_EQ(index.Count(), kMaxEndpoints - 2);
+
+    for (uint16_t i = 0; i < kMaxEndpoints; i++)
+    {
+        if (table[i] != kInvalidEndpointId)
+        {
+            EXPECT_EQ(index.Find(table[i]), i);
+        }
+    }
+    EXPECT_EQ(index.Find(1000 + 3 * 10), Index::kInvalidIndex);
+    EXPECT_EQ(index.Find(2), Index::kInvalidIndex);
+    EXPECT_EQ(index.Find(kInvalidEndpointId), Index::kInvalidIndex);
+
+    // Ids that collide on the same slot are all found.
+    index.Invalidate();
+    EXPECT_TRUE(index.IsStale());
+    index.Clear();
+    EXPECT_EQ(index.Add(5, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Add(static_cast<EndpointId>(5 + Index::kCapacity), 1), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Add(static_cast<EndpointId>(5 + 2 * Index::kCapacity), 2), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Add(6, 3), CHIP_NO_ERROR);
+    index.Finalize();
+    EXPECT_EQ(index.Find(5), 0u);
+    EXPECT_EQ(index.Find(static_cast<EndpointId>(5 + Index::kCapacity)), 1u);
+    EXPECT_EQ(index.Find(static_cast<EndpointId>(5 + 2 * Index::kCapacity)), 2u);
+    EXPECT_EQ(index.Find(6), 3u);
+    EXPECT_EQ(index.Find(static_cast<EndpointId>(5 + 3 * Index::kCapacity)), Index::kInvalidIndex);
+}
+
+TEST(TestEmberEndpointIndex, TestDuplicateMakesIndexUnusable)
+{
+    Index index;
+    index.Clear();
+    EXPECT_EQ(index.Add(1, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Add(1, 1), CHIP_ERROR_DUPLICATE_KEY_ID);
+    EXPECT_EQ(index.Add(2, 2), CHIP_ERROR_INCORRECT_STATE);
+    index.Finalize();
+
+    // Not stale, so the owner does not rebuild it on every lookup, but not usable either.
+    EXPECT_FALSE(index.IsStale());
+    EXPECT_FALSE(index.IsUsable());
+
+    index.Invalidate();
+    index.Clear();
+    EXPECT_EQ(index.Add(1, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Add(kInvalidEndpointId, 1), CHIP_ERROR_INVALID_ARGUMENT);
+    index.Finalize();
+    EXPECT_TRUE(index.IsUsable());
+    EXPECT_EQ(index.Find(1), 0u);
+}
+
+TEST(TestEmberEndpointIndex, BenchmarkLookupOnBridge)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    EndpointId table[kMaxEndpoints];
+    FillBridgeTable(table);
+
+    Index index;
+    Rebuild(index, table);
+
+    constexpr int kRounds = 200;
+    size_t scanFound      = 0;
+    size_t indexFound     = 0;
+
+    Testing::BenchmarkTimer timer;
+    for (int round = 0; round < kRounds; round++)
+    {
+        for (EndpointId endpoint : table)
+        {
+            // What findIndexFromEndpoint did before the index.
+            for (uint16_t i = 0; i < kMaxEndpoints; i++)
+            {
+                if (table[i] == endpoint && endpoint != kInvalidEndpointId)
+                {
+                    scanFound++;
+                    break;
+                }
+            }
+        }
+    }
+    System::Clock::Microseconds64 scanTime = timer.Elapsed();
+
+    timer.Restart();
+    for (int round = 0; round < kRounds; round++)
+    {
+        for (EndpointId endpoint : table)
+        {
+            if (endpoint != kInvalidEndpointId && index.Find(endpoint) != Index::kInvalidIndex)
+            {
+                indexFound++;
+            }
+        }
+    }
+    System::Clock::Microseconds64 indexTime = timer.Elapsed();
+
+    EXPECT_EQ(scanFound, indexFound);
+    ChipLogProgress(Test, "Endpoint lookup over %u endpoints: scan %u ns, index %u ns per lookup",
+                    static_cast<unsigned>(kMaxEndpoints),
+                    static_cast<unsigned>(scanTime.count() * 1000 / (kRounds * kMaxEndpoints)),
+                    static_cast<unsigned>(indexTime.count() * 1000 / (kRounds * kMaxEndpoints)));
+}
+
+} // namespace TestEmberEndpointIndex
+} // namespace app
+} // namespace chip
@@ -20,6 +20,7 @@
 #include <app/EventLoggingDelegate.h>
 #include <app/EventLoggingTypes.h>
 #include <app/EventManagement.h>
+#include <app/EventSpillStorage.h>
 #include <app/InteractionModelEngine.h>
 #include <app/tests/AppTestContext.h>
 #include <data-model-providers/codegen/Instance.h>
@@ -37,11 +38,15 @@
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
 #include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
 #include <lib/core/StringBuilderAdapters.h>
 #include <pw_unit_test/framework.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace {
 
 static const chip::ClusterId kLivenessClusterId   = 0x00000022;
@@ -61,18 +66,11 @@ public:
     // Performs setup for each individual test in the test suite
     void SetUp() override
     {
-        const chip::app::LogStorageResources logStorageResources[] = {
-            { &gDebugEventBuffer[0], sizeof(gDebugEventBuffer), chip::app::PriorityLevel::Debug },
-            { &gInfoEventBuffer[0], sizeof(gInfoEventBuffer), chip::app::PriorityLevel::Info },
-            { &gCritEventBuffer[0], sizeof(gCritEventBuffer), chip::app::PriorityLevel::Critical },
-        };
-
         AppContext::SetUp();
         chip::app::InteractionModelEngine::GetInstance()->SetDataModelProvider(
             chip::app::CodegenDataModelProviderInstance(nullptr));
         ASSERT_EQ(mEventCounter.Init(0), CHIP_NO_ERROR);
-        chip::app::EventManagement::CreateEventManagement(&GetExchangeManager(), MATTER_ARRAY_SIZE(logStorageResources),
-                                                          gCircularEventBuffer, logStorageResources, &mEventCounter);
+        CreateEventManagement();
     }
 
     // Performs teardown for each individual test in the test suite
@@ -82,6 +80,20 @@ public:
         AppContext::TearDown();
     }
 
+protected:
+    // Also used to simulate a reboot, where the event numbers go on from where they were.
+    void CreateEventManagement()
+    {
+        const chip::app::LogStorageResources logStorageResources[] = {
+            { &gDebugEventBuffer[0], sizeof(gDebugEventBuffer), chip::app::PriorityLevel::Debug },
+            { &gInfoEventBuffer[0], sizeof(gInfoEventBuffer), chip::app::PriorityLevel::Info },
+            { &gCritEventBuffer[0], sizeof(gCritEventBuffer), chip::app::PriorityLevel::Critical },
+        };
+
+        chip::app::EventManagement::CreateEventManagement(&GetExchangeManager(), MATTER_ARRAY_SIZE(logStorageResources),
+                                                          gCircularEventBuffer, logStorageResources, &mEventCounter);
+    }
+
 private:
     chip::MonotonicallyIncreasingCounter<chip::EventNumber> mEventCounter;
 };
@@ -176,6 +188,61 @@ private:
     int32_t mStatus;
 };
 
+// Keeps spilled events in memory, the way a persistent storage would keep them on disk.
+class TestSpillStorage : public chip::app::EventSpillStorage
+{
+public:
+    CHIP_ERROR Append(chip::EventNumber aEventNumber, chip::app::PriorityLevel aPriority, chip::FabricIndex aFabricIndex,
+                      const chip::ByteSpan & aEvent) override
+    {
+        mEvents.push_back({ aEventNumber, aFabricIndex, std::vector<uint8_t>(aEvent.begin(), aEvent.end()) });
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR ForEachEvent(chip::EventNumber aMinEventNumber, chip::EventNumber aEndEventNumber, EventHandler aHandler,
+                            void * apContext) override
+    {
+        std::vector<Event> events = mEvents;
+        std::stable_sort(events.begin(), events.end(),
+                         [](const Event & a, const Event & b) { return a.mEventNumber < b.mEventNumber; });
+        for (const auto & event : events)
+        {
+            if (event.mEventNumber >= aMinEventNumber && event.mEventNumber < aEndEventNumber &&
+                event.mFabricIndex != mRemovedFabricIndex)
+            {
+                ReturnErrorOnFailure(aHandler(chip::ByteSpan(event.mData.data(), event.mData.size()), apContext));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR FabricRemoved(chip::FabricIndex aFabricIndex) override
+    {
+        mRemovedFabricIndex = aFabricIndex;
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<chip::EventNumber> EventNumbers() const
+    {
+        std::vector<chip::EventNumber> eventNumbers;
+        for (const auto & event : mEvents)
+        {
+            eventNumbers.push_back(event.mEventNumber);
+        }
+        return eventNumbers;
+    }
+
+    struct Event
+    {
+        chip::EventNumber mEventNumber;
+        chip::FabricIndex mFabricIndex;
+        std::vector<uint8_t> mData;
+    };
+
+    std::vector<Event> mEvents;
+    chip::FabricIndex mRemovedFabricIndex = chip::kUndefinedFabricIndex;
+};
+
 TEST_F(TestEventLogging, TestCheckLogEventWithEvictToNextBuffer)
 {
 
@@ -288,4 +355,236 @@ TEST_F(TestEventLogging, TestCheckLogEventWithDiscardLowEvent)
     CheckLogState(logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+TEST_F(TestEventLogging, TestDroppedEventsAreSpilled)
+{
+    chip::EventNumber eids[6];
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Debug;
+    TestEventGenerator testEventGenerator;
+    TestSpillStorage spillStorage;
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    logMgmt.SetSpillStorage(&spillStorage);
+
+    for (size_t i = 0; i < MATTER_ARRAY_SIZE(eids); i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i % 2));
+        EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eids[i]), CHIP_NO_ERROR);
+    }
+
+    // The buffers hold the last three debug events, the first three were spilled, oldest first.
+    CheckLogState(logMgmt, 3, chip::app::PriorityLevel::Debug);
+    ASSERT_EQ(spillStorage.mEvents.size(), 3u);
+    for (size_t i = 0; i < spillStorage.mEvents.size(); i++)
+    {
+        EXPECT_EQ(spillStorage.mEvents[i].mEventNumber, eids[i]);
+        EXPECT_EQ(spillStorage.mEvents[i].mFabricIndex, chip::kUndefinedFabricIndex);
+    }
+
+    chip::SingleLinkedListNode<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId1;
+    path.mValue.mClusterId  = kLivenessClusterId;
+
+    // Spilled events are reported in event number order with the buffered ones, and resuming from an event number skips
+    // the older ones.
+    CheckLogReadOut(logMgmt, 0, 6, &path);
+    CheckLogReadOut(logMgmt, eids[2], 4, &path);
+    CheckLogReadOut(logMgmt, eids[4], 2, &path);
+
+    logMgmt.SetSpillStorage(nullptr);
+    CheckLogReadOut(logMgmt, 0, 3, &path);
+}
+
+// A mock clock whose real time can be unknown, as it is until it is synced.
+class TestClock : public chip::System::Clock::Internal::MockClock
+{
+public:
+    CHIP_ERROR GetClock_RealTimeMS(chip::System::Clock::Milliseconds64 & aCurTime) override
+    {
+        VerifyOrReturnError(mRealTimeKnown, CHIP_ERROR_REAL_TIME_NOT_SYNCED);
+        return MockClock::GetClock_RealTimeMS(aCurTime);
+    }
+
+    bool mRealTimeKnown = true;
+};
+
+TEST_F(TestEventLogging, TestBufferedEventsAreSpilledOnShutdown)
+{
+    chip::EventNumber eids[3];
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Debug;
+    TestEventGenerator testEventGenerator;
+    TestSpillStorage spillStorage;
+
+    // With the real time known, the system timestamps of spilled events are replaced by epoch ones, which can still be
+    // reported after a reboot.
+    TestClock clock;
+    chip::System::Clock::ClockBase * const realClock = &chip::System::SystemClock();
+    EXPECT_EQ(clock.SetClock_RealTime(chip::System::Clock::Seconds64(1767225600)), CHIP_NO_ERROR);
+    chip::System::Clock::Internal::SetSystemClockForTesting(&clock);
+    chip::app::EventManagement::DestroyEventManagement();
+    CreateEventManagement();
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    logMgmt.SetSpillStorage(&spillStorage);
+    for (size_t i = 0; i < 2; i++)
+    {
+        clock.AdvanceMonotonic(chip::System::Clock::Milliseconds64(10));
+        EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eids[i]), CHIP_NO_ERROR);
+    }
+    EXPECT_TRUE(spillStorage.mEvents.empty());
+
+    // Nothing was dropped, but the buffers are about to be lost.
+    chip::app::EventManagement::DestroyEventManagement();
+    EXPECT_EQ(spillStorage.EventNumbers(), std::vector<chip::EventNumber>({ eids[0], eids[1] }));
+
+    clock.SetMonotonic(chip::System::Clock::kZero);
+    CreateEventManagement();
+    logMgmt.SetSpillStorage(&spillStorage);
+    CheckLogState(logMgmt, 0, chip::app::PriorityLevel::Debug);
+    EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eids[2]), CHIP_NO_ERROR);
+    EXPECT_GT(eids[2], eids[1]);
+
+    chip::SingleLinkedListNode<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId1;
+    path.mValue.mClusterId  = kLivenessClusterId;
+    CheckLogReadOut(logMgmt, 0, 3, &path);
+
+    // Events of an earlier boot that still carry a system timestamp are not reported, since it no longer means anything.
+    chip::app::EventManagement::DestroyEventManagement();
+    spillStorage.mEvents.clear();
+    clock.mRealTimeKnown = false;
+    CreateEventManagement();
+    logMgmt.SetSpillStorage(&spillStorage);
+    EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eids[0]), CHIP_NO_ERROR);
+    chip::app::EventManagement::DestroyEventManagement();
+    EXPECT_EQ(spillStorage.EventNumbers(), std::vector<chip::EventNumber>({ eids[0] }));
+
+    CreateEventManagement();
+    logMgmt.SetSpillStorage(&spillStorage);
+    EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eids[1]), CHIP_NO_ERROR);
+    CheckLogReadOut(logMgmt, 0, 1, &path);
+
+    logMgmt.SetSpillStorage(nullptr);
+    chip::app::EventManagement::DestroyEventManagement();
+    chip::System::Clock::Internal::SetSystemClockForTesting(realClock);
+    CreateEventManagement();
+}
+
+TEST_F(TestEventLogging, TestFetchSkipsIndexedEvents)
+{
+    chip::EventNumber eids[4];
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Info;
+    TestEventGenerator testEventGenerator;
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    for (size_t i = 0; i < MATTER_ARRAY_SIZE(eids); i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i % 2));
+        EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eids[i]), CHIP_NO_ERROR);
+    }
+
+    // The oldest event moved on to the info buffer, the others are still in the debug buffer.
+    const chip::app::EventBufferIndex & debugIndex = gCircularEventBuffer[0].GetIndex();
+    const chip::app::EventBufferIndex & infoIndex  = gCircularEventBuffer[1].GetIndex();
+    EXPECT_EQ(debugIndex.GetLastEventNumber(), eids[3]);
+    EXPECT_EQ(infoIndex.GetLastEventNumber(), eids[0]);
+    EXPECT_TRUE(debugIndex.MayContainCluster(kLivenessClusterId));
+    EXPECT_TRUE(gCircularEventBuffer[2].GetIndex().IsEmpty());
+
+    chip::SingleLinkedListNode<chip::app::EventPathParams> path;
+    path.mValue.mClusterId = kLivenessClusterId + 1;
+    if (debugIndex.MayContainCluster(path.mValue.mClusterId))
+    {
+        // The cluster shares a bucket of the filter with the liveness cluster, which is allowed but not expected.
+        path.mValue.mClusterId = kLivenessClusterId + 2;
+    }
+
+    uint8_t backingStore[1024];
+    chip::TLV::TLVWriter writer;
+    writer.Init(backingStore);
+
+    // Nothing to report for other clusters, but the next fetch still resumes after the skipped events.
+    chip::EventNumber eventMin = 0;
+    size_t eventCount          = 0;
+    EXPECT_EQ(logMgmt.FetchEventsSince(writer, &path, eventMin, eventCount, chip::Access::SubjectDescriptor{}), CHIP_NO_ERROR);
+    EXPECT_EQ(eventCount, 0u);
+    EXPECT_EQ(eventMin, eids[3] + 1);
+    EXPECT_EQ(writer.GetLengthWritten(), 0u);
+
+    // Starting at one of the most recent events reports the same events as decoding the buffers from the start.
+    path.mValue.mClusterId = kLivenessClusterId;
+    CheckLogReadOut(logMgmt, eids[2], 2, &path);
+    CheckLogReadOut(logMgmt, eids[1], 3, &path);
+    CheckLogReadOut(logMgmt, 0, 4, &path);
+}
+
+TEST_F(TestEventLogging, BenchmarkFetchRecentEvents)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    static uint8_t sDebugBuffer[2048];
+    static uint8_t sInfoBuffer[2048];
+    static uint8_t sCritBuffer[2048];
+    const chip::app::LogStorageResources logStorageResources[] = {
+        { &sDebugBuffer[0], sizeof(sDebugBuffer), chip::app::PriorityLevel::Debug },
+        { &sInfoBuffer[0], sizeof(sInfoBuffer), chip::app::PriorityLevel::Info },
+        { &sCritBuffer[0], sizeof(sCritBuffer), chip::app::PriorityLevel::Critical },
+    };
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    ASSERT_EQ(eventCounter.Init(0), CHIP_NO_ERROR);
+    chip::app::EventManagement::DestroyEventManagement();
+    chip::app::EventManagement::CreateEventManagement(&GetExchangeManager(), MATTER_ARRAY_SIZE(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    chip::EventNumber lastEventNumber = 0;
+    options.mPath                     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    for (int i = 0; i < 600; i++)
+    {
+        options.mPriority = static_cast<chip::app::PriorityLevel>(i % 3);
+        testEventGenerator.SetStatus(i);
+        ASSERT_EQ(logMgmt.LogEvent(&testEventGenerator, options, lastEventNumber), CHIP_NO_ERROR);
+    }
+
+    chip::SingleLinkedListNode<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId1;
+    path.mValue.mClusterId  = kLivenessClusterId;
+
+    // What every report of an up to date subscriber does, against what a new subscriber does once.
+    const chip::EventNumber startingEventNumbers[2] = { lastEventNumber, 0 };
+
+    constexpr int kRounds                            = 200;
+    chip::System::Clock::Microseconds64 fetchTime[2] = {};
+    size_t fetched[2]                                = {};
+    for (size_t variant = 0; variant < 2; variant++)
+    {
+        chip::Testing::BenchmarkTimer timer;
+        for (int round = 0; round < kRounds; round++)
+        {
+            uint8_t backingStore[8192];
+            chip::TLV::TLVWriter writer;
+            writer.Init(backingStore);
+            chip::EventNumber eventMin = startingEventNumbers[variant];
+            size_t eventCount          = 0;
+            EXPECT_EQ(logMgmt.FetchEventsSince(writer, &path, eventMin, eventCount, chip::Access::SubjectDescriptor{}),
+                      CHIP_NO_ERROR);
+            EXPECT_EQ(eventMin, lastEventNumber + 1);
+            fetched[variant] = eventCount;
+        }
+        fetchTime[variant] = timer.Elapsed();
+    }
+
+    EXPECT_EQ(fetched[0], 1u);
+    ChipLogProgress(Test, "FetchEventsSince over %u buffered events: %u ns for the last event, %u ns for all of them",
+                    static_cast<unsigned>(fetched[1]), static_cast<unsigned>(fetchTime[0].count() * 1000 / kRounds),
+                    static_cast<unsigned>(fetchTime[1].count() * 1000 / kRounds));
+}
+
 } // namespace
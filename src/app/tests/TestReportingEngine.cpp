@@ -22,7 +22,10 @@
  *
  */
 
+#include <algorithm>
 #include <cinttypes>
+#include <memory>
+#include <vector>
 
 #include <pw_unit_test/framework.h>
 
@@ -98,6 +101,15 @@ public:
     void TestBuildAndSendSingleReportData();
     void TestMergeOverlappedAttributePath();
     void TestMergeAttributePathWhenDirtySetPoolExhausted();
+#if CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+    void TestReadHandlerPathIndex();
+    void TestReadHandlerPathIndexInvalidation();
+    void BenchmarkReadHandlerPathIndex();
+#endif // CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+    void TestReportEncodeCache();
+    void TestReportEncodeCacheSharedBetweenHandlers();
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
 
 private:
     chip::app::DataModel::Provider * mOldProvider = nullptr;
@@ -359,6 +371,331 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+#if CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestReadHandlerPathIndex)
+{
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    EXPECT_EQ(imEngine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    ReadHandler concreteHandler(dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Subscribe,
+                                app::reporting::GetDefaultReportScheduler());
+    ReadHandler clusterHandler(dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Subscribe,
+                               app::reporting::GetDefaultReportScheduler());
+    ReadHandler wildcardHandler(dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Subscribe,
+                                app::reporting::GetDefaultReportScheduler());
+
+    AttributePathParams concretePath1(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    AttributePathParams concretePath2(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    AttributePathParams otherClusterPath(kTestEndpointId + 1, kTestClusterId + 1, kTestFieldId1);
+    AttributePathParams clusterPath(kTestEndpointId, kTestClusterId);
+    AttributePathParams wildcardEndpointPath;
+    wildcardEndpointPath.mClusterId = kTestClusterId;
+
+    EXPECT_SUCCESS(imEngine->PushFrontAttributePathList(concreteHandler.mpAttributePathList, concretePath1));
+    EXPECT_SUCCESS(imEngine->PushFrontAttributePathList(concreteHandler.mpAttributePathList, concretePath2));
+    EXPECT_SUCCESS(imEngine->PushFrontAttributePathList(concreteHandler.mpAttributePathList, otherClusterPath));
+    EXPECT_SUCCESS(imEngine->PushFrontAttributePathList(clusterHandler.mpAttributePathList, clusterPath));
+    EXPECT_SUCCESS(imEngine->PushFrontAttributePathList(wildcardHandler.mpAttributePathList, concretePath1));
+    EXPECT_SUCCESS(imEngine->PushFrontAttributePathList(wildcardHandler.mpAttributePathList, wildcardEndpointPath));
+
+    auto index = std::make_unique<ReadHandlerPathIndex>();
+    EXPECT_TRUE(index->IsStale());
+    EXPECT_FALSE(index->IsUsable());
+
+    index->Clear();
+    EXPECT_SUCCESS(index->Add(concreteHandler));
+    EXPECT_SUCCESS(index->Add(clusterHandler));
+    EXPECT_SUCCESS(index->Add(wildcardHandler));
+    index->Finalize();
+    EXPECT_TRUE(index->IsUsable());
+
+    // The two paths of concreteHandler in the same cluster collapse into a single entry, and the concrete path of
+    // wildcardHandler is not indexed since that handler is always visited.
+    EXPECT_EQ(index->GetEntryCount(), 3u);
+    EXPECT_EQ(index->GetWildcardHandlerCount(), 1u);
+
+    auto collect = [&index](EndpointId endpoint, ClusterId cluster, std::vector<ReadHandler *> & out) {
+        out.clear();
+        index->ForEachCandidate(endpoint, cluster, [&out](ReadHandler * handler) {
+            out.push_back(handler);
+            return Loop::Continue;
+        });
+    };
+
+    std::vector<ReadHandler *> candidates;
+    collect(kTestEndpointId, kTestClusterId, candidates);
+    ASSERT_EQ(candidates.size(), 3u);
+    EXPECT_EQ(candidates[0], &wildcardHandler);
+    EXPECT_EQ(std::count(candidates.begin(), candidates.end(), &concreteHandler), 1);
+    EXPECT_EQ(std::count(candidates.begin(), candidates.end(), &clusterHandler), 1);
+
+    collect(kTestEndpointId + 1, kTestClusterId + 1, candidates);
+    ASSERT_EQ(candidates.size(), 2u);
+    EXPECT_EQ(candidates[0], &wildcardHandler);
+    EXPECT_EQ(candidates[1], &concreteHandler);
+
+    collect(kTestEndpointId + 2, kTestClusterId, candidates);
+    ASSERT_EQ(candidates.size(), 1u);
+    EXPECT_EQ(candidates[0], &wildcardHandler);
+
+    // Invalidation from within the callback stops the iteration.
+    size_t visited = 0;
+    index->ForEachCandidate(kTestEndpointId, kTestClusterId, [&index, &visited](ReadHandler *) {
+        visited++;
+        index->Invalidate();
+        return Loop::Continue;
+    });
+    EXPECT_EQ(visited, 1u);
+    EXPECT_TRUE(index->IsStale());
+
+    DrainAndServiceIO();
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestReadHandlerPathIndexInvalidation)
+{
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    EXPECT_EQ(imEngine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    Engine & engine = imEngine->GetReportingEngine();
+
+    AttributePathParams dirtyPath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+
+    EXPECT_SUCCESS(engine.SetDirty(dirtyPath));
+    EXPECT_TRUE(engine.mReadHandlerPathIndex.IsUsable());
+
+    // Any change to an attribute path list must invalidate the index.
+    SingleLinkedListNode<AttributePathParams> * paths = nullptr;
+    EXPECT_SUCCESS(imEngine->PushFrontAttributePathList(paths, dirtyPath));
+    EXPECT_TRUE(engine.mReadHandlerPathIndex.IsStale());
+
+    EXPECT_SUCCESS(engine.SetDirty(dirtyPath));
+    EXPECT_TRUE(engine.mReadHandlerPathIndex.IsUsable());
+
+    imEngine->RemoveDuplicateConcreteAttributePath(paths);
+    EXPECT_TRUE(engine.mReadHandlerPathIndex.IsStale());
+
+    EXPECT_SUCCESS(engine.SetDirty(dirtyPath));
+    imEngine->ReleaseAttributePathList(paths);
+    EXPECT_TRUE(engine.mReadHandlerPathIndex.IsStale());
+
+    // Wildcard dirty paths do not need the index and leave it untouched.
+    EXPECT_SUCCESS(engine.SetDirty(AttributePathParams(kTestEndpointId, kInvalidClusterId)));
+    EXPECT_TRUE(engine.mReadHandlerPathIndex.IsStale());
+
+    engine.Shutdown();
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, BenchmarkReadHandlerPathIndex)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    constexpr size_t kHandlers        = 16;
+    constexpr size_t kPathsPerHandler = ReadHandlerPathIndex::kMaxEntries / kHandlers;
+    constexpr int kIterations         = 20000;
+
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    EXPECT_EQ(imEngine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    std::vector<std::unique_ptr<ReadHandler>> handlers;
+    auto index = std::make_unique<ReadHandlerPathIndex>();
+    index->Clear();
+    for (size_t i = 0; i < kHandlers; i++)
+    {
+        handlers.push_back(std::make_unique<ReadHandler>(dummy, NewExchangeToAlice(&delegate),
+                                                         ReadHandler::InteractionType::Subscribe,
+                                                         app::reporting::GetDefaultReportScheduler()));
+        // Every handler subscribes to its own set of clusters, as different controllers usually do.
+        for (size_t j = 0; j < kPathsPerHandler; j++)
+        {
+            AttributePathParams path(static_cast<EndpointId>(j % 4), static_cast<ClusterId>(i * kPathsPerHandler + j), 1);
+            ASSERT_SUCCESS(imEngine->PushFrontAttributePathList(handlers.back()->mpAttributePathList, path));
+        }
+        ASSERT_SUCCESS(index->Add(*handlers.back()));
+    }
+    index->Finalize();
+    ASSERT_TRUE(index->IsUsable());
+
+    size_t scanMatches  = 0;
+    size_t indexMatches = 0;
+
+    Testing::BenchmarkTimer timer;
+    for (int n = 0; n < kIterations; n++)
+    {
+        const size_t target = static_cast<size_t>(n) % (kHandlers * kPathsPerHandler);
+        AttributePathParams changed(static_cast<EndpointId>(target % kPathsPerHandler % 4), static_cast<ClusterId>(target), 1);
+        for (auto & handler : handlers)
+        {
+            for (auto * path = handler->GetAttributePathList(); path != nullptr; path = path->mpNext)
+            {
+                if (path->mValue.Intersects(changed))
+                {
+                    scanMatches++;
+                    break;
+                }
+            }
+        }
+    }
+    const System::Clock::Microseconds64 scanTime = timer.Elapsed();
+
+    timer.Restart();
+    for (int n = 0; n < kIterations; n++)
+    {
+        const size_t target = static_cast<size_t>(n) % (kHandlers * kPathsPerHandler);
+        AttributePathParams changed(static_cast<EndpointId>(target % kPathsPerHandler % 4), static_cast<ClusterId>(target), 1);
+        index->ForEachCandidate(changed.mEndpointId, changed.mClusterId, [&](ReadHandler * handler) {
+            for (auto * path = handler->GetAttributePathList(); path != nullptr; path = path->mpNext)
+            {
+                if (path->mValue.Intersects(changed))
+                {
+                    indexMatches++;
+                    break;
+                }
+            }
+            return Loop::Continue;
+        });
+    }
+    const System::Clock::Microseconds64 indexTime = timer.Elapsed();
+
+    EXPECT_EQ(scanMatches, static_cast<size_t>(kIterations));
+    EXPECT_EQ(indexMatches, scanMatches);
+
+    ChipLogProgress(Test, "%u handlers x %u paths, %d changes: full scan %u ns/change, index %u ns/change",
+                    static_cast<unsigned>(kHandlers), static_cast<unsigned>(kPathsPerHandler), kIterations,
+                    static_cast<unsigned>(scanTime.count() * 1000 / kIterations),
+                    static_cast<unsigned>(indexTime.count() * 1000 / kIterations));
+
+    handlers.clear();
+    DrainAndServiceIO();
+}
+
+#endif // CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+
+#if CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
+namespace {
+
+CHIP_ERROR GenerateReadRequest(System::PacketBufferHandle & aPayload)
+{
+    System::PacketBufferTLVWriter writer;
+    ReadRequestMessage::Builder readRequestBuilder;
+
+    writer.Init(System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize));
+    ReturnErrorOnFailure(readRequestBuilder.Init(&writer));
+    AttributePathIBs::Builder & attributePathListBuilder = readRequestBuilder.CreateAttributeRequests();
+    ReturnErrorOnFailure(readRequestBuilder.GetError());
+    for (AttributeId attributeId : { kTestFieldId1, kTestFieldId2 })
+    {
+        AttributePathIB::Builder & attributePathBuilder = attributePathListBuilder.CreatePath();
+        ReturnErrorOnFailure(attributePathListBuilder.GetError());
+        ReturnErrorOnFailure(
+            attributePathBuilder.Endpoint(kTestEndpointId).Cluster(kTestClusterId).Attribute(attributeId).EndOfAttributePathIB());
+    }
+    ReturnErrorOnFailure(attributePathListBuilder.EndOfAttributePathIBs());
+    ReturnErrorOnFailure(readRequestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage());
+    return writer.Finalize(&aPayload);
+}
+
+} // namespace
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestReportEncodeCache)
+{
+    auto cache = std::make_unique<ReportEncodeCache>();
+    const ReportEncodeCache::Key key1 = { ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId1), 1,
+                                          kUndefinedFabricIndex, BitFlags<DataModel::ReadFlags>() };
+    const ReportEncodeCache::Key key2 = { ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId2), 1,
+                                          kUndefinedFabricIndex, BitFlags<DataModel::ReadFlags>() };
+    ReportEncodeCache::Key otherFabricKey = key1;
+    otherFabricKey.mAccessingFabricIndex  = 1;
+    ReportEncodeCache::Key otherVersionKey = key1;
+    otherVersionKey.mDataVersion           = 2;
+
+    // Nothing is cached outside of Begin()/End().
+    EXPECT_EQ(cache->Add(key1, 0), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_FALSE(cache->Find(key1).has_value());
+
+    cache->Begin();
+
+    const uint8_t value1[]    = { 1, 2, 3 };
+    MutableByteSpan freeSpace = cache->GetFreeSpace();
+    ASSERT_GE(freeSpace.size(), sizeof(value1));
+    memcpy(freeSpace.data(), value1, sizeof(value1));
+    EXPECT_SUCCESS(cache->Add(key1, sizeof(value1)));
+    EXPECT_EQ(cache->GetFreeSpace().size(), freeSpace.size() - sizeof(value1));
+
+    // A value that does not fit is recorded with an empty encoding.
+    EXPECT_SUCCESS(cache->Add(key2, 0));
+    EXPECT_EQ(cache->Add(key2, ReportEncodeCache::kBufferSize), CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::optional<ByteSpan> found = cache->Find(key1);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_TRUE(found->data_equal(ByteSpan(value1)));
+    found = cache->Find(key2);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_TRUE(found->empty());
+    EXPECT_FALSE(cache->Find(otherFabricKey).has_value());
+    EXPECT_FALSE(cache->Find(otherVersionKey).has_value());
+
+    cache->End();
+    EXPECT_EQ(cache->GetEntryCount(), 0u);
+    EXPECT_FALSE(cache->Find(key1).has_value());
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestReportEncodeCacheSharedBetweenHandlers)
+{
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    EXPECT_EQ(imEngine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    Engine & engine = imEngine->GetReportingEngine();
+
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    ReadHandler readHandler1(dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+                             app::reporting::GetDefaultReportScheduler());
+    ReadHandler readHandler2(dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+                             app::reporting::GetDefaultReportScheduler());
+
+    uint8_t reports[2][System::PacketBuffer::kMaxSize];
+    size_t reportLengths[2]   = {};
+    ReadHandler * handlers[2] = { &readHandler1, &readHandler2 };
+
+    engine.mReportEncodeCache.Begin();
+    for (size_t i = 0; i < MATTER_ARRAY_SIZE(handlers); i++)
+    {
+        System::PacketBufferHandle readRequest;
+        ASSERT_SUCCESS(GenerateReadRequest(readRequest));
+        handlers[i]->OnInitialRequest(std::move(readRequest));
+
+        TLV::TLVWriter writer;
+        ReportDataMessage::Builder reportDataBuilder;
+        bool hasMoreChunks  = true;
+        bool hasEncodedData = false;
+        writer.Init(reports[i]);
+        ASSERT_SUCCESS(reportDataBuilder.Init(&writer));
+        ASSERT_SUCCESS(
+            engine.BuildSingleReportDataAttributeReportIBs(reportDataBuilder, handlers[i], &hasMoreChunks, &hasEncodedData));
+        EXPECT_FALSE(hasMoreChunks);
+        EXPECT_TRUE(hasEncodedData);
+        reportLengths[i] = writer.GetLengthWritten();
+
+        // Both attributes are encoded by the first handler and reused by the second one.
+        EXPECT_EQ(engine.mReportEncodeCache.GetEntryCount(), 2u);
+    }
+    engine.mReportEncodeCache.End();
+
+    EXPECT_TRUE(ByteSpan(reports[0], reportLengths[0]).data_equal(ByteSpan(reports[1], reportLengths[1])));
+
+    DrainAndServiceIO();
+}
+
+#endif // CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE > 0
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
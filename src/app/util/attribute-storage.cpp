@@ -29,6 +29,7 @@
 #include <app/util/ember-io-storage.h>
 #include <app/util/ember-strings.h>
 #include <app/util/endpoint-config-api.h>
+#include <app/util/endpoint-index.h>
 #include <app/util/generic-callbacks.h>
 #include <data-model-providers/codegen/CodegenDataModelProvider.h>
 #include <lib/core/CHIPConfig.h>
@@ -39,6 +40,8 @@
 #include <platform/LockTracker.h>
 #include <protocols/interaction_model/StatusCode.h>
 
+#include <array>
+
 using chip::Protocols::InteractionModel::Status;
 
 // Attribute storage depends on knowing the current layout/setup of attributes
@@ -136,17 +139,63 @@ constexpr const EmberAfCluster generatedClusters[] = GENERATED_CLUSTERS;
 
 #if FIXED_ENDPOINT_COUNT > 0
 constexpr const EmberAfEndpointType generatedEmberAfEndpointTypes[] = GENERATED_ENDPOINT_TYPES;
+constexpr const uint8_t fixedEmberAfEndpointTypes[]                 = FIXED_ENDPOINT_TYPES;
 constexpr const EmberAfDeviceType fixedDeviceTypeList[]             = FIXED_DEVICE_TYPES;
 
+// Offsets of the attributes of each fixed endpoint in attributeData. They only depend on the generated endpoint
+// types, so they are computed at compile time instead of adding up the sizes of all preceding endpoints on every
+// attribute access.
+constexpr auto fixedEndpointStorageOffsets = [] {
+    std::array<uint16_t, FIXED_ENDPOINT_COUNT> offsets{};
+    uint16_t offset = 0;
+    for (size_t ep = 0; ep < FIXED_ENDPOINT_COUNT; ep++)
+    {
+        offsets[ep] = offset;
+        offset      = static_cast<uint16_t>(offset + generatedEmberAfEndpointTypes[fixedEmberAfEndpointTypes[ep]].endpointSize);
+    }
+    return offsets;
+}();
+
 // Not const, because these need to mutate.
 DataVersion fixedEndpointDataVersions[ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT];
 #endif // FIXED_ENDPOINT_COUNT > 0
 
+// Positions of the endpoints in emAfEndpoints, by endpoint id. Invalidated whenever an endpoint id is written to
+// emAfEndpoints or emberEndpointCount changes, and rebuilt on the next lookup.
+EmberEndpointIndex<MAX_ENDPOINT_COUNT> endpointIndex;
+static_assert(decltype(endpointIndex)::kInvalidIndex == kEmberInvalidEndpointIndex, "Invalid endpoint indices must agree");
+
 bool emberAfIsThisDataTypeAListType(EmberAfAttributeType dataType)
 {
     return dataType == ZCL_ARRAY_ATTRIBUTE_TYPE;
 }
 
+void rebuildEndpointIndex()
+{
+    endpointIndex.Clear();
+    for (uint16_t epi = 0; epi < emberAfEndpointCount(); epi++)
+    {
+        if (emAfEndpoints[epi].endpoint != kInvalidEndpointId &&
+            endpointIndex.Add(emAfEndpoints[epi].endpoint, epi) != CHIP_NO_ERROR)
+        {
+            // Duplicate endpoint ids; lookups scan emAfEndpoints until the next change.
+            return;
+        }
+    }
+    endpointIndex.Finalize();
+}
+
+uint16_t fixedEndpointStorageOffset(uint16_t index)
+{
+#if FIXED_ENDPOINT_COUNT > 0
+    if (index < FIXED_ENDPOINT_COUNT)
+    {
+        return fixedEndpointStorageOffsets[index];
+    }
+#endif // FIXED_ENDPOINT_COUNT > 0
+    return 0;
+}
+
 uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
 {
     if (endpoint == kInvalidEndpointId)
@@ -154,7 +203,23 @@ uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints
         return kEmberInvalidEndpointIndex;
     }
 
+    if (endpointIndex.IsStale())
+    {
+        rebuildEndpointIndex();
+    }
+
     uint16_t epi;
+    if (endpointIndex.IsUsable())
+    {
+        epi = endpointIndex.Find(endpoint);
+        if (epi == kEmberInvalidEndpointIndex ||
+            (ignoreDisabledEndpoints && !emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
+        {
+            return kEmberInvalidEndpointIndex;
+        }
+        return epi;
+    }
+
     for (epi = 0; epi < emberAfEndpointCount(); epi++)
     {
         if (emAfEndpoints[epi].endpoint == endpoint &&
@@ -207,7 +272,6 @@ void emberAfEndpointConfigure()
     constexpr uint16_t fixedEndpoints[]             = FIXED_ENDPOINT_ARRAY;
     constexpr uint16_t fixedDeviceTypeListLengths[] = FIXED_DEVICE_TYPE_LENGTHS;
     constexpr uint16_t fixedDeviceTypeListOffsets[] = FIXED_DEVICE_TYPE_OFFSETS;
-    constexpr uint8_t fixedEmberAfEndpointTypes[]   = FIXED_ENDPOINT_TYPES;
     constexpr EndpointId fixedParentEndpoints[]     = FIXED_PARENT_ENDPOINTS;
 
 #if ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT > 0
@@ -270,11 +334,14 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    endpointIndex.Invalidate();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
     emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    endpointIndex.Invalidate();
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -361,6 +428,7 @@ CHIP_ERROR emberAfSetDynamicEndpointWithEpUniqueId(uint16_t index, EndpointId id
     emAfEndpoints[index].deviceTypeList = deviceTypeList;
     emAfEndpoints[index].endpointType   = ep;
     emAfEndpoints[index].dataVersions   = dataVersionStorage.data();
+    endpointIndex.Invalidate();
 #if CHIP_CONFIG_USE_ENDPOINT_UNIQUE_ID
     MutableCharSpan targetSpan(emAfEndpoints[index].endpointUniqueId);
     if (CopyCharSpanToMutableCharSpan(endpointUniqueId, targetSpan) != CHIP_NO_ERROR)
@@ -410,6 +478,7 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index, MatterClusterShutdownType
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false, shutdownType);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        endpointIndex.Invalidate();
     }
 
     emberMetadataStructureGeneration++;
@@ -662,121 +731,107 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
-    uint16_t attributeOffsetIndex = 0;
-
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    uint16_t ep = findIndexFromEndpoint(attRecord->endpoint, true /* ignoreDisabledEndpoints */);
+    if (ep == kEmberInvalidEndpointIndex)
     {
-        // Is this a dynamic endpoint?
-        bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
+        return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+    }
 
-        if (emAfEndpoints[ep].endpoint == attRecord->endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t clusterIndex;
-            if (!emberAfEndpointIndexIsEnabled(ep))
-            {
-                continue;
-            }
-            for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    // Is this a dynamic endpoint?
+    bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
+
+    // Dynamic endpoints are external and have no internal storage
+    uint16_t attributeOffsetIndex            = fixedEndpointStorageOffset(ep);
+    const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+    uint8_t clusterIndex;
+    for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+        if (emAfMatchCluster(cluster, attRecord))
+        { // Got the cluster
+            uint16_t attrIndex;
+            for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
             {
-                const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
-                if (emAfMatchCluster(cluster, attRecord))
-                { // Got the cluster
-                    uint16_t attrIndex;
-                    for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+                const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+                if (emAfMatchAttribute(cluster, am, attRecord))
+                { // Got the attribute
+                    // If passed metadata location is not null, populate
+                    if (metadata != nullptr)
                     {
-                        const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
-                        if (emAfMatchAttribute(cluster, am, attRecord))
-                        { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
-
-                            uint8_t * attributeLocation = attributeData + attributeOffsetIndex;
-                            uint8_t *src, *dst;
-                            if (write)
-                            {
-                                src = buffer;
-                                dst = attributeLocation;
-                                if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                         am->attributeId))
-                                {
-                                    return Status::UnsupportedAccess;
-                                }
-                            }
-                            else
-                            {
-                                if (buffer == nullptr)
-                                {
-                                    return Status::Success;
-                                }
-
-                                src = attributeLocation;
-                                dst = buffer;
-                                if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
-                                {
-                                    return Status::UnsupportedAccess;
-                                }
-                            }
+                        *metadata = am;
+                    }
 
-                            // Is the attribute externally stored?
-                            if (am->mask & MATTER_ATTRIBUTE_FLAG_EXTERNAL_STORAGE)
-                            {
-                                if (write)
-                                {
-                                    return emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am,
-                                                                                 buffer);
-                                }
-
-                                if (readLength < emberAfAttributeSize(am))
-                                {
-                                    // Prevent a potential buffer overflow
-                                    return Status::ResourceExhausted;
-                                }
-
-                                return emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
-                                                                            emberAfAttributeSize(am));
-                            }
+                    uint8_t * attributeLocation = attributeData + attributeOffsetIndex;
+                    uint8_t *src, *dst;
+                    if (write)
+                    {
+                        src = buffer;
+                        dst = attributeLocation;
+                        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+                        {
+                            return Status::UnsupportedAccess;
+                        }
+                    }
+                    else
+                    {
+                        if (buffer == nullptr)
+                        {
+                            return Status::Success;
+                        }
 
-                            // Internal storage is only supported for fixed endpoints
-                            if (!isDynamicEndpoint)
-                            {
-                                return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                            }
+                        src = attributeLocation;
+                        dst = buffer;
+                        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+                        {
+                            return Status::UnsupportedAccess;
+                        }
+                    }
 
-                            return Status::Failure;
+                    // Is the attribute externally stored?
+                    if (am->mask & MATTER_ATTRIBUTE_FLAG_EXTERNAL_STORAGE)
+                    {
+                        if (write)
+                        {
+                            return emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am, buffer);
                         }
 
-                        // Not the attribute we are looking for
-                        // Increase the index if attribute is not externally stored
-                        if (!(am->mask & MATTER_ATTRIBUTE_FLAG_EXTERNAL_STORAGE))
+                        if (readLength < emberAfAttributeSize(am))
                         {
-                            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
+                            // Prevent a potential buffer overflow
+                            return Status::ResourceExhausted;
                         }
+
+                        return emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
+                                                                    emberAfAttributeSize(am));
+                    }
+
+                    // Internal storage is only supported for fixed endpoints
+                    if (!isDynamicEndpoint)
+                    {
+                        return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
                     }
 
-                    // Attribute is not in the cluster.
-                    return Status::UnsupportedAttribute;
+                    return Status::Failure;
                 }
 
-                // Not the cluster we are looking for
-                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
+                // Not the attribute we are looking for
+                // Increase the index if attribute is not externally stored
+                if (!(am->mask & MATTER_ATTRIBUTE_FLAG_EXTERNAL_STORAGE))
+                {
+                    attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
+                }
             }
 
-            // Cluster is not in the endpoint.
-            return Status::UnsupportedCluster;
+            // Attribute is not in the cluster.
+            return Status::UnsupportedAttribute;
         }
 
-        // Not the endpoint we are looking for
-        // Dynamic endpoints are external and don't factor into storage size
-        if (!isDynamicEndpoint)
-        {
-            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emAfEndpoints[ep].endpointType->endpointSize);
-        }
+        // Not the cluster we are looking for
+        attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
     }
-    return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+
+    // Cluster is not in the endpoint.
+    return Status::UnsupportedCluster;
 }
 
 const EmberAfEndpointType * emberAfFindEndpointType(EndpointId endpointId)
@@ -820,19 +875,16 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    uint16_t ep = emberAfIndexFromEndpointIncludingDisabledEndpoints(endpoint);
+    if (ep == kEmberInvalidEndpointIndex)
     {
-        // Check the endpoint id first, because that way we avoid examining the
-        // endpoint type for endpoints that are not actually defined.
-        if (emAfEndpoints[ep].endpoint == endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t index                            = 0xFF;
-            if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
-            {
-                return index;
-            }
-        }
+        return 0xFF;
+    }
+
+    uint8_t index = 0xFF;
+    if (emberAfFindClusterInType(emAfEndpoints[ep].endpointType, clusterId, mask, &index) != nullptr)
+    {
+        return index;
     }
     return 0xFF;
 }
@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Open-addressing index from endpoint id to the position of that endpoint in the ember endpoint table (emAfEndpoints).
+ *
+ * Without it, every lookup of an endpoint scans the whole table, which on bridges with hundreds of dynamic endpoints
+ * dominates the cost of reading or writing an attribute.
+ *
+ * The table only changes when endpoints are configured, added or removed, so rather than being kept up to date the
+ * index is marked stale on such changes and rebuilt lazily (Clear, Add for every defined endpoint, Finalize). Whether an
+ * endpoint is enabled is not part of the index and has to be checked by the caller.
+ *
+ * If the table holds the same endpoint id twice, the first of them would win a scan, so the index cannot answer
+ * lookups for it; it then stays unusable until the next invalidation and the caller has to scan the table instead.
+ */
+template <size_t kMaxEndpoints>
+class EmberEndpointIndex
+{
+    static constexpr size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+public:
+    static constexpr size_t kCapacity       = RoundUpToPowerOfTwo(2 * kMaxEndpoints);
+    static constexpr uint16_t kInvalidIndex = 0xFFFF;
+
+    static_assert(kMaxEndpoints < kInvalidIndex, "Endpoint positions must fit in 16 bits");
+
+    /**
+     * Mark the index as out of date. Must be called whenever an endpoint id is written to the endpoint table or the
+     * number of endpoints in use changes.
+     */
+    void Invalidate() { mState = State::kStale; }
+
+    bool IsStale() const { return mState == State::kStale; }
+
+    /**
+     * Whether the index can answer lookups. False when stale, or when the last rebuild could not add every endpoint.
+     */
+    bool IsUsable() const { return mState == State::kReady; }
+
+    /**
+     * Start a rebuild.
+     */
+    void Clear()
+    {
+        for (auto & slot : mSlots)
+        {
+            slot = Slot();
+        }
+        mCount = 0;
+        mState = State::kBuilding;
+    }
+
+    /**
+     * Add the endpoint at position @p index of the endpoint table to the index being rebuilt.
+     *
+     * @retval CHIP_ERROR_DUPLICATE_KEY_ID if @p endpoint was already added; the index stays unusable until the next
+     *                                     invalidation.
+     */
+    CHIP_ERROR Add(EndpointId endpoint, uint16_t index)
+    {
+        VerifyOrReturnError(mState == State::kBuilding, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(endpoint != kInvalidEndpointId && index != kInvalidIndex, CHIP_ERROR_INVALID_ARGUMENT);
+        if (mCount >= kMaxEndpoints)
+        {
+            mState = State::kUnusable;
+            return CHIP_ERROR_NO_MEMORY;
+        }
+
+        size_t i = HomeOf(endpoint);
+        for (; mSlots[i].mIndex != kInvalidIndex; i = (i + 1) & kMask)
+        {
+            if (mSlots[i].mEndpoint == endpoint)
+            {
+                mState = State::kUnusable;
+                return CHIP_ERROR_DUPLICATE_KEY_ID;
+            }
+        }
+        mSlots[i] = Slot{ endpoint, index };
+        mCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Complete a rebuild started by Clear().
+     */
+    void Finalize()
+    {
+        if (mState == State::kBuilding)
+        {
+            mState = State::kReady;
+        }
+    }
+
+    /**
+     * Find the position of @p endpoint in the endpoint table. Must only be called while IsUsable().
+     *
+     * @return kInvalidIndex if the endpoint is not in the table.
+     */
+    uint16_t Find(EndpointId endpoint) const
+    {
+        VerifyOrDie(IsUsable());
+
+        for (size_t i = HomeOf(endpoint); mSlots[i].mIndex != kInvalidIndex; i = (i + 1) & kMask)
+        {
+            if (mSlots[i].mEndpoint == endpoint)
+            {
+                return mSlots[i].mIndex;
+            }
+        }
+        return kInvalidIndex;
+    }
+
+    size_t Count() const { return mCount; }
+
+private:
+    static constexpr size_t kMask = kCapacity - 1;
+
+    enum class State : uint8_t
+    {
+        kStale,
+        kBuilding,
+        kReady,
+        kUnusable,
+    };
+
+    struct Slot
+    {
+        EndpointId mEndpoint = kInvalidEndpointId;
+        uint16_t mIndex      = kInvalidIndex;
+    };
+
+    // Endpoint ids are mostly handed out sequentially, fixed ones from 0 and dynamic ones from just after them, so
+    // they spread evenly over the slots as they are.
+    static size_t HomeOf(EndpointId endpoint) { return endpoint & kMask; }
+
+    Slot mSlots[kCapacity];
+    size_t mCount = 0;
+    State mState  = State::kStale;
+};
+
+} // namespace app
+} // namespace chip
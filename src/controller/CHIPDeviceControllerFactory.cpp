@@ -62,6 +62,7 @@ CHIP_ERROR DeviceControllerFactory::Init(FactoryInitParams params)
     // Save our initialization state that we can't recover later from a
     // created-but-shut-down system state.
     mListenPort                = params.listenPort;
+    mUdpReceiveWorkers         = params.udpReceiveWorkers;
     mInterfaceId               = params.interfaceId;
     mFabricIndependentStorage  = params.fabricIndependentStorage;
     mOperationalKeystore       = params.operationalKeystore;
@@ -94,6 +95,7 @@ CHIP_ERROR DeviceControllerFactory::ReinitSystemStateIfNecessary()
     params.bleLayer = mSystemState->BleLayer();
 #endif
     params.listenPort                = mListenPort;
+    params.udpReceiveWorkers         = mUdpReceiveWorkers;
     params.interfaceId               = mInterfaceId;
     params.fabricIndependentStorage  = mFabricIndependentStorage;
     params.enableServerInteractions  = mEnableServerInteractions;
@@ -169,6 +171,13 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
 #endif
 
     stateParams.transportMgr = chip::Platform::New<DeviceTransportMgr>();
+    // Created ahead of the transports, which are given its receive worker delegate.
+    stateParams.sessionMgr = chip::Platform::New<SessionManager>();
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    Transport::ReceiveWorkerDelegate * receiveWorkerDelegate = stateParams.sessionMgr->GetReceiveWorkerDelegate();
+#else
+    Transport::ReceiveWorkerDelegate * receiveWorkerDelegate = nullptr;
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
 
     //
     // The logic below expects IPv6 to be at index 0 of this tuple. Keep that logic in sync with
@@ -177,6 +186,7 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
     ReturnErrorOnFailure(stateParams.transportMgr->Init(Transport::UdpListenParameters(stateParams.udpEndPointManager)
                                                             .SetAddressType(Inet::IPAddressType::kIPv6)
                                                             .SetListenPort(params.listenPort)
+                                                            .SetReceiveWorkers(params.udpReceiveWorkers, receiveWorkerDelegate)
 #if INET_CONFIG_ENABLE_IPV4
                                                             ,
                                                         //
@@ -186,6 +196,7 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
                                                         Transport::UdpListenParameters(stateParams.udpEndPointManager)
                                                             .SetAddressType(Inet::IPAddressType::kIPv4)
                                                             .SetListenPort(params.listenPort)
+                                                            .SetReceiveWorkers(params.udpReceiveWorkers, receiveWorkerDelegate)
 #endif
 #if CONFIG_NETWORK_LAYER_BLE
                                                             ,
@@ -213,7 +224,6 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
                                                             ));
 
     // TODO(#16231): All the new'ed state above/below in this method is never properly released or null-checked!
-    stateParams.sessionMgr                = chip::Platform::New<SessionManager>();
     stateParams.certificateValidityPolicy = params.certificateValidityPolicy;
     stateParams.unsolicitedStatusHandler  = Platform::New<Protocols::SecureChannel::UnsolicitedStatusHandler>();
     stateParams.exchangeMgr               = chip::Platform::New<Messaging::ExchangeManager>();
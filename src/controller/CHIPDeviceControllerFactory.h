@@ -171,6 +171,10 @@ struct FactoryInitParams
      * The default value of `0` will pick any available port. */
     uint16_t listenPort = 0;
 
+    /* The number of threads that receive and decrypt the messages of secure unicast sessions over UDP, for each
+     * address type, off the Matter thread. The default value of `0` keeps all of that on the Matter thread. */
+    uint8_t udpReceiveWorkers = 0;
+
     // MUST NOT be null during initialization: every application must define the
     // data model it wants to use. Backwards-compatibility can use `CodegenDataModelProviderInstance`
     // for ember/zap-generated models.
@@ -311,6 +315,7 @@ private:
     void ControllerInitialized(const DeviceController & controller);
 
     uint16_t mListenPort;
+    uint8_t mUdpReceiveWorkers = 0;
     std::optional<Inet::InterfaceId> mInterfaceId;
 
     DeviceControllerSystemState * mSystemState                          = nullptr;
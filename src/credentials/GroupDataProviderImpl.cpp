@@ -23,6 +23,8 @@
 #include <lib/support/PersistentData.h>
 #include <lib/support/Pool.h>
 #include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
 #include <stdlib.h>
 
 namespace chip {
@@ -855,12 +857,14 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    InvalidateGroupSessionIndex();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
     mStorage = storage;
+    InvalidateGroupSessionIndex();
 }
 
 //
@@ -1431,6 +1435,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKey(FabricIndex fabric_index, GroupId group_id, KeysetId keyset_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     ReturnErrorOnFailure(fabric.Load(mStorage));
@@ -1461,6 +1466,7 @@ CHIP_ERROR GroupDataProviderImpl::SetGroupKey(FabricIndex fabric_index, GroupId
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1552,6 +1558,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1585,6 +1592,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1669,6 +1677,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
         ChipLogError(NotSpecified, "Unsupported group key security policy: %d", static_cast<int>(in_keyset.policy));
         return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
     }
+    InvalidateGroupSessionIndex();
     FabricData fabric(fabric_index);
     KeySetData keyset;
 
@@ -1737,6 +1746,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1838,6 +1848,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionIndex();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1988,9 +2000,124 @@ GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGrou
     return mGroupSessionsIterator.CreateObject(*this, session_id);
 }
 
+namespace {
+
+// Calls f(fabric_index, group_id, policy, credentials) for the operational keys of every keyset-group pair in storage, in
+// storage order.
+template <typename F>
+CHIP_ERROR ForEachGroupSessionKey(PersistentStorageDelegate * storage, F f)
+{
+    FabricList fabric_list;
+    ReturnErrorOnFailure(fabric_list.Load(storage));
+
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        ReturnErrorOnFailure(fabric.Load(storage));
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            ReturnErrorOnFailure(mapping.Load(storage));
+
+            KeySetData keyset;
+            VerifyOrReturnError(keyset.Find(storage, fabric, mapping.keyset_id), CHIP_ERROR_KEY_NOT_FOUND);
+            for (uint16_t k = 0; k < keyset.keys_count && k < KeySet::kEpochKeysMax; ++k)
+            {
+                f(fabric.fabric_index, mapping.group_id, keyset.policy, keyset.operational_keys[k]);
+            }
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+bool GroupDataProviderImpl::LoadGroupSessionIndex()
+{
+    VerifyOrReturnValue(!mGroupSessionIndexValid, true);
+    // Iterators may still point into the stale index, in which case new ones read storage until they are all released.
+    VerifyOrReturnValue(mGroupSessionsIterator.Allocated() == 0, false);
+    ClearGroupSessionIndex();
+
+    size_t count = 0;
+    CHIP_ERROR err =
+        ForEachGroupSessionKey(mStorage, [&](FabricIndex, GroupId, SecurityPolicy, const Crypto::GroupOperationalCredentials &) {
+            count++;
+        });
+    VerifyOrReturnValue(err == CHIP_NO_ERROR, false);
+
+    if (count > 0)
+    {
+        mGroupSessionIndex.Alloc(count);
+        VerifyOrReturnValue(mGroupSessionIndex.Get() != nullptr, false);
+    }
+
+    size_t loaded = 0;
+    auto load     = [&](FabricIndex fabric_index, GroupId group_id, SecurityPolicy policy,
+                    const Crypto::GroupOperationalCredentials & credentials) {
+        if (loaded < count)
+        {
+            mGroupSessionIndex[loaded++] = { fabric_index, group_id, policy, credentials };
+        }
+    };
+    err = ForEachGroupSessionKey(mStorage, load);
+    if (err != CHIP_NO_ERROR || loaded != count)
+    {
+        ClearGroupSessionIndex();
+        return false;
+    }
+
+    // Insertion sort by session id: it is stable, so the keys of a session id keep their storage order, and it does not
+    // allocate. Writes to the keys are rare enough for its cost not to matter.
+    GroupSessionEntry * entries = mGroupSessionIndex.Get();
+    for (size_t i = 1; i < count; i++)
+    {
+        GroupSessionEntry * position =
+            std::upper_bound(entries, entries + i, entries[i].credentials.hash,
+                             [](uint16_t hash, const GroupSessionEntry & entry) { return hash < entry.credentials.hash; });
+        std::rotate(position, entries + i, entries + i + 1);
+    }
+
+    mGroupSessionIndexValid = true;
+    return true;
+}
+
+void GroupDataProviderImpl::InvalidateGroupSessionIndex()
+{
+    mGroupSessionIndexValid = false;
+    if (mGroupSessionsIterator.Allocated() == 0)
+    {
+        ClearGroupSessionIndex();
+    }
+}
+
+void GroupDataProviderImpl::ClearGroupSessionIndex()
+{
+    if (mGroupSessionIndex.Get() != nullptr)
+    {
+        Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mGroupSessionIndex.Get()),
+                                mGroupSessionIndex.AllocatedSize() * sizeof(GroupSessionEntry));
+    }
+    mGroupSessionIndex.Free();
+}
+
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+    if (provider.LoadGroupSessionIndex())
+    {
+        const GroupSessionEntry * entries = provider.mGroupSessionIndex.Get();
+        const size_t count                = provider.mGroupSessionIndex.AllocatedSize();
+        auto entryBefore = [](const GroupSessionEntry & entry, uint16_t hash) { return entry.credentials.hash < hash; };
+        auto entryAfter  = [](uint16_t hash, const GroupSessionEntry & entry) { return hash < entry.credentials.hash; };
+
+        mIndexEntry = std::lower_bound(entries, entries + count, session_id, entryBefore);
+        mIndexEnd   = std::upper_bound(mIndexEntry, entries + count, session_id, entryAfter);
+        mUseIndex   = true;
+        return;
+    }
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -2003,6 +2130,11 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
+    if (mUseIndex)
+    {
+        return static_cast<size_t>(mIndexEnd - mIndexEntry);
+    }
+
     FabricData fabric(mFirstFabric);
     size_t count = 0;
 
@@ -2044,6 +2176,19 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+    if (mUseIndex)
+    {
+        VerifyOrReturnValue(mIndexEntry != mIndexEnd, false);
+        const GroupSessionEntry & entry = *mIndexEntry++;
+        TEMPORARY_RETURN_IGNORED mGroupKeyContext.Initialize(entry.credentials.encryption_key, mSessionId,
+                                                             entry.credentials.privacy_key);
+        output.fabric_index    = entry.fabric_index;
+        output.group_id        = entry.group_id;
+        output.security_policy = entry.security_policy;
+        output.keyContext      = &mGroupKeyContext;
+        return true;
+    }
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
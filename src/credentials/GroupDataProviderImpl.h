@@ -20,6 +20,7 @@
 #include <crypto/SessionKeystore.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <lib/support/Pool.h>
+#include <lib/support/ScopedMemoryBuffer.h>
 
 namespace chip {
 namespace Credentials {
@@ -41,7 +42,7 @@ public:
     GroupDataProviderImpl(uint16_t maxGroupsPerFabric, uint16_t maxGroupKeysPerFabric) :
         GroupDataProvider(maxGroupsPerFabric, maxGroupKeysPerFabric)
     {}
-    ~GroupDataProviderImpl() override {}
+    ~GroupDataProviderImpl() override { ClearGroupSessionIndex(); }
 
     /**
      * @brief Set the storage implementation used for non-volatile storage of configuration data.
@@ -251,6 +252,14 @@ protected:
         size_t mTotal       = 0;
     };
 
+    struct GroupSessionEntry
+    {
+        FabricIndex fabric_index;
+        GroupId group_id;
+        SecurityPolicy security_policy;
+        Crypto::GroupOperationalCredentials credentials;
+    };
+
     class GroupSessionIteratorImpl : public GroupSessionIterator
     {
     public:
@@ -271,9 +280,19 @@ protected:
         uint16_t mKeyIndex       = 0;
         uint16_t mKeyCount       = 0;
         bool mFirstMap           = true;
+        // Range of the group session index with the session id, when the index could be loaded.
+        const GroupSessionEntry * mIndexEntry = nullptr;
+        const GroupSessionEntry * mIndexEnd   = nullptr;
+        bool mUseIndex                        = false;
         GroupKeyContext mGroupKeyContext;
     };
 
+    // Loads the group session index from storage, unless it is up to date. Returns false if it could not be loaded.
+    bool LoadGroupSessionIndex();
+    // Marks the group session index as stale, after a write to the keysets or the keyset-group pairs.
+    void InvalidateGroupSessionIndex();
+    void ClearGroupSessionIndex();
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
@@ -282,6 +301,10 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+    // Operational keys of all the keyset-group pairs, sorted by session id, so that group messages can be matched to their
+    // keys without reading storage.
+    Platform::ScopedMemoryBufferWithSize<GroupSessionEntry> mGroupSessionIndex;
+    bool mGroupSessionIndexValid   = false;
     bool mAuxAclNotificationNeeded = false;
 };
 
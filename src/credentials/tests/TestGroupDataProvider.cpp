@@ -1293,6 +1293,75 @@ TEST_F(TestGroupDataProvider, TestGroupDecryption)
     it->Release();
 }
 
+TEST_F(TestGroupDataProvider, TestGroupSessionsFollowKeyChanges)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+    ASSERT_TRUE(provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    auto getSessionId = [provider](FabricIndex fabric_index, GroupId group_id) {
+        Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(fabric_index, group_id);
+        EXPECT_NE(nullptr, key_context);
+        if (key_context == nullptr)
+        {
+            return static_cast<uint16_t>(0);
+        }
+        uint16_t session_id = key_context->GetKeyHash();
+        key_context->Release();
+        return session_id;
+    };
+
+    auto countSessions = [provider](uint16_t session_id) {
+        GroupSession session;
+        size_t count = 0;
+        auto it      = provider->IterateGroupSessions(session_id);
+        EXPECT_TRUE(it);
+        if (it)
+        {
+            while (it->Next(session))
+            {
+                count++;
+            }
+            EXPECT_EQ(count, it->Count());
+            it->Release();
+        }
+        return count;
+    };
+
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 1, kGroup3Keyset2), CHIP_NO_ERROR);
+
+    const uint16_t old_session_id = getSessionId(kFabric1, kGroup1);
+    EXPECT_EQ(countSessions(old_session_id), 2u);
+
+    // Replace the keys while an iterator is open
+    auto held = provider->IterateGroupSessions(old_session_id);
+    ASSERT_TRUE(held);
+
+    KeySet new_keys    = kKeySet3;
+    new_keys.keyset_id = kKeysetId2;
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, new_keys), CHIP_NO_ERROR);
+
+    const uint16_t new_session_id = getSessionId(kFabric1, kGroup1);
+    EXPECT_NE(old_session_id, new_session_id);
+    EXPECT_EQ(countSessions(new_session_id), 2u);
+    EXPECT_EQ(countSessions(old_session_id), 0u);
+
+    held->Release();
+    EXPECT_EQ(countSessions(new_session_id), 2u);
+    EXPECT_EQ(countSessions(old_session_id), 0u);
+
+    // Removing keyset-group pairs removes their sessions
+    EXPECT_EQ(provider->RemoveGroupKeyAt(kFabric1, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(new_session_id), 1u);
+
+    EXPECT_EQ(provider->RemoveFabric(kFabric1), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessions(new_session_id), 0u);
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
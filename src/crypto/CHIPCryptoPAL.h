@@ -907,6 +907,56 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext);
 
+/**
+ * @brief AES-CCM encryption and decryption with a key that stays prepared between messages.
+ *
+ * Crypto backends that would otherwise set up a cipher context and expand the key schedule on every
+ * AES_CCM_encrypt()/AES_CCM_decrypt() call keep that state here for as long as the key is in use. Other backends
+ * forward to AES_CCM_encrypt()/AES_CCM_decrypt(), which is also the fallback for inputs the prepared state was not
+ * set up for.
+ *
+ * The key handle must stay valid until Release() is called or the cipher is destroyed.
+ */
+class AesCcm128Cipher
+{
+public:
+    AesCcm128Cipher() = default;
+    ~AesCcm128Cipher() { Release(); }
+
+    AesCcm128Cipher(const AesCcm128Cipher &)             = delete;
+    AesCcm128Cipher & operator=(const AesCcm128Cipher &) = delete;
+
+    /**
+     * @brief Prepare the cipher for the given key, releasing any previously prepared key.
+     *
+     * @return An error if the backend failed to set up its state, in which case the cipher is left uninitialized.
+     */
+    CHIP_ERROR Init(const Aes128KeyHandle & key);
+
+    void Release();
+
+    bool IsInitialized() const { return mKey != nullptr; }
+
+    /**
+     * @brief Same as AES_CCM_encrypt() with the key passed to Init().
+     */
+    CHIP_ERROR Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length) const;
+
+    /**
+     * @brief Same as AES_CCM_decrypt() with the key passed to Init().
+     */
+    CHIP_ERROR Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                       uint8_t * plaintext) const;
+
+private:
+    const Aes128KeyHandle * mKey = nullptr;
+    // Backend-specific state for each direction, if the backend has any. It is set up on first use.
+    mutable void * mEncryptContext = nullptr;
+    mutable void * mDecryptContext = nullptr;
+};
+
 /**
  * @brief A function that implements AES-CTR encryption/decryption
  *
@@ -403,6 +403,198 @@ exit:
     return error;
 }
 
+namespace {
+
+#if CHIP_CRYPTO_BORINGSSL
+using AesCcm128CipherContext = EVP_AEAD_CTX;
+#else
+using AesCcm128CipherContext = EVP_CIPHER_CTX;
+#endif // CHIP_CRYPTO_BORINGSSL
+
+AesCcm128CipherContext * NewAesCcm128CipherContext(const Aes128KeyHandle & key, bool encrypt)
+{
+    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
+
+#if CHIP_CRYPTO_BORINGSSL
+    (void) encrypt;
+    return EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), key.As<Symmetric128BitsKeyByteArray>(),
+                            sizeof(Symmetric128BitsKeyByteArray), kAES_CCM128_Tag_Length);
+#else
+    EVP_CIPHER_CTX * context = EVP_CIPHER_CTX_new();
+    VerifyOrReturnValue(context != nullptr, nullptr);
+
+    // The nonce and tag lengths are fixed when the key is set, and the context cannot switch between encryption and
+    // decryption afterwards, so it is prepared for one direction and for the lengths used by Matter messages.
+    const int enc = encrypt ? 1 : 0;
+    if (EVP_CipherInit_ex(context, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, enc) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(kAES_CCM128_Nonce_Length), nullptr) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(kAES_CCM128_Tag_Length), nullptr) != 1 ||
+        EVP_CipherInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), nullptr, enc) != 1)
+    {
+        EVP_CIPHER_CTX_free(context);
+        return nullptr;
+    }
+    return context;
+#endif // CHIP_CRYPTO_BORINGSSL
+}
+
+void FreeAesCcm128CipherContext(void * context)
+{
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX_free(static_cast<EVP_AEAD_CTX *>(context));
+#else
+    EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX *>(context));
+#endif // CHIP_CRYPTO_BORINGSSL
+}
+
+} // namespace
+
+CHIP_ERROR AesCcm128Cipher::Init(const Aes128KeyHandle & key)
+{
+    // The cipher contexts are only set up on first use, since a session key is normally used in one direction only.
+    Release();
+    mKey = &key;
+    return CHIP_NO_ERROR;
+}
+
+void AesCcm128Cipher::Release()
+{
+    if (mEncryptContext != nullptr)
+    {
+        FreeAesCcm128CipherContext(mEncryptContext);
+        mEncryptContext = nullptr;
+    }
+    if (mDecryptContext != nullptr)
+    {
+        FreeAesCcm128CipherContext(mDecryptContext);
+        mDecryptContext = nullptr;
+    }
+    mKey = nullptr;
+}
+
+CHIP_ERROR AesCcm128Cipher::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                    size_t tag_length) const
+{
+    VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    if (mEncryptContext == nullptr)
+    {
+        mEncryptContext = NewAesCcm128CipherContext(*mKey, true);
+    }
+
+    if (mEncryptContext == nullptr || plaintext_length == 0 || nonce_length != kAES_CCM128_Nonce_Length ||
+        tag_length != kAES_CCM128_Tag_Length)
+    {
+        return AES_CCM_encrypt(plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length, ciphertext, tag,
+                               tag_length);
+    }
+
+    VerifyOrReturnError(plaintext != nullptr && ciphertext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr && tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    auto * context = static_cast<AesCcm128CipherContext *>(mEncryptContext);
+
+#if CHIP_CRYPTO_BORINGSSL
+    size_t written_tag_len = 0;
+
+    int result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
+                                           plaintext_length, nullptr, 0, aad, aad_length);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(written_tag_len == tag_length, CHIP_ERROR_INTERNAL);
+#else
+    VerifyOrReturnError(CanCastTo<int>(plaintext_length) && CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    int bytesWritten = 0;
+
+    // Only the nonce is passed in; the cipher, lengths and key schedule are kept from the first message.
+    int result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, nullptr, static_cast<int>(plaintext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    if (aad_length > 0)
+    {
+        result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    result = EVP_EncryptUpdate(context, Uint8::to_uchar(ciphertext), &bytesWritten, Uint8::to_const_uchar(plaintext),
+                               static_cast<int>(plaintext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(bytesWritten >= 0 && bytesWritten <= static_cast<int>(plaintext_length), CHIP_ERROR_INTERNAL);
+
+    result = EVP_EncryptFinal_ex(context, ciphertext + bytesWritten, &bytesWritten);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_GET_TAG, static_cast<int>(tag_length), Uint8::to_uchar(tag));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AesCcm128Cipher::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                    uint8_t * plaintext) const
+{
+    VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    if (mDecryptContext == nullptr)
+    {
+        mDecryptContext = NewAesCcm128CipherContext(*mKey, false);
+    }
+
+    if (mDecryptContext == nullptr || ciphertext_length == 0 || nonce_length != kAES_CCM128_Nonce_Length ||
+        tag_length != kAES_CCM128_Tag_Length)
+    {
+        return AES_CCM_decrypt(ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey, nonce, nonce_length,
+                               plaintext);
+    }
+
+    VerifyOrReturnError(ciphertext != nullptr && plaintext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr && tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    auto * context = static_cast<AesCcm128CipherContext *>(mDecryptContext);
+
+#if CHIP_CRYPTO_BORINGSSL
+    int result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length,
+                                          aad, aad_length);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#else
+    VerifyOrReturnError(CanCastTo<int>(ciphertext_length) && CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    int bytesOutput = 0;
+
+    // Only the nonce and expected tag are passed in; the cipher, lengths and key schedule are kept from the first message.
+    int result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
+                                 const_cast<void *>(static_cast<const void *>(tag)));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, nullptr, static_cast<int>(ciphertext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    if (aad_length > 0)
+    {
+        result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    // We won't get anything if validation fails.
+    result = EVP_DecryptUpdate(context, Uint8::to_uchar(plaintext), &bytesOutput, Uint8::to_const_uchar(ciphertext),
+                               static_cast<int>(ciphertext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
@@ -64,6 +64,7 @@
 #include <lib/asn1/ASN1.h>
 #include <lib/asn1/ASN1Macros.h>
 #include <lib/core/TLV.h>
+#include <system/SystemClock.h>
 
 #include <fcntl.h>
 #include <stdlib.h>
@@ -547,6 +548,112 @@ TEST_F(TestChipCryptoPAL, TestAES_CCM_128InPlaceDecryption)
     EXPECT_GT(numOfTestsRan, 0);
 }
 
+// Testing a prepared cipher, used repeatedly with the same key, in place as done for Matter messages
+TEST_F(TestChipCryptoPAL, TestAES_CCM_128Cipher)
+{
+    HeapChecker heapChecker;
+    int numOfTestVectors = MATTER_ARRAY_SIZE(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->result != CHIP_NO_ERROR || vector->pt_len == 0)
+        {
+            continue;
+        }
+        numOfTestsRan++;
+
+        chip::Platform::ScopedMemoryBuffer<uint8_t> inplace_buffer;
+        ASSERT_TRUE(inplace_buffer.Alloc(vector->pt_len));
+        chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+        ASSERT_TRUE(out_tag.Alloc(vector->tag_len));
+
+        TestAesKey key(vector->key, vector->key_len);
+        AesCcm128Cipher cipher;
+        EXPECT_FALSE(cipher.IsInitialized());
+        ASSERT_SUCCESS(cipher.Init(key.key));
+        EXPECT_TRUE(cipher.IsInitialized());
+
+        // Each operation runs twice to check that the prepared state is reusable.
+        for (int pass = 0; pass < 2; pass++)
+        {
+            memcpy(inplace_buffer.Get(), vector->pt, vector->pt_len);
+            EXPECT_SUCCESS(cipher.Encrypt(inplace_buffer.Get(), vector->pt_len, vector->aad, vector->aad_len, vector->nonce,
+                                          vector->nonce_len, inplace_buffer.Get(), out_tag.Get(), vector->tag_len));
+            EXPECT_EQ(memcmp(inplace_buffer.Get(), vector->ct, vector->ct_len), 0) << "Test " << vector->tcId;
+            EXPECT_EQ(memcmp(out_tag.Get(), vector->tag, vector->tag_len), 0) << "Test " << vector->tcId;
+        }
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            EXPECT_SUCCESS(cipher.Decrypt(inplace_buffer.Get(), vector->ct_len, vector->aad, vector->aad_len, vector->tag,
+                                          vector->tag_len, vector->nonce, vector->nonce_len, inplace_buffer.Get()));
+            EXPECT_EQ(memcmp(inplace_buffer.Get(), vector->pt, vector->pt_len), 0) << "Test " << vector->tcId;
+            memcpy(inplace_buffer.Get(), vector->ct, vector->ct_len);
+        }
+
+        // A bad tag must be rejected, without breaking the next message.
+        memcpy(out_tag.Get(), vector->tag, vector->tag_len);
+        out_tag[0] ^= 0x01;
+        EXPECT_NE(cipher.Decrypt(inplace_buffer.Get(), vector->ct_len, vector->aad, vector->aad_len, out_tag.Get(),
+                                 vector->tag_len, vector->nonce, vector->nonce_len, inplace_buffer.Get()),
+                  CHIP_NO_ERROR);
+        memcpy(inplace_buffer.Get(), vector->ct, vector->ct_len);
+        EXPECT_SUCCESS(cipher.Decrypt(inplace_buffer.Get(), vector->ct_len, vector->aad, vector->aad_len, vector->tag,
+                                      vector->tag_len, vector->nonce, vector->nonce_len, inplace_buffer.Get()));
+        EXPECT_EQ(memcmp(inplace_buffer.Get(), vector->pt, vector->pt_len), 0) << "Test " << vector->tcId;
+
+        cipher.Release();
+        EXPECT_FALSE(cipher.IsInitialized());
+    }
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
+TEST_F(TestChipCryptoPAL, BenchmarkAES_CCM_128Cipher)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    constexpr size_t kIterations    = 10000;
+    constexpr size_t kPayloadLength = 128;
+
+    const uint8_t keyBytes[kAES_CCM128_Key_Length] = { 0x2b };
+    const uint8_t aad[8]                           = { 0 };
+    uint8_t nonce[NONCE_LENGTH]                    = { 0 };
+    uint8_t payload[kPayloadLength]                = { 0 };
+    uint8_t tag[kAES_CCM128_Tag_Length];
+
+    TestAesKey key(keyBytes, sizeof(keyBytes));
+    AesCcm128Cipher cipher;
+    ASSERT_SUCCESS(cipher.Init(key.key));
+
+    Testing::BenchmarkTimer timer;
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        nonce[0] = static_cast<uint8_t>(i);
+        ASSERT_SUCCESS(AES_CCM_encrypt(payload, sizeof(payload), aad, sizeof(aad), key.key, nonce, sizeof(nonce), payload, tag,
+                                       sizeof(tag)));
+    }
+    const System::Clock::Microseconds64 oneShotTime = timer.Elapsed();
+
+    timer.Restart();
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        nonce[0] = static_cast<uint8_t>(i);
+        ASSERT_SUCCESS(
+            cipher.Encrypt(payload, sizeof(payload), aad, sizeof(aad), nonce, sizeof(nonce), payload, tag, sizeof(tag)));
+    }
+    const System::Clock::Microseconds64 preparedTime = timer.Elapsed();
+
+    // The last message encrypted by the prepared cipher still decrypts with the one-shot API.
+    ASSERT_SUCCESS(
+        AES_CCM_decrypt(payload, sizeof(payload), aad, sizeof(aad), tag, sizeof(tag), key.key, nonce, sizeof(nonce), payload));
+
+    ChipLogProgress(Crypto, "AES-CCM-128 encrypt of %u bytes: one-shot %u ns, prepared cipher %u ns",
+                    static_cast<unsigned>(kPayloadLength), static_cast<unsigned>(oneShotTime.count() * 1000 / kIterations),
+                    static_cast<unsigned>(preparedTime.count() * 1000 / kIterations));
+}
+
 TEST_F(TestChipCryptoPAL, TestAES_CCM_128EncryptInvalidNonceLen)
 {
     HeapChecker heapChecker;
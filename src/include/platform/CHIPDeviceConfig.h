@@ -136,6 +136,16 @@
 #define CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE
+ *
+ * The number of threads started by StartBackgroundEventLoopTask() on POSIX platforms, which process
+ * background events (e.g. the CASE certificate validation and signature checks) concurrently.
+ */
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE
+#define CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE 4
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ICD_SLOW_POLL_INTERVAL
  *
@@ -79,6 +79,16 @@ protected:
     pthread_t mChipStackLockOwnerThread;
 #endif
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    pthread_mutex_t mBackgroundEventQueueLock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t mBackgroundEventQueueCond  = PTHREAD_COND_INITIALIZER;
+    std::queue<ChipDeviceEvent> mBackgroundEventQueue;
+    bool mShouldRunBackgroundEventLoop = false;
+
+    pthread_t mBackgroundEventLoopTasks[CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE];
+    size_t mBackgroundEventLoopTaskCount = 0;
+#endif
+
     // ===== Methods that implement the PlatformManager abstract interface.
 
     CHIP_ERROR
@@ -93,6 +103,13 @@ protected:
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
     void _Shutdown();
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    void _RunBackgroundEventLoop();
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+#endif
+
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
@@ -112,6 +129,11 @@ private:
     std::atomic<bool> mShouldRunEventLoop{ true };
     static void * EventLoopTaskMain(void * arg);
 #endif
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    void ProcessBackgroundEvents();
+    static void * BackgroundEventLoopTaskMain(void * arg);
+#endif
     void ProcessDeviceEvents();
 };
 
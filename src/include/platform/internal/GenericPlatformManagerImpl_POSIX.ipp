@@ -397,6 +397,132 @@ exit:
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    VerifyOrReturnError(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    if (!mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+        // Use foreground event loop for background events until background tasks are running
+        return Impl()->PostEvent(event);
+    }
+    mBackgroundEventQueue.push(*event);
+    pthread_cond_signal(&mBackgroundEventQueueCond);
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessBackgroundEvents()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    while (true)
+    {
+        while (mBackgroundEventQueue.empty() && mShouldRunBackgroundEventLoop)
+        {
+            pthread_cond_wait(&mBackgroundEventQueueCond, &mBackgroundEventQueueLock);
+        }
+
+        // Events posted before the loop was stopped are still processed.
+        if (mBackgroundEventQueue.empty())
+        {
+            break;
+        }
+
+        const ChipDeviceEvent event = mBackgroundEventQueue.front();
+        mBackgroundEventQueue.pop();
+
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        Impl()->DispatchEvent(&event);
+        pthread_mutex_lock(&mBackgroundEventQueueLock);
+    }
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = true;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    ProcessBackgroundEvents();
+}
+
+template <class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::BackgroundEventLoopTaskMain(void * arg)
+{
+    ChipLogDetail(DeviceLayer, "CHIP background task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass> *>(arg)->ProcessBackgroundEvents();
+    return nullptr;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+    VerifyOrReturnError(mBackgroundEventLoopTaskCount == 0, CHIP_ERROR_INCORRECT_STATE);
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = true;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    int err = 0;
+    for (auto & task : mBackgroundEventLoopTasks)
+    {
+        err = pthread_create(&task, nullptr, BackgroundEventLoopTaskMain, this);
+        if (err != 0)
+        {
+            break;
+        }
+        mBackgroundEventLoopTaskCount++;
+    }
+
+    if (err != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to start CHIP background task: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(err).Format());
+        LogErrorOnFailure(_StopBackgroundEventLoopTask());
+    }
+
+    return CHIP_ERROR_POSIX(err);
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = false;
+    pthread_cond_broadcast(&mBackgroundEventQueueCond);
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    int err = 0;
+    for (size_t i = 0; i < mBackgroundEventLoopTaskCount; i++)
+    {
+        // A background task stopping the loop cannot wait for itself.
+        if (pthread_equal(pthread_self(), mBackgroundEventLoopTasks[i]) == 0)
+        {
+            int joinErr = pthread_join(mBackgroundEventLoopTasks[i], nullptr);
+            err         = (err != 0) ? err : joinErr;
+        }
+        else
+        {
+            pthread_detach(mBackgroundEventLoopTasks[i]);
+        }
+    }
+    mBackgroundEventLoopTaskCount = 0;
+
+    return CHIP_ERROR_POSIX(err);
+}
+
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
 {
@@ -407,6 +533,10 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     //
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    LogErrorOnFailure(_StopBackgroundEventLoopTask());
+#endif
+
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
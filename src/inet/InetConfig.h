@@ -272,6 +272,58 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams that a socket-based UDP endpoint
+ *    receives with one recvmmsg() call, or sends with one sendmmsg() call,
+ *    when batched I/O is enabled on it.
+ *
+ *  @details
+ *    Set to 0 to compile out batched I/O, e.g. where recvmmsg() and
+ *    sendmmsg() are not available. An endpoint with batched I/O enabled
+ *    keeps up to this many receive buffers of the largest size allocated,
+ *    so a small value is preferable when packet buffers come from a pool.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+#if defined(__linux__) && CHIP_SYSTEM_CONFIG_USE_POSIX_SOCKETS
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 16
+#else
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 0
+#endif
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_UDP_RECEIVE_WORKERS
+ *
+ *  @brief
+ *    The maximum number of receive worker threads that a socket-based UDP
+ *    endpoint can be given, each reading its own SO_REUSEPORT socket.
+ *
+ *  @details
+ *    Set to 0 to compile out receive workers, e.g. where threads or
+ *    SO_REUSEPORT load balancing are not available.
+ */
+#ifndef INET_CONFIG_UDP_RECEIVE_WORKERS
+#if defined(__linux__) && CHIP_SYSTEM_CONFIG_USE_POSIX_SOCKETS
+#define INET_CONFIG_UDP_RECEIVE_WORKERS 8
+#else
+#define INET_CONFIG_UDP_RECEIVE_WORKERS 0
+#endif
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS
+
+/**
+ *  @def INET_CONFIG_UDP_RECEIVE_WORKER_QUEUE_SIZE
+ *
+ *  @brief
+ *    The number of received datagrams that each receive worker of a UDP
+ *    endpoint can hold for the Matter thread before it stops reading.
+ */
+#ifndef INET_CONFIG_UDP_RECEIVE_WORKER_QUEUE_SIZE
+#define INET_CONFIG_UDP_RECEIVE_WORKER_QUEUE_SIZE 64
+#endif // INET_CONFIG_UDP_RECEIVE_WORKER_QUEUE_SIZE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
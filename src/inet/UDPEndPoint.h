@@ -88,6 +88,32 @@ public:
      */
     using OnReceiveErrorFunct = void (*)(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo);
 
+    /**
+     * Type of the function that receive workers run on each datagram, on their own threads.
+     *
+     * @param[in]     endPoint    The endpoint associated with the event.
+     * @param[in,out] msg         The message text received, which may be modified in place, or released to drop it.
+     * @param[in]     pktInfo     The packet's IP information.
+     *
+     * @return A value that is passed along with the message to the \c OnWorkerMessageReceivedFunct.
+     *
+     *  Functions of this type must not use any state of the endpoint besides \c mAppState, nor any other state that
+     *  is not safe to use outside of the Matter thread.
+     */
+    using ReceiveWorkerFunct = uint32_t (*)(UDPEndPoint * endPoint, chip::System::PacketBufferHandle & msg,
+                                            const IPPacketInfo * pktInfo);
+
+    /**
+     * Type of the function that handles, on the Matter thread, the datagrams processed by receive workers.
+     *
+     * @param[in]   endPoint        The endpoint associated with the event.
+     * @param[in]   msg             The message text, as left by the \c ReceiveWorkerFunct.
+     * @param[in]   pktInfo         The packet's IP information.
+     * @param[in]   workerResult    The value returned by the \c ReceiveWorkerFunct for the message.
+     */
+    using OnWorkerMessageReceivedFunct = void (*)(UDPEndPoint * endPoint, chip::System::PacketBufferHandle && msg,
+                                                  const IPPacketInfo * pktInfo, uint32_t workerResult);
+
     /**
      * Set whether IP multicast traffic should be looped back.
      */
@@ -247,6 +273,42 @@ public:
      */
     virtual inline void SetNativeParams(void * params) { (void) params; }
 
+    /**
+     * Enable or disable batched I/O.
+     *
+     *  With batched I/O, the endpoint reads all the datagrams that are ready with as few system calls as possible,
+     *  and queues the datagrams it is asked to send until the current event has been handled, so that they go out
+     *  together. SendMsg() then only reports errors found while queueing a datagram; errors from actually sending it
+     *  are logged.
+     *
+     * @retval  CHIP_NO_ERROR                 success.
+     * @retval  CHIP_ERROR_NOT_IMPLEMENTED    batched I/O is not available on this platform.
+     * @retval  CHIP_ERROR_NO_MEMORY          insufficient memory for the batches.
+     */
+    virtual CHIP_ERROR SetBatchedIO(bool enable) { return enable ? CHIP_ERROR_NOT_IMPLEMENTED : CHIP_NO_ERROR; }
+
+    /**
+     * Receive datagrams on worker threads.
+     *
+     *  Once the endpoint is listening, each of \c count threads reads datagrams from its own socket, bound with
+     *  SO_REUSEPORT to the same address and port as the endpoint so that the kernel spreads the peers among them,
+     *  and runs \c process on each datagram. The datagrams are then handed to \c onReceived on the Matter thread,
+     *  in place of the \c OnMessageReceived given to Listen(), in the order each worker received them.
+     *
+     *  Must be called before Listen(), on an endpoint to be bound with Bind(). Datagrams are still sent from the
+     *  endpoint's own socket, and only that socket joins multicast groups.
+     *
+     * @retval  CHIP_NO_ERROR                 success.
+     * @retval  CHIP_ERROR_NOT_IMPLEMENTED    receive workers are not available on this platform.
+     * @retval  CHIP_ERROR_INVALID_ARGUMENT   \c count exceeds INET_CONFIG_UDP_RECEIVE_WORKERS, or a function is missing.
+     * @retval  CHIP_ERROR_INCORRECT_STATE    the endpoint is already listening.
+     * @retval  CHIP_ERROR_NO_MEMORY          insufficient memory for the workers.
+     */
+    virtual CHIP_ERROR SetReceiveWorkers(uint8_t count, ReceiveWorkerFunct process, OnWorkerMessageReceivedFunct onReceived)
+    {
+        return count > 0 ? CHIP_ERROR_NOT_IMPLEMENTED : CHIP_NO_ERROR;
+    }
+
     inline bool operator==(const UDPEndPointHandle & other) const { return other.IsReferencing(this); }
     inline bool operator!=(const UDPEndPointHandle & other) const { return !other.IsReferencing(this); }
 
@@ -26,6 +26,7 @@
 #define __APPLE_USE_RFC_3542
 #include <inet/UDPEndPointImplSockets.h>
 
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -47,6 +48,13 @@
 #include <unistd.h>
 #include <utility>
 
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+#include <atomic>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
 // SOCK_CLOEXEC not defined on all platforms, e.g. iOS/macOS:
 #ifndef SOCK_CLOEXEC
 #define SOCK_CLOEXEC 0
@@ -87,6 +95,113 @@ namespace Inet {
 
 namespace {
 
+// Open a UDP socket with the options shared by the sockets of all endpoints.
+CHIP_ERROR OpenSocket(IPAddressType addressType, int & socket)
+{
+    constexpr int type     = (SOCK_DGRAM | SOCK_CLOEXEC);
+    constexpr int protocol = 0;
+
+    int family = PF_UNSPEC;
+
+    switch (addressType)
+    {
+    case IPAddressType::kIPv6:
+        family = PF_INET6;
+        break;
+
+#if INET_CONFIG_ENABLE_IPV4
+    case IPAddressType::kIPv4:
+        family = PF_INET;
+        break;
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    default:
+        return INET_ERROR_WRONG_ADDRESS_TYPE;
+    }
+
+    socket = ::socket(family, type, protocol);
+    if (socket == -1)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    // NOTE WELL: the errors returned by setsockopt() here are not
+    // returned as Inet layer CHIP_ERROR_POSIX(errno)
+    // codes because they are normally expected to fail on some
+    // platforms where the socket option code is defined in the
+    // header files but not [yet] implemented. Certainly, there is
+    // room to improve this by connecting the build configuration
+    // logic up to check for implementations of these options and
+    // to provide appropriate HAVE_xxxxx definitions accordingly.
+
+    constexpr int one = 1;
+    int res           = setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    static_cast<void>(res);
+
+#ifdef SO_REUSEPORT
+    res = setsockopt(socket, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+    if (res != 0)
+    {
+        ChipLogError(Inet, "SO_REUSEPORT failed: %d", errno);
+    }
+#endif // defined(SO_REUSEPORT)
+
+    // If creating an IPv6 socket, tell the kernel that it will be
+    // IPv6 only.  This makes it posible to bind two sockets to
+    // the same port, one for IPv4 and one for IPv6.
+
+#ifdef IPV6_V6ONLY
+    if (addressType == IPAddressType::kIPv6)
+    {
+        res = setsockopt(socket, IPPROTO_IPV6, IPV6_V6ONLY, &one, sizeof(one));
+        if (res != 0)
+        {
+            ChipLogError(Inet, "IPV6_V6ONLY failed: %d", errno);
+        }
+    }
+#endif // defined(IPV6_V6ONLY)
+
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+    if (addressType == IPAddressType::kIPv4)
+    {
+        res = setsockopt(socket, IPPROTO_IP, IP_PKTINFO, &one, sizeof(one));
+        if (res != 0)
+        {
+            ChipLogError(Inet, "IP_PKTINFO failed: %d", errno);
+        }
+    }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_RECVPKTINFO
+    if (addressType == IPAddressType::kIPv6)
+    {
+        res = setsockopt(socket, IPPROTO_IPV6, IPV6_RECVPKTINFO, &one, sizeof(one));
+        if (res != 0)
+        {
+            ChipLogError(Inet, "IPV6_PKTINFO failed: %d", errno);
+        }
+    }
+#endif // defined(IPV6_RECVPKTINFO)
+
+    // On systems that support it, disable the delivery of SIGPIPE
+    // signals when writing to a closed socket.  This is mostly
+    // needed on iOS which has the peculiar habit of sending
+    // SIGPIPEs on unconnected UDP sockets.
+#ifdef SO_NOSIGPIPE
+    {
+        res = setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+        if (res != 0)
+        {
+            ChipLogError(Inet, "SO_NOSIGPIPE failed: %d", errno);
+        }
+    }
+#endif // defined(SO_NOSIGPIPE)
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR IPv6Bind(int socket, const IPAddress & address, uint16_t port, InterfaceId interface)
 {
     struct sockaddr_in6 sa;
@@ -173,6 +288,148 @@ CHIP_ERROR IPv4Bind(int socket, const IPAddress & address, uint16_t port)
 UDPEndPointImplSockets::MulticastGroupHandler UDPEndPointImplSockets::sMulticastGroupHandler;
 #endif // CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
+struct UDPEndPointImplSockets::BatchedIO
+{
+    static constexpr unsigned kSize = INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE;
+
+    // Large enough for an IP_PKTINFO or IPV6_PKTINFO control message.
+    static constexpr size_t kControlSize = 128;
+
+    struct Batch
+    {
+        struct mmsghdr mHeaders[kSize];
+        struct iovec mIOVs[kSize];
+        SockAddr mPeers[kSize];
+        alignas(struct cmsghdr) uint8_t mControl[kSize][kControlSize];
+        System::PacketBufferHandle mBuffers[kSize];
+    };
+
+    Batch mReceive;
+    Batch mSend;
+    unsigned mPendingSends = 0;
+    bool mEnabled          = false;
+    bool mFlushScheduled   = false;
+};
+
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
+struct UDPEndPointImplSockets::ReceiveWorkers
+{
+    static constexpr uint32_t kQueueSize = INET_CONFIG_UDP_RECEIVE_WORKER_QUEUE_SIZE;
+
+    // How long a worker that cannot queue any more datagrams waits before trying again.
+    static constexpr int kStalledRetryMs = 1;
+
+    struct Message
+    {
+        System::PacketBufferHandle mBuffer;
+        IPPacketInfo mPacketInfo;
+        uint32_t mResult = 0;
+    };
+
+    struct Worker
+    {
+        static void * Main(void * worker);
+        void Run();
+        bool ReadMessages();
+
+        UDPEndPointImplSockets * mEndPoint = nullptr;
+        pthread_t mThread;
+        bool mThreadStarted = false;
+        // The endpoint's own socket for the first worker, and one of its own for each other worker.
+        int mSocket = kInvalidSocketFd;
+
+        // Messages are queued by the worker and taken by the Matter thread, each only moving its own index.
+        Message mQueue[kQueueSize];
+        std::atomic<uint32_t> mHead{ 0 };
+        std::atomic<uint32_t> mTail{ 0 };
+    };
+
+    ReceiveWorkerFunct mProcess              = nullptr;
+    OnWorkerMessageReceivedFunct mOnReceived = nullptr;
+    uint8_t mCount                           = 0;
+    bool mRunning                            = false;
+
+    // Signalled to make the workers return.
+    int mStopFd = -1;
+    // Signalled by the workers when they queue messages. The endpoint watches it in place of its socket, which the
+    // first worker reads.
+    int mNotifyFd = -1;
+    std::atomic<bool> mNotifyPending{ false };
+
+    Worker mWorkers[INET_CONFIG_UDP_RECEIVE_WORKERS];
+};
+
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
+UDPEndPointImplSockets::~UDPEndPointImplSockets()
+{
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    Platform::Delete(mBatchedIO);
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    Platform::Delete(mReceiveWorkers);
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+}
+
+CHIP_ERROR UDPEndPointImplSockets::SetBatchedIO(bool enable)
+{
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    if (enable && mBatchedIO == nullptr)
+    {
+        mBatchedIO = Platform::New<BatchedIO>();
+        VerifyOrReturnError(mBatchedIO != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    if (mBatchedIO != nullptr)
+    {
+        // Send what is already queued first, so that direct sends cannot overtake it.
+        if (!enable)
+        {
+            FlushSendQueue();
+        }
+        mBatchedIO->mEnabled = enable;
+    }
+    return CHIP_NO_ERROR;
+#else
+    return enable ? CHIP_ERROR_NOT_IMPLEMENTED : CHIP_NO_ERROR;
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+}
+
+CHIP_ERROR UDPEndPointImplSockets::SetReceiveWorkers(uint8_t count, ReceiveWorkerFunct process,
+                                                     OnWorkerMessageReceivedFunct onReceived)
+{
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    VerifyOrReturnError(mState == State::kReady || mState == State::kBound, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(count <= INET_CONFIG_UDP_RECEIVE_WORKERS, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (count == 0)
+    {
+        Platform::Delete(mReceiveWorkers);
+        mReceiveWorkers = nullptr;
+        return CHIP_NO_ERROR;
+    }
+
+    VerifyOrReturnError(process != nullptr && onReceived != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    if (mReceiveWorkers == nullptr)
+    {
+        mReceiveWorkers = Platform::New<ReceiveWorkers>();
+        VerifyOrReturnError(mReceiveWorkers != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    mReceiveWorkers->mCount      = count;
+    mReceiveWorkers->mProcess    = process;
+    mReceiveWorkers->mOnReceived = onReceived;
+    return CHIP_NO_ERROR;
+#else
+    return count > 0 ? CHIP_ERROR_NOT_IMPLEMENTED : CHIP_NO_ERROR;
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+}
+
 CHIP_ERROR UDPEndPointImplSockets::BindImpl(IPAddressType addressType, const IPAddress & addr, uint16_t port, InterfaceId interface)
 {
     // Make sure we have the appropriate type of socket.
@@ -195,6 +452,10 @@ CHIP_ERROR UDPEndPointImplSockets::BindImpl(IPAddressType addressType, const IPA
 
     mBoundPort   = port;
     mBoundIntfId = interface;
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    mBoundAddress   = addr;
+    mBoundToAddress = true;
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
 
     // If an ephemeral port was requested, retrieve the actual bound port.
     if (port == 0)
@@ -271,6 +532,13 @@ uint16_t UDPEndPointImplSockets::GetBoundPort() const
 
 CHIP_ERROR UDPEndPointImplSockets::ListenImpl()
 {
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    if (mReceiveWorkers != nullptr)
+    {
+        return StartReceiveWorkers();
+    }
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
     // Wait for ability to read on this endpoint.
     auto * layer = static_cast<System::LayerSockets *>(&GetSystemLayer());
     ReturnErrorOnFailure(layer->SetCallback(mWatch, HandlePendingIO, reinterpret_cast<intptr_t>(this)));
@@ -292,22 +560,49 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     // For now the entire message must fit within a single buffer.
     VerifyOrReturnError(!msg->HasChainedBuffer(), CHIP_ERROR_MESSAGE_TOO_LONG);
 
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    if (mBatchedIO != nullptr && mBatchedIO->mEnabled)
+    {
+        return QueueSend(aPktInfo, std::move(msg));
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
     struct iovec msgIOV;
     msgIOV.iov_base = msg->Start();
     msgIOV.iov_len  = msg->DataLength();
 
-#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
     uint8_t controlData[256];
-    memset(controlData, 0, sizeof(controlData));
-#endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-
     struct msghdr msgHeader;
     memset(&msgHeader, 0, sizeof(msgHeader));
     msgHeader.msg_iov    = &msgIOV;
     msgHeader.msg_iovlen = 1;
 
-    // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
     SockAddr peerSockAddr;
+    ReturnErrorOnFailure(PrepareSendHeader(aPktInfo, peerSockAddr, msgHeader, controlData, sizeof(controlData)));
+
+    // Send IP packet.
+    // NOLINTNEXTLINE(clang-analyzer-unix.StdCLibraryFunctions): GetSocket calls ensure mSocket is valid
+    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
+    if (lenSent == -1)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    size_t len = static_cast<size_t>(lenSent);
+
+    if (len != msg->DataLength())
+    {
+        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR UDPEndPointImplSockets::PrepareSendHeader(const IPPacketInfo * aPktInfo, SockAddr & peerSockAddr,
+                                                     struct msghdr & msgHeader, uint8_t * controlData, size_t controlSize)
+{
+    memset(controlData, 0, controlSize);
+
+    // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
     msgHeader.msg_name = &peerSockAddr;
     if (mAddrType == IPAddressType::kIPv6)
@@ -351,7 +646,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
         msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_controllen = static_cast<decltype(msgHeader.msg_controllen)>(controlSize);
 
         struct cmsghdr * controlHdr      = CMSG_FIRSTHDR(&msgHeader);
         InterfaceId::PlatformType intfId = intf.GetPlatformInterface();
@@ -409,20 +704,6 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     }
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
-    // Send IP packet.
-    // NOLINTNEXTLINE(clang-analyzer-unix.StdCLibraryFunctions): GetSocket calls ensure mSocket is valid
-    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
-    if (lenSent == -1)
-    {
-        return CHIP_ERROR_POSIX(errno);
-    }
-
-    size_t len = static_cast<size_t>(lenSent);
-
-    if (len != msg->DataLength())
-    {
-        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
-    }
     return CHIP_NO_ERROR;
 }
 
@@ -430,7 +711,22 @@ void UDPEndPointImplSockets::CloseImpl()
 {
     if (mSocket != kInvalidSocketFd)
     {
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+        if (mBatchedIO != nullptr)
+        {
+            // Send what was queued before the socket goes away, and let go of the receive buffers.
+            FlushSendQueue();
+            for (auto & buffer : mBatchedIO->mReceive.mBuffers)
+            {
+                buffer = nullptr;
+            }
+        }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
         TEMPORARY_RETURN_IGNORED static_cast<System::LayerSockets *>(&GetSystemLayer())->StopWatchingSocket(&mWatch);
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+        // The first worker reads the socket, so it has to be stopped before the socket is closed.
+        StopReceiveWorkers();
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
         close(mSocket);
         mSocket = kInvalidSocketFd;
     }
@@ -440,32 +736,7 @@ CHIP_ERROR UDPEndPointImplSockets::GetSocket(IPAddressType addressType)
 {
     if (mSocket == kInvalidSocketFd)
     {
-        constexpr int type     = (SOCK_DGRAM | SOCK_CLOEXEC);
-        constexpr int protocol = 0;
-
-        int family = PF_UNSPEC;
-
-        switch (addressType)
-        {
-        case IPAddressType::kIPv6:
-            family = PF_INET6;
-            break;
-
-#if INET_CONFIG_ENABLE_IPV4
-        case IPAddressType::kIPv4:
-            family = PF_INET;
-            break;
-#endif // INET_CONFIG_ENABLE_IPV4
-
-        default:
-            return INET_ERROR_WRONG_ADDRESS_TYPE;
-        }
-
-        mSocket = ::socket(family, type, protocol);
-        if (mSocket == -1)
-        {
-            return CHIP_ERROR_POSIX(errno);
-        }
+        ReturnErrorOnFailure(OpenSocket(addressType, mSocket));
         CHIP_ERROR err = static_cast<System::LayerSockets *>(&GetSystemLayer())->StartWatchingSocket(mSocket, &mWatch);
         if (err != CHIP_NO_ERROR)
         {
@@ -476,80 +747,6 @@ CHIP_ERROR UDPEndPointImplSockets::GetSocket(IPAddressType addressType)
         }
 
         mAddrType = addressType;
-
-        // NOTE WELL: the errors returned by setsockopt() here are not
-        // returned as Inet layer CHIP_ERROR_POSIX(errno)
-        // codes because they are normally expected to fail on some
-        // platforms where the socket option code is defined in the
-        // header files but not [yet] implemented. Certainly, there is
-        // room to improve this by connecting the build configuration
-        // logic up to check for implementations of these options and
-        // to provide appropriate HAVE_xxxxx definitions accordingly.
-
-        constexpr int one = 1;
-        int res           = setsockopt(mSocket, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
-        static_cast<void>(res);
-
-#ifdef SO_REUSEPORT
-        res = setsockopt(mSocket, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
-        if (res != 0)
-        {
-            ChipLogError(Inet, "SO_REUSEPORT failed: %d", errno);
-        }
-#endif // defined(SO_REUSEPORT)
-
-        // If creating an IPv6 socket, tell the kernel that it will be
-        // IPv6 only.  This makes it posible to bind two sockets to
-        // the same port, one for IPv4 and one for IPv6.
-
-#ifdef IPV6_V6ONLY
-        if (addressType == IPAddressType::kIPv6)
-        {
-            res = setsockopt(mSocket, IPPROTO_IPV6, IPV6_V6ONLY, &one, sizeof(one));
-            if (res != 0)
-            {
-                ChipLogError(Inet, "IPV6_V6ONLY failed: %d", errno);
-            }
-        }
-#endif // defined(IPV6_V6ONLY)
-
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-        if (addressType == IPAddressType::kIPv4)
-        {
-            res = setsockopt(mSocket, IPPROTO_IP, IP_PKTINFO, &one, sizeof(one));
-            if (res != 0)
-            {
-                ChipLogError(Inet, "IP_PKTINFO failed: %d", errno);
-            }
-        }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_RECVPKTINFO
-        if (addressType == IPAddressType::kIPv6)
-        {
-            res = setsockopt(mSocket, IPPROTO_IPV6, IPV6_RECVPKTINFO, &one, sizeof(one));
-            if (res != 0)
-            {
-                ChipLogError(Inet, "IPV6_PKTINFO failed: %d", errno);
-            }
-        }
-#endif // defined(IPV6_RECVPKTINFO)
-
-        // On systems that support it, disable the delivery of SIGPIPE
-        // signals when writing to a closed socket.  This is mostly
-        // needed on iOS which has the peculiar habit of sending
-        // SIGPIPEs on unconnected UDP sockets.
-#ifdef SO_NOSIGPIPE
-        {
-            res = setsockopt(mSocket, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
-            if (res != 0)
-            {
-                ChipLogError(Inet, "SO_NOSIGPIPE failed: %d", errno);
-            }
-        }
-#endif // defined(SO_NOSIGPIPE)
     }
     else if (mAddrType != addressType)
     {
@@ -576,14 +773,19 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
 
     // Prevent the endpoint from being freed while in the middle of a callback.
     UDPEndPointHandle ref(this);
+
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    if (mBatchedIO != nullptr && mBatchedIO->mEnabled)
+    {
+        HandleBatchedRead();
+        return;
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
 
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort  = mBoundPort;
-    lPacketInfo.Interface = mBoundIntfId;
-
     lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
 
     if (!lBuffer.IsNull())
@@ -620,83 +822,530 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         else
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+            lStatus = DecodePacketInfo(msgHeader, lPacketInfo);
+        }
+    }
+    else
+    {
+        lStatus = CHIP_ERROR_NO_MEMORY;
+    }
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
+    if (lStatus == CHIP_NO_ERROR)
+    {
+        lBuffer.RightSize();
+        OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+    }
+    else
+    {
+        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+    }
+}
+
+CHIP_ERROR UDPEndPointImplSockets::DecodePacketInfo(struct msghdr & msgHeader, IPPacketInfo & packetInfo)
+{
+    const auto * peerSockAddr = static_cast<const SockAddr *>(msgHeader.msg_name);
+
+    packetInfo.Clear();
+    packetInfo.DestPort  = mBoundPort;
+    packetInfo.Interface = mBoundIntfId;
+
+    if (peerSockAddr->any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr->in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr->in6.sin6_port);
+    }
 #if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
+    else if (peerSockAddr->any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr->in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr->in.sin_port);
+    }
 #endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
 
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
 #if INET_CONFIG_ENABLE_IPV4
 #ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
 #endif // defined(IP_PKTINFO)
 #endif // INET_CONFIG_ENABLE_IPV4
 
 #ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
 #endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
+void UDPEndPointImplSockets::HandleBatchedRead()
+{
+    BatchedIO::Batch & batch = mBatchedIO->mReceive;
+
+    // Buffers that were not filled by the previous read are kept for the next one, so only the ones handed to the
+    // application need to be replaced.
+    unsigned count = 0;
+    for (; count < BatchedIO::kSize; count++)
+    {
+        System::PacketBufferHandle & buffer = batch.mBuffers[count];
+        if (buffer.IsNull())
+        {
+            buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (buffer.IsNull())
+            {
+                break;
             }
         }
+
+        memset(&batch.mHeaders[count], 0, sizeof(batch.mHeaders[count]));
+        memset(&batch.mPeers[count], 0, sizeof(batch.mPeers[count]));
+        batch.mIOVs[count].iov_base = buffer->Start();
+        batch.mIOVs[count].iov_len  = buffer->AvailableDataLength();
+
+        struct msghdr & msgHeader = batch.mHeaders[count].msg_hdr;
+        msgHeader.msg_name        = &batch.mPeers[count];
+        msgHeader.msg_namelen     = sizeof(batch.mPeers[count]);
+        msgHeader.msg_iov         = &batch.mIOVs[count];
+        msgHeader.msg_iovlen      = 1;
+        msgHeader.msg_control     = batch.mControl[count];
+        msgHeader.msg_controllen  = sizeof(batch.mControl[count]);
     }
-    else
+
+    if (count == 0)
     {
-        lStatus = CHIP_ERROR_NO_MEMORY;
+        if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, CHIP_ERROR_NO_MEMORY, nullptr);
+        }
+        return;
     }
 
-    if (lStatus == CHIP_NO_ERROR)
+    const int received = recvmmsg(mSocket, batch.mHeaders, count, MSG_DONTWAIT, nullptr);
+    if (received == -1)
     {
-        lBuffer.RightSize();
-        OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        CHIP_ERROR status = CHIP_ERROR_POSIX(errno);
+        if (OnReceiveError != nullptr && status != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, status, nullptr);
+        }
+        return;
     }
-    else
+
+    for (int i = 0; i < received; i++)
     {
-        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        // Take every received buffer out of the batch, even if the endpoint was closed by an earlier callback and
+        // the message is dropped, so that the buffer is not mistaken for an empty one by the next read.
+        System::PacketBufferHandle buffer = std::move(batch.mBuffers[i]);
+        if (buffer.IsNull() || mState != State::kListening || OnMessageReceived == nullptr)
         {
-            OnReceiveError(this, lStatus, nullptr);
+            continue;
+        }
+
+        IPPacketInfo packetInfo;
+        CHIP_ERROR status = CHIP_NO_ERROR;
+        if (buffer->AvailableDataLength() < batch.mHeaders[i].msg_len)
+        {
+            status = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            buffer->SetDataLength(static_cast<uint16_t>(batch.mHeaders[i].msg_len));
+            status = DecodePacketInfo(batch.mHeaders[i].msg_hdr, packetInfo);
+        }
+
+        if (status == CHIP_NO_ERROR)
+        {
+            buffer.RightSize();
+            OnMessageReceived(this, std::move(buffer), &packetInfo);
+        }
+        else if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, status, nullptr);
+        }
+    }
+}
+
+CHIP_ERROR UDPEndPointImplSockets::QueueSend(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
+{
+    BatchedIO & batchedIO = *mBatchedIO;
+    if (batchedIO.mPendingSends == BatchedIO::kSize)
+    {
+        FlushSendQueue();
+    }
+
+    BatchedIO::Batch & batch = batchedIO.mSend;
+    const unsigned index     = batchedIO.mPendingSends;
+
+    memset(&batch.mHeaders[index], 0, sizeof(batch.mHeaders[index]));
+    batch.mIOVs[index].iov_base = msg->Start();
+    batch.mIOVs[index].iov_len  = msg->DataLength();
+
+    struct msghdr & msgHeader = batch.mHeaders[index].msg_hdr;
+    msgHeader.msg_iov         = &batch.mIOVs[index];
+    msgHeader.msg_iovlen      = 1;
+    ReturnErrorOnFailure(
+        PrepareSendHeader(aPktInfo, batch.mPeers[index], msgHeader, batch.mControl[index], sizeof(batch.mControl[index])));
+
+    batch.mBuffers[index] = std::move(msg);
+    batchedIO.mPendingSends++;
+
+    if (!batchedIO.mFlushScheduled)
+    {
+        // The scheduled flush holds a reference so that the endpoint outlives it.
+        Ref();
+        if (GetSystemLayer().ScheduleWork(FlushSendQueue, this) == CHIP_NO_ERROR)
+        {
+            batchedIO.mFlushScheduled = true;
+        }
+        else
+        {
+            Unref();
+            FlushSendQueue();
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void UDPEndPointImplSockets::FlushSendQueue()
+{
+    BatchedIO::Batch & batch = mBatchedIO->mSend;
+    const unsigned pending   = mBatchedIO->mPendingSends;
+
+    unsigned sent = 0;
+    while (sent < pending && mSocket != kInvalidSocketFd)
+    {
+        const int result = sendmmsg(mSocket, &batch.mHeaders[sent], pending - sent, 0);
+        if (result <= 0)
+        {
+            // sendmmsg() stops at the first message that cannot be sent: drop that one and carry on with the rest.
+            ChipLogError(Inet, "Failed to send queued UDP message: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+            sent++;
+            continue;
+        }
+        sent += static_cast<unsigned>(result);
+    }
+
+    for (unsigned i = 0; i < pending; i++)
+    {
+        batch.mBuffers[i] = nullptr;
+    }
+    mBatchedIO->mPendingSends = 0;
+}
+
+// static
+void UDPEndPointImplSockets::FlushSendQueue(System::Layer * aLayer, void * aAppState)
+{
+    auto * endPoint = static_cast<UDPEndPointImplSockets *>(aAppState);
+
+    endPoint->mBatchedIO->mFlushScheduled = false;
+    endPoint->FlushSendQueue();
+    endPoint->Unref();
+}
+
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
+CHIP_ERROR UDPEndPointImplSockets::StartReceiveWorkers()
+{
+    ReceiveWorkers & workers = *mReceiveWorkers;
+    auto * layer             = static_cast<System::LayerSockets *>(&GetSystemLayer());
+    bool watchMoved          = false;
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+
+    // The other workers need the address the endpoint was bound to, which BindInterface() does not give.
+    VerifyOrReturnError(mBoundToAddress, CHIP_ERROR_INCORRECT_STATE);
+
+    workers.mStopFd   = eventfd(0, EFD_CLOEXEC);
+    workers.mNotifyFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    VerifyOrExit(workers.mStopFd != -1 && workers.mNotifyFd != -1, err = CHIP_ERROR_POSIX(errno));
+
+    workers.mWorkers[0].mSocket = mSocket;
+    for (uint8_t i = 1; i < workers.mCount; i++)
+    {
+        int & socket = workers.mWorkers[i].mSocket;
+        SuccessOrExit(err = OpenSocket(mAddrType, socket));
+
+        // Only the endpoint's own socket joins multicast groups, so keep the others from receiving copies of the
+        // datagrams sent to the groups that it joined.
+        [[maybe_unused]] constexpr int zero = 0;
+#if INET_CONFIG_ENABLE_IPV4 && defined(IP_MULTICAST_ALL)
+        if (mAddrType == IPAddressType::kIPv4)
+        {
+            setsockopt(socket, IPPROTO_IP, IP_MULTICAST_ALL, &zero, sizeof(zero));
+        }
+#endif // INET_CONFIG_ENABLE_IPV4 && defined(IP_MULTICAST_ALL)
+#ifdef IPV6_MULTICAST_ALL
+        if (mAddrType == IPAddressType::kIPv6)
+        {
+            setsockopt(socket, IPPROTO_IPV6, IPV6_MULTICAST_ALL, &zero, sizeof(zero));
+        }
+#endif // defined(IPV6_MULTICAST_ALL)
+
+        if (mAddrType == IPAddressType::kIPv6)
+        {
+            SuccessOrExit(err = IPv6Bind(socket, mBoundAddress, mBoundPort, mBoundIntfId));
+        }
+#if INET_CONFIG_ENABLE_IPV4
+        else
+        {
+            SuccessOrExit(err = IPv4Bind(socket, mBoundAddress, mBoundPort));
+        }
+#endif // INET_CONFIG_ENABLE_IPV4
+    }
+
+    SuccessOrExit(err = layer->StopWatchingSocket(&mWatch));
+    watchMoved = true;
+    SuccessOrExit(err = layer->StartWatchingSocket(workers.mNotifyFd, &mWatch));
+    SuccessOrExit(err = layer->SetCallback(mWatch, HandleWorkerMessages, reinterpret_cast<intptr_t>(this)));
+    SuccessOrExit(err = layer->RequestCallbackOnPendingRead(mWatch));
+
+    workers.mRunning = true;
+    for (uint8_t i = 0; i < workers.mCount; i++)
+    {
+        ReceiveWorkers::Worker & worker = workers.mWorkers[i];
+        worker.mEndPoint                = this;
+
+        const int result = pthread_create(&worker.mThread, nullptr, ReceiveWorkers::Worker::Main, &worker);
+        VerifyOrExit(result == 0, err = CHIP_ERROR_POSIX(result));
+        worker.mThreadStarted = true;
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to start UDP receive workers: %" CHIP_ERROR_FORMAT, err.Format());
+        if (watchMoved)
+        {
+            TEMPORARY_RETURN_IGNORED layer->StopWatchingSocket(&mWatch);
+        }
+        StopReceiveWorkers();
+    }
+    return err;
+}
+
+void UDPEndPointImplSockets::StopReceiveWorkers()
+{
+    VerifyOrReturn(mReceiveWorkers != nullptr);
+    ReceiveWorkers & workers = *mReceiveWorkers;
+
+    if (workers.mStopFd != -1)
+    {
+        eventfd_write(workers.mStopFd, 1);
+    }
+
+    for (uint8_t i = 0; i < workers.mCount; i++)
+    {
+        ReceiveWorkers::Worker & worker = workers.mWorkers[i];
+        if (worker.mThreadStarted)
+        {
+            pthread_join(worker.mThread, nullptr);
+            worker.mThreadStarted = false;
+        }
+        if (i > 0 && worker.mSocket != kInvalidSocketFd)
+        {
+            close(worker.mSocket);
+        }
+        worker.mSocket = kInvalidSocketFd;
+
+        // Drop the messages that the Matter thread did not get to.
+        for (auto & message : worker.mQueue)
+        {
+            message.mBuffer = nullptr;
+        }
+        worker.mHead.store(0);
+        worker.mTail.store(0);
+    }
+
+    if (workers.mStopFd != -1)
+    {
+        close(workers.mStopFd);
+        workers.mStopFd = -1;
+    }
+    if (workers.mNotifyFd != -1)
+    {
+        close(workers.mNotifyFd);
+        workers.mNotifyFd = -1;
+    }
+    workers.mNotifyPending.store(false);
+    workers.mRunning = false;
+}
+
+// static
+void * UDPEndPointImplSockets::ReceiveWorkers::Worker::Main(void * worker)
+{
+    static_cast<Worker *>(worker)->Run();
+    return nullptr;
+}
+
+void UDPEndPointImplSockets::ReceiveWorkers::Worker::Run()
+{
+    const int stopFd = mEndPoint->mReceiveWorkers->mStopFd;
+    bool stalled     = false;
+
+    while (true)
+    {
+        // While stalled on a full queue or a failed allocation, leave the datagrams in the socket for a while.
+        struct pollfd fds[2] = { { stopFd, POLLIN, 0 }, { mSocket, POLLIN, 0 } };
+        if (poll(fds, stalled ? 1 : 2, stalled ? kStalledRetryMs : -1) == -1 && errno != EINTR)
+        {
+            ChipLogError(Inet, "UDP receive worker failed to poll: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+            return;
+        }
+        if (fds[0].revents != 0)
+        {
+            return;
+        }
+
+        stalled = ReadMessages();
+    }
+}
+
+bool UDPEndPointImplSockets::ReceiveWorkers::Worker::ReadMessages()
+{
+    ReceiveWorkers & workers = *mEndPoint->mReceiveWorkers;
+
+    while (true)
+    {
+        const uint32_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == kQueueSize)
+        {
+            return true;
+        }
+
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (buffer.IsNull())
+        {
+            return true;
+        }
+
+        struct iovec msgIOV;
+        SockAddr peerSockAddr;
+        uint8_t controlData[256];
+        struct msghdr msgHeader;
+
+        msgIOV.iov_base = buffer->Start();
+        msgIOV.iov_len  = buffer->AvailableDataLength();
+
+        memset(&peerSockAddr, 0, sizeof(peerSockAddr));
+        memset(&msgHeader, 0, sizeof(msgHeader));
+
+        msgHeader.msg_name       = &peerSockAddr;
+        msgHeader.msg_namelen    = sizeof(peerSockAddr);
+        msgHeader.msg_iov        = &msgIOV;
+        msgHeader.msg_iovlen     = 1;
+        msgHeader.msg_control    = controlData;
+        msgHeader.msg_controllen = sizeof(controlData);
+
+        const ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+        if (rcvLen == -1)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                ChipLogError(Inet, "Failed to receive UDP message: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+            }
+            return false;
+        }
+
+        IPPacketInfo packetInfo;
+        if (buffer->AvailableDataLength() < static_cast<size_t>(rcvLen) ||
+            mEndPoint->DecodePacketInfo(msgHeader, packetInfo) != CHIP_NO_ERROR)
+        {
+            continue;
+        }
+        buffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+        buffer.RightSize();
+
+        const uint32_t result = workers.mProcess(mEndPoint, buffer, &packetInfo);
+        if (buffer.IsNull())
+        {
+            continue;
+        }
+
+        Message & message   = mQueue[tail % kQueueSize];
+        message.mBuffer     = std::move(buffer);
+        message.mPacketInfo = packetInfo;
+        message.mResult     = result;
+        mTail.store(tail + 1, std::memory_order_release);
+
+        // The Matter thread clears the flag before it takes the messages, so the last message queued is never missed.
+        if (!workers.mNotifyPending.exchange(true))
+        {
+            eventfd_write(workers.mNotifyFd, 1);
         }
     }
 }
 
+// static
+void UDPEndPointImplSockets::HandleWorkerMessages(System::SocketEvents events, intptr_t data)
+{
+    auto * endPoint = reinterpret_cast<UDPEndPointImplSockets *>(data);
+    VerifyOrReturn(endPoint != nullptr);
+    endPoint->HandleWorkerMessages();
+}
+
+void UDPEndPointImplSockets::HandleWorkerMessages()
+{
+    ReceiveWorkers & workers = *mReceiveWorkers;
+    VerifyOrReturn(workers.mRunning);
+
+    eventfd_t count;
+    eventfd_read(workers.mNotifyFd, &count);
+    workers.mNotifyPending.store(false);
+
+    // Prevent the endpoint from being freed while in the middle of a callback.
+    UDPEndPointHandle ref(this);
+
+    // Only take the messages that are queued by now, and leave the ones queued meanwhile to the next notification.
+    for (uint8_t i = 0; i < workers.mCount && workers.mRunning; i++)
+    {
+        ReceiveWorkers::Worker & worker = workers.mWorkers[i];
+        const uint32_t tail             = worker.mTail.load(std::memory_order_acquire);
+
+        // A callback may close the endpoint, which stops the workers and empties the queues.
+        for (uint32_t head = worker.mHead.load(std::memory_order_relaxed); workers.mRunning && head != tail; head++)
+        {
+            ReceiveWorkers::Message & message = worker.mQueue[head % ReceiveWorkers::kQueueSize];
+            System::PacketBufferHandle buffer = std::move(message.mBuffer);
+            const IPPacketInfo packetInfo     = message.mPacketInfo;
+            const uint32_t result             = message.mResult;
+            worker.mHead.store(head + 1, std::memory_order_release);
+
+            if (mState == State::kListening)
+            {
+                workers.mOnReceived(this, std::move(buffer), &packetInfo, result);
+            }
+        }
+    }
+}
+
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
 #ifdef IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
 {
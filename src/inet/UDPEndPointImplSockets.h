@@ -35,11 +35,14 @@ public:
     UDPEndPointImplSockets(EndPointManager<UDPEndPoint> & endPointManager) :
         UDPEndPoint(endPointManager), mBoundIntfId(InterfaceId::Null())
     {}
+    ~UDPEndPointImplSockets() override;
 
     // UDPEndPoint overrides.
     CHIP_ERROR SetMulticastLoopback(IPVersion aIPVersion, bool aLoopback) override;
     InterfaceId GetBoundInterface() const override;
     uint16_t GetBoundPort() const override;
+    CHIP_ERROR SetBatchedIO(bool enable) override;
+    CHIP_ERROR SetReceiveWorkers(uint8_t count, ReceiveWorkerFunct process, OnWorkerMessageReceivedFunct onReceived) override;
 
 private:
     // UDPEndPoint overrides.
@@ -56,10 +59,38 @@ private:
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+    CHIP_ERROR PrepareSendHeader(const IPPacketInfo * aPktInfo, SockAddr & peerSockAddr, struct msghdr & msgHeader,
+                                 uint8_t * controlData, size_t controlSize);
+    CHIP_ERROR DecodePacketInfo(struct msghdr & msgHeader, IPPacketInfo & packetInfo);
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    struct BatchedIO;
+
+    void HandleBatchedRead();
+    CHIP_ERROR QueueSend(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg);
+    void FlushSendQueue();
+    static void FlushSendQueue(System::Layer * aLayer, void * aAppState);
+
+    BatchedIO * mBatchedIO = nullptr;
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    struct ReceiveWorkers;
+
+    CHIP_ERROR StartReceiveWorkers();
+    void StopReceiveWorkers();
+    void HandleWorkerMessages();
+    static void HandleWorkerMessages(System::SocketEvents events, intptr_t data);
+
+    ReceiveWorkers * mReceiveWorkers = nullptr;
+    // The address given to Bind(), which the sockets of the receive workers are bound to as well.
+    IPAddress mBoundAddress;
+    bool mBoundToAddress = false;
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 public:
     enum class MulticastOperation
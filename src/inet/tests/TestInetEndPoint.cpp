@@ -378,6 +378,56 @@ TEST_F(TestInetEndPoint, TestInetEndPointInternal)
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 }
 
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+uint8_t receivedOrder[2];
+size_t receivedCount = 0;
+
+void HandleOrderedMessage(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    if (receivedCount < MATTER_ARRAY_SIZE(receivedOrder) && msg->DataLength() > 0)
+    {
+        receivedOrder[receivedCount] = msg->Start()[0];
+    }
+    receivedCount++;
+}
+
+// Turning batching off must not let a direct send overtake datagrams still waiting in the send queue.
+TEST_F(TestInetEndPoint, TestUDPBatchedIOSwitchKeepsOrder)
+{
+    IPAddress loopback;
+    ASSERT_TRUE(IPAddress::FromString("::1", loopback));
+
+    UDPEndPointHandle testUDPEP;
+    ASSERT_EQ(gUDP.NewEndPoint(testUDPEP), CHIP_NO_ERROR);
+    ASSERT_EQ(testUDPEP->Bind(IPAddressType::kIPv6, loopback, 0), CHIP_NO_ERROR);
+    ASSERT_EQ(testUDPEP->Listen(HandleOrderedMessage, nullptr), CHIP_NO_ERROR);
+    ASSERT_EQ(testUDPEP->SetBatchedIO(true), CHIP_NO_ERROR);
+
+    receivedCount = 0;
+    for (uint8_t i = 0; i < MATTER_ARRAY_SIZE(receivedOrder); i++)
+    {
+        if (i == 1)
+        {
+            // The first datagram is still queued for the deferred flush.
+            ASSERT_EQ(testUDPEP->SetBatchedIO(false), CHIP_NO_ERROR);
+        }
+        PacketBufferHandle msg = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        ASSERT_FALSE(msg.IsNull());
+        EXPECT_EQ(testUDPEP->SendTo(loopback, testUDPEP->GetBoundPort(), std::move(msg)), CHIP_NO_ERROR);
+    }
+
+    for (int i = 0; i < 100 && receivedCount < MATTER_ARRAY_SIZE(receivedOrder); i++)
+    {
+        ServiceEvents(10);
+    }
+
+    ASSERT_EQ(receivedCount, MATTER_ARRAY_SIZE(receivedOrder));
+    EXPECT_EQ(receivedOrder[0], 0);
+    EXPECT_EQ(receivedOrder[1], 1);
+    testUDPEP.Release();
+}
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 TEST_F(TestInetEndPoint, TestInetEndPointLimit)
@@ -304,6 +304,19 @@
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 16
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ * @def CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+ *
+ * @brief If enabled, the exchange manager keeps a hash index of its exchanges by exchange ID, so that finding the
+ * exchange of an incoming message does not scan every active exchange.
+ *
+ * This costs about 4 * CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS * (sizeof(void *) + sizeof(uint16_t)) bytes of RAM and is
+ * meant for controllers that keep many exchanges open at once.
+ */
+#ifndef CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+#define CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX 0
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+
 /**
  *  @def CHIP_CONFIG_MCSP_RECEIVE_TABLE_SIZE
  *
@@ -821,6 +834,19 @@
 #define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+ *
+ * @brief If enabled, the secure session table keeps hash indexes of its sessions by local session ID and by peer, so
+ * that finding the session of an incoming message, or the sessions to a given peer, does not scan the whole table.
+ *
+ * This costs about 4 * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE * (2 * sizeof(void *) + sizeof(ScopedNodeId)) bytes of RAM
+ * and is meant for controllers with large session pools.
+ */
+#ifndef CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+#define CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX 0
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
 /**
  *  @def CHIP_CONFIG_MAX_GROUP_DATA_PEERS
  *
@@ -906,6 +932,9 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+ *      * #CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+ *      * #CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE
+ *      * #CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_MAX_ENTRIES
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
@@ -983,6 +1012,38 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+ *
+ * @brief If enabled, the reporting engine keeps an index from concrete (endpoint, cluster) pairs to the read handlers
+ *        interested in them, so that marking an attribute dirty does not walk every path of every read handler.
+ *        Costs roughly (CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS)
+ *        * 16 bytes of RAM; mostly useful on devices with many subscriptions.
+ */
+#ifndef CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX
+#define CHIP_CONFIG_IM_READ_HANDLER_PATH_INDEX 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE
+ *
+ * @brief Size in bytes of the buffer in which the reporting engine keeps the attribute values it encoded during one run, so
+ *        that several read handlers reporting the same attribute to the same fabric share a single read and encoding. Values
+ *        that do not fit are read and encoded for every handler, as when this is 0, which disables the cache.
+ */
+#ifndef CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE
+#define CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_MAX_ENTRIES
+ *
+ * @brief Maximum number of attribute values held in the cache sized by #CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_SIZE.
+ */
+#ifndef CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_MAX_ENTRIES
+#define CHIP_CONFIG_IM_REPORT_ENCODE_CACHE_MAX_ENTRIES 32
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1239,6 +1300,60 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_TARGETS_PER_ENTRY 3
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX
+ *
+ * @brief If 1, AccessControl checks requests against a flattened copy of the access control list and remembers its
+ *        most recent decisions, instead of reading every entry through the delegate on each check.
+ *
+ * The index is rebuilt on the first check after any change made through AccessControl. Delegates must not change
+ * their entries behind AccessControl's back while this is enabled.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_ENTRIES
+ *
+ * @brief The number of access control entries, across all fabrics, that the index can hold. Larger lists are checked
+ *        through the delegate.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_ENTRIES
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_ENTRIES                                                                               \
+    (CHIP_CONFIG_MAX_FABRICS * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC)
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_SUBJECTS
+ *
+ * @brief The number of subjects, across all entries, that the access control index can hold.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_SUBJECTS
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_SUBJECTS                                                                              \
+    (CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_ENTRIES * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_SUBJECTS_PER_ENTRY)
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_TARGETS
+ *
+ * @brief The number of targets, across all entries, that the access control index can hold.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_TARGETS
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_TARGETS                                                                               \
+    (CHIP_CONFIG_ACCESS_CONTROL_INDEX_MAX_ENTRIES * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_TARGETS_PER_ENTRY)
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+ *
+ * @brief The number of access control list decisions remembered by the access control index, by subject, endpoint,
+ *        cluster and privilege. Consecutive checks of the attributes of one cluster share a decision.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE 16
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_ENTRY_STORAGE_POOL_SIZE
  *
@@ -1362,6 +1477,21 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_INDEX_RECENT_EVENTS
+ *
+ * @brief The number of most recent events of each event logging buffer
+ *   whose position in the buffer is remembered.
+ *
+ * A subscriber that is up to date only needs the events logged since its
+ * last report, so fetching events for it starts at the remembered position
+ * of the first such event instead of decoding the whole buffer. Each entry
+ * takes 16 bytes per buffer.
+ */
+#ifndef CHIP_CONFIG_EVENT_INDEX_RECENT_EVENTS
+#define CHIP_CONFIG_EVENT_INDEX_RECENT_EVENTS 8
+#endif
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1472,6 +1602,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+ *
+ * @brief Determines the maximum number of PTR, SRV, TXT, A and AAAA records
+ *        that minmdns keeps from received responses, for as long as their
+ *        TTL, to answer resolves and browses without waiting for the network.
+ *        Records that answered a resolve are queried again before they expire.
+ *
+ *        A value of 0 disables the record cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1957,6 +2101,37 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_BDX_LOG_TRANSFER_MAX_BLOCK_SIZE 1024
 #endif // CHIP_CONFIG_BDX_LOG_TRANSFER_MAX_BLOCK_SIZE
 
+/**
+ *  @def CHIP_CONFIG_BDX_WINDOW_SIZE
+ *
+ *  @brief
+ *    Maximum number of BlockQuery messages that the receiver of a windowed BDX transfer
+ *    keeps outstanding. A window of N blocks lets a transfer move N blocks per round trip
+ *    instead of one. Windowed transfers are only used on sessions that do not use MRP, such
+ *    as TCP sessions, since MRP allows a single unacknowledged message per exchange. The
+ *    responder accepts the smaller of this and the proposed window.
+ *
+ *    Setting this to 1 keeps windowed transfers lock-step.
+ *
+ */
+#ifndef CHIP_CONFIG_BDX_WINDOW_SIZE
+#define CHIP_CONFIG_BDX_WINDOW_SIZE 4
+#endif // CHIP_CONFIG_BDX_WINDOW_SIZE
+
+/**
+ *  @def CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP
+ *
+ *  @brief
+ *    If asserted (1), the default OTA requestor asks for a large payload (TCP) session to
+ *    download an image, so that the BDX transfer can use a window of
+ *    CHIP_CONFIG_BDX_WINDOW_SIZE blocks. It falls back to an MRP session if the TCP session
+ *    cannot be established. Requires INET_CONFIG_ENABLE_TCP_ENDPOINT.
+ *
+ */
+#ifndef CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP
+#define CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP 0
+#endif // CHIP_CONFIG_OTA_REQUESTOR_DOWNLOAD_OVER_TCP
+
 /**
  *  @def CHIP_CONFIG_TEST_GOOGLETEST
  *
@@ -1982,6 +2157,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MRP_ANALYTICS_ENABLED 0
 #endif // CHIP_CONFIG_MRP_ANALYTICS_ENABLED
 
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    Enables code for measuring the round-trip time of MRP messages on each session, and for deriving the
+ *    retransmission timeouts from it once ReliableMessageMgr::SetAdaptiveRetransTimeoutEnabled() is called.
+ *
+ * The purpose of this macro is to save on flash and RAM for devices that only use the static MRP intervals.
+ */
+
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+#define CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT 0
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 /**
  *  @def CHIP_CONFIG_USE_ENDPOINT_UNIQUE_ID
  *
@@ -2094,6 +2283,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_NUM_ZONES 4
 #endif // CHIP_CONFIG_MAX_NUM_ZONES
 
+/**
+ * @def CHIP_CONFIG_TLV_READER_FAST_SKIP
+ *
+ * @brief Enable the TLVReader fast path for skipping containers.
+ *
+ * When enabled, skipping a container decodes the elements that lie wholly
+ * within the current input buffer in place, through a 256-byte table of
+ * element head sizes, instead of staging each element head. Disable to save
+ * code size on constrained devices.
+ */
+#ifndef CHIP_CONFIG_TLV_READER_FAST_SKIP
+#define CHIP_CONFIG_TLV_READER_FAST_SKIP 1
+#endif // CHIP_CONFIG_TLV_READER_FAST_SKIP
+
 /**
  * @def CHIP_MEMORY_SANITIZER_ENABLED
  *
@@ -17,6 +17,7 @@
  */
 #include <lib/core/TLVReader.h>
 
+#include <array>
 #include <stdint.h>
 #include <string.h>
 
@@ -44,7 +45,36 @@ namespace TLV {
 
 using namespace chip::Encoding;
 
-static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+static constexpr uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+
+#if CHIP_CONFIG_TLV_READER_FAST_SKIP
+namespace {
+
+constexpr std::array<uint8_t, 256> MakeElementHeadSizes()
+{
+    std::array<uint8_t, 256> sizes = {};
+    for (size_t controlByte = 0; controlByte < sizes.size(); controlByte++)
+    {
+        const TLVElementType elemType = static_cast<TLVElementType>(controlByte & kTLVTypeMask);
+        if (IsValidTLVType(elemType))
+        {
+            const uint8_t tagBytes = sTagSizes[(controlByte & kTLVTagControlMask) >> kTLVTagControlShift];
+            sizes[controlByte]     = static_cast<uint8_t>(1 + tagBytes + TLVFieldSizeToBytes(GetTLVFieldSize(elemType)));
+        }
+    }
+    return sizes;
+}
+
+// The number of bytes in the head of an element, indexed by its control byte, or 0 if the element type is invalid.
+constexpr std::array<uint8_t, 256> sElementHeadSizes = MakeElementHeadSizes();
+
+static_assert(sElementHeadSizes[0x00] == 2, "anonymous 1-byte signed integer");
+static_assert(sElementHeadSizes[0x35] == 2, "context-tagged structure");
+static_assert(sElementHeadSizes[0xE7] == 17, "fully-qualified 8-byte unsigned integer");
+static_assert(sElementHeadSizes[0x19] == 0, "invalid element type");
+
+} // namespace
+#endif // CHIP_CONFIG_TLV_READER_FAST_SKIP
 
 TLVReader::TLVReader() :
     ImplicitProfileId(kProfileIdNotSpecified), AppData(nullptr), mElemLenOrVal(0), mBackingStore(nullptr), mReadPoint(nullptr),
@@ -780,12 +810,75 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
         if (err != CHIP_NO_ERROR)
             return err;
 
+#if CHIP_CONFIG_TLV_READER_FAST_SKIP
+        if (SkipElementsInBuffer(nestLevel, outerContainerType))
+            return CHIP_NO_ERROR;
+#endif // CHIP_CONFIG_TLV_READER_FAST_SKIP
+
         err = ReadElement();
         if (err != CHIP_NO_ERROR)
             return err;
     }
 }
 
+#if CHIP_CONFIG_TLV_READER_FAST_SKIP
+/**
+ * Skip, on behalf of SkipToEndOfContainer, the elements that lie wholly within the current input buffer, decoding
+ * their heads in place. The scan stops before the first element that ReadElement would reject, or whose head or data
+ * continues past the buffer, and leaves it to be read the usual way, so the outcome is the same as reading every
+ * element through ReadElement.
+ *
+ * @return true if the scan reached the end of the container being skipped, and the reader is positioned on its
+ *         EndOfContainer element.
+ */
+bool TLVReader::SkipElementsInBuffer(uint32_t & nestLevel, TLVType outerContainerType)
+{
+    while (mReadPoint < mBufEnd)
+    {
+        const uint8_t * head    = mReadPoint;
+        const uint8_t headBytes = sElementHeadSizes[*head];
+        if (headBytes == 0 || headBytes > mBufEnd - head)
+            return false;
+
+        mControlByte = *head;
+        mReadPoint += headBytes;
+        mLenRead += headBytes;
+
+        TLVElementType elemType = ElementType();
+        if (DecodeElementHead(head + 1) != CHIP_NO_ERROR ||
+            (TLVTypeHasLength(elemType) && mElemLenOrVal > static_cast<size_t>(mBufEnd - mReadPoint)))
+        {
+            mReadPoint = head;
+            mLenRead -= headBytes;
+            return false;
+        }
+
+        if (elemType == TLVElementType::EndOfContainer)
+        {
+            if (nestLevel == 0)
+                return true;
+
+            nestLevel--;
+            mContainerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+        }
+
+        else if (TLVTypeIsContainer(elemType))
+        {
+            nestLevel++;
+            mContainerType = static_cast<TLVType>(elemType);
+        }
+
+        else if (TLVTypeHasLength(elemType))
+        {
+            mReadPoint += static_cast<uint32_t>(mElemLenOrVal);
+            mLenRead += static_cast<uint32_t>(mElemLenOrVal);
+        }
+    }
+
+    return false;
+}
+#endif // CHIP_CONFIG_TLV_READER_FAST_SKIP
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     // Make sure we have input data. Return CHIP_END_OF_TLV if no more data is available.
@@ -815,23 +908,41 @@ CHIP_ERROR TLVReader::ReadElement()
     // length bytes (if present), and for elements that don't have a length (e.g. integers), the value bytes.
     const uint8_t elemHeadBytes = static_cast<uint8_t>(1 + tagBytes + valOrLenBytes);
 
+    // If the head of the element is in the current input buffer, parse it in place. Otherwise it goes past the end
+    // of the buffer, so read it into a staging buffer to parse it.
     // 17 = 1 control byte + 8 tag bytes + 8 length/value bytes
     uint8_t stagingBuf[17];
+    const uint8_t * p;
+    if (elemHeadBytes <= mBufEnd - mReadPoint)
+    {
+        p = mReadPoint;
+        mReadPoint += elemHeadBytes;
+        mLenRead += elemHeadBytes;
+    }
+    else
+    {
+        // Odd workaround: clang-tidy claims garbage value otherwise as it does not
+        // understand that ReadData initializes stagingBuf
+        stagingBuf[1] = 0;
 
-    // Odd workaround: clang-tidy claims garbage value otherwise as it does not
-    // understand that ReadData initializes stagingBuf
-    stagingBuf[1] = 0;
-
-    // If the head of the element goes past the end of the current input buffer,
-    // we need to read it into the staging buffer to parse it.  Just do that unconditionally,
-    // even if the head does not go past end of current buffer, to save codesize.
-    ReturnErrorOnFailure(ReadData(stagingBuf, elemHeadBytes));
+        ReturnErrorOnFailure(ReadData(stagingBuf, elemHeadBytes));
+        p = stagingBuf;
+    }
 
     // +1 to skip over the control byte
-    const uint8_t * p = stagingBuf + 1;
+    return DecodeElementHead(p + 1);
+}
+
+/**
+ * Decode the tag and length or value field of the element whose control byte is in mControlByte, from the bytes
+ * following the control byte, and verify the element.
+ */
+CHIP_ERROR TLVReader::DecodeElementHead(const uint8_t * p)
+{
+    TLVElementType elemType = ElementType();
 
     // Read the tag field, if present.
-    mElemTag      = ReadTag(tagControl, p);
+    mElemTag      = ReadTag(static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask), p);
     mElemLenOrVal = 0;
 
     // Read the length/value field, if present.
@@ -839,7 +950,7 @@ CHIP_ERROR TLVReader::ReadElement()
     //       the rest 0. Value looks like "<le-byte> <le-byte> ... <le-byte> 0 0 ... 0"
     //       which is the TLV format. HostSwap ensures this becomes a real host value
     //       (should be a NOOP on LE machines, will full-swap on big-endian machines)
-    memcpy(&mElemLenOrVal, p, valOrLenBytes);
+    memcpy(&mElemLenOrVal, p, TLVFieldSizeToBytes(GetTLVFieldSize(elemType)));
     LittleEndian::HostSwap(mElemLenOrVal);
 
     VerifyOrReturnError(!TLVTypeHasLength(elemType) || (mElemLenOrVal <= UINT32_MAX), CHIP_ERROR_NOT_IMPLEMENTED);
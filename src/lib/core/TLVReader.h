@@ -31,6 +31,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <lib/core/DataModelTypes.h>
 #include <lib/core/Optional.h>
@@ -992,6 +993,10 @@ protected:
     void ClearElementState();
     CHIP_ERROR SkipData();
     CHIP_ERROR SkipToEndOfContainer();
+#if CHIP_CONFIG_TLV_READER_FAST_SKIP
+    bool SkipElementsInBuffer(uint32_t & nestLevel, TLVType outerContainerType);
+#endif // CHIP_CONFIG_TLV_READER_FAST_SKIP
+    CHIP_ERROR DecodeElementHead(const uint8_t * p);
     CHIP_ERROR VerifyElement();
     Tag ReadTag(TLVTagControl tagControl, const uint8_t *& p) const;
     CHIP_ERROR EnsureData(CHIP_ERROR noDataErr);
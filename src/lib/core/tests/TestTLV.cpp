@@ -42,10 +42,13 @@
 #include <lib/support/logging/Constants.h>
 #include <lib/support/tests/ExtraPwTestMacros.h>
 
+#include <system/SystemClock.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
+#include <algorithm>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 using namespace chip;
 using namespace chip::TLV;
@@ -5540,3 +5543,261 @@ TEST_F(TestTLV, CheckUtf8ValidationOnWriteEnforcedAtSingleEntryPoint)
     writer2.Init(out);
     EXPECT_EQ(writer2.PutString(AnonymousTag(), CharSpan(invalid, sizeof(invalid))), CHIP_ERROR_INVALID_UTF8);
 }
+
+namespace {
+
+// A backing store that hands out a contiguous encoding a few bytes at a time, so that most elements straddle two
+// buffers and the reader decodes them through its staging buffer rather than in place.
+class ChunkedBackingStore : public TLVBackingStore
+{
+public:
+    ChunkedBackingStore(const uint8_t * data, uint32_t len, uint32_t chunkLen) : mData(data), mLen(len), mChunkLen(chunkLen) {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mData;
+        bufLen   = std::min(mLen, mChunkLen);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        // bufStart is the end of the previous buffer.
+        uint32_t offset = static_cast<uint32_t>(bufStart - mData);
+        bufLen          = std::min(mLen - offset, mChunkLen);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mData;
+    uint32_t mLen;
+    uint32_t mChunkLen;
+};
+
+// Encodes a payload shaped like a ReportDataMessage: a list of attribute reports, each with a path, a data version and
+// a value that is a list of structures holding integers, strings and nested containers.
+CHIP_ERROR EncodeReportData(TLVWriter & writer, size_t reportCount)
+{
+    static const char sLabel[] = "Living room ceiling light";
+    uint8_t octets[300];
+    memset(octets, 0xA5, sizeof(octets));
+
+    TLVType message, reports, report, data, path, value, entry, nested;
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, message));
+    ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint32_t>(0x12345678)));
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Array, reports));
+    for (size_t i = 0; i < reportCount; i++)
+    {
+        ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, report));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Structure, data));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint32_t>(i * 7919)));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_List, path));
+        ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint16_t>(i % 3)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(3), static_cast<uint32_t>(0x0006)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(4), static_cast<uint32_t>(i)));
+        ReturnErrorOnFailure(writer.EndContainer(path));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(2), kTLVType_Array, value));
+        for (size_t j = 0; j < 3; j++)
+        {
+            ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, entry));
+            ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<int64_t>(-1) - static_cast<int64_t>(i * j)));
+            ReturnErrorOnFailure(writer.PutString(ContextTag(1), sLabel));
+            ReturnErrorOnFailure(writer.PutBytes(ContextTag(2), octets, static_cast<uint32_t>((i * 37 + j) % sizeof(octets))));
+            ReturnErrorOnFailure(writer.PutBoolean(CommonTag(0x1234), (j % 2) == 0));
+            ReturnErrorOnFailure(writer.PutNull(ProfileTag(TestProfile_1, 0x10000)));
+            ReturnErrorOnFailure(writer.StartContainer(ContextTag(3), kTLVType_Array, nested));
+            ReturnErrorOnFailure(writer.Put(AnonymousTag(), 1.5f));
+            ReturnErrorOnFailure(writer.Put(AnonymousTag(), static_cast<uint64_t>(i) << 40));
+            ReturnErrorOnFailure(writer.EndContainer(nested));
+            ReturnErrorOnFailure(writer.EndContainer(entry));
+        }
+        ReturnErrorOnFailure(writer.EndContainer(value));
+        ReturnErrorOnFailure(writer.EndContainer(data));
+        ReturnErrorOnFailure(writer.EndContainer(report));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(reports));
+    ReturnErrorOnFailure(writer.PutBoolean(ContextTag(4), true));
+    ReturnErrorOnFailure(writer.Put(ContextTag(0xFF), static_cast<uint8_t>(12)));
+    ReturnErrorOnFailure(writer.EndContainer(message));
+    return writer.Finalize();
+}
+
+// Walks the elements of the container the reader is in, entering some containers and skipping the others as chosen by
+// the seed, and records the outcome of every call.
+void WalkTLV(TLVReader & reader, uint32_t & seed, std::vector<uint64_t> & trace, int depth)
+{
+    while (true)
+    {
+        CHIP_ERROR err = reader.Next();
+        trace.push_back(err.AsInteger());
+        if (err != CHIP_NO_ERROR)
+            return;
+
+        seed = seed * 1103515245 + 12345;
+        trace.push_back(static_cast<uint64_t>(reader.GetType()));
+        trace.push_back(ProfileIdFromTag(reader.GetTag()));
+        trace.push_back(TagNumFromTag(reader.GetTag()));
+        trace.push_back(reader.GetLength());
+
+        uint64_t u = 0;
+        int64_t s  = 0;
+        trace.push_back(reader.Get(u).AsInteger());
+        trace.push_back(u);
+        trace.push_back(reader.Get(s).AsInteger());
+        trace.push_back(static_cast<uint64_t>(s));
+
+        if (TLVTypeIsContainer(reader.GetType()) && depth < 4 && (seed >> 16) % 2 == 0)
+        {
+            TLVType outer;
+            err = reader.EnterContainer(outer);
+            trace.push_back(err.AsInteger());
+            if (err != CHIP_NO_ERROR)
+                return;
+            WalkTLV(reader, seed, trace, depth + 1);
+            err = reader.ExitContainer(outer);
+        }
+        else if (reader.GetType() == kTLVType_ByteString && (seed >> 16) % 3 == 0)
+        {
+            uint8_t bytes[512];
+            uint32_t length = reader.GetLength();
+            err             = reader.GetBytes(bytes, sizeof(bytes));
+            if (err == CHIP_NO_ERROR && length > 0)
+            {
+                trace.push_back(bytes[length - 1]);
+            }
+        }
+        else
+        {
+            err = reader.Skip();
+        }
+        trace.push_back(err.AsInteger());
+        if (err != CHIP_NO_ERROR)
+            return;
+    }
+}
+
+std::vector<uint64_t> WalkContiguous(const uint8_t * data, uint32_t len, uint32_t seed)
+{
+    std::vector<uint64_t> trace;
+    TLVReader reader;
+    reader.Init(data, len);
+    reader.ImplicitProfileId = TestProfile_2;
+    WalkTLV(reader, seed, trace, 0);
+    return trace;
+}
+
+std::vector<uint64_t> WalkChunked(const uint8_t * data, uint32_t len, uint32_t chunkLen, uint32_t seed)
+{
+    std::vector<uint64_t> trace;
+    ChunkedBackingStore store(data, len, chunkLen);
+    TLVReader reader;
+    CHIP_ERROR err = reader.Init(store, len);
+    if (err != CHIP_NO_ERROR)
+    {
+        trace.push_back(err.AsInteger());
+        return trace;
+    }
+    reader.ImplicitProfileId = TestProfile_2;
+    WalkTLV(reader, seed, trace, 0);
+    return trace;
+}
+
+} // namespace
+
+TEST_F(TestTLV, CheckSkipFastPathMatchesChunkedReader)
+{
+    std::vector<uint8_t> encoding(8192);
+    TLVWriter writer;
+    writer.Init(encoding.data(), encoding.size());
+    ASSERT_EQ(EncodeReportData(writer, 12), CHIP_NO_ERROR);
+    encoding.resize(writer.GetLengthWritten());
+    const uint32_t len = static_cast<uint32_t>(encoding.size());
+
+    // The unmodified payload reads the same whatever way it is split, and whichever containers are skipped.
+    for (uint32_t seed = 0; seed < 16; seed++)
+    {
+        std::vector<uint64_t> expected = WalkContiguous(encoding.data(), len, seed);
+        EXPECT_EQ(expected[expected.size() - 1], CHIP_END_OF_TLV.AsInteger());
+        for (uint32_t chunkLen = 1; chunkLen <= 20; chunkLen++)
+        {
+            EXPECT_EQ(WalkChunked(encoding.data(), len, chunkLen, seed), expected);
+        }
+    }
+
+    // Corrupt and truncated payloads fail, or not, in the same way.
+    srand(1234);
+    std::vector<uint8_t> fuzzed;
+    for (int round = 0; round < 3000; round++)
+    {
+        fuzzed = encoding;
+        for (int flips = 1 + rand() % 4; flips > 0; flips--)
+        {
+            uint8_t & byte = fuzzed[static_cast<size_t>(rand()) % fuzzed.size()];
+            byte           = (rand() % 2) ? static_cast<uint8_t>(rand()) : static_cast<uint8_t>(byte ^ (1 << (rand() % 8)));
+        }
+        uint32_t fuzzedLen = (round % 5 == 0) ? static_cast<uint32_t>(rand()) % len : len;
+        uint32_t seed      = static_cast<uint32_t>(rand());
+        uint32_t chunkLen  = 1 + static_cast<uint32_t>(rand()) % 24;
+
+        std::vector<uint64_t> expected = WalkContiguous(fuzzed.data(), fuzzedLen, seed);
+        std::vector<uint64_t> actual   = WalkChunked(fuzzed.data(), fuzzedLen, chunkLen, seed);
+        EXPECT_EQ(actual, expected);
+        if (actual != expected)
+        {
+            ChipLogError(Test, "Mismatch on round %d, chunks of %u bytes", round, static_cast<unsigned>(chunkLen));
+            return;
+        }
+    }
+}
+
+TEST_F(TestTLV, BenchmarkSkipReportData)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    std::vector<uint8_t> encoding(64 * 1024);
+    TLVWriter writer;
+    writer.Init(encoding.data(), encoding.size());
+    ASSERT_EQ(EncodeReportData(writer, 50), CHIP_NO_ERROR);
+    const uint32_t len = writer.GetLengthWritten();
+
+    constexpr int kRounds = 2000;
+
+    // Skipping the whole message from a contiguous buffer, which decodes its elements in place.
+    chip::Testing::BenchmarkTimer timer;
+    for (int round = 0; round < kRounds; round++)
+    {
+        TLVReader reader;
+        reader.Init(encoding.data(), len);
+        ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+        ASSERT_EQ(reader.Skip(), CHIP_NO_ERROR);
+        ASSERT_EQ(reader.Next(), CHIP_END_OF_TLV);
+    }
+    const chip::System::Clock::Microseconds64 contiguousTime = timer.Elapsed();
+
+    // The same, from the 64-byte buffers of a backing store.
+    timer.Restart();
+    for (int round = 0; round < kRounds; round++)
+    {
+        ChunkedBackingStore store(encoding.data(), len, 64);
+        TLVReader reader;
+        ASSERT_EQ(reader.Init(store, len), CHIP_NO_ERROR);
+        ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+        ASSERT_EQ(reader.Skip(), CHIP_NO_ERROR);
+        ASSERT_EQ(reader.Next(), CHIP_END_OF_TLV);
+    }
+    const chip::System::Clock::Microseconds64 chunkedTime = timer.Elapsed();
+
+    ChipLogProgress(Test, "Skipping a %u-byte ReportData: %u ns contiguous, %u ns in 64-byte buffers", static_cast<unsigned>(len),
+                    static_cast<unsigned>(contiguousTime.count() * 1000 / kRounds),
+                    static_cast<unsigned>(chunkedTime.count() * 1000 / kRounds));
+}
@@ -26,6 +26,7 @@
 #include <lib/dnssd/minimal_mdns/MinMdnsConfig.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/RecordCache.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
 #include <lib/support/CHIPMemString.h>
@@ -291,13 +292,33 @@ private:
     System::Layer * mSystemLayer                      = nullptr;
     ActiveResolveAttempts mActiveResolves;
     PacketParser mPacketParser;
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    RecordCache mRecordCache{ &chip::System::SystemClock() };
+#endif
 
     void SetDiscoveryContext(DiscoveryContext * context);
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
 
+    /// Sends the queries of an attempt that was just marked as pending
+    CHIP_ERROR SendNewlyPendingQueries();
     CHIP_ERROR SendAllPendingQueries();
     CHIP_ERROR ScheduleRetries();
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    /// Feeds the cached records that answer the given attempt through the
+    /// packet parser, as if they were just received.
+    ///
+    /// Returns true if the attempt was answered and needs no query.
+    bool AnswerFromCache(const ActiveResolveAttempts::ScheduledAttempt & attempt);
+    void ParseCachedResponse(const System::PacketBufferHandle & packet, Inet::InterfaceId interface);
+
+    /// Queries the cached records that are about to expire while still in use
+    CHIP_ERROR SendCacheRefreshQueries();
+#endif
+
+    /// Get the name that browses query
+    CHIP_ERROR BuildBrowseQName(const ActiveResolveAttempts::ScheduledAttempt::Browse & data, mdns::Minimal::FullQName & qname);
+
     /// Prepare a query for the given schedule attempt
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
 
@@ -501,6 +522,10 @@ void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet
 {
     MATTER_TRACE_SCOPE("Received MDNS Packet", "MinMdnsResolver");
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    mRecordCache.AddPacket(data, info->Interface);
+#endif
+
     // Fill up any relevant data
     mPacketParser.ParseSrvRecords(data);
     mPacketParser.ParseNonSrvRecords(info->Interface, data);
@@ -532,13 +557,14 @@ bool MinMdnsResolver::IsInitialized()
 void MinMdnsResolver::Shutdown()
 {
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    mRecordCache.Clear();
+#endif
 }
 
-CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
-                                       bool firstSend)
+CHIP_ERROR MinMdnsResolver::BuildBrowseQName(const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
+                                             mdns::Minimal::FullQName & qname)
 {
-    mdns::Minimal::FullQName qname;
-
     switch (data.type)
     {
     case DiscoveryType::kOperational:
@@ -589,6 +615,14 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     }
 
     VerifyOrReturnError(qname.nameCount, CHIP_ERROR_NO_MEMORY);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
+                                       bool firstSend)
+{
+    mdns::Minimal::FullQName qname;
+    ReturnErrorOnFailure(BuildBrowseQName(data, qname));
 
     mdns::Minimal::Query query(qname);
     query
@@ -678,6 +712,13 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+        if (AnswerFromCache(*resolve))
+        {
+            continue;
+        }
+#endif
+
         System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
         VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
 
@@ -698,9 +739,131 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 
     ExpireIncrementalResolvers();
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    LogErrorOnFailure(SendCacheRefreshQueries());
+#endif
+
     return ScheduleRetries();
 }
 
+CHIP_ERROR MinMdnsResolver::SendNewlyPendingQueries()
+{
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    // Callers only expect results once they get control back, as for results
+    // from the network, so cached answers are delivered from the event loop.
+    if (!mRecordCache.IsEmpty())
+    {
+        VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mSystemLayer->ScheduleWork(&RetryCallback, this);
+    }
+#endif
+
+    return SendAllPendingQueries();
+}
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+bool MinMdnsResolver::AnswerFromCache(const ActiveResolveAttempts::ScheduledAttempt & attempt)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    if (attempt.IsResolve())
+    {
+        char nameBuffer[kMaxOperationalServiceNameSize] = "";
+        VerifyOrReturnValue(MakeInstanceName(nameBuffer, sizeof(nameBuffer), attempt.ResolveData().peerId) == CHIP_NO_ERROR, false);
+
+        const char * instanceQName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+        CHIP_ERROR err               = mRecordCache.BuildInstanceResponse(FullQName(instanceQName), packet, interface);
+        VerifyOrReturnValue(err == CHIP_NO_ERROR, false);
+        ParseCachedResponse(packet, interface);
+        return true;
+    }
+
+    if (attempt.IsIpResolve())
+    {
+        CHIP_ERROR err = mRecordCache.BuildAddressResponse(attempt.IpResolveData().hostName.Content(), packet, interface);
+        VerifyOrReturnValue(err == CHIP_NO_ERROR, false);
+        ParseCachedResponse(packet, interface);
+        return true;
+    }
+
+    // Browses still query the network, for the nodes that are not cached, so
+    // the cached ones only need reporting once.
+    if (attempt.IsBrowse() && attempt.firstSend)
+    {
+        FullQName qname;
+        VerifyOrReturnValue(BuildBrowseQName(attempt.BrowseData(), qname) == CHIP_NO_ERROR, false);
+
+        if (attempt.BrowseData().filter.type == DiscoveryFilterType::kInstanceName)
+        {
+            if (mRecordCache.BuildInstanceResponse(qname, packet, interface) == CHIP_NO_ERROR)
+            {
+                ParseCachedResponse(packet, interface);
+            }
+            return false;
+        }
+
+        mRecordCache.ForEachInstance(qname, [&](const SerializedQNameIterator & instanceName) {
+            if (mRecordCache.BuildInstanceResponse(instanceName, packet, interface) == CHIP_NO_ERROR)
+            {
+                ParseCachedResponse(packet, interface);
+            }
+        });
+    }
+
+    return false;
+}
+
+void MinMdnsResolver::ParseCachedResponse(const System::PacketBufferHandle & packet, Inet::InterfaceId interface)
+{
+    const BytesRange data(packet->Start(), packet->Start() + packet->DataLength());
+
+    mPacketParser.ParseSrvRecords(data);
+    mPacketParser.ParseNonSrvRecords(interface, data);
+
+    AdvancePendingResolverStates();
+}
+
+CHIP_ERROR MinMdnsResolver::SendCacheRefreshQueries()
+{
+    std::optional<System::Clock::Timeout> delay = mRecordCache.GetTimeUntilNextRefresh();
+    VerifyOrReturnError(delay.has_value() && (*delay == System::Clock::kZero), CHIP_NO_ERROR);
+
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
+    VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    QueryBuilder builder(std::move(buffer));
+    builder.Header().SetMessageId(0);
+
+    bool hasQueries = false;
+    mRecordCache.ForEachRecordToRefresh([&](const SerializedQNameIterator & name, QType type) {
+        HeapQName qname(name);
+        if (!qname.IsOk())
+        {
+            return;
+        }
+
+        Query query(qname.Content());
+        query
+            .SetClass(QClass::IN)       //
+            .SetType(type)              //
+            .SetAnswerViaUnicast(false) //
+            ;
+
+        mdns::Minimal::Logging::LogSendingQuery(query);
+        builder.AddQuery(query);
+        hasQueries = true;
+    });
+
+    VerifyOrReturnError(hasQueries, CHIP_NO_ERROR);
+    VerifyOrReturnError(builder.Ok(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort);
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
 void MinMdnsResolver::ExpireIncrementalResolvers()
 {
     // once all queries are sent, if any SRV cannot receive AAAA addresses, expire it
@@ -749,14 +912,14 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 {
     mActiveResolves.MarkPending(filter, type);
 
-    return SendAllPendingQueries();
+    return SendNewlyPendingQueries();
 }
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
     mActiveResolves.MarkPending(peerId);
 
-    return SendAllPendingQueries();
+    return SendNewlyPendingQueries();
 }
 
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
@@ -773,6 +936,14 @@ CHIP_ERROR MinMdnsResolver::ScheduleRetries()
 
     std::optional<System::Clock::Timeout> delay = mActiveResolves.GetTimeUntilNextExpectedResponse();
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    std::optional<System::Clock::Timeout> refreshDelay = mRecordCache.GetTimeUntilNextRefresh();
+    if (refreshDelay.has_value() && (!delay.has_value() || (*refreshDelay < *delay)))
+    {
+        delay = refreshDelay;
+    }
+#endif
+
     if (!delay.has_value())
     {
         return CHIP_NO_ERROR;
@@ -0,0 +1,493 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "RecordCache.h"
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
+#include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+namespace {
+
+using chip::Encoding::BigEndian::BufferWriter;
+using chip::System::Clock::Timestamp;
+using namespace chip::System::Clock::Literals;
+
+/// Refresh points, in percents of the TTL (RFC 6762, section 5.2).
+constexpr uint8_t kRefreshPercents[] = { 80, 85, 90, 95 };
+
+/// Records that a record with the cache flush bit replaces (RFC 6762, section 10.2).
+constexpr chip::System::Clock::Milliseconds64 kFlushMinAge = 1000_ms64;
+
+bool IsCachedType(QType type)
+{
+    switch (type)
+    {
+    case QType::PTR:
+    case QType::SRV:
+    case QType::TXT:
+    case QType::A:
+    case QType::AAAA:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Whether only one record of the type is kept per name and interface. Other
+/// types may have several records with the same name, one for each data.
+bool IsUniqueType(QType type)
+{
+    return (type == QType::SRV) || (type == QType::TXT);
+}
+
+bool IsAddressType(QType type)
+{
+    return (type == QType::A) || (type == QType::AAAA);
+}
+
+bool WriteName(BufferWriter & output, const SerializedQNameIterator & name)
+{
+    SerializedQNameIterator copy = name;
+    while (copy.Next())
+    {
+    }
+    VerifyOrReturnValue(copy.IsValid(), false);
+
+    // A writer that did not write anything before does not compress names.
+    RecordWriter(&output).WriteQName(name);
+    return true;
+}
+
+/// Writes the data of a record, with the names in it uncompressed, so that it
+/// does not depend on the packet it came from.
+bool WriteData(BufferWriter & output, const ResourceData & data, const BytesRange & packet)
+{
+    switch (data.GetType())
+    {
+    case QType::PTR:
+        return WriteName(output, SerializedQNameIterator(packet, data.GetData().Start()));
+    case QType::SRV: {
+        SrvRecord srv;
+        VerifyOrReturnValue(srv.Parse(data.GetData(), packet), false);
+        output.Put16(srv.GetPriority()).Put16(srv.GetWeight()).Put16(srv.GetPort());
+        return WriteName(output, srv.GetName());
+    }
+    default:
+        output.Put(data.GetData().Start(), data.GetData().Size());
+        return true;
+    }
+}
+
+/// Writes cached records as the answers of a response.
+class ResponseWriter
+{
+public:
+    ResponseWriter(chip::System::PacketBufferHandle & packet) :
+        mPacket(packet), mOutput(packet->Start(), packet->AvailableDataLength()), mWriter(&mOutput)
+    {
+        mOutput.Skip(HeaderRef::kSizeBytes);
+    }
+
+    void AddAnswer(const SerializedQNameIterator & name, QType type, uint32_t ttlSeconds, const BytesRange & data)
+    {
+        mWriter.WriteQName(name)
+            .Put16(static_cast<uint16_t>(type))
+            .Put16(static_cast<uint16_t>(QClass::IN))
+            .Put32(ttlSeconds)
+            .Put16(static_cast<uint16_t>(data.Size()))
+            .Put(data);
+        mAnswerCount++;
+    }
+
+    CHIP_ERROR Finish()
+    {
+        VerifyOrReturnError(mWriter.Fit(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        HeaderRef header(mPacket->Start());
+        header.Clear();
+        header.SetFlags(header.GetFlags().SetResponse());
+        header.SetAnswerCount(mAnswerCount);
+        mPacket->SetDataLength(static_cast<uint16_t>(mOutput.Needed()));
+
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    chip::System::PacketBufferHandle & mPacket;
+    BufferWriter mOutput;
+    RecordWriter mWriter;
+    uint16_t mAnswerCount = 0;
+};
+
+} // namespace
+
+Timestamp RecordCache::Entry::Expiry() const
+{
+    return received + chip::System::Clock::Seconds64(ttlSeconds);
+}
+
+std::optional<Timestamp> RecordCache::Entry::NextRefresh() const
+{
+    VerifyOrReturnValue(inUse && refreshCount < MATTER_ARRAY_SIZE(kRefreshPercents), std::nullopt);
+    return received + chip::System::Clock::Milliseconds64(uint64_t(ttlSeconds) * 10 * kRefreshPercents[refreshCount]);
+}
+
+uint32_t RecordCache::Entry::RemainingTtlSeconds(Timestamp now) const
+{
+    VerifyOrReturnValue(Expiry() > now, 0);
+
+    // A TTL of 0 would announce that the record is gone.
+    return std::max<uint32_t>(1, static_cast<uint32_t>((Expiry() - now).count() / 1000));
+}
+
+void RecordCache::AddPacket(const BytesRange & packet, chip::Inet::InterfaceId interface)
+{
+    class Delegate : public ParserDelegate
+    {
+    public:
+        Delegate(RecordCache & cache, const BytesRange & packet, chip::Inet::InterfaceId interface, Timestamp now) :
+            mCache(cache), mPacket(packet), mInterface(interface), mNow(now)
+        {}
+
+        void OnHeader(ConstHeaderRef & header) override { mIsResponse = header.GetFlags().IsResponse(); }
+        void OnQuery(const QueryData & data) override {}
+        void OnResource(ResourceType type, const ResourceData & data) override
+        {
+            if (mIsResponse)
+            {
+                mCache.AddRecord(data, mPacket, mInterface, mNow);
+            }
+        }
+
+    private:
+        RecordCache & mCache;
+        const BytesRange mPacket;
+        const chip::Inet::InterfaceId mInterface;
+        const Timestamp mNow;
+        bool mIsResponse = false;
+    };
+
+    const Timestamp now = mClock->GetMonotonicTimestamp();
+    RemoveExpired(now);
+
+    Delegate delegate(*this, packet, interface, now);
+    ParsePacket(packet, &delegate);
+}
+
+void RecordCache::AddRecord(const ResourceData & data, const BytesRange & packet, chip::Inet::InterfaceId interface,
+                            Timestamp now)
+{
+    const uint16_t rawClass = static_cast<uint16_t>(data.GetClass());
+    VerifyOrReturn(IsCachedType(data.GetType()));
+    VerifyOrReturn((rawClass & ~kQClassResponseFlushBit) == static_cast<uint16_t>(QClass::IN));
+
+    BufferWriter nameSize(nullptr, 0);
+    BufferWriter dataSize(nullptr, 0);
+    VerifyOrReturn(WriteName(nameSize, data.GetName()) && WriteData(dataSize, data, packet));
+    VerifyOrReturn(nameSize.Needed() <= kMaxNameSize && dataSize.Needed() <= UINT16_MAX);
+
+    Entry record;
+    record.nameSize   = static_cast<uint16_t>(nameSize.Needed());
+    record.dataSize   = static_cast<uint16_t>(dataSize.Needed());
+    record.type       = data.GetType();
+    record.interface  = interface;
+    record.ttlSeconds = static_cast<uint32_t>(data.GetTtlSeconds());
+    record.received   = now;
+    record.storage    = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(record.nameSize + record.dataSize));
+    VerifyOrReturn(record.storage != nullptr);
+
+    BufferWriter nameOutput(record.storage, record.nameSize);
+    BufferWriter dataOutput(record.storage + record.nameSize, record.dataSize);
+    WriteName(nameOutput, data.GetName());
+    WriteData(dataOutput, data, packet);
+
+    const bool flush = (rawClass & kQClassResponseFlushBit) != 0;
+    for (auto & entry : mEntries)
+    {
+        if (!entry.IsValid() || (entry.type != record.type) || (entry.interface != interface) || (entry.Name() != record.Name()))
+        {
+            continue;
+        }
+
+        const bool sameRecord = IsUniqueType(record.type) ||
+            ((entry.dataSize == record.dataSize) && (memcmp(entry.Data().Start(), record.Data().Start(), record.dataSize) == 0));
+        if (sameRecord || (flush && (now - entry.received > kFlushMinAge)))
+        {
+            // A newer copy of a record that answered something keeps being refreshed.
+            record.inUse = record.inUse || entry.inUse;
+            Remove(entry);
+        }
+    }
+
+    if (record.ttlSeconds == 0)
+    {
+        // Goodbye packet: the record was only needed to find what to remove.
+        chip::Platform::MemoryFree(record.storage);
+        return;
+    }
+
+    *FindSlot(now) = record;
+}
+
+void RecordCache::Remove(Entry & entry)
+{
+    chip::Platform::MemoryFree(entry.storage);
+    entry = Entry();
+}
+
+void RecordCache::RemoveExpired(Timestamp now)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.IsValid() && !entry.IsLive(now))
+        {
+            Remove(entry);
+        }
+    }
+}
+
+RecordCache::Entry * RecordCache::FindSlot(Timestamp now)
+{
+    Entry * evicted = nullptr;
+    for (auto & entry : mEntries)
+    {
+        if (!entry.IsValid())
+        {
+            return &entry;
+        }
+
+        if ((evicted == nullptr) || (evicted->inUse && !entry.inUse) ||
+            ((evicted->inUse == entry.inUse) && (entry.Expiry() < evicted->Expiry())))
+        {
+            evicted = &entry;
+        }
+    }
+
+    Remove(*evicted);
+    return evicted;
+}
+
+void RecordCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.IsValid())
+        {
+            Remove(entry);
+        }
+    }
+}
+
+bool RecordCache::IsEmpty()
+{
+    RemoveExpired(mClock->GetMonotonicTimestamp());
+    for (const auto & entry : mEntries)
+    {
+        if (entry.IsValid())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+CHIP_ERROR RecordCache::BuildInstanceResponse(const FullQName & instanceName, chip::System::PacketBufferHandle & packet,
+                                              chip::Inet::InterfaceId & interface)
+{
+    return BuildInstanceResponseImpl(instanceName, packet, interface);
+}
+
+CHIP_ERROR RecordCache::BuildInstanceResponse(const SerializedQNameIterator & instanceName,
+                                              chip::System::PacketBufferHandle & packet, chip::Inet::InterfaceId & interface)
+{
+    return BuildInstanceResponseImpl(instanceName, packet, interface);
+}
+
+template <typename Name>
+CHIP_ERROR RecordCache::BuildInstanceResponseImpl(const Name & instanceName, chip::System::PacketBufferHandle & packet,
+                                                  chip::Inet::InterfaceId & interface)
+{
+    const Timestamp now = mClock->GetMonotonicTimestamp();
+
+    for (auto & srv : mEntries)
+    {
+        if (!srv.IsLive(now) || (srv.type != QType::SRV) || !(srv.Name() == instanceName))
+        {
+            continue;
+        }
+
+        SrvRecord srvRecord;
+        if (!srvRecord.Parse(srv.Data(), srv.Data()))
+        {
+            continue;
+        }
+
+        auto isRecordOfInstance = [&](const Entry & entry) {
+            if (!entry.IsLive(now) || (entry.interface != srv.interface))
+            {
+                return false;
+            }
+            if (IsAddressType(entry.type))
+            {
+                return entry.Name() == srvRecord.GetName();
+            }
+            return (&entry == &srv) || ((entry.type == QType::TXT) && (entry.Name() == srv.Name()));
+        };
+
+        bool hasAddress = false;
+        for (const auto & entry : mEntries)
+        {
+            hasAddress = hasAddress || (IsAddressType(entry.type) && isRecordOfInstance(entry));
+        }
+        if (!hasAddress)
+        {
+            continue;
+        }
+
+        packet = chip::System::PacketBufferHandle::New(kMaxResponseSize);
+        VerifyOrReturnError(!packet.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+        ResponseWriter writer(packet);
+        for (auto & entry : mEntries)
+        {
+            if (isRecordOfInstance(entry))
+            {
+                writer.AddAnswer(entry.Name(), entry.type, entry.RemainingTtlSeconds(now), entry.Data());
+                entry.inUse = true;
+            }
+        }
+
+        interface = srv.interface;
+        return writer.Finish();
+    }
+
+    return CHIP_ERROR_NOT_FOUND;
+}
+
+CHIP_ERROR RecordCache::BuildAddressResponse(const FullQName & hostName, chip::System::PacketBufferHandle & packet,
+                                             chip::Inet::InterfaceId & interface)
+{
+    const Timestamp now = mClock->GetMonotonicTimestamp();
+
+    for (const auto & first : mEntries)
+    {
+        if (!first.IsLive(now) || !IsAddressType(first.type) || (first.Name() != hostName))
+        {
+            continue;
+        }
+
+        packet = chip::System::PacketBufferHandle::New(kMaxResponseSize);
+        VerifyOrReturnError(!packet.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+        ResponseWriter writer(packet);
+        for (auto & entry : mEntries)
+        {
+            if (entry.IsLive(now) && IsAddressType(entry.type) && (entry.interface == first.interface) &&
+                (entry.Name() == hostName))
+            {
+                writer.AddAnswer(entry.Name(), entry.type, entry.RemainingTtlSeconds(now), entry.Data());
+                entry.inUse = true;
+            }
+        }
+
+        interface = first.interface;
+        return writer.Finish();
+    }
+
+    return CHIP_ERROR_NOT_FOUND;
+}
+
+bool RecordCache::CopyInstanceName(size_t index, const FullQName & serviceName, uint8_t (&name)[kMaxNameSize],
+                                   size_t & nameSize)
+{
+    Entry & entry = mEntries[index];
+    VerifyOrReturnValue(entry.IsLive(mClock->GetMonotonicTimestamp()), false);
+    VerifyOrReturnValue((entry.type == QType::PTR) && (entry.Name() == serviceName), false);
+    VerifyOrReturnValue(entry.dataSize <= sizeof(name), false);
+
+    memcpy(name, entry.Data().Start(), entry.dataSize);
+    nameSize    = entry.dataSize;
+    entry.inUse = true;
+    return true;
+}
+
+void RecordCache::MarkRecordsToRefresh()
+{
+    const Timestamp now = mClock->GetMonotonicTimestamp();
+    RemoveExpired(now);
+
+    for (auto & entry : mEntries)
+    {
+        // When several refresh points passed, a single query covers them.
+        entry.refreshDue = false;
+        for (std::optional<Timestamp> next = entry.NextRefresh(); next.has_value() && (*next <= now); next = entry.NextRefresh())
+        {
+            entry.refreshCount++;
+            entry.refreshDue = true;
+        }
+    }
+}
+
+bool RecordCache::IsFirstToRefresh(size_t index) const
+{
+    const Entry & entry = mEntries[index];
+    VerifyOrReturnValue(entry.refreshDue, false);
+
+    for (size_t i = 0; i < index; i++)
+    {
+        if (mEntries[i].refreshDue && (mEntries[i].type == entry.type) && (mEntries[i].Name() == entry.Name()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::optional<chip::System::Clock::Timeout> RecordCache::GetTimeUntilNextRefresh()
+{
+    std::optional<Timestamp> earliest;
+    for (const auto & entry : mEntries)
+    {
+        std::optional<Timestamp> next = entry.NextRefresh();
+        if (next.has_value() && (!earliest.has_value() || (*next < *earliest)))
+        {
+            earliest = next;
+        }
+    }
+    VerifyOrReturnValue(earliest.has_value(), std::nullopt);
+
+    const Timestamp now = mClock->GetMonotonicTimestamp();
+    VerifyOrReturnValue(*earliest > now, chip::System::Clock::Timeout(0));
+    return std::chrono::duration_cast<chip::System::Clock::Timeout>(*earliest - now);
+}
+
+} // namespace Minimal
+} // namespace mdns
+
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
@@ -0,0 +1,179 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPError.h>
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+#include <lib/dnssd/minimal_mdns/core/Constants.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace mdns {
+namespace Minimal {
+
+class ResourceData;
+
+/// Keeps the PTR, SRV, TXT, A and AAAA records of received responses for as
+/// long as their TTL says (RFC 6762, section 10), so that resolves and browses
+/// can be answered without waiting for the network.
+///
+/// Answers are built as response packets, which go through the same parsing as
+/// the packets received from the network.
+///
+/// Records that answered something are due for a refresh query at 80%, 85%, 90%
+/// and 95% of their TTL (RFC 6762, section 5.2). When the cache is full, the
+/// record closest to expiry is evicted, preferring records that never answered
+/// anything.
+class RecordCache
+{
+public:
+    static constexpr size_t kMaxResponseSize = 1024;
+
+    RecordCache(chip::System::Clock::ClockBase * clock) : mClock(clock) {}
+    ~RecordCache() { Clear(); }
+
+    RecordCache(const RecordCache &)             = delete;
+    RecordCache & operator=(const RecordCache &) = delete;
+
+    /// Stores the records of a response received on the given interface.
+    ///
+    /// Records with a TTL of 0 remove the matching cached records. Records with
+    /// the cache flush bit set remove the cached records with the same name and
+    /// type that were received more than a second earlier.
+    void AddPacket(const BytesRange & packet, chip::Inet::InterfaceId interface);
+
+    void Clear();
+
+    /// Whether any unexpired record is cached.
+    bool IsEmpty();
+
+    /// Builds a response with the SRV and TXT records of a service instance and
+    /// the A and AAAA records of its target host, all received on the interface
+    /// that is returned in [interface].
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND unless the SRV record and at least one
+    /// address of the target are cached.
+    CHIP_ERROR BuildInstanceResponse(const FullQName & instanceName, chip::System::PacketBufferHandle & packet,
+                                     chip::Inet::InterfaceId & interface);
+    CHIP_ERROR BuildInstanceResponse(const SerializedQNameIterator & instanceName, chip::System::PacketBufferHandle & packet,
+                                     chip::Inet::InterfaceId & interface);
+
+    /// Builds a response with the A and AAAA records of a host, all received on
+    /// the interface that is returned in [interface].
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND if no address of the host is cached.
+    CHIP_ERROR BuildAddressResponse(const FullQName & hostName, chip::System::PacketBufferHandle & packet,
+                                    chip::Inet::InterfaceId & interface);
+
+    /// Calls [callback] with the instance name of every cached PTR record of
+    /// the given service name, as a SerializedQNameIterator.
+    ///
+    /// The name is a copy, so the callback may use the cache.
+    template <typename F>
+    void ForEachInstance(const FullQName & serviceName, F callback)
+    {
+        uint8_t name[kMaxNameSize];
+        for (size_t i = 0; i < CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE; i++)
+        {
+            size_t nameSize = 0;
+            if (CopyInstanceName(i, serviceName, name, nameSize))
+            {
+                callback(SerializedQNameIterator(BytesRange(name, name + nameSize), name));
+            }
+        }
+    }
+
+    /// Calls [callback] once for every name and type with records that are due
+    /// for a refresh query, with the name as a SerializedQNameIterator and the
+    /// QType. Expired records are removed first.
+    ///
+    /// The callback must not use the cache.
+    template <typename F>
+    void ForEachRecordToRefresh(F callback)
+    {
+        MarkRecordsToRefresh();
+        for (size_t i = 0; i < CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE; i++)
+        {
+            if (IsFirstToRefresh(i))
+            {
+                callback(mEntries[i].Name(), mEntries[i].type);
+            }
+        }
+    }
+
+    /// Time until the next refresh query is due, if any record answered
+    /// something.
+    std::optional<chip::System::Clock::Timeout> GetTimeUntilNextRefresh();
+
+private:
+    /// Names are at most 255 bytes long, uncompressed (RFC 1035, section 3.1).
+    static constexpr size_t kMaxNameSize = 256;
+
+    struct Entry
+    {
+        uint8_t * storage = nullptr; // Uncompressed name, followed by the data with uncompressed names.
+        uint16_t nameSize = 0;
+        uint16_t dataSize = 0;
+        QType type        = QType::ANY;
+        chip::Inet::InterfaceId interface;
+        uint32_t ttlSeconds = 0;
+        chip::System::Clock::Timestamp received;
+        uint8_t refreshCount = 0; // Refresh points that passed.
+        bool inUse           = false;
+        bool refreshDue      = false;
+
+        bool IsValid() const { return storage != nullptr; }
+        bool IsLive(chip::System::Clock::Timestamp now) const { return IsValid() && Expiry() > now; }
+        SerializedQNameIterator Name() const { return SerializedQNameIterator(BytesRange(storage, storage + nameSize), storage); }
+        BytesRange Data() const { return BytesRange(storage + nameSize, storage + nameSize + dataSize); }
+        chip::System::Clock::Timestamp Expiry() const;
+        std::optional<chip::System::Clock::Timestamp> NextRefresh() const;
+        uint32_t RemainingTtlSeconds(chip::System::Clock::Timestamp now) const;
+    };
+
+    void AddRecord(const ResourceData & data, const BytesRange & packet, chip::Inet::InterfaceId interface,
+                   chip::System::Clock::Timestamp now);
+    void Remove(Entry & entry);
+    void RemoveExpired(chip::System::Clock::Timestamp now);
+    Entry * FindSlot(chip::System::Clock::Timestamp now);
+
+    template <typename Name>
+    CHIP_ERROR BuildInstanceResponseImpl(const Name & instanceName, chip::System::PacketBufferHandle & packet,
+                                         chip::Inet::InterfaceId & interface);
+    bool CopyInstanceName(size_t index, const FullQName & serviceName, uint8_t (&name)[kMaxNameSize], size_t & nameSize);
+    void MarkRecordsToRefresh();
+    bool IsFirstToRefresh(size_t index) const;
+
+    chip::System::Clock::ClockBase * mClock;
+    Entry mEntries[CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE];
+};
+
+} // namespace Minimal
+} // namespace mdns
+
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
@@ -0,0 +1,362 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/minimal_mdns/RecordCache.h>
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/ResponseBuilder.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/CHIPMem.h>
+
+#include <initializer_list>
+#include <stdio.h>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+using namespace mdns::Minimal;
+
+const QNamePart kServiceParts[]   = { "_matter", "_tcp", "local" };
+const QNamePart kInstanceParts[]  = { "ABCD1234ABCD1234-0000000000000001", "_matter", "_tcp", "local" };
+const QNamePart kHostParts[]      = { "AABBCCDDEEFF", "local" };
+const QNamePart kOtherHostParts[] = { "112233445566", "local" };
+const QNamePart kTxtParts[]       = { "SII=5000", "SAI=300" };
+
+const FullQName kServiceName(kServiceParts);
+const FullQName kInstanceName(kInstanceParts);
+const FullQName kHostName(kHostParts);
+const FullQName kOtherHostName(kOtherHostParts);
+
+constexpr uint32_t kTtlSeconds = 120;
+
+Inet::IPAddress MakeAddress(unsigned index)
+{
+    char text[Inet::IPAddress::kMaxStringLength];
+    snprintf(text, sizeof(text), "fe80::%x", index);
+
+    Inet::IPAddress address;
+    Inet::IPAddress::FromString(text, address);
+    return address;
+}
+
+/// Records the answers of a response.
+class ResponseContent : public ParserDelegate
+{
+public:
+    struct Answer
+    {
+        QType type;
+        uint64_t ttlSeconds;
+    };
+
+    bool isResponse = false;
+    std::vector<Answer> answers;
+
+    void OnHeader(ConstHeaderRef & header) override { isResponse = header.GetFlags().IsResponse(); }
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        answers.push_back({ data.GetType(), data.GetTtlSeconds() });
+    }
+
+    size_t Count(QType type) const
+    {
+        size_t count = 0;
+        for (const auto & answer : answers)
+        {
+            count += (answer.type == type) ? 1 : 0;
+        }
+        return count;
+    }
+};
+
+class TestRecordCache : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+protected:
+    void AddRecords(std::initializer_list<const ResourceRecord *> records)
+    {
+        ResponseBuilder builder(System::PacketBufferHandle::New(RecordCache::kMaxResponseSize));
+        for (const ResourceRecord * record : records)
+        {
+            builder.AddRecord(ResourceType::kAnswer, *record);
+        }
+        ASSERT_TRUE(builder.Ok());
+
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        mCache.AddPacket(BytesRange(packet->Start(), packet->Start() + packet->DataLength()), Inet::InterfaceId::Null());
+    }
+
+    void AddInstance(uint32_t ttlSeconds = kTtlSeconds)
+    {
+        PtrResourceRecord ptr(kServiceName, kInstanceName);
+        SrvResourceRecord srv(kInstanceName, kHostName, 5540);
+        TxtResourceRecord txt(kInstanceName, kTxtParts);
+        IPResourceRecord ip(kHostName, MakeAddress(1));
+
+        ptr.SetTtl(ttlSeconds);
+        srv.SetTtl(ttlSeconds);
+        txt.SetTtl(ttlSeconds);
+        ip.SetTtl(ttlSeconds);
+
+        AddRecords({ &ptr, &srv, &txt, &ip });
+    }
+
+    static ResponseContent Parse(const System::PacketBufferHandle & packet)
+    {
+        ResponseContent content;
+        EXPECT_TRUE(ParsePacket(BytesRange(packet->Start(), packet->Start() + packet->DataLength()), &content));
+        return content;
+    }
+
+    System::Clock::Internal::MockClock mClock;
+    RecordCache mCache{ &mClock };
+};
+
+TEST_F(TestRecordCache, AnswersInstanceFromCache)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    EXPECT_TRUE(mCache.IsEmpty());
+    EXPECT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_ERROR_NOT_FOUND);
+
+    AddInstance();
+    EXPECT_FALSE(mCache.IsEmpty());
+
+    ASSERT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_NO_ERROR);
+    ResponseContent content = Parse(packet);
+    EXPECT_TRUE(content.isResponse);
+    EXPECT_EQ(content.answers.size(), 3u);
+    EXPECT_EQ(content.Count(QType::SRV), 1u);
+    EXPECT_EQ(content.Count(QType::TXT), 1u);
+    EXPECT_EQ(content.Count(QType::AAAA), 1u);
+    for (const auto & answer : content.answers)
+    {
+        EXPECT_EQ(answer.ttlSeconds, kTtlSeconds);
+    }
+
+    // Answers carry the remaining TTL.
+    mClock.AdvanceMonotonic(50_s);
+    ASSERT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_NO_ERROR);
+    for (const auto & answer : Parse(packet).answers)
+    {
+        EXPECT_EQ(answer.ttlSeconds, kTtlSeconds - 50);
+    }
+
+    ASSERT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_NO_ERROR);
+    EXPECT_EQ(Parse(packet).Count(QType::AAAA), 1u);
+    EXPECT_EQ(mCache.BuildAddressResponse(kOtherHostName, packet, interface), CHIP_ERROR_NOT_FOUND);
+
+    size_t instanceCount = 0;
+    mCache.ForEachInstance(kServiceName, [&](const SerializedQNameIterator & instanceName) {
+        EXPECT_TRUE(instanceName == kInstanceName);
+        instanceCount++;
+    });
+    EXPECT_EQ(instanceCount, 1u);
+}
+
+TEST_F(TestRecordCache, NeedsServiceAndAddress)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    SrvResourceRecord srv(kInstanceName, kHostName, 5540);
+    AddRecords({ &srv });
+    EXPECT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_ERROR_NOT_FOUND);
+
+    // Addresses of other hosts do not help.
+    IPResourceRecord otherIp(kOtherHostName, MakeAddress(2));
+    AddRecords({ &otherIp });
+    EXPECT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_ERROR_NOT_FOUND);
+
+    IPResourceRecord ip(kHostName, MakeAddress(1));
+    AddRecords({ &ip });
+    ASSERT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_NO_ERROR);
+
+    ResponseContent content = Parse(packet);
+    EXPECT_EQ(content.answers.size(), 2u);
+    EXPECT_EQ(content.Count(QType::SRV), 1u);
+    EXPECT_EQ(content.Count(QType::AAAA), 1u);
+}
+
+TEST_F(TestRecordCache, ExpiresRecords)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    AddInstance();
+
+    mClock.AdvanceMonotonic(System::Clock::Seconds64(kTtlSeconds - 1));
+    ASSERT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_NO_ERROR);
+    for (const auto & answer : Parse(packet).answers)
+    {
+        EXPECT_EQ(answer.ttlSeconds, 1u);
+    }
+
+    mClock.AdvanceMonotonic(1_s);
+    EXPECT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_ERROR_NOT_FOUND);
+    EXPECT_TRUE(mCache.IsEmpty());
+}
+
+TEST_F(TestRecordCache, GoodbyeRemovesRecords)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    AddInstance();
+    IPResourceRecord otherIp(kHostName, MakeAddress(2));
+    AddRecords({ &otherIp });
+
+    ASSERT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_NO_ERROR);
+    EXPECT_EQ(Parse(packet).Count(QType::AAAA), 2u);
+
+    // Only the record with the same data goes away.
+    otherIp.SetTtl(0);
+    AddRecords({ &otherIp });
+    ASSERT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_NO_ERROR);
+    EXPECT_EQ(Parse(packet).Count(QType::AAAA), 1u);
+
+    SrvResourceRecord srv(kInstanceName, kHostName, 5540);
+    srv.SetTtl(0);
+    AddRecords({ &srv });
+    EXPECT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_ERROR_NOT_FOUND);
+}
+
+TEST_F(TestRecordCache, CacheFlushReplacesOlderRecords)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    IPResourceRecord ip1(kHostName, MakeAddress(1));
+    IPResourceRecord ip2(kHostName, MakeAddress(2));
+    IPResourceRecord ip3(kHostName, MakeAddress(3));
+    ip2.SetCacheFlush(true);
+    ip3.SetCacheFlush(true);
+
+    // Records of the same packet do not flush each other.
+    AddRecords({ &ip1 });
+    AddRecords({ &ip2, &ip3 });
+    ASSERT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_NO_ERROR);
+    EXPECT_EQ(Parse(packet).Count(QType::AAAA), 3u);
+
+    mClock.AdvanceMonotonic(2_s);
+    AddRecords({ &ip3 });
+    ASSERT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_NO_ERROR);
+    EXPECT_EQ(Parse(packet).Count(QType::AAAA), 1u);
+}
+
+TEST_F(TestRecordCache, RefreshesRecordsInUse)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    auto countRefreshes = [&](QType type) {
+        size_t count = 0;
+        mCache.ForEachRecordToRefresh([&](const SerializedQNameIterator & name, QType refreshType) {
+            count += (refreshType == type) ? 1 : 0;
+        });
+        return count;
+    };
+
+    // Records that did not answer anything are not refreshed.
+    AddInstance();
+    EXPECT_FALSE(mCache.GetTimeUntilNextRefresh().has_value());
+
+    ASSERT_EQ(mCache.BuildInstanceResponse(kInstanceName, packet, interface), CHIP_NO_ERROR);
+    EXPECT_EQ(mCache.GetTimeUntilNextRefresh(), std::make_optional<System::Clock::Timeout>(96000_ms32));
+
+    // 80% of the TTL
+    mClock.AdvanceMonotonic(96_s);
+    EXPECT_EQ(mCache.GetTimeUntilNextRefresh(), std::make_optional<System::Clock::Timeout>(0_ms32));
+
+    size_t srvCount  = 0;
+    size_t txtCount  = 0;
+    size_t aaaaCount = 0;
+    mCache.ForEachRecordToRefresh([&](const SerializedQNameIterator & name, QType type) {
+        srvCount += ((type == QType::SRV) && (name == kInstanceName)) ? 1 : 0;
+        txtCount += ((type == QType::TXT) && (name == kInstanceName)) ? 1 : 0;
+        aaaaCount += ((type == QType::AAAA) && (name == kHostName)) ? 1 : 0;
+    });
+    EXPECT_EQ(srvCount, 1u);
+    EXPECT_EQ(txtCount, 1u);
+    EXPECT_EQ(aaaaCount, 1u);
+    EXPECT_EQ(countRefreshes(QType::SRV), 0u);
+
+    // 85%, then 90% and 95% at once
+    EXPECT_EQ(mCache.GetTimeUntilNextRefresh(), std::make_optional<System::Clock::Timeout>(6000_ms32));
+    mClock.AdvanceMonotonic(6_s);
+    EXPECT_EQ(countRefreshes(QType::SRV), 1u);
+    mClock.AdvanceMonotonic(12_s);
+    EXPECT_EQ(countRefreshes(QType::SRV), 1u);
+    EXPECT_FALSE(mCache.GetTimeUntilNextRefresh().has_value());
+
+    // An answer to the refresh starts over, and keeps the records in use.
+    AddInstance();
+    EXPECT_EQ(mCache.GetTimeUntilNextRefresh(), std::make_optional<System::Clock::Timeout>(96000_ms32));
+}
+
+TEST_F(TestRecordCache, EvictsRecordsClosestToExpiry)
+{
+    System::PacketBufferHandle packet;
+    Inet::InterfaceId interface;
+
+    auto fill = [&]() {
+        for (unsigned i = 1; i < CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE; i++)
+        {
+            IPResourceRecord ip(kOtherHostName, MakeAddress(i));
+            ip.SetTtl(kTtlSeconds + i);
+            AddRecords({ &ip });
+        }
+    };
+
+    IPResourceRecord ip(kHostName, MakeAddress(0));
+    ip.SetTtl(kTtlSeconds);
+
+    AddRecords({ &ip });
+    fill();
+    EXPECT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_NO_ERROR);
+
+    IPResourceRecord extra(kOtherHostName, MakeAddress(CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE));
+    AddRecords({ &extra });
+    EXPECT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_NO_ERROR);
+
+    // Records that answered something are kept over the ones that did not.
+    mCache.Clear();
+    AddRecords({ &ip });
+    fill();
+    AddRecords({ &extra });
+    EXPECT_EQ(mCache.BuildAddressResponse(kHostName, packet, interface), CHIP_ERROR_NOT_FOUND);
+}
+
+} // namespace
+
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
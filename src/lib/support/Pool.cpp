@@ -20,6 +20,8 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/Pool.h>
 
+#include <type_traits>
+
 namespace chip {
 
 #if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -51,34 +53,80 @@ void HeapObjectPoolExitHandling::ExitHandler()
 
 namespace internal {
 
+namespace {
+
+template <typename T>
+size_t CountTrailingZeros(T word)
+{
+    static_assert(std::is_same<T, unsigned long>::value, "CountTrailingZeros is only needed for unsigned long");
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctzl(word));
+#else
+    size_t count = 0;
+    while ((word & 1) == 0)
+    {
+        word >>= 1;
+        count++;
+    }
+    return count;
+#endif // defined(__GNUC__)
+}
+
+} // namespace
+
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+StaticAllocatorBitmap::StaticAllocatorBitmap(void * storage, std::atomic<tBitChunkType> * usage,
+                                             std::atomic<tBitChunkType> * activeWords, size_t capacity, size_t elementSize) :
+    StaticAllocatorBase(capacity),
+    mElements(storage), mElementSize(elementSize), mUsage(usage), mActiveWords(activeWords)
+{
+    for (size_t word = 0; word < WordCountFor(WordCount()); ++word)
+    {
+        mActiveWords[word].store(0);
+    }
+#else
 StaticAllocatorBitmap::StaticAllocatorBitmap(void * storage, std::atomic<tBitChunkType> * usage, size_t capacity,
                                              size_t elementSize) :
     StaticAllocatorBase(capacity),
     mElements(storage), mElementSize(elementSize), mUsage(usage)
 {
-    for (size_t word = 0; word * kBitChunkSize < Capacity(); ++word)
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    for (size_t word = 0; word < WordCount(); ++word)
     {
         mUsage[word].store(0);
     }
 }
 
+StaticAllocatorBitmap::tBitChunkType StaticAllocatorBitmap::ValidBits(size_t word) const
+{
+    const size_t bits = Capacity() - word * kBitChunkSize;
+    return (bits >= kBitChunkSize) ? ~static_cast<tBitChunkType>(0) : ((kBit1 << bits) - 1);
+}
+
 void * StaticAllocatorBitmap::Allocate()
 {
-    for (size_t word = 0; word * kBitChunkSize < Capacity(); ++word)
+    // Start from the word of the last allocation or release, which is likely to have a free bit, and wrap around.
+    const size_t wordCount = WordCount();
+    size_t word            = mAllocationHint.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < wordCount; ++i, word = (word + 1 < wordCount) ? word + 1 : 0)
     {
         auto & usage = mUsage[word];
         auto value   = usage.load(std::memory_order_relaxed);
-        for (size_t offset = 0; offset < kBitChunkSize && offset + word * kBitChunkSize < Capacity(); ++offset)
+        for (tBitChunkType free = ~value & ValidBits(word); free != 0; free = ~value & ValidBits(word))
         {
-            if ((value & (kBit1 << offset)) == 0)
+            const size_t offset = CountTrailingZeros(free);
+            // On failure, value is updated to the current usage, in case of a race.
+            if (usage.compare_exchange_strong(value, value | (kBit1 << offset)))
             {
-                if (usage.compare_exchange_strong(value, value | (kBit1 << offset)))
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+                if ((value & ValidBits(word)) == 0)
                 {
-                    IncreaseUsage();
-                    return At(word * kBitChunkSize + offset);
+                    mActiveWords[word / kBitChunkSize].fetch_or(kBit1 << (word % kBitChunkSize));
                 }
-
-                value = usage.load(std::memory_order_relaxed); // if there is a race, update new usage
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+                mAllocationHint.store(word, std::memory_order_relaxed);
+                IncreaseUsage();
+                return At(word * kBitChunkSize + offset);
             }
         }
     }
@@ -96,6 +144,19 @@ void StaticAllocatorBitmap::Deallocate(void * element)
 
     auto value = mUsage[word].fetch_and(~(kBit1 << offset));
     VerifyOrDie((value & (kBit1 << offset)) != 0); // assert fail when free an unused slot
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    if ((value & ~(kBit1 << offset)) == 0)
+    {
+        const tBitChunkType summaryBit = kBit1 << (word % kBitChunkSize);
+        mActiveWords[word / kBitChunkSize].fetch_and(~summaryBit);
+        // An allocation may have raced with this release; it sets its usage bit before its summary bit.
+        if (mUsage[word].load() != 0)
+        {
+            mActiveWords[word / kBitChunkSize].fetch_or(summaryBit);
+        }
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    mAllocationHint.store(word, std::memory_order_relaxed);
     DecreaseUsage();
 }
 
@@ -109,62 +170,68 @@ size_t StaticAllocatorBitmap::IndexOf(void * element)
     return index;
 }
 
-Loop StaticAllocatorBitmap::ForEachActiveObjectInner(void * context, Lambda lambda)
+size_t StaticAllocatorBitmap::NextActiveWord(size_t word) const
 {
-    for (size_t word = 0; word * kBitChunkSize < Capacity(); ++word)
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    while (word < WordCount())
     {
-        auto & usage = mUsage[word];
-        auto value   = usage.load(std::memory_order_relaxed);
-        for (size_t offset = 0; offset < kBitChunkSize && offset + word * kBitChunkSize < Capacity(); ++offset)
+        const size_t summaryWord = word / kBitChunkSize;
+        auto value               = mActiveWords[summaryWord].load(std::memory_order_relaxed) >> (word % kBitChunkSize);
+        if (value != 0)
         {
-            if ((value & (kBit1 << offset)) != 0)
-            {
-                if (lambda(context, At(word * kBitChunkSize + offset)) == Loop::Break)
-                    return Loop::Break;
-            }
+            return word + CountTrailingZeros(value);
         }
+        word = (summaryWord + 1) * kBitChunkSize;
     }
-    return Loop::Finish;
+    return WordCount();
+#else
+    return word;
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
 }
 
-size_t StaticAllocatorBitmap::FirstActiveIndex()
+Loop StaticAllocatorBitmap::ForEachActiveObjectInner(void * context, Lambda lambda)
 {
-    size_t idx = 0;
-    for (size_t word = 0; word * kBitChunkSize < Capacity(); ++word)
+    for (size_t word = NextActiveWord(0); word < WordCount(); word = NextActiveWord(word + 1))
     {
         auto & usage = mUsage[word];
         auto value   = usage.load(std::memory_order_relaxed);
-        for (size_t offset = 0; offset < kBitChunkSize && offset + word * kBitChunkSize < Capacity(); ++offset)
+        while (value != 0)
         {
-            if ((value & (kBit1 << offset)) != 0)
-            {
-                return idx;
-            }
-            idx++;
+            const size_t offset = CountTrailingZeros(value);
+            value &= value - 1;
+            if (lambda(context, At(word * kBitChunkSize + offset)) == Loop::Break)
+                return Loop::Break;
+            // Do not visit objects of this word that were released by the lambda.
+            value &= usage.load(std::memory_order_relaxed);
         }
     }
-    VerifyOrDie(idx == mCapacity);
-    return mCapacity;
+    return Loop::Finish;
 }
 
-size_t StaticAllocatorBitmap::NextActiveIndexAfter(size_t start)
+size_t StaticAllocatorBitmap::NextActiveIndexFrom(size_t index)
 {
-    size_t idx = 0;
-    for (size_t word = 0; word * kBitChunkSize < Capacity(); ++word)
+    size_t word = index / kBitChunkSize;
+    VerifyOrReturnValue(word < WordCount(), mCapacity);
+
+    auto value = mUsage[word].load(std::memory_order_relaxed) & (~static_cast<tBitChunkType>(0) << (index % kBitChunkSize));
+    while (value == 0)
     {
-        auto & usage = mUsage[word];
-        auto value   = usage.load(std::memory_order_relaxed);
-        for (size_t offset = 0; offset < kBitChunkSize && offset + word * kBitChunkSize < Capacity(); ++offset)
-        {
-            if (((value & (kBit1 << offset)) != 0) && (start < idx))
-            {
-                return idx;
-            }
-            idx++;
-        }
+        word = NextActiveWord(word + 1);
+        VerifyOrReturnValue(word < WordCount(), mCapacity);
+        value = mUsage[word].load(std::memory_order_relaxed);
     }
-    VerifyOrDie(idx == mCapacity);
-    return mCapacity;
+    return word * kBitChunkSize + CountTrailingZeros(value);
+}
+
+size_t StaticAllocatorBitmap::FirstActiveIndex()
+{
+    return NextActiveIndexFrom(0);
+}
+
+size_t StaticAllocatorBitmap::NextActiveIndexAfter(size_t start)
+{
+    VerifyOrReturnValue(start < mCapacity, mCapacity);
+    return NextActiveIndexFrom(start + 1);
 }
 
 #if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -87,9 +87,16 @@ protected:
     static_assert(ATOMIC_LONG_LOCK_FREE, "StaticAllocatorBitmap is not lock free");
 
 public:
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    StaticAllocatorBitmap(void * storage, std::atomic<tBitChunkType> * usage, std::atomic<tBitChunkType> * activeWords,
+                          size_t capacity, size_t elementSize);
+#else
     StaticAllocatorBitmap(void * storage, std::atomic<tBitChunkType> * usage, size_t capacity, size_t elementSize);
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
 
 protected:
+    static constexpr size_t WordCountFor(size_t bits) { return (bits + kBitChunkSize - 1) / kBitChunkSize; }
+
     void * Allocate();
     void Deallocate(void * element);
     void * At(size_t index) { return static_cast<uint8_t *>(mElements) + mElementSize * index; }
@@ -113,9 +120,26 @@ protected:
     }
 
 private:
+    size_t WordCount() const { return WordCountFor(Capacity()); }
+
+    /// Mask of the bits of a usage word that correspond to elements of the pool.
+    tBitChunkType ValidBits(size_t word) const;
+
+    /// Returns the first usage word at or after `word` that may have active elements, or WordCount() if there is none.
+    size_t NextActiveWord(size_t word) const;
+
+    /// Returns the first active index at or after `index`, or mCapacity if there is none.
+    size_t NextActiveIndexFrom(size_t index);
+
     void * mElements;
     const size_t mElementSize;
     std::atomic<tBitChunkType> * mUsage;
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    /// One bit per usage word, set while that word has active elements.
+    std::atomic<tBitChunkType> * mActiveWords;
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    /// Usage word where the next allocation starts looking: the last word that was allocated from or freed into.
+    std::atomic<size_t> mAllocationHint{ 0 };
 
     /// allow accessing direct At() calls
     template <class T>
@@ -263,7 +287,11 @@ template <class T, size_t N>
 class BitMapObjectPool : public internal::StaticAllocatorBitmap
 {
 public:
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    BitMapObjectPool() : StaticAllocatorBitmap(mData.mMemory, mUsage, mActiveWords, N, sizeof(T)) {}
+#else
     BitMapObjectPool() : StaticAllocatorBitmap(mData.mMemory, mUsage, N, sizeof(T)) {}
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
     ~BitMapObjectPool() { VerifyOrDieWithObject(Allocated() == 0, this); }
 
     BitmapActiveObjectIterator<T> begin() { return BitmapActiveObjectIterator<T>(this, FirstActiveIndex()); }
@@ -343,7 +371,10 @@ private:
         return Loop::Continue;
     }
 
-    std::atomic<tBitChunkType> mUsage[(N + kBitChunkSize - 1) / kBitChunkSize];
+    std::atomic<tBitChunkType> mUsage[WordCountFor(N)];
+#if CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+    std::atomic<tBitChunkType> mActiveWords[WordCountFor(WordCountFor(N))];
+#endif // CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
     union Data
     {
         Data() {}
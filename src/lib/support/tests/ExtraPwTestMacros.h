@@ -20,6 +20,10 @@
 
 #include <pw_unit_test/framework.h>
 
+#include <system/SystemClock.h>
+
+#include <cstdlib>
+
 /**
  * Run Fixture's class function as a test.
  *
@@ -81,6 +85,48 @@
  */
 #define ASSERT_SUCCESS(expr) ASSERT_EQ((expr), CHIP_NO_ERROR)
 
+/**
+ * Skip the current test unless the CHIP_TEST_RUN_BENCHMARKS environment variable is set.
+ *
+ * Timed benchmarks use this to stay out of the default unit test runs, since they take long and their
+ * results are only meaningful on an otherwise idle machine.
+ */
+#define SKIP_UNLESS_BENCHMARKS_ENABLED()                                                                                           \
+    if (std::getenv("CHIP_TEST_RUN_BENCHMARKS") != nullptr)                                                                        \
+        ;                                                                                                                          \
+    else                                                                                                                           \
+        GTEST_SKIP() << "Set CHIP_TEST_RUN_BENCHMARKS to run this benchmark"
+
+namespace chip {
+namespace Testing {
+
+/**
+ * Measures the time taken by the sections of a benchmark on the monotonic system clock.
+ *
+ * Example:
+ *   BenchmarkTimer timer;
+ *   RunScan();
+ *   const System::Clock::Microseconds64 scanTime = timer.Elapsed();
+ *   timer.Restart();
+ *   RunIndexedLookup();
+ *   const System::Clock::Microseconds64 indexTime = timer.Elapsed();
+ */
+class BenchmarkTimer
+{
+public:
+    BenchmarkTimer() { Restart(); }
+
+    void Restart() { mStart = System::SystemClock().GetMonotonicMicroseconds64(); }
+
+    System::Clock::Microseconds64 Elapsed() const { return System::SystemClock().GetMonotonicMicroseconds64() - mStart; }
+
+private:
+    System::Clock::Microseconds64 mStart;
+};
+
+} // namespace Testing
+} // namespace chip
+
 // Override ASSERT_TRUE and ASSERT_FALSE from pw_unit_test in a way that
 // is friendly to static analysis tools like clang-tidy. The problem with
 // the default implementation (in both the light and googletest backends)
@@ -23,6 +23,7 @@
  *
  */
 
+#include <memory>
 #include <set>
 
 #include <pw_unit_test/framework.h>
@@ -30,6 +31,9 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/Pool.h>
 #include <lib/support/PoolWrapper.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
+#include <system/SystemClock.h>
 #include <system/SystemConfig.h>
 
 namespace chip {
@@ -589,4 +593,119 @@ TEST_F(TestPool, TestPoolAutoReleaseDynamic)
 }
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
+TEST_F(TestPool, TestBitMapObjectPoolSparse)
+{
+    // Large enough to span several usage words, and several summary words when those are enabled.
+    constexpr size_t kSize = 5000;
+    auto pool              = std::make_unique<BitMapObjectPool<uint32_t, kSize>>();
+    uint32_t * objs[kSize];
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        objs[i] = pool->CreateObject(static_cast<uint32_t>(i));
+        ASSERT_NE(objs[i], nullptr);
+    }
+    EXPECT_EQ(pool->CreateObject(0u), nullptr);
+
+    // In a full pool, a released slot is found by the next allocation.
+    pool->ReleaseObject(objs[kSize - 2]);
+    objs[kSize - 2] = pool->CreateObject(static_cast<uint32_t>(kSize - 2));
+    ASSERT_NE(objs[kSize - 2], nullptr);
+    EXPECT_EQ(pool->CreateObject(0u), nullptr);
+
+    // Keep a few objects far apart from each other.
+    const std::set<size_t> kept = { 0, 63, 64, 1000, 4095, 4096, kSize - 1 };
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        if (kept.count(i) == 0)
+        {
+            pool->ReleaseObject(objs[i]);
+        }
+    }
+    EXPECT_EQ(pool->Allocated(), kept.size());
+
+    std::set<uint32_t> visited;
+    pool->ForEachActiveObject([&visited](uint32_t * object) {
+        visited.insert(*object);
+        return Loop::Continue;
+    });
+    EXPECT_EQ(visited, std::set<uint32_t>(kept.begin(), kept.end()));
+
+    visited.clear();
+    for (auto * object : *pool)
+    {
+        visited.insert(*object);
+    }
+    EXPECT_EQ(visited, std::set<uint32_t>(kept.begin(), kept.end()));
+
+    // Releasing objects other than the current one during iteration must not visit them.
+    size_t count = 0;
+    pool->ForEachActiveObject([&](uint32_t * object) {
+        ++count;
+        if (*object == 63)
+        {
+            pool->ReleaseObject(objs[64]);
+            pool->ReleaseObject(objs[1000]);
+        }
+        return Loop::Continue;
+    });
+    EXPECT_EQ(count, kept.size() - 2);
+    EXPECT_EQ(GetNumObjectsInUse(*pool), kept.size() - 2);
+
+    pool->ReleaseAll();
+    EXPECT_EQ(GetNumObjectsInUse(*pool), 0u);
+    EXPECT_EQ(pool->begin(), pool->end());
+}
+
+TEST_F(TestPool, BenchmarkBitMapObjectPool)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    constexpr size_t kSize       = 4096;
+    constexpr size_t kIterations = 10000;
+    auto pool                    = std::make_unique<BitMapObjectPool<uint32_t, kSize>>();
+    uint32_t * objs[kSize];
+
+    // Allocation churn in a nearly full pool, with the free slot towards its end.
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        objs[i] = pool->CreateObject(static_cast<uint32_t>(i));
+    }
+    Testing::BenchmarkTimer timer;
+    for (size_t i = 0; i < kIterations; ++i)
+    {
+        const size_t index = kSize - 1 - (i % 64);
+        pool->ReleaseObject(objs[index]);
+        objs[index] = pool->CreateObject(static_cast<uint32_t>(index));
+    }
+    const System::Clock::Microseconds64 churnTime = timer.Elapsed();
+    EXPECT_EQ(pool->Allocated(), kSize);
+
+    // Iteration over a sparse pool.
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        if ((i % 512) != 0)
+        {
+            pool->ReleaseObject(objs[i]);
+        }
+    }
+    size_t visited = 0;
+    timer.Restart();
+    for (size_t i = 0; i < kIterations; ++i)
+    {
+        pool->ForEachActiveObject([&visited](uint32_t *) {
+            ++visited;
+            return Loop::Continue;
+        });
+    }
+    const System::Clock::Microseconds64 iterateTime = timer.Elapsed();
+    EXPECT_EQ(visited, kIterations * kSize / 512);
+
+    ChipLogProgress(Support, "BitMapObjectPool<%u>: release+create when full %u ns, iterate %u live objects %u ns",
+                    static_cast<unsigned>(kSize), static_cast<unsigned>(churnTime.count() * 1000 / kIterations),
+                    static_cast<unsigned>(kSize / 512), static_cast<unsigned>(iterateTime.count() * 1000 / kIterations));
+
+    pool->ReleaseAll();
+}
+
 } // namespace
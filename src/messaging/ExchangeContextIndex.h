@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+#include <messaging/ExchangeContext.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Messaging {
+
+/**
+ * Open-addressing index over the exchanges of an ExchangeManager, by exchange id.
+ *
+ * Exchange ids are only unique per session and role, so the index may hold several exchanges with the same id; they
+ * are all found in the probe sequence of that id, and the caller still has to match the session of each candidate.
+ * Like SecureSessionIndex, it uses linear probing with backward-shift deletion and a load factor of at most 50%.
+ *
+ * The index does not own the exchanges. The owner must Insert() an exchange once it is allocated and Remove() it
+ * before it is released. If more than kMaxExchanges exchanges are inserted, the index becomes unusable until it is
+ * cleared, and the owner has to fall back to scanning its exchanges.
+ */
+template <size_t kMaxExchanges>
+class ExchangeContextIndex
+{
+    static constexpr size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+public:
+    static constexpr size_t kCapacity = RoundUpToPowerOfTwo(2 * kMaxExchanges);
+
+    bool IsUsable() const { return !mOverflow; }
+
+    size_t Count() const { return mCount; }
+
+    void Clear()
+    {
+        for (auto & slot : mSlots)
+        {
+            slot = Slot();
+        }
+        mCount    = 0;
+        mOverflow = false;
+    }
+
+    /**
+     * @retval CHIP_ERROR_NO_MEMORY if the index is full; it is then unusable until the next Clear().
+     */
+    CHIP_ERROR Insert(ExchangeContext & exchange)
+    {
+        VerifyOrReturnError(!mOverflow, CHIP_ERROR_INCORRECT_STATE);
+        if (mCount >= kMaxExchanges)
+        {
+            mOverflow = true;
+            return CHIP_ERROR_NO_MEMORY;
+        }
+
+        size_t i = HomeOf(exchange.GetExchangeId());
+        while (mSlots[i].mExchange != nullptr)
+        {
+            i = (i + 1) & kMask;
+        }
+        mSlots[i] = Slot{ &exchange, exchange.GetExchangeId() };
+        mCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void Remove(ExchangeContext & exchange)
+    {
+        VerifyOrReturn(!mOverflow);
+
+        size_t index = HomeOf(exchange.GetExchangeId());
+        while (mSlots[index].mExchange != &exchange)
+        {
+            VerifyOrReturn(mSlots[index].mExchange != nullptr);
+            index = (index + 1) & kMask;
+        }
+
+        // Shift later entries of the probe sequence back into the hole, unless their home slot lies after the hole.
+        size_t hole = index;
+        for (size_t next = (hole + 1) & kMask; mSlots[next].mExchange != nullptr; next = (next + 1) & kMask)
+        {
+            if (((next - HomeOf(mSlots[next].mExchangeId)) & kMask) >= ((next - hole) & kMask))
+            {
+                mSlots[hole] = mSlots[next];
+                hole         = next;
+            }
+        }
+        mSlots[hole] = Slot();
+        mCount--;
+    }
+
+    /**
+     * Invoke @p fn for every exchange whose id is @p exchangeId. @p fn returns Loop::Continue or Loop::Break, and must
+     * not release exchanges.
+     */
+    template <typename Function>
+    Loop ForEachWithExchangeId(uint16_t exchangeId, Function && fn) const
+    {
+        VerifyOrDie(!mOverflow);
+
+        for (size_t i = HomeOf(exchangeId); mSlots[i].mExchange != nullptr; i = (i + 1) & kMask)
+        {
+            if (mSlots[i].mExchangeId == exchangeId)
+            {
+                VerifyOrReturnValue(fn(mSlots[i].mExchange) == Loop::Continue, Loop::Break);
+            }
+        }
+        return Loop::Finish;
+    }
+
+private:
+    static constexpr size_t kMask = kCapacity - 1;
+
+    struct Slot
+    {
+        ExchangeContext * mExchange = nullptr;
+        uint16_t mExchangeId        = 0;
+    };
+
+    // Our own exchange ids are handed out sequentially and the peers' are random, so both spread evenly over the
+    // slots as they are.
+    static size_t HomeOf(uint16_t exchangeId) { return exchangeId & kMask; }
+
+    Slot mSlots[kCapacity];
+    size_t mCount  = 0;
+    bool mOverflow = false;
+};
+
+} // namespace Messaging
+} // namespace chip
@@ -125,7 +125,57 @@ ExchangeContext * ExchangeManager::NewContext(const SessionHandle & session, Exc
         // Disallow creating exchange on an inactive session
         return nullptr;
     }
-    return mContextPool.CreateObject(this, mNextExchangeId++, session, isInitiator, delegate);
+    return CreateContext(mNextExchangeId++, session, isInitiator, delegate);
+}
+
+void ExchangeManager::ReleaseContext(ExchangeContext * ec)
+{
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+    mContextIndex.Remove(*ec);
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+
+    mContextPool.ReleaseObject(ec);
+
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+    if (!mContextIndex.IsUsable() && mContextPool.Allocated() <= CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS)
+    {
+        mContextIndex.Clear();
+        mContextPool.ForEachActiveObject([this](ExchangeContext * context) {
+            return mContextIndex.Insert(*context) == CHIP_NO_ERROR ? Loop::Continue : Loop::Break;
+        });
+    }
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+}
+
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
+{
+    ExchangeContext * found = nullptr;
+
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+    if (mContextIndex.IsUsable())
+    {
+        mContextIndex.ForEachWithExchangeId(payloadHeader.GetExchangeID(), [&](ExchangeContext * ec) {
+            if (ec->MatchExchange(session, packetHeader, payloadHeader))
+            {
+                found = ec;
+                return Loop::Break;
+            }
+            return Loop::Continue;
+        });
+        return found;
+    }
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+
+    mContextPool.ForEachActiveObject([&](ExchangeContext * ec) {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            found = ec;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
 }
 
 CHIP_ERROR ExchangeManager::RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId,
@@ -291,24 +341,15 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                TEMPORARY_RETURN_IGNORED ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags,
-                                                           std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindExchange(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            TEMPORARY_RETURN_IGNORED ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags,
+                                                       std::move(msgBuf));
             return;
         }
     }
@@ -391,7 +432,7 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
             return;
         }
 
-        ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, false, delegate);
+        ExchangeContext * ec = CreateContext(payloadHeader.GetExchangeID(), session, false, delegate);
 
         if (ec == nullptr)
         {
@@ -450,8 +491,8 @@ void ExchangeManager::SendStandaloneAckIfNeeded(const PacketHeader & packetHeade
     // If rcvd msg is from initiator then this exchange is created as not Initiator.
     // If rcvd msg is not from initiator then this exchange is created as Initiator.
     // Create a EphemeralExchange to generate a StandaloneAck
-    ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(),
-                                                     nullptr, true /* IsEphemeralExchange */);
+    ExchangeContext * ec = CreateContext(payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(), nullptr,
+                                         true /* IsEphemeralExchange */);
 
     if (ec == nullptr)
     {
@@ -30,6 +30,7 @@
 #include <lib/support/Pool.h>
 #include <lib/support/TypeTraits.h>
 #include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeContextIndex.h>
 #include <messaging/ReliableMessageMgr.h>
 #include <protocols/Protocols.h>
 #include <transport/SessionManager.h>
@@ -111,7 +112,7 @@ public:
      */
     ExchangeContext * NewContext(const SessionHandle & session, ExchangeDelegate * delegate, bool isInitiator = true);
 
-    void ReleaseContext(ExchangeContext * ec) { mContextPool.ReleaseObject(ec); }
+    void ReleaseContext(ExchangeContext * ec);
 
     /**
      *  Register an unsolicited message handler for a given protocol identifier. This handler would be
@@ -251,6 +252,9 @@ private:
     FabricIndex mFabricIndex = 0;
 
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+    ExchangeContextIndex<CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextIndex;
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
 
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
@@ -265,6 +269,23 @@ private:
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType,
                              Messaging::UnsolicitedMessageHandler ** outHandler = nullptr);
 
+    template <typename... Args>
+    ExchangeContext * CreateContext(Args &&... args)
+    {
+        ExchangeContext * ec = mContextPool.CreateObject(this, std::forward<Args>(args)...);
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+        if (ec != nullptr && mContextIndex.IsUsable())
+        {
+            // On failure the index stays unusable, and lookups scan the pool, until ReleaseContext() can rebuild it.
+            RETURN_SAFELY_IGNORED mContextIndex.Insert(*ec);
+        }
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX
+        return ec;
+    }
+
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
+
     void OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader, const SessionHandle & session,
                            DuplicateMessage isDuplicate, System::PacketBufferHandle && msgBuf) override;
     void SendStandaloneAckIfNeeded(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
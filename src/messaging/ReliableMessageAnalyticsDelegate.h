@@ -76,6 +76,11 @@ public:
         // that have elapsed between when the initial message was sent and when we received
         // acknowledgment for the message.
         std::optional<System::Clock::Milliseconds64> ackLatencyMs;
+        // When eventType is kAcknowledged and the round-trip time of the session is measured (see
+        // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT), these will be populated with the smoothed round-trip time
+        // and its variation, including the sample taken from this message, if it was not retransmitted.
+        std::optional<System::Clock::Milliseconds32> smoothedRtt;
+        std::optional<System::Clock::Milliseconds32> rttVariation;
     };
 
     virtual void OnTransmitEvent(const TransmitEvent & event) = 0;
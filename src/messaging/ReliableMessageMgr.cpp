@@ -21,6 +21,7 @@
  *
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <inttypes.h>
 
@@ -49,6 +50,9 @@ namespace chip {
 namespace Messaging {
 
 System::Clock::Timeout ReliableMessageMgr::sAdditionalMRPBackoffTime = CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST;
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+bool ReliableMessageMgr::sAdaptiveRetransTimeoutEnabled = false;
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
     ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
@@ -135,6 +139,14 @@ void ReliableMessageMgr::NotifyMessageSendAnalytics(const RetransTableEntry & en
     {
         auto now           = System::SystemClock().GetMonotonicTimestamp();
         event.ackLatencyMs = now - entry.initialSentTime;
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+        const auto & rttEstimator = sessionHandle->GetRttEstimator();
+        if (rttEstimator.HasSamples())
+        {
+            event.smoothedRtt  = rttEstimator.GetSmoothedRtt();
+            event.rttVariation = rttEstimator.GetRttVariation();
+        }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     }
 
     mAnalyticsDelegate->OnTransmitEvent(event);
@@ -329,8 +341,10 @@ System::Clock::Timeout ReliableMessageMgr::GetBackoff(System::Clock::Timeout bas
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
     CalculateNextRetransTime(*entry);
-#if CHIP_CONFIG_MRP_ANALYTICS_ENABLED
+#if CHIP_CONFIG_MRP_ANALYTICS_ENABLED || CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     entry->initialSentTime = System::SystemClock().GetMonotonicTimestamp();
+#endif // CHIP_CONFIG_MRP_ANALYTICS_ENABLED || CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+#if CHIP_CONFIG_MRP_ANALYTICS_ENABLED
     NotifyMessageSendAnalytics(*entry, entry->ec->GetSessionHandle(), ReliableMessageAnalyticsDelegate::EventType::kInitialSend);
 #endif // CHIP_CONFIG_MRP_ANALYTICS_ENABLED
     StartTimer();
@@ -342,6 +356,15 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
         {
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+            // Acknowledgements of retransmitted messages cannot be matched to one transmission, so they are not sampled
+            // (Karn's algorithm).
+            if (entry->sendCount == 0 && entry->ec->HasSessionHandle())
+            {
+                entry->ec->GetSessionHandle()->GetRttEstimator().AddSample(System::SystemClock().GetMonotonicTimestamp() -
+                                                                           entry->initialSentTime);
+            }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 #if CHIP_CONFIG_MRP_ANALYTICS_ENABLED
             auto session = entry->ec->GetSessionHandle();
             NotifyMessageSendAnalytics(*entry, session, ReliableMessageAnalyticsDelegate::EventType::kAcknowledged);
@@ -538,6 +561,26 @@ void ReliableMessageMgr::SetAdditionalMRPBackoffTime(const Optional<System::Cloc
     sAdditionalMRPBackoffTime = additionalTime.ValueOr(CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST);
 }
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+System::Clock::Timeout ReliableMessageMgr::GetAdaptiveBaseTimeout(const SessionHandle & session, System::Clock::Timeout baseTimeout)
+{
+    const auto & rttEstimator = session->GetRttEstimator();
+    const auto & config       = session->GetRemoteMRPConfig();
+
+    // An idle peer may be asleep for up to its idle interval, which the round-trip times measured while it was
+    // active say nothing about, so its idle interval is kept.
+    if (!sAdaptiveRetransTimeoutEnabled || !rttEstimator.HasSamples() || baseTimeout != config.mActiveRetransTimeout)
+    {
+        return baseTimeout;
+    }
+
+    const System::Clock::Timeout upperBound = std::max(config.mActiveRetransTimeout, config.mIdleRetransTimeout);
+    const System::Clock::Timeout timeout =
+        std::max<System::Clock::Timeout>(rttEstimator.GetRetransTimeout(), CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRANS_TIMEOUT);
+    return std::min(timeout, upperBound);
+}
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 {
     const auto sessionHandle = entry.ec->GetSessionHandle();
@@ -564,6 +607,9 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
     // Active window and IdleRetransTimeout (SII) afterward, which is the
     // behavior the spec actually prescribes.
     System::Clock::Timeout baseTimeout = sessionHandle->GetMRPBaseTimeout();
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    baseTimeout = GetAdaptiveBaseTimeout(sessionHandle, baseTimeout);
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 
     System::Clock::Timeout backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime          = System::SystemClock().GetMonotonicTimestamp() + backoff;
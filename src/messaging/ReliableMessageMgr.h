@@ -67,9 +67,9 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
-#if CHIP_CONFIG_MRP_ANALYTICS_ENABLED
+#if CHIP_CONFIG_MRP_ANALYTICS_ENABLED || CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
         System::Clock::Timestamp initialSentTime; /**< Timestamp when the initial message was sent */
-#endif                                            // CHIP_CONFIG_MRP_ANALYTICS_ENABLED
+#endif                                            // CHIP_CONFIG_MRP_ANALYTICS_ENABLED || CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     };
 
     ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
@@ -234,6 +234,26 @@ public:
      */
     static void SetAdditionalMRPBackoffTime(const Optional<System::Clock::Timeout> & additionalTime);
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    /**
+     * Set whether the base retransmission timeout of a session is derived from the round-trip time measured on it,
+     * in place of the interval advertised by the peer.
+     *
+     * This is only done while the peer is active, and the result is kept between
+     * CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRANS_TIMEOUT and the larger of the intervals advertised by the peer. The round-trip
+     * time is measured whether this is set or not.
+     *
+     * This is a static, like SetAdditionalMRPBackoffTime, so that it can be set before bringing up the stack.
+     */
+    static void SetAdaptiveRetransTimeoutEnabled(bool enabled) { sAdaptiveRetransTimeoutEnabled = enabled; }
+
+    /**
+     * The base interval to use for the backoff calculation of a message sent on @p session, given the base interval
+     * @p baseTimeout chosen from the intervals advertised by the peer.
+     */
+    static System::Clock::Timeout GetAdaptiveBaseTimeout(const SessionHandle & session, System::Clock::Timeout baseTimeout);
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 private:
     /**
      * Calculates the next retransmission time for the entry
@@ -272,6 +292,9 @@ private:
 #endif // CHIP_CONFIG_MRP_ANALYTICS_ENABLED
 
     static System::Clock::Timeout sAdditionalMRPBackoffTime;
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    static bool sAdaptiveRetransTimeoutEnabled;
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 };
 
 } // namespace Messaging
@@ -183,6 +183,20 @@ namespace chip {
 #endif
 #endif // CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST
 
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    The lowest base retransmission timeout that the present node derives from the measured round-trip time of a
+ *    session, when adaptive retransmission timeouts are enabled.
+ *
+ *  A peer may hold its acknowledgement for up to its standalone acknowledgement timeout when it has no message to
+ *  piggyback it on, so timeouts below that would retransmit messages that were received.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRANS_TIMEOUT
+#define CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRANS_TIMEOUT (250_ms32)
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRANS_TIMEOUT
+
 inline constexpr System::Clock::Milliseconds32 kDefaultActiveTime = System::Clock::Milliseconds16(4000);
 
 /**
@@ -0,0 +1,97 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the round-trip time estimator that the CHIP reliable
+ *      message protocol keeps for each session.
+ */
+
+#pragma once
+
+#include <system/SystemClock.h>
+
+#include <algorithm>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ * Smoothed round-trip time (SRTT) and round-trip time variation (RTTVAR) of the messages sent on a session, computed as in
+ * RFC 6298 section 2 with alpha = 1/8 and beta = 1/4.
+ *
+ * Samples are the times between the first transmission of a message and its acknowledgement. Messages that were
+ * retransmitted must not be sampled, since their acknowledgement cannot be matched to one transmission (Karn's algorithm).
+ *
+ * The values are kept scaled by 8 and 4 respectively, so that the updates only use integer additions and shifts.
+ */
+class ReliableMessageRttEstimator
+{
+public:
+    void AddSample(System::Clock::Milliseconds64 rtt)
+    {
+        const int64_t sample = static_cast<int64_t>(std::min<uint64_t>(static_cast<uint64_t>(rtt.count()), kMaxSampleMs));
+
+        if (!mHasSamples)
+        {
+            // SRTT <- R, RTTVAR <- R/2
+            mScaledSmoothedRtt  = sample << 3;
+            mScaledRttVariation = sample << 1;
+            mHasSamples         = true;
+            return;
+        }
+
+        // RTTVAR <- (1 - beta) * RTTVAR + beta * |SRTT - R'|, then SRTT <- (1 - alpha) * SRTT + alpha * R'
+        const int64_t delta = sample - (mScaledSmoothedRtt >> 3);
+        mScaledRttVariation += ((delta < 0) ? -delta : delta) - (mScaledRttVariation >> 2);
+        mScaledSmoothedRtt += delta;
+    }
+
+    bool HasSamples() const { return mHasSamples; }
+
+    void Reset() { *this = ReliableMessageRttEstimator(); }
+
+    System::Clock::Milliseconds32 GetSmoothedRtt() const
+    {
+        return System::Clock::Milliseconds32(static_cast<uint32_t>(mScaledSmoothedRtt >> 3));
+    }
+
+    System::Clock::Milliseconds32 GetRttVariation() const
+    {
+        return System::Clock::Milliseconds32(static_cast<uint32_t>(mScaledRttVariation >> 2));
+    }
+
+    /**
+     * The retransmission timeout, RTO <- SRTT + max(G, K * RTTVAR), with K = 4 and a clock granularity G of 1 ms. It has
+     * no meaning before the first sample.
+     */
+    System::Clock::Milliseconds32 GetRetransTimeout() const
+    {
+        const int64_t variation = (mScaledRttVariation > 1) ? mScaledRttVariation : 1;
+        return System::Clock::Milliseconds32(static_cast<uint32_t>((mScaledSmoothedRtt >> 3) + variation));
+    }
+
+private:
+    // Keeps the scaled values, and the timeout computed from them, within 32 bits.
+    static constexpr uint64_t kMaxSampleMs = UINT32_MAX / 16;
+
+    int64_t mScaledSmoothedRtt  = 0; // SRTT * 8
+    int64_t mScaledRttVariation = 0; // RTTVAR * 4
+    bool mHasSamples            = false;
+};
+
+} // namespace chip
@@ -29,12 +29,14 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/tests/ExtraPwTestMacros.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeMgr.h>
 #include <messaging/Flags.h>
 #include <messaging/tests/MessagingContext.h>
 #include <protocols/Protocols.h>
+#include <system/SystemClock.h>
 #include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
 
@@ -352,4 +354,110 @@ TEST_F(TestExchangeMgr, CheckUmhEncryptionMismatchCleanup)
     }
 }
 
+// Plays both ends of a request/response exchange with every simulated peer, replying until a shared budget of
+// replies is spent.
+class PingPongDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        mMessagesReceived++;
+        VerifyOrReturnError(mRepliesLeft > 0, CHIP_NO_ERROR);
+        mRepliesLeft--;
+        return Ping(ec);
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    static CHIP_ERROR Ping(ExchangeContext * ec)
+    {
+        return ec->SendMessage(
+            Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(64),
+            SendFlags(Messaging::SendMessageFlags::kExpectResponse).Set(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+
+    size_t mMessagesReceived = 0;
+    size_t mRepliesLeft      = 0;
+};
+
+TEST_F(TestExchangeMgr, BenchmarkDispatchWithManyPeers)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    // This measures the cost per message on the single event loop as the number of peers grows, up to as many peers as
+    // the secure session pool can hold next to the sessions of the messaging context.
+    static constexpr size_t kMaxPeers     = CHIP_CONFIG_SECURE_SESSION_POOL_SIZE / 2;
+    static constexpr size_t kRoundTrips   = 200;
+    static constexpr uint16_t kFirstKeyId = 1000;
+    static constexpr NodeId kFirstPeerId  = 0x1000;
+
+    size_t freeSessions = CHIP_CONFIG_SECURE_SESSION_POOL_SIZE;
+    GetSecureSessionManager().GetSecureSessions().ForEachSession([&freeSessions](auto *) {
+        freeSessions--;
+        return Loop::Continue;
+    });
+    const size_t peerCounts[] = { 1, 4, 16, freeSessions / 2 };
+
+    PingPongDelegate delegate;
+    EXPECT_SUCCESS(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &delegate));
+
+    for (size_t peerCount : peerCounts)
+    {
+        ASSERT_LE(peerCount, kMaxPeers);
+
+        // Each simulated peer gets a session from the controller and the matching session back, over the loopback.
+        SessionManager & sessionManager = GetSecureSessionManager();
+        SessionHolder toPeer[kMaxPeers];
+        SessionHolder fromPeer[kMaxPeers];
+        for (size_t i = 0; i < peerCount; i++)
+        {
+            const auto controllerKeyId = static_cast<uint16_t>(kFirstKeyId + 2 * i);
+            const auto peerKeyId       = static_cast<uint16_t>(controllerKeyId + 1);
+            ASSERT_EQ(sessionManager.InjectPaseSessionWithTestKey(toPeer[i], controllerKeyId, kFirstPeerId + i, peerKeyId,
+                                                                  GetAliceFabricIndex(), GetBobAddress(),
+                                                                  CryptoContext::SessionRole::kInitiator),
+                      CHIP_NO_ERROR);
+            ASSERT_EQ(sessionManager.InjectPaseSessionWithTestKey(fromPeer[i], peerKeyId, GetAliceFabric()->GetNodeId(),
+                                                                  controllerKeyId, GetBobFabricIndex(), GetAliceAddress(),
+                                                                  CryptoContext::SessionRole::kResponder),
+                      CHIP_NO_ERROR);
+        }
+
+        delegate.mMessagesReceived = 0;
+        delegate.mRepliesLeft      = 2 * kRoundTrips * peerCount - peerCount;
+
+        Testing::BenchmarkTimer timer;
+        for (size_t i = 0; i < peerCount; i++)
+        {
+            ExchangeContext * ec = GetExchangeManager().NewContext(toPeer[i].Get().Value(), &delegate);
+            ASSERT_NE(ec, nullptr);
+            EXPECT_SUCCESS(PingPongDelegate::Ping(ec));
+        }
+        DrainAndServiceIO();
+        const System::Clock::Microseconds64 elapsed = timer.Elapsed();
+
+        EXPECT_EQ(delegate.mMessagesReceived, 2 * kRoundTrips * peerCount);
+        const size_t messages = delegate.mMessagesReceived ? delegate.mMessagesReceived : 1;
+        ChipLogProgress(Test, "%u peers: %u messages, %u ns per message", static_cast<unsigned>(peerCount),
+                        static_cast<unsigned>(delegate.mMessagesReceived),
+                        static_cast<unsigned>(elapsed.count() * 1000 / messages));
+
+        GetExchangeManager().CloseAllContextsForDelegate(&delegate);
+        for (size_t i = 0; i < peerCount; i++)
+        {
+            toPeer[i]->AsSecureSession()->MarkForEviction();
+            fromPeer[i]->AsSecureSession()->MarkForEviction();
+        }
+    }
+
+    EXPECT_SUCCESS(GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1));
+}
+
 } // namespace
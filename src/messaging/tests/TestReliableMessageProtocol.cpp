@@ -35,6 +35,7 @@
 #include <messaging/ReliableMessageContext.h>
 #include <messaging/ReliableMessageMgr.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
+#include <messaging/ReliableMessageRttEstimator.h>
 #include <protocols/Protocols.h>
 #include <protocols/echo/Echo.h>
 #include <transport/SessionManager.h>
@@ -2154,6 +2155,141 @@ TEST_F(TestReliableMessageProtocol, CheckGetBackoffAdditionalTime)
     CheckGetBackoffImpl(System::Clock::Seconds32(1));
 }
 
+TEST_F(TestReliableMessageProtocol, CheckRttEstimator)
+{
+    ReliableMessageRttEstimator estimator;
+    EXPECT_FALSE(estimator.HasSamples());
+
+    // The first sample gives SRTT = R and RTTVAR = R/2.
+    estimator.AddSample(System::Clock::Milliseconds64(100));
+    EXPECT_TRUE(estimator.HasSamples());
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 100_ms32);
+    EXPECT_EQ(estimator.GetRttVariation(), 50_ms32);
+    EXPECT_EQ(estimator.GetRetransTimeout(), 300_ms32);
+
+    // The next ones move RTTVAR by a quarter of |SRTT - R'| - RTTVAR and SRTT by an eighth of R' - SRTT.
+    estimator.AddSample(System::Clock::Milliseconds64(200));
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 112_ms32);
+    EXPECT_EQ(estimator.GetRttVariation(), 62_ms32);
+    EXPECT_EQ(estimator.GetRetransTimeout(), 362_ms32);
+
+    // A steady round-trip time makes the variation fade, and the timeout come down to just above the round-trip time.
+    for (int i = 0; i < 50; i++)
+    {
+        estimator.AddSample(System::Clock::Milliseconds64(112));
+    }
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 112_ms32);
+    EXPECT_EQ(estimator.GetRttVariation(), 0_ms32);
+    EXPECT_GT(estimator.GetRetransTimeout(), 112_ms32);
+    EXPECT_LT(estimator.GetRetransTimeout(), 120_ms32);
+
+    estimator.Reset();
+    EXPECT_FALSE(estimator.HasSamples());
+}
+
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+TEST_F(TestReliableMessageProtocol, CheckAdaptiveRetransTimeoutWithLatencyAndLoss)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    ReliableMessageMgr::SetAdditionalMRPBackoffTime(MakeOptional(System::Clock::Timeout(0)));
+    ReliableMessageMgr::SetAdaptiveRetransTimeoutEnabled(true);
+
+    MockAppDelegate mockReceiver(*this);
+    err = GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &mockReceiver);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    // The peer advertises intervals that are far longer than the round-trip time of the path to it, which has a
+    // latency of 150ms on the way there and 50ms on the way back.
+    constexpr auto kTestRetryInterval = 2000_ms32;
+    GetSessionBobToAlice()->AsSecureSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        kTestRetryInterval, // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        kTestRetryInterval, // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+
+    auto & loopback               = GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+    loopback.SetMessageLatency(GetAliceAddress(), 150_ms32);
+    loopback.SetMessageLatency(GetBobAddress(), 50_ms32);
+
+    const auto & rttEstimator = GetSessionBobToAlice()->GetRttEstimator();
+    EXPECT_FALSE(rttEstimator.HasSamples());
+
+    MockAppDelegate mockSender(*this);
+    for (int i = 0; i < 4; i++)
+    {
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        EXPECT_FALSE(buffer.IsNull());
+
+        ExchangeContext * exchange = NewExchangeToAlice(&mockSender);
+        ASSERT_NE(exchange, nullptr);
+
+        err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+
+        GetIOContext().DriveIOUntil(1000_ms32, [&] { return rm->TestGetCountRetransTable() == 0; });
+        EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+    }
+
+    // Every message was acknowledged without retransmissions, each giving a sample of at least the 200ms round trip.
+    EXPECT_EQ(loopback.mSentMessageCount, 8u);
+    ASSERT_TRUE(rttEstimator.HasSamples());
+    EXPECT_GE(rttEstimator.GetSmoothedRtt(), 200_ms32);
+    EXPECT_LT(rttEstimator.GetRetransTimeout(), kTestRetryInterval);
+    const auto smoothedRtt = rttEstimator.GetSmoothedRtt();
+
+    // Drop the next message: its retransmission is scheduled from the measured round-trip time rather than from the
+    // interval advertised by the peer.
+    loopback.mNumMessagesToDrop = 1;
+
+    chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    EXPECT_FALSE(buffer.IsNull());
+
+    ExchangeContext * exchange = NewExchangeToAlice(&mockSender);
+    ASSERT_NE(exchange, nullptr);
+
+    err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    EXPECT_EQ(loopback.mDroppedMessageCount, 1u);
+    ASSERT_EQ(rm->TestGetCountRetransTable(), 1);
+
+    const System::Clock::Timeout expectedBaseTimeout =
+        std::max<System::Clock::Timeout>(rttEstimator.GetRetransTimeout(), CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRANS_TIMEOUT);
+    EXPECT_EQ(ReliableMessageMgr::GetAdaptiveBaseTimeout(exchange->GetSessionHandle(), kTestRetryInterval), expectedBaseTimeout);
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    rm->EnumerateRetransTable([&](auto * entry) {
+        EXPECT_LE(entry->nextRetransTime - now, ReliableMessageMgr::GetBackoff(expectedBaseTimeout, 0, true));
+        EXPECT_LT(entry->nextRetransTime - now, kTestRetryInterval);
+        return Loop::Continue;
+    });
+
+    GetIOContext().DriveIOUntil(2000_ms32, [&] { return rm->TestGetCountRetransTable() == 0; });
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+    EXPECT_EQ(loopback.mSentMessageCount, 11u);
+
+    // The acknowledgement of a retransmitted message is not sampled.
+    EXPECT_EQ(rttEstimator.GetSmoothedRtt(), smoothedRtt);
+
+    loopback.SetMessageLatency(GetAliceAddress(), System::Clock::kZero);
+    loopback.SetMessageLatency(GetBobAddress(), System::Clock::kZero);
+    ReliableMessageMgr::SetAdaptiveRetransTimeoutEnabled(false);
+    ReliableMessageMgr::SetAdditionalMRPBackoffTime(NullOptional);
+
+    Messaging::UnsolicitedMessageHandler * removedHandler = nullptr;
+    err = GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &removedHandler);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    EXPECT_EQ(removedHandler, &mockReceiver);
+}
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 TEST_F(TestReliableMessageProtocol, CheckApplicationResponseDelayed)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
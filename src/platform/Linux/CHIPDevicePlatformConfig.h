@@ -55,6 +55,72 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+ *
+ * @brief
+ *   Back KeyValueStoreManagerImpl with the append-only ChipLinuxStorageLog instead of rewriting the
+ *   ChipLinuxStorage INI file on every write. An existing INI file is migrated on first use.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS
+ *
+ * @brief
+ *   The longest time that records appended to a ChipLinuxStorageLog may stay unsynced, i.e. the window of writes that a
+ *   power loss can lose. Writes within that window share one fdatasync.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS 50
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE
+ *
+ * @brief
+ *   The size in bytes below which a ChipLinuxStorageLog is never compacted. Above it, the log is compacted in the
+ *   background once overwritten and deleted values take up more than half of it.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+ *
+ * @brief
+ *   Have the Linux example apps keep the events that EventManagement drops from its in-memory buffers in an
+ *   EventSpillStorageImpl next to the KVS file, so that they can still be reported to subscribers that fall behind, also
+ *   across reboots.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+#define CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_STORAGE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_SEGMENT_SIZE
+ *
+ * @brief
+ *   The size in bytes beyond which an EventSpillStorageImpl starts a new segment file. A segment is synced when it is
+ *   full, so this is also roughly the amount of spilled events that a power loss can lose.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_SEGMENT_SIZE
+#define CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_SEGMENT_SIZE (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_SEGMENT_SIZE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_MAX_SEGMENTS
+ *
+ * @brief
+ *   The number of segment files an EventSpillStorageImpl keeps before deleting the oldest one.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_MAX_SEGMENTS
+#define CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_MAX_SEGMENTS 16
+#endif // CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_MAX_SEGMENTS
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
@@ -69,6 +135,12 @@
 #define CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS 1
 #endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
+// InitChipStack() starts CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE background workers; background work runs on the Matter
+// thread while they are stopped.
+#ifndef CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+#define CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING 1
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 #define CHIP_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
@@ -338,6 +338,26 @@ bool ChipLinuxStorageIni::HasValue(const char * key)
     return it != section.end();
 }
 
+CHIP_ERROR ChipLinuxStorageIni::GetKeys(std::vector<std::string> & keys)
+{
+    std::map<std::string, std::string> section;
+    ReturnErrorOnFailure(GetDefaultSection(section));
+
+    keys.clear();
+    for (const auto & entry : section)
+    {
+        std::string key = UnescapeKey(entry.first);
+        if (key.empty())
+        {
+            ChipLogError(DeviceLayer, "Skipping malformed key: %s", entry.first.c_str());
+            continue;
+        }
+        keys.push_back(std::move(key));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR ChipLinuxStorageIni::AddEntry(const char * key, const char * value)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
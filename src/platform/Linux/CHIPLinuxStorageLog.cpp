@@ -0,0 +1,674 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         Implements ChipLinuxStorageLog, an append-only, log-structured key-value store.
+ *
+ *         The log starts with an 8-byte header, followed by records of the form
+ *
+ *             crc32 (4) | type (1) | key length (2) | value length (4) | key | value
+ *
+ *         in little-endian order, where the CRC-32 covers everything after it.
+ */
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedMemoryBuffer.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/CHIPLinuxStorageIni.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kLogHeader[8]        = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', '1' };
+constexpr size_t kRecordHeaderSize     = 11;
+constexpr uint8_t kRecordTypePut       = 1;
+constexpr uint8_t kRecordTypeDelete    = 2;
+constexpr off_t kMinCompactionSize     = CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE;
+constexpr auto kSyncInterval           = std::chrono::milliseconds(CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS);
+constexpr const char kMigrateSuffix[]  = ".migrate";
+constexpr const char kCompactSuffix[]  = ".compact";
+constexpr mode_t kLogFileMode          = S_IRUSR | S_IWUSR;
+constexpr size_t kMaxRecordValueLength = UINT32_MAX - kRecordHeaderSize - UINT16_MAX;
+
+struct Crc32Table
+{
+    uint32_t mValues[256];
+
+    constexpr Crc32Table() : mValues()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+            }
+            mValues[i] = crc;
+        }
+    }
+};
+
+constexpr Crc32Table kCrc32Table;
+
+uint32_t Crc32(const void * data, size_t length, uint32_t crc = 0)
+{
+    const uint8_t * bytes = static_cast<const uint8_t *>(data);
+    crc                   = ~crc;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = kCrc32Table.mValues[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+CHIP_ERROR WriteAll(int fd, off_t offset, struct iovec * iov, int iovcnt)
+{
+    while (iovcnt > 0)
+    {
+        ssize_t written = pwritev(fd, iov, iovcnt, offset);
+        if (written < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        offset += written;
+
+        // Skip over what was written, which may end in the middle of a buffer.
+        size_t remaining = static_cast<size_t>(written);
+        while (iovcnt > 0 && remaining >= iov->iov_len)
+        {
+            remaining -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0)
+        {
+            iov->iov_base = static_cast<uint8_t *>(iov->iov_base) + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadAll(int fd, off_t offset, void * buffer, size_t length)
+{
+    uint8_t * bytes = static_cast<uint8_t *>(buffer);
+    while (length > 0)
+    {
+        ssize_t result = pread(fd, bytes, length, offset);
+        if (result < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        VerifyOrReturnError(result > 0, CHIP_ERROR_READ_FAILED);
+        bytes += result;
+        offset += result;
+        length -= static_cast<size_t>(result);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Make a rename durable by syncing the directory that holds the file.
+void SyncDirectoryOf(const std::string & path)
+{
+    std::string copy = path;
+    int fd           = open(dirname(&copy[0]), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+} // namespace
+
+CHIP_ERROR ChipLinuxStorageLog::Init(const char * file)
+{
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Like ChipLinuxStorage, keep using the first file when initialized again.
+    if (mFd >= 0)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog::Init: Attempt to re-initialize with KVS log file: %s, IGNORING.", file);
+        return CHIP_NO_ERROR;
+    }
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageLog::Init: Using KVS log file: %s", file);
+    mPath.assign(file);
+
+    mFd = open(file, O_RDWR | O_CREAT | O_CLOEXEC, kLogFileMode);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    // Anything that is not (a prefix of) the log header is an INI file written by ChipLinuxStorage.
+    uint8_t header[sizeof(kLogHeader)];
+    ssize_t headerSize = pread(mFd, header, sizeof(header), 0);
+    CHIP_ERROR err     = (headerSize < 0) ? CHIP_ERROR_POSIX(errno) : CHIP_NO_ERROR;
+    if (err == CHIP_NO_ERROR && memcmp(header, kLogHeader, static_cast<size_t>(headerSize)) != 0)
+    {
+        close(mFd);
+        mFd = -1;
+
+        err = MigrateIni();
+        if (err == CHIP_NO_ERROR)
+        {
+            mFd = open(file, O_RDWR | O_CLOEXEC);
+            err = (mFd >= 0) ? CHIP_NO_ERROR : CHIP_ERROR_POSIX(errno);
+        }
+    }
+
+    if (err == CHIP_NO_ERROR)
+    {
+        err = Load();
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to open KVS log %s: %" CHIP_ERROR_FORMAT, file, err.Format());
+        if (mFd >= 0)
+        {
+            close(mFd);
+            mFd = -1;
+        }
+        mIndex.clear();
+        return err;
+    }
+
+    mRunning = true;
+    mThread  = std::thread(&ChipLinuxStorageLog::Run, this);
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mRunning = false;
+    }
+    mWakeup.notify_all();
+    mCompacted.notify_all();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+
+    if (mFd >= 0)
+    {
+        if (mUnsynced && fdatasync(mFd) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to sync KVS log: %s", strerror(errno));
+        }
+        close(mFd);
+        mFd = -1;
+    }
+    mIndex.clear();
+    mFileSize = 0;
+    mLiveSize = 0;
+    mUnsynced = false;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr && (value != nullptr || valueSize == 0), CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mIndex.find(key);
+    VerifyOrReturnError(it != mIndex.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    const Location & location = it->second;
+    VerifyOrReturnError(offset <= location.mValueSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const size_t remaining = location.mValueSize - offset;
+    const size_t copySize  = std::min(valueSize, remaining);
+    const off_t valueStart = location.mRecordOffset + static_cast<off_t>(location.mRecordSize - location.mValueSize);
+    ReturnErrorOnFailure(ReadAll(mFd, valueStart + static_cast<off_t>(offset), value, copySize));
+
+    if (readBytesSize != nullptr)
+    {
+        *readBytesSize = copySize;
+    }
+    return (valueSize < remaining) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Put(const char * key, const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(key != nullptr && (value != nullptr || valueSize == 0), CHIP_ERROR_INVALID_ARGUMENT);
+
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+        ReturnErrorOnFailure(Append(mFd, mFileSize, mIndex, kRecordTypePut, key, value, valueSize));
+        mUnsynced = true;
+    }
+    mWakeup.notify_one();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Delete(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(mIndex.find(key) != mIndex.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        ReturnErrorOnFailure(Append(mFd, mFileSize, mIndex, kRecordTypeDelete, key, nullptr, 0));
+        mUnsynced = true;
+    }
+    mWakeup.notify_one();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Sync()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+    mUnsynced = false;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Compact()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    VerifyOrReturnError(mRunning, CHIP_ERROR_INCORRECT_STATE);
+
+    // A compaction that is already under way started before this request, so wait for the next one.
+    const uint32_t compactionCount = mCompactionCount;
+    mCompactionRequested           = true;
+    mWakeup.notify_one();
+    mCompacted.wait(lock, [&] { return !mRunning || (mCompactionCount != compactionCount && !mCompactionRequested); });
+    VerifyOrReturnError(mRunning, CHIP_ERROR_INCORRECT_STATE);
+    return mCompactionError;
+}
+
+size_t ChipLinuxStorageLog::GetFileSize()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return static_cast<size_t>(mFileSize);
+}
+
+size_t ChipLinuxStorageLog::GetLiveSize()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mLiveSize;
+}
+
+uint64_t ChipLinuxStorageLog::GetBytesWritten()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mBytesWritten;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Load()
+{
+    struct stat st;
+    VerifyOrReturnError(fstat(mFd, &st) == 0, CHIP_ERROR_POSIX(errno));
+
+    mIndex.clear();
+    mLiveSize = 0;
+
+    if (static_cast<size_t>(st.st_size) < sizeof(kLogHeader))
+    {
+        // A new log, or one whose creation was cut short.
+        struct iovec iov = { const_cast<uint8_t *>(kLogHeader), sizeof(kLogHeader) };
+        VerifyOrReturnError(ftruncate(mFd, 0) == 0, CHIP_ERROR_POSIX(errno));
+        ReturnErrorOnFailure(WriteAll(mFd, 0, &iov, 1));
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+        mBytesWritten += sizeof(kLogHeader);
+        mFileSize = sizeof(kLogHeader);
+        return CHIP_NO_ERROR;
+    }
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    Platform::ScopedMemoryBuffer<uint8_t> contents;
+    VerifyOrReturnError(contents.Alloc(fileSize), CHIP_ERROR_NO_MEMORY);
+    ReturnErrorOnFailure(ReadAll(mFd, 0, contents.Get(), fileSize));
+
+    size_t offset = sizeof(kLogHeader);
+    while (fileSize - offset >= kRecordHeaderSize)
+    {
+        const uint8_t * record = contents.Get() + offset;
+        const uint8_t type     = record[4];
+        const size_t keySize   = Encoding::LittleEndian::Get16(record + 5);
+        const size_t valueSize = Encoding::LittleEndian::Get32(record + 7);
+        if (keySize + valueSize > fileSize - offset - kRecordHeaderSize ||
+            Crc32(record + 4, kRecordHeaderSize - 4 + keySize + valueSize) != Encoding::LittleEndian::Get32(record) ||
+            (type != kRecordTypePut && type != kRecordTypeDelete))
+        {
+            break;
+        }
+
+        const size_t recordSize = kRecordHeaderSize + keySize + valueSize;
+        std::string key(reinterpret_cast<const char *>(record + kRecordHeaderSize), keySize);
+        auto it = mIndex.find(key);
+        if (it != mIndex.end())
+        {
+            mLiveSize -= it->second.mRecordSize;
+            mIndex.erase(it);
+        }
+        if (type == kRecordTypePut)
+        {
+            const Location location = { static_cast<off_t>(offset), static_cast<uint32_t>(recordSize),
+                                        static_cast<uint32_t>(valueSize) };
+            mIndex.emplace(std::move(key), location);
+            mLiveSize += recordSize;
+        }
+        offset += recordSize;
+    }
+
+    if (offset < fileSize)
+    {
+        // Only the last records can have been torn by a crash; everything after the first bad record is dropped.
+        ChipLogError(DeviceLayer, "Dropping %u bytes of incomplete records at the end of KVS log %s",
+                     static_cast<unsigned>(fileSize - offset), mPath.c_str());
+        VerifyOrReturnError(ftruncate(mFd, static_cast<off_t>(offset)) == 0, CHIP_ERROR_POSIX(errno));
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+    }
+
+    mFileSize = static_cast<off_t>(offset);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Create(const std::string & path, int & fd)
+{
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, kLogFileMode);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+
+    struct iovec iov = { const_cast<uint8_t *>(kLogHeader), sizeof(kLogHeader) };
+    CHIP_ERROR err   = WriteAll(fd, 0, &iov, 1);
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        fd = -1;
+        unlink(path.c_str());
+    }
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::MigrateIni()
+{
+    ChipLogProgress(DeviceLayer, "Converting KVS file %s to a log", mPath.c_str());
+
+    ChipLinuxStorageIni ini;
+    std::vector<std::string> keys;
+    ReturnErrorOnFailure(ini.Init());
+    ReturnErrorOnFailure(ini.AddConfig(mPath));
+    CHIP_ERROR err = ini.GetKeys(keys);
+    if (err == CHIP_ERROR_KEY_NOT_FOUND)
+    {
+        // The INI file has no DEFAULT section, i.e. no values.
+        keys.clear();
+        err = CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+
+    // Build the log next to the INI file and rename it over the INI file once it is complete, so that a crash leaves
+    // one or the other.
+    const std::string tmpPath = mPath + kMigrateSuffix;
+    int fd                    = -1;
+    off_t fileSize            = sizeof(kLogHeader);
+    Index index;
+    ReturnErrorOnFailure(Create(tmpPath, fd));
+    mBytesWritten += sizeof(kLogHeader);
+
+    Platform::ScopedMemoryBuffer<uint8_t> value;
+    for (const auto & key : keys)
+    {
+        size_t valueSize = 0;
+        err              = ini.GetBinaryBlobValue(key.c_str(), nullptr, 0, valueSize);
+        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+        {
+            VerifyOrExit(value.Calloc(valueSize), err = CHIP_ERROR_NO_MEMORY);
+            err = ini.GetBinaryBlobValue(key.c_str(), value.Get(), valueSize, valueSize);
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            // ChipLinuxStorage could not have read it either.
+            ChipLogError(DeviceLayer, "Not converting unreadable KVS value %s: %" CHIP_ERROR_FORMAT, key.c_str(), err.Format());
+            continue;
+        }
+        SuccessOrExit(err = Append(fd, fileSize, index, kRecordTypePut, key, value.Get(), valueSize));
+    }
+
+    VerifyOrExit(fdatasync(fd) == 0, err = CHIP_ERROR_POSIX(errno));
+    VerifyOrExit(rename(tmpPath.c_str(), mPath.c_str()) == 0, err = CHIP_ERROR_POSIX(errno));
+    SyncDirectoryOf(mPath);
+    ChipLogProgress(DeviceLayer, "Converted %u KVS values", static_cast<unsigned>(index.size()));
+
+exit:
+    close(fd);
+    if (err != CHIP_NO_ERROR)
+    {
+        unlink(tmpPath.c_str());
+    }
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Append(int fd, off_t & fileSize, Index & index, uint8_t type, const std::string & key,
+                                       const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(key.size() <= UINT16_MAX && valueSize <= kMaxRecordValueLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t header[kRecordHeaderSize];
+    header[4] = type;
+    Encoding::LittleEndian::Put16(header + 5, static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Put32(header + 7, static_cast<uint32_t>(valueSize));
+    uint32_t crc = Crc32(header + 4, kRecordHeaderSize - 4);
+    crc          = Crc32(key.data(), key.size(), crc);
+    crc          = Crc32(value, valueSize, crc);
+    Encoding::LittleEndian::Put32(header, crc);
+
+    struct iovec iov[] = {
+        { header, sizeof(header) },
+        { const_cast<char *>(key.data()), key.size() },
+        { const_cast<void *>(value), valueSize },
+    };
+    const size_t recordSize = kRecordHeaderSize + key.size() + valueSize;
+    CHIP_ERROR err          = WriteAll(fd, fileSize, iov, MATTER_ARRAY_SIZE(iov));
+    if (err != CHIP_NO_ERROR)
+    {
+        // Do not leave a partial record behind for later records to follow.
+        if (ftruncate(fd, fileSize) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to truncate KVS log: %s", strerror(errno));
+        }
+        return err;
+    }
+    mBytesWritten += recordSize;
+
+    // Only the live index tracks the live size; the index of a log being built does not need it.
+    const bool isLiveIndex = (&index == &mIndex);
+    auto it                = index.find(key);
+    if (it != index.end())
+    {
+        if (isLiveIndex)
+        {
+            mLiveSize -= it->second.mRecordSize;
+        }
+        index.erase(it);
+    }
+    if (type == kRecordTypePut)
+    {
+        index.emplace(key, Location{ fileSize, static_cast<uint32_t>(recordSize), static_cast<uint32_t>(valueSize) });
+        if (isLiveIndex)
+        {
+            mLiveSize += recordSize;
+        }
+    }
+    fileSize += static_cast<off_t>(recordSize);
+    return CHIP_NO_ERROR;
+}
+
+bool ChipLinuxStorageLog::NeedsCompaction() const
+{
+    const off_t garbageSize = mFileSize - static_cast<off_t>(sizeof(kLogHeader) + mLiveSize);
+    return mFileSize >= std::max(kMinCompactionSize, mNextCompactionSize) && garbageSize > static_cast<off_t>(mLiveSize);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::CompactLocked(std::unique_lock<std::mutex> & lock)
+{
+    // Records never change once written, so everything up to the current end of the log can be copied without the
+    // lock, while new records keep being appended after it.
+    std::vector<std::pair<std::string, Location>> liveRecords(mIndex.begin(), mIndex.end());
+    const off_t snapshotEnd   = mFileSize;
+    const int fd              = mFd;
+    const std::string tmpPath = mPath + kCompactSuffix;
+    lock.unlock();
+
+    int newFd          = -1;
+    off_t newFileSize  = sizeof(kLogHeader);
+    uint64_t copyBytes = sizeof(kLogHeader);
+    Index newIndex;
+    Platform::ScopedMemoryBuffer<uint8_t> record;
+    size_t recordBufferSize = 0;
+
+    CHIP_ERROR err = Create(tmpPath, newFd);
+    for (size_t i = 0; i < liveRecords.size() && err == CHIP_NO_ERROR; i++)
+    {
+        const Location & location = liveRecords[i].second;
+        if (location.mRecordSize > recordBufferSize)
+        {
+            recordBufferSize = location.mRecordSize;
+            if (!record.Alloc(recordBufferSize))
+            {
+                err = CHIP_ERROR_NO_MEMORY;
+                break;
+            }
+        }
+        err = ReadAll(fd, location.mRecordOffset, record.Get(), location.mRecordSize);
+        if (err == CHIP_NO_ERROR)
+        {
+            struct iovec iov = { record.Get(), location.mRecordSize };
+            err              = WriteAll(newFd, newFileSize, &iov, 1);
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            newIndex.emplace(std::move(liveRecords[i].first), Location{ newFileSize, location.mRecordSize, location.mValueSize });
+            newFileSize += location.mRecordSize;
+            copyBytes += location.mRecordSize;
+        }
+    }
+
+    lock.lock();
+    mBytesWritten += copyBytes;
+
+    // Replay the records appended since the snapshot; they are few, so this is done under the lock.
+    for (off_t offset = snapshotEnd; offset < mFileSize && err == CHIP_NO_ERROR;)
+    {
+        uint8_t header[kRecordHeaderSize];
+        err = ReadAll(fd, offset, header, sizeof(header));
+        SuccessOrExit(err);
+
+        const size_t keySize   = Encoding::LittleEndian::Get16(header + 5);
+        const size_t valueSize = Encoding::LittleEndian::Get32(header + 7);
+        Platform::ScopedMemoryBuffer<uint8_t> payload;
+        VerifyOrExit(payload.Alloc(keySize + valueSize), err = CHIP_ERROR_NO_MEMORY);
+        SuccessOrExit(err = ReadAll(fd, offset + static_cast<off_t>(kRecordHeaderSize), payload.Get(), keySize + valueSize));
+
+        const std::string key(reinterpret_cast<const char *>(payload.Get()), keySize);
+        SuccessOrExit(err = Append(newFd, newFileSize, newIndex, header[4], key, payload.Get() + keySize, valueSize));
+        offset += static_cast<off_t>(kRecordHeaderSize + keySize + valueSize);
+    }
+    SuccessOrExit(err);
+
+    VerifyOrExit(fdatasync(newFd) == 0, err = CHIP_ERROR_POSIX(errno));
+    VerifyOrExit(rename(tmpPath.c_str(), mPath.c_str()) == 0, err = CHIP_ERROR_POSIX(errno));
+    SyncDirectoryOf(mPath);
+
+    ChipLogDetail(DeviceLayer, "Compacted KVS log from %u to %u bytes", static_cast<unsigned>(mFileSize),
+                  static_cast<unsigned>(newFileSize));
+    close(mFd);
+    mFd       = newFd;
+    mFileSize = newFileSize;
+    mIndex    = std::move(newIndex);
+    mLiveSize = 0;
+    for (const auto & entry : mIndex)
+    {
+        mLiveSize += entry.second.mRecordSize;
+    }
+    mUnsynced           = false;
+    mNextCompactionSize = 0;
+    return CHIP_NO_ERROR;
+
+exit:
+    ChipLogError(DeviceLayer, "Failed to compact KVS log: %" CHIP_ERROR_FORMAT, err.Format());
+    if (newFd >= 0)
+    {
+        close(newFd);
+        unlink(tmpPath.c_str());
+    }
+    mNextCompactionSize = mFileSize + kMinCompactionSize;
+    return err;
+}
+
+void ChipLinuxStorageLog::Run()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while (mRunning)
+    {
+        if (mCompactionRequested || NeedsCompaction())
+        {
+            mCompactionRequested = false;
+            mCompactionError     = CompactLocked(lock);
+            mCompactionCount++;
+            mCompacted.notify_all();
+            continue;
+        }
+
+        if (mUnsynced)
+        {
+            // Give the writes that follow a chance to share this sync. Only this thread replaces mFd, so it can be
+            // synced without the lock.
+            mWakeup.wait_for(lock, kSyncInterval, [this] { return !mRunning || mCompactionRequested; });
+            const int fd = mFd;
+            mUnsynced    = false;
+            lock.unlock();
+            if (fdatasync(fd) != 0)
+            {
+                ChipLogError(DeviceLayer, "Failed to sync KVS log: %s", strerror(errno));
+            }
+            lock.lock();
+            continue;
+        }
+
+        mWakeup.wait(lock);
+    }
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,150 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         Defines an append-only, log-structured key-value store, used to back
+ *         KeyValueStoreManagerImpl when CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE is enabled.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <platform/CHIPDeviceConfig.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <unordered_map>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * A key-value store kept as a log of checksummed records, one per Put or Delete.
+ *
+ * ChipLinuxStorage rewrites its whole INI file on every commit, so the cost of a write grows with the size of the
+ * store. Here a write only appends its own record, and an in-memory hash index maps every key to the position of its
+ * latest value in the log.
+ *
+ * Records are written to the file right away, so they survive a crash of the process. A background thread
+ * fdatasyncs them at most CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS later, so all writes made within that
+ * window share one sync, and a power loss can lose at most that window. A torn record at the end of the log fails its
+ * checksum and is dropped the next time the log is opened.
+ *
+ * Once overwritten and deleted values take up more than half of a log larger than
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE, the same thread copies the live records to a new file and
+ * renames it over the log. Writes may continue while the records are copied.
+ *
+ * A file that does not start with the log header is taken to be a ChipLinuxStorage INI file, and is converted when
+ * the store is initialized.
+ */
+class ChipLinuxStorageLog
+{
+public:
+    ChipLinuxStorageLog() = default;
+    ~ChipLinuxStorageLog() { Shutdown(); }
+
+    ChipLinuxStorageLog(const ChipLinuxStorageLog &)             = delete;
+    ChipLinuxStorageLog & operator=(const ChipLinuxStorageLog &) = delete;
+
+    /**
+     * Open the log at @p file, creating it or converting an INI file found there, and start the background thread.
+     */
+    CHIP_ERROR Init(const char * file);
+
+    /**
+     * Sync all pending records, stop the background thread and close the log.
+     */
+    void Shutdown();
+
+    /**
+     * Read a value, with the semantics of KeyValueStoreManager::Get.
+     */
+    CHIP_ERROR Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize = nullptr, size_t offset = 0);
+    CHIP_ERROR Put(const char * key, const void * value, size_t valueSize);
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Make all records appended so far durable, without waiting for the background thread.
+     */
+    CHIP_ERROR Sync();
+
+    /**
+     * Compact the log now, regardless of how much of it is garbage. Blocks until the background thread is done.
+     */
+    CHIP_ERROR Compact();
+
+    /**
+     * The size of the log file, and the part of it that holds the latest values of the keys.
+     */
+    size_t GetFileSize();
+    size_t GetLiveSize();
+
+    /**
+     * The number of bytes written to files since Init, including compaction. Divided by the size of the keys and
+     * values that were put, this is the write amplification of the store.
+     */
+    uint64_t GetBytesWritten();
+
+private:
+    struct Location
+    {
+        off_t mRecordOffset;
+        uint32_t mRecordSize;
+        uint32_t mValueSize;
+    };
+
+    using Index = std::unordered_map<std::string, Location>;
+
+    CHIP_ERROR Load();
+    CHIP_ERROR Create(const std::string & path, int & fd);
+    CHIP_ERROR MigrateIni();
+    CHIP_ERROR Append(int fd, off_t & fileSize, Index & index, uint8_t type, const std::string & key, const void * value,
+                      size_t valueSize);
+    CHIP_ERROR CompactLocked(std::unique_lock<std::mutex> & lock);
+    bool NeedsCompaction() const;
+    void Run();
+
+    std::string mPath;
+    int mFd          = -1;
+    off_t mFileSize  = 0;
+    size_t mLiveSize = 0;
+    Index mIndex;
+    uint64_t mBytesWritten = 0;
+
+    std::mutex mLock;
+    std::condition_variable mWakeup;
+    std::condition_variable mCompacted;
+    std::thread mThread;
+    bool mRunning               = false;
+    bool mUnsynced              = false;
+    bool mCompactionRequested   = false;
+    uint32_t mCompactionCount   = 0;
+    CHIP_ERROR mCompactionError = CHIP_NO_ERROR;
+    // After a failed compaction, wait for the log to grow this large before trying again.
+    off_t mNextCompactionSize = 0;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,550 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         Implements EventSpillStorageImpl.
+ *
+ *         Each segment starts with an 8-byte header, followed by records of the form
+ *
+ *             marker (1) | flags (1) | fabric index (1) | priority (1) | event length (4) | event number (8) | event
+ *
+ *         in little-endian order, where the event is a single TLV element. Records are validated by their marker and
+ *         by parsing the event, which a torn write leaves truncated or filled with zeros.
+ *
+ *         The records of each priority are in event number order, so ForEachEvent merges one run per priority.
+ */
+
+#include <platform/Linux/EventSpillStorageImpl.h>
+
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+
+namespace {
+
+constexpr uint8_t kSegmentHeader[8]  = { 'C', 'H', 'I', 'P', 'E', 'V', 'S', '1' };
+constexpr size_t kRecordHeaderSize   = 16;
+constexpr uint8_t kRecordMarker      = 0xE5;
+constexpr uint8_t kFlagFabricRemoved = 0x01;
+constexpr size_t kMaxEventLength     = UINT16_MAX;
+constexpr mode_t kSegmentFileMode    = S_IRUSR | S_IWUSR;
+constexpr size_t kMaxSequenceDigits  = 10;
+
+CHIP_ERROR WriteAll(int fd, off_t offset, struct iovec * iov, int iovcnt)
+{
+    while (iovcnt > 0)
+    {
+        ssize_t written = pwritev(fd, iov, iovcnt, offset);
+        if (written < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        offset += written;
+
+        // Skip over what was written, which may end in the middle of a buffer.
+        size_t remaining = static_cast<size_t>(written);
+        while (iovcnt > 0 && remaining >= iov->iov_len)
+        {
+            remaining -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0)
+        {
+            iov->iov_base = static_cast<uint8_t *>(iov->iov_base) + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * A segment file mapped into memory for as long as the object lives.
+ */
+class MappedSegment
+{
+public:
+    MappedSegment() = default;
+    ~MappedSegment() { Unmap(); }
+
+    MappedSegment(const MappedSegment &)             = delete;
+    MappedSegment & operator=(const MappedSegment &) = delete;
+
+    CHIP_ERROR Map(const std::string & path, size_t size, bool writable)
+    {
+        VerifyOrReturnError(size > 0, CHIP_ERROR_INVALID_ARGUMENT);
+        int fd = open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+
+        void * data        = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        const int mapErrno = errno;
+        close(fd);
+        VerifyOrReturnError(data != MAP_FAILED, CHIP_ERROR_POSIX(mapErrno));
+
+        mData = static_cast<uint8_t *>(data);
+        mSize = size;
+        return CHIP_NO_ERROR;
+    }
+
+    void Unmap()
+    {
+        if (mData != nullptr)
+        {
+            munmap(mData, mSize);
+            mData = nullptr;
+            mSize = 0;
+        }
+    }
+
+    uint8_t * Data() const { return mData; }
+    size_t Size() const { return mSize; }
+
+private:
+    uint8_t * mData = nullptr;
+    size_t mSize    = 0;
+};
+
+struct Record
+{
+    uint8_t * mHeader;
+    EventNumber mEventNumber;
+    FabricIndex mFabricIndex;
+    uint8_t mPriority;
+    ByteSpan mEvent;
+
+    bool IsFabricRemoved() const { return (mHeader[1] & kFlagFabricRemoved) != 0; }
+    size_t Size() const { return kRecordHeaderSize + mEvent.size(); }
+};
+
+/**
+ * Parse the record at @p offset of a mapped segment, which was validated when the segment was loaded.
+ */
+bool ReadRecord(const MappedSegment & segment, size_t offset, Record & record)
+{
+    VerifyOrReturnValue(segment.Size() - offset >= kRecordHeaderSize, false);
+    uint8_t * header    = segment.Data() + offset;
+    const size_t length = Encoding::LittleEndian::Get32(header + 4);
+    VerifyOrReturnValue(header[0] == kRecordMarker && header[3] < kNumPriorityLevel, false);
+    VerifyOrReturnValue(length <= segment.Size() - offset - kRecordHeaderSize, false);
+
+    record.mHeader      = header;
+    record.mFabricIndex = header[2];
+    record.mPriority    = header[3];
+    record.mEventNumber = Encoding::LittleEndian::Get64(header + 8);
+    record.mEvent       = ByteSpan(header + kRecordHeaderSize, length);
+    return true;
+}
+
+bool IsValidEvent(const ByteSpan & event)
+{
+    TLV::TLVReader reader;
+    reader.Init(event);
+    return reader.Next() == CHIP_NO_ERROR && reader.GetType() == TLV::kTLVType_Structure && reader.Skip() == CHIP_NO_ERROR &&
+        reader.Next() == CHIP_END_OF_TLV;
+}
+
+} // namespace
+
+/**
+ * Reads the records of one priority that are in a range of event numbers, in the order they were appended, mapping one
+ * segment at a time.
+ */
+class EventSpillStorageImpl::RecordCursor
+{
+public:
+    RecordCursor(const EventSpillStorageImpl & storage, uint8_t priority, EventNumber minEventNumber,
+                 EventNumber endEventNumber) :
+        mStorage(storage),
+        mPriority(priority), mMinEventNumber(minEventNumber), mEndEventNumber(endEventNumber)
+    {}
+
+    /**
+     * Move to the next record, if any. HasRecord tells whether there was one.
+     */
+    CHIP_ERROR Next()
+    {
+        mHasRecord = false;
+        while (mSegmentIndex < mStorage.mSegments.size())
+        {
+            const Segment & segment = mStorage.mSegments[mSegmentIndex];
+            if (mMapped.Data() == nullptr)
+            {
+                if (segment.mEventCount == 0 || segment.mMaxEventNumber < mMinEventNumber ||
+                    segment.mMinEventNumber >= mEndEventNumber)
+                {
+                    mSegmentIndex++;
+                    continue;
+                }
+                ReturnErrorOnFailure(
+                    mMapped.Map(mStorage.SegmentPath(segment.mSequence), static_cast<size_t>(segment.mSize), false));
+                mOffset = sizeof(kSegmentHeader);
+            }
+
+            while (ReadRecord(mMapped, mOffset, mRecord))
+            {
+                mOffset += mRecord.Size();
+                if (mRecord.mPriority == mPriority && mRecord.mEventNumber >= mMinEventNumber &&
+                    mRecord.mEventNumber < mEndEventNumber && !mRecord.IsFabricRemoved())
+                {
+                    mHasRecord = true;
+                    return CHIP_NO_ERROR;
+                }
+            }
+            mMapped.Unmap();
+            mSegmentIndex++;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    bool HasRecord() const { return mHasRecord; }
+    const Record & GetRecord() const { return mRecord; }
+
+private:
+    const EventSpillStorageImpl & mStorage;
+    const uint8_t mPriority;
+    const EventNumber mMinEventNumber;
+    const EventNumber mEndEventNumber;
+    size_t mSegmentIndex = 0;
+    size_t mOffset       = 0;
+    MappedSegment mMapped;
+    Record mRecord;
+    bool mHasRecord = false;
+};
+
+CHIP_ERROR EventSpillStorageImpl::Init(const char * pathPrefix, size_t segmentSize, size_t maxSegments)
+{
+    VerifyOrReturnError(pathPrefix != nullptr && maxSegments > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(segmentSize > sizeof(kSegmentHeader) + kRecordHeaderSize, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mFd < 0, CHIP_ERROR_INCORRECT_STATE);
+
+    mPathPrefix.assign(pathPrefix);
+    mSegmentSize = segmentSize;
+    mMaxSegments = maxSegments;
+
+    std::deque<uint32_t> sequences;
+    CHIP_ERROR err = ListSegments(sequences);
+    for (size_t i = 0; i < sequences.size() && err == CHIP_NO_ERROR; i++)
+    {
+        err = LoadSegment(sequences[i]);
+    }
+    SuccessOrExit(err);
+
+    if (mSegments.empty())
+    {
+        SuccessOrExit(err = StartSegment(sequences.empty() ? 0 : sequences.back() + 1));
+    }
+    else
+    {
+        mFd = open(SegmentPath(mSegments.back().mSequence).c_str(), O_RDWR | O_CLOEXEC);
+        VerifyOrExit(mFd >= 0, err = CHIP_ERROR_POSIX(errno));
+    }
+    DropExcessSegments();
+
+    ChipLogProgress(DeviceLayer, "Spilling events to %s.*: %u segments, %u bytes", pathPrefix,
+                    static_cast<unsigned>(mSegments.size()), static_cast<unsigned>(GetStoredSize()));
+    return CHIP_NO_ERROR;
+
+exit:
+    ChipLogError(DeviceLayer, "Failed to open event spill storage %s: %" CHIP_ERROR_FORMAT, pathPrefix, err.Format());
+    Shutdown();
+    return err;
+}
+
+void EventSpillStorageImpl::Shutdown()
+{
+    if (mFd >= 0)
+    {
+        if (fdatasync(mFd) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to sync event spill segment: %s", strerror(errno));
+        }
+        close(mFd);
+        mFd = -1;
+    }
+    mSegments.clear();
+}
+
+CHIP_ERROR EventSpillStorageImpl::Append(EventNumber aEventNumber, app::PriorityLevel aPriority, FabricIndex aFabricIndex,
+                                         const ByteSpan & aEvent)
+{
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!aEvent.empty() && aEvent.size() <= kMaxEventLength, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(to_underlying(aPriority) < kNumPriorityLevel, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const off_t recordSize = static_cast<off_t>(kRecordHeaderSize + aEvent.size());
+    if (mSegments.back().mEventCount > 0 && mSegments.back().mSize + recordSize > static_cast<off_t>(mSegmentSize))
+    {
+        ReturnErrorOnFailure(Rotate());
+    }
+    Segment & segment = mSegments.back();
+
+    uint8_t header[kRecordHeaderSize] = { kRecordMarker, 0, aFabricIndex, to_underlying(aPriority) };
+    Encoding::LittleEndian::Put32(header + 4, static_cast<uint32_t>(aEvent.size()));
+    Encoding::LittleEndian::Put64(header + 8, aEventNumber);
+
+    struct iovec iov[] = {
+        { header, sizeof(header) },
+        { const_cast<uint8_t *>(aEvent.data()), aEvent.size() },
+    };
+    CHIP_ERROR err = WriteAll(mFd, segment.mSize, iov, MATTER_ARRAY_SIZE(iov));
+    if (err != CHIP_NO_ERROR)
+    {
+        // Do not leave a partial record behind for later records to follow.
+        if (ftruncate(mFd, segment.mSize) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to truncate event spill segment: %s", strerror(errno));
+        }
+        return err;
+    }
+
+    segment.mMinEventNumber = (segment.mEventCount == 0) ? aEventNumber : std::min(segment.mMinEventNumber, aEventNumber);
+    segment.mMaxEventNumber = (segment.mEventCount == 0) ? aEventNumber : std::max(segment.mMaxEventNumber, aEventNumber);
+    segment.mEventCount++;
+    segment.mSize += recordSize;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventSpillStorageImpl::ForEachEvent(EventNumber aMinEventNumber, EventNumber aEndEventNumber, EventHandler aHandler,
+                                               void * apContext)
+{
+    VerifyOrReturnError(aHandler != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Each priority is in order, so the smallest event number is always at one of the cursors.
+    RecordCursor cursors[] = {
+        RecordCursor(*this, to_underlying(app::PriorityLevel::Debug), aMinEventNumber, aEndEventNumber),
+        RecordCursor(*this, to_underlying(app::PriorityLevel::Info), aMinEventNumber, aEndEventNumber),
+        RecordCursor(*this, to_underlying(app::PriorityLevel::Critical), aMinEventNumber, aEndEventNumber),
+    };
+    static_assert(MATTER_ARRAY_SIZE(cursors) == kNumPriorityLevel, "One cursor per priority");
+    for (RecordCursor & cursor : cursors)
+    {
+        ReturnErrorOnFailure(cursor.Next());
+    }
+
+    while (true)
+    {
+        RecordCursor * next = nullptr;
+        for (RecordCursor & cursor : cursors)
+        {
+            if (cursor.HasRecord() && (next == nullptr || cursor.GetRecord().mEventNumber < next->GetRecord().mEventNumber))
+            {
+                next = &cursor;
+            }
+        }
+        VerifyOrReturnError(next != nullptr, CHIP_NO_ERROR);
+
+        ReturnErrorOnFailure(aHandler(next->GetRecord().mEvent, apContext));
+        ReturnErrorOnFailure(next->Next());
+    }
+}
+
+CHIP_ERROR EventSpillStorageImpl::FabricRemoved(FabricIndex aFabricIndex)
+{
+    for (const Segment & segment : mSegments)
+    {
+        if (segment.mEventCount == 0)
+        {
+            continue;
+        }
+
+        MappedSegment mapped;
+        ReturnErrorOnFailure(mapped.Map(SegmentPath(segment.mSequence), static_cast<size_t>(segment.mSize), true));
+
+        bool changed = false;
+        Record record;
+        for (size_t offset = sizeof(kSegmentHeader); ReadRecord(mapped, offset, record); offset += record.Size())
+        {
+            if (record.mFabricIndex == aFabricIndex && !record.IsFabricRemoved())
+            {
+                record.mHeader[1] |= kFlagFabricRemoved;
+                changed = true;
+            }
+        }
+
+        // The events of the fabric must not come back after a reboot.
+        VerifyOrReturnError(!changed || msync(mapped.Data(), mapped.Size(), MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+    }
+    return CHIP_NO_ERROR;
+}
+
+uint64_t EventSpillStorageImpl::GetStoredSize() const
+{
+    uint64_t size = 0;
+    for (const Segment & segment : mSegments)
+    {
+        size += static_cast<uint64_t>(segment.mSize);
+    }
+    return size;
+}
+
+std::string EventSpillStorageImpl::SegmentPath(uint32_t sequence) const
+{
+    return mPathPrefix + "." + std::to_string(sequence);
+}
+
+CHIP_ERROR EventSpillStorageImpl::ListSegments(std::deque<uint32_t> & sequences) const
+{
+    std::string directory = mPathPrefix;
+    std::string prefix    = mPathPrefix;
+    prefix.assign(basename(&prefix[0]));
+    prefix += ".";
+
+    DIR * dir = opendir(dirname(&directory[0]));
+    VerifyOrReturnError(dir != nullptr, CHIP_ERROR_POSIX(errno));
+    for (struct dirent * entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+    {
+        const char * name = entry->d_name;
+        if (strncmp(name, prefix.c_str(), prefix.size()) != 0)
+        {
+            continue;
+        }
+        const char * digits = name + prefix.size();
+        const size_t length = strlen(digits);
+        if (length == 0 || length > kMaxSequenceDigits || strspn(digits, "0123456789") != length)
+        {
+            continue;
+        }
+        const unsigned long sequence = strtoul(digits, nullptr, 10);
+        if (sequence <= UINT32_MAX)
+        {
+            sequences.push_back(static_cast<uint32_t>(sequence));
+        }
+    }
+    closedir(dir);
+
+    std::sort(sequences.begin(), sequences.end());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventSpillStorageImpl::LoadSegment(uint32_t sequence)
+{
+    const std::string path = SegmentPath(sequence);
+    struct stat st;
+    VerifyOrReturnError(stat(path.c_str(), &st) == 0, CHIP_ERROR_POSIX(errno));
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    MappedSegment mapped;
+    if (fileSize >= sizeof(kSegmentHeader))
+    {
+        ReturnErrorOnFailure(mapped.Map(path, fileSize, false));
+    }
+    if (fileSize < sizeof(kSegmentHeader) || memcmp(mapped.Data(), kSegmentHeader, sizeof(kSegmentHeader)) != 0)
+    {
+        // A segment whose creation was cut short, or a file that only looks like one.
+        ChipLogError(DeviceLayer, "Removing invalid event spill segment %s", path.c_str());
+        VerifyOrReturnError(unlink(path.c_str()) == 0, CHIP_ERROR_POSIX(errno));
+        return CHIP_NO_ERROR;
+    }
+
+    Segment segment = { sequence, sizeof(kSegmentHeader), 0, 0, 0 };
+    Record record;
+    for (size_t offset = sizeof(kSegmentHeader); ReadRecord(mapped, offset, record) && IsValidEvent(record.mEvent);
+         offset += record.Size())
+    {
+        segment.mMinEventNumber = (segment.mEventCount == 0) ? record.mEventNumber
+                                                             : std::min(segment.mMinEventNumber, record.mEventNumber);
+        segment.mMaxEventNumber = (segment.mEventCount == 0) ? record.mEventNumber
+                                                             : std::max(segment.mMaxEventNumber, record.mEventNumber);
+        segment.mEventCount++;
+        segment.mSize += static_cast<off_t>(record.Size());
+    }
+
+    if (static_cast<size_t>(segment.mSize) < fileSize)
+    {
+        // Only the end of a segment can have been torn by a crash; everything after the first bad record is dropped.
+        ChipLogError(DeviceLayer, "Dropping %u bytes of incomplete events at the end of %s",
+                     static_cast<unsigned>(fileSize - static_cast<size_t>(segment.mSize)), path.c_str());
+        VerifyOrReturnError(truncate(path.c_str(), segment.mSize) == 0, CHIP_ERROR_POSIX(errno));
+    }
+
+    mSegments.push_back(segment);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventSpillStorageImpl::StartSegment(uint32_t sequence)
+{
+    const std::string path = SegmentPath(sequence);
+    int fd                 = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, kSegmentFileMode);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+
+    struct iovec iov = { const_cast<uint8_t *>(kSegmentHeader), sizeof(kSegmentHeader) };
+    CHIP_ERROR err   = WriteAll(fd, 0, &iov, 1);
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        unlink(path.c_str());
+        return err;
+    }
+
+    mFd = fd;
+    mSegments.push_back(Segment{ sequence, sizeof(kSegmentHeader), 0, 0, 0 });
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventSpillStorageImpl::Rotate()
+{
+    // A full segment is never written again, so it only has to be synced once.
+    if (fdatasync(mFd) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to sync event spill segment: %s", strerror(errno));
+    }
+
+    const int fd = mFd;
+    ReturnErrorOnFailure(StartSegment(mSegments.back().mSequence + 1));
+    close(fd);
+
+    DropExcessSegments();
+    return CHIP_NO_ERROR;
+}
+
+void EventSpillStorageImpl::DropExcessSegments()
+{
+    while (mSegments.size() > mMaxSegments)
+    {
+        const Segment & oldest = mSegments.front();
+        ChipLogDetail(DeviceLayer, "Dropping %u spilled events up to event number 0x" ChipLogFormatX64,
+                      static_cast<unsigned>(oldest.mEventCount), ChipLogValueX64(oldest.mMaxEventNumber));
+        if (unlink(SegmentPath(oldest.mSequence).c_str()) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to remove event spill segment: %s", strerror(errno));
+        }
+        mSegments.pop_front();
+    }
+}
+
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         Defines a file-backed EventSpillStorage, which keeps the events that EventManagement drops from memory.
+ */
+
+#pragma once
+
+#include <app/EventSpillStorage.h>
+#include <platform/CHIPDeviceConfig.h>
+
+#include <deque>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <sys/types.h>
+
+namespace chip {
+namespace DeviceLayer {
+
+/**
+ * An EventSpillStorage that appends events to a bounded series of segment files, named <prefix>.<sequence number>.
+ *
+ * Once the last segment would grow beyond the segment size, it is synced and a new one is started, and once there are
+ * more segments than allowed, the oldest is deleted along with its events. Disk use is thus bounded by the product of
+ * the two, and memory use by one small descriptor per segment.
+ *
+ * The descriptor of a segment holds the range of event numbers in it, so ForEachEvent only reads the segments that can
+ * hold events in the requested range; for a subscriber that is up to date, that is none of them. It streams the events
+ * with one mapped segment per priority at most, so its memory use does not grow with the number of events.
+ *
+ * Events are written to the file right away, so they survive a crash of the process, but only synced along with their
+ * segment. An event torn by a power loss fails validation and is dropped, with whatever follows it in its segment, the
+ * next time the storage is initialized.
+ */
+class EventSpillStorageImpl : public app::EventSpillStorage
+{
+public:
+    EventSpillStorageImpl() = default;
+    ~EventSpillStorageImpl() override { Shutdown(); }
+
+    EventSpillStorageImpl(const EventSpillStorageImpl &)             = delete;
+    EventSpillStorageImpl & operator=(const EventSpillStorageImpl &) = delete;
+
+    /**
+     * Open the segments named @p pathPrefix.<sequence number>, creating the first one if there are none.
+     */
+    CHIP_ERROR Init(const char * pathPrefix, size_t segmentSize = CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_SEGMENT_SIZE,
+                    size_t maxSegments = CHIP_DEVICE_CONFIG_LINUX_EVENT_SPILL_MAX_SEGMENTS);
+
+    /**
+     * Sync the last segment and close the storage.
+     */
+    void Shutdown();
+
+    CHIP_ERROR Append(EventNumber aEventNumber, app::PriorityLevel aPriority, FabricIndex aFabricIndex,
+                      const ByteSpan & aEvent) override;
+    CHIP_ERROR ForEachEvent(EventNumber aMinEventNumber, EventNumber aEndEventNumber, EventHandler aHandler,
+                            void * apContext) override;
+    CHIP_ERROR FabricRemoved(FabricIndex aFabricIndex) override;
+
+    size_t GetSegmentCount() const { return mSegments.size(); }
+
+    /**
+     * The total size of the segment files.
+     */
+    uint64_t GetStoredSize() const;
+
+private:
+    struct Segment
+    {
+        uint32_t mSequence;
+        off_t mSize;
+        size_t mEventCount;
+        EventNumber mMinEventNumber;
+        EventNumber mMaxEventNumber;
+    };
+
+    class RecordCursor;
+
+    std::string SegmentPath(uint32_t sequence) const;
+    CHIP_ERROR ListSegments(std::deque<uint32_t> & sequences) const;
+    CHIP_ERROR LoadSegment(uint32_t sequence);
+    CHIP_ERROR StartSegment(uint32_t sequence);
+    CHIP_ERROR Rotate();
+    void DropExcessSegments();
+
+    std::string mPathPrefix;
+    size_t mSegmentSize = 0;
+    size_t mMaxSegments = 0;
+    std::deque<Segment> mSegments;
+    // The last segment, which events are appended to.
+    int mFd = -1;
+};
+
+} // namespace DeviceLayer
+} // namespace chip
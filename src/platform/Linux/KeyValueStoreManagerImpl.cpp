@@ -44,6 +44,10 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t
     // Copy data into value buffer
     VerifyOrReturnError(value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+    // The log reads just the requested part of the value.
+    return mStorage.Get(key, value, value_size, read_bytes_size, offset_bytes);
+#else
     // On linux read first without a buffer which returns the size, and then
     // use a local buffer to read the entire object, which allows partial and
     // offset reads.
@@ -74,10 +78,14 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t
     ::memcpy(value, buf.Get() + offset_bytes, copy_size);
 
     return (value_size < total_size_to_read) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
 }
 
 CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
 {
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+    return mStorage.Put(key, value, value_size);
+#else
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
@@ -89,10 +97,14 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
 
 exit:
     return err;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
 }
 
 CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
 {
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+    return mStorage.Delete(key);
+#else
     CHIP_ERROR err = CHIP_NO_ERROR;
     err            = mStorage.ClearValue(key);
 
@@ -108,6 +120,7 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
 
 exit:
     return err;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
 }
 
 } // namespace PersistedStorage
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -43,7 +44,11 @@ public:
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
 private:
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+    DeviceLayer::Internal::ChipLinuxStorageLog mStorage;
+#else
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
+#endif
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
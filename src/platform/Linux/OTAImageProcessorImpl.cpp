@@ -21,10 +21,41 @@
 
 #include "OTAImageProcessorImpl.h"
 
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 namespace chip {
 
+namespace {
+
+/// Length of the digests of the given type that can be checked with SHA-256, or 0 for the other types
+size_t GetSha256DigestLength(OTAImageDigestType digestType)
+{
+    switch (digestType)
+    {
+    case OTAImageDigestType::kSha256:
+        return Crypto::kSHA256_Hash_Length;
+    case OTAImageDigestType::kSha256_128:
+        return 16;
+    case OTAImageDigestType::kSha256_120:
+        return 15;
+    case OTAImageDigestType::kSha256_96:
+        return 12;
+    case OTAImageDigestType::kSha256_64:
+        return 8;
+    case OTAImageDigestType::kSha256_32:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
 CHIP_ERROR OTAImageProcessorImpl::PrepareDownload()
 {
     if (mImageFile == nullptr)
@@ -43,6 +74,9 @@ CHIP_ERROR OTAImageProcessorImpl::Finalize()
 
 CHIP_ERROR OTAImageProcessorImpl::Apply()
 {
+    // Finalize has checked the image by the time it is applied
+    VerifyOrReturnError(mImageVerified, CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
     return DeviceLayer::PlatformMgr().ScheduleWork(HandleApply, reinterpret_cast<intptr_t>(this));
 }
 
@@ -59,16 +93,24 @@ CHIP_ERROR OTAImageProcessorImpl::Abort()
 
 CHIP_ERROR OTAImageProcessorImpl::ProcessBlock(ByteSpan & block)
 {
-    if (!mOfs.is_open() || !mOfs.good())
+    if (mFd < 0)
     {
         return CHIP_ERROR_INTERNAL;
     }
 
-    // Store block data for HandleProcessBlock to access
-    CHIP_ERROR err = SetBlock(block);
-    if (err != CHIP_NO_ERROR)
+    // The block is consumed right away, so that it does not need to be copied. The downloader is only told about the outcome
+    // from HandleProcessBlock, since it may not be called back while it is handing out the block.
+    ByteSpan payload = block;
+    mBlockError      = ProcessHeader(payload);
+    if (mBlockError != CHIP_NO_ERROR)
+    {
+        ChipLogError(SoftwareUpdate, "Image does not contain a valid header");
+        mBlockError = CHIP_ERROR_INVALID_FILE_IDENTIFIER;
+    }
+    else
     {
-        ChipLogError(SoftwareUpdate, "Cannot set block data: %" CHIP_ERROR_FORMAT, err.Format());
+        mBlockError = WritePayload(payload);
+        mParams.downloadedBytes += payload.size();
     }
 
     return DeviceLayer::PlatformMgr().ScheduleWork(HandleProcessBlock, reinterpret_cast<intptr_t>(this));
@@ -120,14 +162,30 @@ void OTAImageProcessorImpl::HandlePrepareDownload(intptr_t context)
         return;
     }
 
+    imageProcessor->CloseImageFile();
     unlink(imageProcessor->mImageFile);
 
     imageProcessor->mParams.downloadedBytes = 0;
     imageProcessor->mParams.totalFileBytes  = 0;
+    imageProcessor->mExpectedDigestLength   = 0;
+    imageProcessor->mHeaderDecoded          = false;
+    imageProcessor->mImageVerified          = false;
     imageProcessor->mHeaderParser.Init();
-    imageProcessor->mOfs.open(imageProcessor->mImageFile, std::ofstream::out | std::ofstream::ate | std::ofstream::app);
-    if (!imageProcessor->mOfs.good())
+
+    constexpr int kOpenFlags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    constexpr mode_t kMode   = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+#ifdef O_DIRECT
+    // Bypass the page cache, since the image is not read back. File systems such as tmpfs do not support it.
+    imageProcessor->mFd = open(imageProcessor->mImageFile, kOpenFlags | O_DIRECT, kMode);
+    if (imageProcessor->mFd < 0 && errno == EINVAL)
+#endif
     {
+        imageProcessor->mFd = open(imageProcessor->mImageFile, kOpenFlags, kMode);
+    }
+
+    if (imageProcessor->mFd < 0 || imageProcessor->mPayloadHash.Begin() != CHIP_NO_ERROR)
+    {
+        imageProcessor->CloseImageFile();
         TEMPORARY_RETURN_IGNORED imageProcessor->mDownloader->OnPreparedForDownload(CHIP_ERROR_OPEN_FAILED);
         return;
     }
@@ -143,9 +201,16 @@ void OTAImageProcessorImpl::HandleFinalize(intptr_t context)
         return;
     }
 
-    imageProcessor->mOfs.close();
-    TEMPORARY_RETURN_IGNORED imageProcessor->ReleaseBlock();
+    CHIP_ERROR error = imageProcessor->VerifyImage();
+    imageProcessor->CloseImageFile();
+    if (error != CHIP_NO_ERROR)
+    {
+        ChipLogError(SoftwareUpdate, "OTA image verification failed: %" CHIP_ERROR_FORMAT, error.Format());
+        unlink(imageProcessor->mImageFile);
+        return;
+    }
 
+    imageProcessor->mImageVerified = true;
     ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s", imageProcessor->mImageFile);
 }
 
@@ -177,9 +242,10 @@ void OTAImageProcessorImpl::HandleAbort(intptr_t context)
         return;
     }
 
-    imageProcessor->mOfs.close();
+    imageProcessor->CloseImageFile();
     unlink(imageProcessor->mImageFile);
-    TEMPORARY_RETURN_IGNORED imageProcessor->ReleaseBlock();
+    imageProcessor->mPayloadHash.Clear();
+    imageProcessor->mImageVerified = false;
 }
 
 void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
@@ -196,29 +262,22 @@ void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
         return;
     }
 
-    ByteSpan block   = imageProcessor->mBlock;
-    CHIP_ERROR error = imageProcessor->ProcessHeader(block);
-    if (error != CHIP_NO_ERROR)
+    if (imageProcessor->mBlockError != CHIP_NO_ERROR)
     {
-        ChipLogError(SoftwareUpdate, "Image does not contain a valid header");
-        imageProcessor->mDownloader->EndDownload(CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+        imageProcessor->mDownloader->EndDownload(imageProcessor->mBlockError);
         return;
     }
 
-    if (!imageProcessor->mOfs.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size())))
-    {
-        imageProcessor->mDownloader->EndDownload(CHIP_ERROR_WRITE_FAILED);
-        return;
-    }
-
-    imageProcessor->mParams.downloadedBytes += block.size();
     TEMPORARY_RETURN_IGNORED imageProcessor->mDownloader->FetchNextData();
 }
 
 CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
 {
-    if (mHeaderParser.IsInitialized())
+    if (!mHeaderDecoded)
     {
+        // The parser is cleared once the header turned out to be invalid
+        VerifyOrReturnError(mHeaderParser.IsInitialized(), CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+
         OTAImageHeader header;
         CHIP_ERROR error = mHeaderParser.AccumulateAndDecode(block, header);
 
@@ -227,50 +286,97 @@ CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
         ReturnErrorOnFailure(error);
 
         mParams.totalFileBytes = header.mPayloadSize;
+
+        // The digest is only a view into the parser, which is cleared below. Images that cannot be verified are rejected.
+        mExpectedDigestLength = GetSha256DigestLength(header.mImageDigestType);
+        if (mExpectedDigestLength == 0)
+        {
+            ChipLogError(SoftwareUpdate, "OTA image digest type %u is not supported",
+                         static_cast<unsigned>(header.mImageDigestType));
+            mHeaderParser.Clear();
+            return CHIP_ERROR_INVALID_FILE_IDENTIFIER;
+        }
+        VerifyOrReturnError(header.mImageDigest.size() == mExpectedDigestLength, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+        memcpy(mExpectedDigest, header.mImageDigest.data(), mExpectedDigestLength);
+
         mHeaderParser.Clear();
+        mHeaderDecoded = true;
     }
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR OTAImageProcessorImpl::SetBlock(ByteSpan & block)
+CHIP_ERROR OTAImageProcessorImpl::WritePayload(ByteSpan payload)
 {
-    if (block.empty())
-    {
-        TEMPORARY_RETURN_IGNORED ReleaseBlock();
-        return CHIP_NO_ERROR;
-    }
-    if (mBlock.size() < block.size())
+    ReturnErrorOnFailure(mPayloadHash.AddData(payload));
+
+    while (!payload.empty())
     {
-        if (!mBlock.empty())
-        {
-            TEMPORARY_RETURN_IGNORED ReleaseBlock();
-        }
-        uint8_t * mBlock_ptr = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(block.size()));
-        if (mBlock_ptr == nullptr)
+        const size_t length = std::min(payload.size(), kWriteBufferSize - mWriteBufferLength);
+        memcpy(&mWriteBuffer[mWriteBufferLength], payload.data(), length);
+        mWriteBufferLength += length;
+        payload = payload.SubSpan(length);
+
+        if (mWriteBufferLength == kWriteBufferSize)
         {
-            return CHIP_ERROR_NO_MEMORY;
+            ReturnErrorOnFailure(FlushWriteBuffer());
         }
-        mBlock = MutableByteSpan(mBlock_ptr, block.size());
     }
-    CHIP_ERROR err = CopySpanToMutableSpan(block, mBlock);
-    if (err != CHIP_NO_ERROR)
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OTAImageProcessorImpl::FlushWriteBuffer()
+{
+    size_t offset = 0;
+    while (offset < mWriteBufferLength)
     {
-        ChipLogError(SoftwareUpdate, "Cannot copy block data: %" CHIP_ERROR_FORMAT, err.Format());
-        return err;
+        const ssize_t written = write(mFd, &mWriteBuffer[offset], mWriteBufferLength - offset);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(written > 0, CHIP_ERROR_WRITE_FAILED);
+        offset += static_cast<size_t>(written);
     }
+
+    mWriteBufferLength = 0;
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR OTAImageProcessorImpl::ReleaseBlock()
+CHIP_ERROR OTAImageProcessorImpl::VerifyImage()
 {
-    if (mBlock.data() != nullptr)
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+#ifdef O_DIRECT
+    // The end of the image is not aligned
+    const int flags = fcntl(mFd, F_GETFL);
+    VerifyOrReturnError(flags >= 0 && fcntl(mFd, F_SETFL, flags & ~O_DIRECT) == 0, CHIP_ERROR_WRITE_FAILED);
+#endif
+    ReturnErrorOnFailure(FlushWriteBuffer());
+
+    // The header must have been decoded, and the whole payload received
+    VerifyOrReturnError(mHeaderDecoded, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+    VerifyOrReturnError(mParams.downloadedBytes == mParams.totalFileBytes, CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    ReturnErrorOnFailure(mPayloadHash.Finish(digest));
+    VerifyOrReturnError(digest.SubSpan(0, mExpectedDigestLength).data_equal(ByteSpan(mExpectedDigest, mExpectedDigestLength)),
+                        CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageProcessorImpl::CloseImageFile()
+{
+    if (mFd >= 0)
     {
-        chip::Platform::MemoryFree(mBlock.data());
+        close(mFd);
+        mFd = -1;
     }
 
-    mBlock = MutableByteSpan();
-    return CHIP_NO_ERROR;
+    mWriteBufferLength = 0;
 }
 
 } // namespace chip
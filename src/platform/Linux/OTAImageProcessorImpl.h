@@ -19,17 +19,21 @@
 #pragma once
 
 #include <app/clusters/ota-requestor/OTADownloader.h>
+#include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/OTAImageHeader.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/OTAImageProcessor.h>
 
-#include <fstream>
-
 namespace chip {
 
 // Full file path to where the new image will be executed from post-download
 static constexpr char kImageExecPath[] = "/tmp/ota.update";
 
+/**
+ * Writes the payload of a Matter OTA image to a file as the blocks arrive. The header is parsed on the fly, the payload is
+ * hashed block by block and written through an aligned buffer (with O_DIRECT where the file system supports it), and the
+ * digest from the header is checked at Finalize, so the image is never read back.
+ */
 class OTAImageProcessorImpl : public OTAImageProcessorInterface
 {
 public:
@@ -54,19 +58,29 @@ private:
     static void HandleProcessBlock(intptr_t context);
 
     CHIP_ERROR ProcessHeader(ByteSpan & block);
+    CHIP_ERROR WritePayload(ByteSpan payload);
+    CHIP_ERROR FlushWriteBuffer();
+    CHIP_ERROR VerifyImage();
+    void CloseImageFile();
+
+    // O_DIRECT needs the buffer, the size and the file offset of every write to be aligned to the logical block size of the
+    // device. The page size covers all of them.
+    static constexpr size_t kWriteAlignment  = 4096;
+    static constexpr size_t kWriteBufferSize = 16 * kWriteAlignment;
+
+    int mFd = -1;
+    alignas(kWriteAlignment) uint8_t mWriteBuffer[kWriteBufferSize];
+    size_t mWriteBufferLength = 0;
 
-    /**
-     * Called to allocate memory for mBlock if necessary and set it to block
-     */
-    CHIP_ERROR SetBlock(ByteSpan & block);
+    // Outcome of the last ProcessBlock(), reported to the downloader from HandleProcessBlock
+    CHIP_ERROR mBlockError = CHIP_NO_ERROR;
 
-    /**
-     * Called to release allocated memory for mBlock
-     */
-    CHIP_ERROR ReleaseBlock();
+    Crypto::Hash_SHA256_stream mPayloadHash;
+    uint8_t mExpectedDigest[Crypto::kSHA256_Hash_Length];
+    size_t mExpectedDigestLength = 0;
+    bool mHeaderDecoded          = false;
+    bool mImageVerified          = false;
 
-    std::ofstream mOfs;
-    MutableByteSpan mBlock;
     OTADownloader * mDownloader;
     OTAImageHeaderParser mHeaderParser;
     const char * mImageFile = nullptr;
@@ -250,6 +250,12 @@ CHIP_ERROR PlatformManagerImpl::_InitChipStack()
     // to finish the initialization process.
     ReturnErrorOnFailure(Internal::GenericPlatformManagerImpl_POSIX<PlatformManagerImpl>::_InitChipStack());
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE > 0 && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    // Start the background workers, which take the CASE key agreement and signature checks off the Matter thread.
+    // The generic _Shutdown() stops them.
+    ReturnErrorOnFailure(StartBackgroundEventLoopTask());
+#endif
+
     // Now set up our device instance info provider.  We couldn't do that
     // earlier, because the generic implementation sets a generic one.
     SetDeviceInstanceInfoProvider(&DeviceInstanceInfoProviderMgrImpl());
@@ -0,0 +1,322 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the log-structured
+ *      key-value store of the Linux platform.
+ *
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+#include <system/SystemClock.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr size_t kLogHeaderSize    = 8;
+constexpr size_t kRecordHeaderSize = 11;
+
+size_t FileSize(const std::string & path)
+{
+    struct stat st;
+    return (stat(path.c_str(), &st) == 0) ? static_cast<size_t>(st.st_size) : 0;
+}
+
+struct TestChipLinuxStorageLog : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        char path[] = "/tmp/chip_kvs_log_XXXXXX";
+        int fd      = mkstemp(path);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        unlink(path);
+        mPath = path;
+    }
+
+    void TearDown() override
+    {
+        mStorage.Shutdown();
+        unlink(mPath.c_str());
+    }
+
+    std::string mPath;
+    ChipLinuxStorageLog mStorage;
+};
+
+TEST_F(TestChipLinuxStorageLog, TestPutGetDelete)
+{
+    static constexpr char kValue[] = "0123456789";
+    char readValue[sizeof(kValue)];
+    size_t readSize = 0;
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("key", readValue, sizeof(readValue)), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_EQ(mStorage.Delete("key"), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    EXPECT_EQ(mStorage.Put("key", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("key", readValue, sizeof(readValue), &readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, sizeof(kValue));
+    EXPECT_STREQ(readValue, kValue);
+
+    // Partial and offset reads
+    EXPECT_EQ(mStorage.Get("key", readValue, 4, &readSize), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(readSize, 4u);
+    EXPECT_EQ(memcmp(readValue, "0123", 4), 0);
+    EXPECT_EQ(mStorage.Get("key", readValue, sizeof(readValue), &readSize, 6), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, sizeof(kValue) - 6);
+    EXPECT_STREQ(readValue, "6789");
+    EXPECT_EQ(mStorage.Get("key", readValue, sizeof(readValue), &readSize, sizeof(kValue) + 1), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Empty values
+    EXPECT_EQ(mStorage.Put("empty", nullptr, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("empty", nullptr, 0, &readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 0u);
+
+    EXPECT_EQ(mStorage.Put("key", "abc", 3), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("key", readValue, sizeof(readValue), &readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 3u);
+    EXPECT_EQ(memcmp(readValue, "abc", 3), 0);
+
+    EXPECT_EQ(mStorage.Delete("key"), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("key", readValue, sizeof(readValue)), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_EQ(mStorage.GetLiveSize(), kRecordHeaderSize + strlen("empty"));
+}
+
+TEST_F(TestChipLinuxStorageLog, TestReopen)
+{
+    uint32_t value = 0;
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(mStorage.Put("counter", &i, sizeof(i)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(mStorage.Put("deleted", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Delete("deleted"), CHIP_NO_ERROR);
+    const size_t fileSize = mStorage.GetFileSize();
+    EXPECT_EQ(fileSize, FileSize(mPath));
+    mStorage.Shutdown();
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetFileSize(), fileSize);
+    EXPECT_EQ(mStorage.Get("counter", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 99u);
+    EXPECT_EQ(mStorage.Get("deleted", &value, sizeof(value)), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+TEST_F(TestChipLinuxStorageLog, TestTornRecord)
+{
+    static constexpr char kValue[] = "value";
+    char readValue[sizeof(kValue)];
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Put("kept", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+    const size_t fileSize = mStorage.GetFileSize();
+    EXPECT_EQ(mStorage.Put("torn", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+    mStorage.Shutdown();
+
+    // Cut the last record short, as a crash in the middle of a write would.
+    ASSERT_EQ(truncate(mPath.c_str(), static_cast<off_t>(FileSize(mPath) - 2)), 0);
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetFileSize(), fileSize);
+    EXPECT_EQ(FileSize(mPath), fileSize);
+    EXPECT_EQ(mStorage.Get("kept", readValue, sizeof(readValue)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("torn", readValue, sizeof(readValue)), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // New records go where the torn one was.
+    EXPECT_EQ(mStorage.Put("torn", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+    mStorage.Shutdown();
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("torn", readValue, sizeof(readValue)), CHIP_NO_ERROR);
+}
+
+TEST_F(TestChipLinuxStorageLog, TestCompact)
+{
+    uint8_t value[64] = {};
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    for (uint8_t i = 0; i < 100; i++)
+    {
+        memset(value, i, sizeof(value));
+        EXPECT_EQ(mStorage.Put((i % 2) ? "odd" : "even", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(mStorage.Put("deleted", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(mStorage.Delete("deleted"), CHIP_NO_ERROR);
+    }
+    EXPECT_GT(mStorage.GetFileSize(), kLogHeaderSize + mStorage.GetLiveSize());
+
+    EXPECT_EQ(mStorage.Compact(), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetLiveSize(), 2 * kRecordHeaderSize + strlen("odd") + strlen("even") + 2 * sizeof(value));
+    EXPECT_EQ(mStorage.GetFileSize(), kLogHeaderSize + mStorage.GetLiveSize());
+    EXPECT_EQ(FileSize(mPath), mStorage.GetFileSize());
+
+    EXPECT_EQ(mStorage.Get("odd", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(value[0], 99);
+    EXPECT_EQ(mStorage.Get("even", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(value[0], 98);
+    EXPECT_EQ(mStorage.Get("deleted", value, sizeof(value)), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // The compacted log is appended to and reopened like any other.
+    EXPECT_EQ(mStorage.Put("odd", value, 1), CHIP_NO_ERROR);
+    mStorage.Shutdown();
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    size_t readSize = 0;
+    EXPECT_EQ(mStorage.Get("odd", value, sizeof(value), &readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 1u);
+    EXPECT_EQ(mStorage.Get("even", value, sizeof(value)), CHIP_NO_ERROR);
+}
+
+TEST_F(TestChipLinuxStorageLog, TestBackgroundCompaction)
+{
+    constexpr size_t kValueSize = 1024;
+    uint8_t value[kValueSize]   = {};
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Put("static", value, sizeof(value)), CHIP_NO_ERROR);
+
+    // Write well past the compaction threshold, and wait for the log to shrink back.
+    const size_t writeCount = 3 * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE / kValueSize;
+    for (size_t i = 0; i < writeCount; i++)
+    {
+        value[0] = static_cast<uint8_t>(i);
+        EXPECT_EQ(mStorage.Put("changing", value, sizeof(value)), CHIP_NO_ERROR);
+    }
+    for (int i = 0; i < 500 && mStorage.GetFileSize() >= CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE; i++)
+    {
+        usleep(10 * 1000);
+    }
+    EXPECT_LT(mStorage.GetFileSize(), static_cast<size_t>(CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_MIN_COMPACTION_SIZE));
+
+    EXPECT_EQ(mStorage.Get("changing", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(value[0], static_cast<uint8_t>(writeCount - 1));
+    EXPECT_EQ(mStorage.Get("static", value, sizeof(value)), CHIP_NO_ERROR);
+}
+
+TEST_F(TestChipLinuxStorageLog, TestMigrateIni)
+{
+    static constexpr uint8_t kBinaryValue[] = { 0x00, 0x01, 0x02, 0xFF };
+    uint8_t readValue[16];
+    size_t readSize = 0;
+
+    {
+        ChipLinuxStorage ini;
+        ASSERT_EQ(ini.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(ini.WriteValueBin("f/1/n", kBinaryValue, sizeof(kBinaryValue)), CHIP_NO_ERROR);
+        EXPECT_EQ(ini.WriteValueBin("key with = and spaces", kBinaryValue, 1), CHIP_NO_ERROR);
+        EXPECT_EQ(ini.Commit(), CHIP_NO_ERROR);
+    }
+
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Get("f/1/n", readValue, sizeof(readValue), &readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, sizeof(kBinaryValue));
+    EXPECT_EQ(memcmp(readValue, kBinaryValue, sizeof(kBinaryValue)), 0);
+    EXPECT_EQ(mStorage.Get("key with = and spaces", readValue, sizeof(readValue), &readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 1u);
+
+    // The file is a log from now on.
+    mStorage.Shutdown();
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetFileSize(), FileSize(mPath));
+    EXPECT_EQ(mStorage.Get("f/1/n", readValue, sizeof(readValue)), CHIP_NO_ERROR);
+}
+
+TEST_F(TestChipLinuxStorageLog, BenchmarkWriteAmplification)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    // A store of a few hundred small values, such as fabric tables, subscriptions and counters, in which one value at
+    // a time keeps being updated.
+    constexpr size_t kKeyCount   = 200;
+    constexpr size_t kValueSize  = 64;
+    constexpr size_t kWriteCount = 1000;
+    uint8_t value[kValueSize]    = {};
+    char key[16];
+    auto makeKey = [&key](size_t i) {
+        snprintf(key, sizeof(key), "k/%u", static_cast<unsigned>(i));
+        return key;
+    };
+
+    const std::string iniPath = mPath + ".ini";
+    ChipLinuxStorage ini;
+    ASSERT_EQ(ini.Init(iniPath.c_str()), CHIP_NO_ERROR);
+    ASSERT_EQ(mStorage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    for (size_t i = 0; i < kKeyCount; i++)
+    {
+        EXPECT_EQ(ini.WriteValueBin(makeKey(i), value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(mStorage.Put(makeKey(i), value, sizeof(value)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(ini.Commit(), CHIP_NO_ERROR);
+
+    uint64_t payloadBytes = 0;
+    uint64_t iniBytes     = 0;
+    Testing::BenchmarkTimer timer;
+    for (size_t i = 0; i < kWriteCount; i++)
+    {
+        value[0] = static_cast<uint8_t>(i);
+        EXPECT_EQ(ini.WriteValueBin(makeKey(i % kKeyCount), value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(ini.Commit(), CHIP_NO_ERROR);
+        iniBytes += FileSize(iniPath);
+        payloadBytes += strlen(key) + sizeof(value);
+    }
+    const System::Clock::Microseconds64 iniTime = timer.Elapsed();
+
+    const uint64_t logBytesBefore = mStorage.GetBytesWritten();
+    timer.Restart();
+    for (size_t i = 0; i < kWriteCount; i++)
+    {
+        value[0] = static_cast<uint8_t>(i);
+        EXPECT_EQ(mStorage.Put(makeKey(i % kKeyCount), value, sizeof(value)), CHIP_NO_ERROR);
+    }
+    const System::Clock::Microseconds64 logTime = timer.Elapsed();
+    const uint64_t logBytes                     = mStorage.GetBytesWritten() - logBytesBefore;
+    unlink(iniPath.c_str());
+
+    // Every INI commit rewrites the whole store; a log write only adds its own record, plus its share of compaction.
+    EXPECT_LT(logBytes, iniBytes / 10);
+
+    ChipLogProgress(Test, "%u writes of %u-byte values to a store of %u keys:", static_cast<unsigned>(kWriteCount),
+                    static_cast<unsigned>(kValueSize), static_cast<unsigned>(kKeyCount));
+    ChipLogProgress(Test, "  INI: write amplification %u.%02u, %u us per write", static_cast<unsigned>(iniBytes / payloadBytes),
+                    static_cast<unsigned>(iniBytes * 100 / payloadBytes % 100),
+                    static_cast<unsigned>(iniTime.count() / kWriteCount));
+    ChipLogProgress(Test, "  log: write amplification %u.%02u, %u us per write", static_cast<unsigned>(logBytes / payloadBytes),
+                    static_cast<unsigned>(logBytes * 100 / payloadBytes % 100),
+                    static_cast<unsigned>(logTime.count() / kWriteCount));
+}
+
+} // namespace
@@ -0,0 +1,334 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the file-backed
+ *      event spill storage of the Linux platform.
+ *
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
+#include <platform/Linux/EventSpillStorageImpl.h>
+#include <system/SystemClock.h>
+
+#include <dirent.h>
+#include <limits>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::DeviceLayer;
+
+namespace {
+
+constexpr size_t kSegmentHeaderSize = 8;
+constexpr size_t kRecordHeaderSize  = 16;
+
+size_t FileSize(const std::string & path)
+{
+    struct stat st;
+    return (stat(path.c_str(), &st) == 0) ? static_cast<size_t>(st.st_size) : 0;
+}
+
+// An event the way EventManagement keeps it, reduced to what the storage looks at: an anonymous structure.
+struct TestEvent
+{
+    explicit TestEvent(EventNumber eventNumber)
+    {
+        TLV::TLVWriter writer;
+        TLV::TLVType containerType;
+        writer.Init(mBuffer);
+        VerifyOrDie(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType) == CHIP_NO_ERROR);
+        VerifyOrDie(writer.Put(TLV::ContextTag(1), eventNumber) == CHIP_NO_ERROR);
+        VerifyOrDie(writer.Put(TLV::ContextTag(2), static_cast<uint32_t>(0x12345678)) == CHIP_NO_ERROR);
+        VerifyOrDie(writer.EndContainer(containerType) == CHIP_NO_ERROR);
+        VerifyOrDie(writer.Finalize() == CHIP_NO_ERROR);
+        mLength = writer.GetLengthWritten();
+    }
+
+    ByteSpan Span() const { return ByteSpan(mBuffer, mLength); }
+
+    uint8_t mBuffer[32];
+    size_t mLength = 0;
+};
+
+// Collects the event numbers of the events passed to the handler.
+CHIP_ERROR CollectEventNumber(const ByteSpan & aEvent, void * apContext)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType containerType;
+    EventNumber eventNumber;
+    reader.Init(aEvent);
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(reader.Get(eventNumber));
+    static_cast<std::vector<EventNumber> *>(apContext)->push_back(eventNumber);
+    return CHIP_NO_ERROR;
+}
+
+struct TestEventSpillStorageImpl : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        char directory[] = "/tmp/chip_event_spill_XXXXXX";
+        ASSERT_NE(mkdtemp(directory), nullptr);
+        mDirectory = directory;
+        mPrefix    = mDirectory + "/events";
+    }
+
+    void TearDown() override
+    {
+        mStorage.Shutdown();
+
+        DIR * dir = opendir(mDirectory.c_str());
+        for (struct dirent * entry = (dir != nullptr) ? readdir(dir) : nullptr; entry != nullptr; entry = readdir(dir))
+        {
+            if (entry->d_name[0] != '.')
+            {
+                unlink((mDirectory + "/" + entry->d_name).c_str());
+            }
+        }
+        if (dir != nullptr)
+        {
+            closedir(dir);
+        }
+        rmdir(mDirectory.c_str());
+    }
+
+    void AppendEvents(EventNumber first, EventNumber last, FabricIndex fabricIndex = kUndefinedFabricIndex,
+                      app::PriorityLevel priority = app::PriorityLevel::Debug)
+    {
+        for (EventNumber eventNumber = first; eventNumber <= last; eventNumber++)
+        {
+            EXPECT_EQ(mStorage.Append(eventNumber, priority, fabricIndex, TestEvent(eventNumber).Span()), CHIP_NO_ERROR);
+        }
+    }
+
+    std::vector<EventNumber> StoredEvents(EventNumber minEventNumber = 0,
+                                          EventNumber endEventNumber = std::numeric_limits<EventNumber>::max())
+    {
+        std::vector<EventNumber> eventNumbers;
+        EXPECT_EQ(mStorage.ForEachEvent(minEventNumber, endEventNumber, CollectEventNumber, &eventNumbers), CHIP_NO_ERROR);
+        return eventNumbers;
+    }
+
+    static std::vector<EventNumber> Range(EventNumber first, EventNumber last)
+    {
+        std::vector<EventNumber> eventNumbers;
+        for (EventNumber eventNumber = first; eventNumber <= last; eventNumber++)
+        {
+            eventNumbers.push_back(eventNumber);
+        }
+        return eventNumbers;
+    }
+
+    std::string mDirectory;
+    std::string mPrefix;
+    EventSpillStorageImpl mStorage;
+};
+
+TEST_F(TestEventSpillStorageImpl, TestAppendAndIterate)
+{
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetSegmentCount(), 1u);
+    EXPECT_EQ(mStorage.GetStoredSize(), kSegmentHeaderSize);
+    EXPECT_TRUE(StoredEvents().empty());
+
+    AppendEvents(1, 10);
+    EXPECT_EQ(StoredEvents(), Range(1, 10));
+    EXPECT_EQ(StoredEvents(6), Range(6, 10));
+    EXPECT_TRUE(StoredEvents(11).empty());
+    EXPECT_EQ(StoredEvents(3, 7), Range(3, 6));
+    EXPECT_TRUE(StoredEvents(0, 1).empty());
+    EXPECT_EQ(mStorage.GetStoredSize(), FileSize(mPrefix + ".0"));
+
+    // The handler stops the iteration.
+    auto stop = [](const ByteSpan &, void *) -> CHIP_ERROR { return CHIP_ERROR_BUFFER_TOO_SMALL; };
+    EXPECT_EQ(mStorage.ForEachEvent(0, std::numeric_limits<EventNumber>::max(), stop, nullptr), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    EXPECT_EQ(mStorage.Append(11, app::PriorityLevel::Debug, kUndefinedFabricIndex, ByteSpan()), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mStorage.Append(11, app::PriorityLevel::Invalid, kUndefinedFabricIndex, TestEvent(11).Span()),
+              CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(TestEventSpillStorageImpl, TestRotationIsBounded)
+{
+    const size_t recordSize  = kRecordHeaderSize + TestEvent(0).mLength;
+    constexpr size_t kEvents = 10;
+    const size_t segmentSize = kSegmentHeaderSize + kEvents * recordSize;
+
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 3), CHIP_NO_ERROR);
+    AppendEvents(0, 99);
+
+    // Only the last three segments are kept, the last of which is full.
+    EXPECT_EQ(mStorage.GetSegmentCount(), 3u);
+    EXPECT_EQ(mStorage.GetStoredSize(), 3 * segmentSize);
+    EXPECT_EQ(FileSize(mPrefix + ".6"), 0u);
+    EXPECT_EQ(FileSize(mPrefix + ".7"), segmentSize);
+    EXPECT_EQ(FileSize(mPrefix + ".9"), segmentSize);
+    EXPECT_EQ(StoredEvents(), Range(70, 99));
+    EXPECT_EQ(StoredEvents(85), Range(85, 99));
+
+    AppendEvents(100, 100);
+    EXPECT_EQ(mStorage.GetSegmentCount(), 3u);
+    EXPECT_EQ(StoredEvents(), Range(80, 100));
+}
+
+TEST_F(TestEventSpillStorageImpl, TestReopen)
+{
+    const size_t segmentSize = kSegmentHeaderSize + 4 * (kRecordHeaderSize + TestEvent(0).mLength);
+
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 4), CHIP_NO_ERROR);
+    AppendEvents(0, 9);
+    const uint64_t storedSize = mStorage.GetStoredSize();
+    mStorage.Shutdown();
+
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 4), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetSegmentCount(), 3u);
+    EXPECT_EQ(mStorage.GetStoredSize(), storedSize);
+    EXPECT_EQ(StoredEvents(), Range(0, 9));
+    EXPECT_EQ(StoredEvents(8), Range(8, 9));
+
+    // Appending continues in the last segment.
+    AppendEvents(10, 11);
+    EXPECT_EQ(mStorage.GetSegmentCount(), 3u);
+    EXPECT_EQ(StoredEvents(), Range(0, 11));
+    mStorage.Shutdown();
+
+    // Reopening with fewer segments allowed drops the oldest.
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 2), CHIP_NO_ERROR);
+    EXPECT_EQ(StoredEvents(), Range(4, 11));
+}
+
+TEST_F(TestEventSpillStorageImpl, TestTornTail)
+{
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str()), CHIP_NO_ERROR);
+    AppendEvents(0, 2);
+    const uint64_t storedSize = mStorage.GetStoredSize();
+    AppendEvents(3, 3);
+    mStorage.Shutdown();
+
+    // Cut the last record short, as a crash in the middle of a write would.
+    const std::string path = mPrefix + ".0";
+    ASSERT_EQ(truncate(path.c_str(), static_cast<off_t>(FileSize(path) - 2)), 0);
+
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetStoredSize(), storedSize);
+    EXPECT_EQ(FileSize(path), storedSize);
+    EXPECT_EQ(StoredEvents(), Range(0, 2));
+
+    // New records go where the torn one was.
+    AppendEvents(3, 4);
+    mStorage.Shutdown();
+
+    // A power loss can also leave zeros where the record should be.
+    ASSERT_EQ(truncate(path.c_str(), static_cast<off_t>(FileSize(path) + kRecordHeaderSize)), 0);
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(StoredEvents(), Range(0, 4));
+    mStorage.Shutdown();
+
+    // Or a segment whose header was not written yet.
+    FILE * file = fopen((mPrefix + ".1").c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fputs("CHI", file);
+    fclose(file);
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetSegmentCount(), 1u);
+    EXPECT_EQ(StoredEvents(), Range(0, 4));
+}
+
+TEST_F(TestEventSpillStorageImpl, TestFabricRemoved)
+{
+    const size_t segmentSize = kSegmentHeaderSize + 4 * (kRecordHeaderSize + TestEvent(0).mLength);
+
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 4), CHIP_NO_ERROR);
+    for (EventNumber eventNumber = 0; eventNumber < 10; eventNumber++)
+    {
+        AppendEvents(eventNumber, eventNumber, static_cast<FabricIndex>(1 + eventNumber % 2));
+    }
+    AppendEvents(10, 10);
+
+    EXPECT_EQ(mStorage.FabricRemoved(1), CHIP_NO_ERROR);
+    const std::vector<EventNumber> expected = { 1, 3, 5, 7, 9, 10 };
+    EXPECT_EQ(StoredEvents(), expected);
+    mStorage.Shutdown();
+
+    // The events of the removed fabric stay hidden after a reboot, when the index may already be reused.
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 4), CHIP_NO_ERROR);
+    EXPECT_EQ(StoredEvents(), expected);
+    AppendEvents(11, 11, 1);
+    EXPECT_EQ(StoredEvents(10), Range(10, 11));
+}
+
+TEST_F(TestEventSpillStorageImpl, TestInterleavedAppendsAreSorted)
+{
+    const size_t segmentSize = kSegmentHeaderSize + 4 * (kRecordHeaderSize + TestEvent(0).mLength);
+
+    // Events dropped from different priority buffers arrive out of order, and across segments, but each priority is
+    // in order.
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 4), CHIP_NO_ERROR);
+    for (EventNumber eventNumber : { 4, 5, 0, 6, 1, 2, 7, 3 })
+    {
+        AppendEvents(eventNumber, eventNumber, kUndefinedFabricIndex,
+                     eventNumber >= 4 ? app::PriorityLevel::Info : app::PriorityLevel::Debug);
+    }
+    EXPECT_EQ(StoredEvents(), Range(0, 7));
+    EXPECT_EQ(StoredEvents(2, 6), Range(2, 5));
+}
+
+TEST_F(TestEventSpillStorageImpl, BenchmarkAppend)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    constexpr EventNumber kEvents = 20000;
+    const size_t segmentSize      = 64 * 1024;
+
+    ASSERT_EQ(mStorage.Init(mPrefix.c_str(), segmentSize, 4), CHIP_NO_ERROR);
+
+    Testing::BenchmarkTimer timer;
+    AppendEvents(0, kEvents - 1);
+    const System::Clock::Microseconds64 appendTime = timer.Elapsed();
+
+    timer.Restart();
+    std::vector<EventNumber> eventNumbers               = StoredEvents(kEvents - 10);
+    const System::Clock::Microseconds64 fetchRecentTime = timer.Elapsed();
+
+    EXPECT_EQ(eventNumbers, Range(kEvents - 10, kEvents - 1));
+    EXPECT_LE(mStorage.GetStoredSize(), 4 * segmentSize);
+    ChipLogProgress(Test, "Spilled %u events: %u ns per append, %u segments of %u bytes, %u us to fetch the last 10",
+                    static_cast<unsigned>(kEvents), static_cast<unsigned>(appendTime.count() * 1000 / kEvents),
+                    static_cast<unsigned>(mStorage.GetSegmentCount()), static_cast<unsigned>(segmentSize),
+                    static_cast<unsigned>(fetchRecentTime.count()));
+}
+
+} // namespace
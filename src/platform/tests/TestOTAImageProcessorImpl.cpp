@@ -0,0 +1,309 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the OTA image processor
+ *      of the Linux platform, which writes the image to a file as the
+ *      blocks arrive and checks its digest at Finalize.
+ *
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <app/clusters/ota-requestor/OTADownloader.h>
+#include <app/clusters/ota-requestor/OTARequestorInterface.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/OTAImageHeader.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TypeTraits.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/Linux/OTAImageProcessorImpl.h>
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::DeviceLayer;
+
+namespace chip {
+
+// There is no OTA requestor in this test, the image processor only needs it to apply the image
+OTARequestorInterface * GetRequestorInstance()
+{
+    return nullptr;
+}
+
+} // namespace chip
+
+namespace {
+
+// Larger than the write buffer of the processor, so that the payload is written in several chunks
+constexpr size_t kPayloadSize = 150000;
+constexpr size_t kBlockSize   = 1024;
+
+// Context tags of the OTA image header
+constexpr uint8_t kVendorIdTag              = 0;
+constexpr uint8_t kProductIdTag             = 1;
+constexpr uint8_t kSoftwareVersionTag       = 2;
+constexpr uint8_t kSoftwareVersionStringTag = 3;
+constexpr uint8_t kPayloadSizeTag           = 4;
+constexpr uint8_t kImageDigestTypeTag       = 8;
+constexpr uint8_t kImageDigestTag           = 9;
+
+// Length of a SHA-384 digest, the longest one used in the tests
+constexpr size_t kMaxDigestLength = 48;
+
+// Generates an OTA image with the given payload and a SHA-256 digest of it in the header. Other digest types get a
+// digest of their length that the processor has no way to check.
+std::vector<uint8_t> MakeImage(const std::vector<uint8_t> & payload, OTAImageDigestType digestType = OTAImageDigestType::kSha256)
+{
+    uint8_t digest[kMaxDigestLength] = {};
+    VerifyOrDie(Crypto::Hash_SHA256(payload.data(), payload.size(), digest) == CHIP_NO_ERROR);
+    const size_t digestLength = digestType == OTAImageDigestType::kSha256 ? Crypto::kSHA256_Hash_Length : kMaxDigestLength;
+
+    uint8_t headerTlv[128];
+    TLV::TLVWriter writer;
+    TLV::TLVType containerType;
+    writer.Init(headerTlv);
+    VerifyOrDie(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Put(TLV::ContextTag(kVendorIdTag), static_cast<uint16_t>(0xFFF1)) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Put(TLV::ContextTag(kProductIdTag), static_cast<uint16_t>(0x8000)) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Put(TLV::ContextTag(kSoftwareVersionTag), static_cast<uint32_t>(2)) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.PutString(TLV::ContextTag(kSoftwareVersionStringTag), "2.0") == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Put(TLV::ContextTag(kPayloadSizeTag), static_cast<uint64_t>(payload.size())) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Put(TLV::ContextTag(kImageDigestTypeTag), to_underlying(digestType)) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Put(TLV::ContextTag(kImageDigestTag), ByteSpan(digest, digestLength)) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.EndContainer(containerType) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Finalize() == CHIP_NO_ERROR);
+    const uint32_t headerTlvSize = writer.GetLengthWritten();
+
+    uint8_t fixedHeader[16];
+    Encoding::LittleEndian::BufferWriter fixedWriter(fixedHeader, sizeof(fixedHeader));
+    fixedWriter.Put32(kOTAImageFileIdentifier)
+        .Put64(sizeof(fixedHeader) + headerTlvSize + payload.size())
+        .Put32(headerTlvSize);
+    VerifyOrDie(fixedWriter.Fit());
+
+    std::vector<uint8_t> image(fixedHeader, fixedHeader + sizeof(fixedHeader));
+    image.insert(image.end(), headerTlv, headerTlv + headerTlvSize);
+    image.insert(image.end(), payload.begin(), payload.end());
+    return image;
+}
+
+std::vector<uint8_t> MakePayload()
+{
+    std::vector<uint8_t> payload(kPayloadSize);
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = static_cast<uint8_t>((i * 31) ^ (i >> 8));
+    }
+    return payload;
+}
+
+// Records what the image processor reports to the downloader
+class FakeDownloader : public OTADownloader
+{
+public:
+    CHIP_ERROR BeginPrepareDownload() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR OnPreparedForDownload(CHIP_ERROR status) override
+    {
+        mPrepareStatus = status;
+        return CHIP_NO_ERROR;
+    }
+    void OnDownloadTimeout() override {}
+    void EndDownload(CHIP_ERROR reason) override { mEndReason = reason; }
+    CHIP_ERROR FetchNextData() override
+    {
+        mFetchCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR mPrepareStatus = CHIP_ERROR_INTERNAL;
+    CHIP_ERROR mEndReason     = CHIP_NO_ERROR;
+    size_t mFetchCount        = 0;
+};
+
+class TestOTAImageProcessorImpl : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+    }
+
+    static void TearDownTestSuite()
+    {
+        PlatformMgr().Shutdown();
+        chip::Platform::MemoryShutdown();
+    }
+
+    void SetUp() override
+    {
+        char imageFile[] = "/tmp/chip_ota_image_XXXXXX";
+        const int fd     = mkstemp(imageFile);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        mImageFile = imageFile;
+
+        mProcessor = std::make_unique<OTAImageProcessorImpl>();
+        mProcessor->SetOTADownloader(&mDownloader);
+        mProcessor->SetOTAImageFile(mImageFile.c_str());
+    }
+
+    void TearDown() override
+    {
+        mProcessor.reset();
+        unlink(mImageFile.c_str());
+    }
+
+    // The processor hands its work to the Matter thread, run it until the queue is empty
+    static void RunScheduledWork()
+    {
+        EXPECT_EQ(PlatformMgr().ScheduleWork([](intptr_t) { TEMPORARY_RETURN_IGNORED PlatformMgr().StopEventLoopTask(); }),
+                  CHIP_NO_ERROR);
+        PlatformMgr().RunEventLoop();
+    }
+
+    // Streams the image to the processor in blocks, the way the downloader does, and finalizes it
+    void Download(const std::vector<uint8_t> & image)
+    {
+        EXPECT_EQ(mProcessor->PrepareDownload(), CHIP_NO_ERROR);
+        RunScheduledWork();
+        EXPECT_EQ(mDownloader.mPrepareStatus, CHIP_NO_ERROR);
+
+        for (size_t offset = 0; offset < image.size(); offset += kBlockSize)
+        {
+            ByteSpan block(&image[offset], std::min(kBlockSize, image.size() - offset));
+            EXPECT_EQ(mProcessor->ProcessBlock(block), CHIP_NO_ERROR);
+            RunScheduledWork();
+        }
+        EXPECT_EQ(mDownloader.mEndReason, CHIP_NO_ERROR);
+        EXPECT_EQ(mDownloader.mFetchCount, (image.size() + kBlockSize - 1) / kBlockSize);
+
+        EXPECT_EQ(mProcessor->Finalize(), CHIP_NO_ERROR);
+        RunScheduledWork();
+    }
+
+    bool ImageFileExists() const
+    {
+        struct stat st;
+        return stat(mImageFile.c_str(), &st) == 0;
+    }
+
+    std::vector<uint8_t> ReadImageFile() const
+    {
+        std::vector<uint8_t> contents;
+        FILE * file = fopen(mImageFile.c_str(), "rb");
+        VerifyOrReturnValue(file != nullptr, contents);
+        uint8_t buffer[4096];
+        for (size_t length; (length = fread(buffer, 1, sizeof(buffer), file)) > 0;)
+        {
+            contents.insert(contents.end(), buffer, buffer + length);
+        }
+        fclose(file);
+        return contents;
+    }
+
+    FakeDownloader mDownloader;
+    std::unique_ptr<OTAImageProcessorImpl> mProcessor;
+    std::string mImageFile;
+};
+
+TEST_F(TestOTAImageProcessorImpl, TestValidImage)
+{
+    const std::vector<uint8_t> payload = MakePayload();
+    Download(MakeImage(payload));
+
+    EXPECT_EQ(mProcessor->GetBytesDownloaded(), payload.size());
+    EXPECT_EQ(mProcessor->GetPercentComplete().Value(), 100);
+
+    // Only the payload is written, and the image may be applied
+    EXPECT_EQ(ReadImageFile(), payload);
+    EXPECT_EQ(mProcessor->Apply(), CHIP_NO_ERROR);
+    RunScheduledWork();
+}
+
+TEST_F(TestOTAImageProcessorImpl, TestCorruptedPayload)
+{
+    std::vector<uint8_t> image = MakeImage(MakePayload());
+    image[image.size() - kPayloadSize / 2] ^= 0x01;
+    Download(image);
+
+    EXPECT_FALSE(ImageFileExists());
+    EXPECT_EQ(mProcessor->Apply(), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+}
+
+TEST_F(TestOTAImageProcessorImpl, TestTruncatedImage)
+{
+    std::vector<uint8_t> image = MakeImage(MakePayload());
+    image.resize(image.size() - 100);
+    Download(image);
+
+    EXPECT_FALSE(ImageFileExists());
+    EXPECT_EQ(mProcessor->Apply(), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+}
+
+TEST_F(TestOTAImageProcessorImpl, TestInvalidHeader)
+{
+    std::vector<uint8_t> image = MakeImage(MakePayload());
+    image[0] ^= 0xFF;
+
+    EXPECT_EQ(mProcessor->PrepareDownload(), CHIP_NO_ERROR);
+    RunScheduledWork();
+
+    ByteSpan block(image.data(), kBlockSize);
+    EXPECT_EQ(mProcessor->ProcessBlock(block), CHIP_NO_ERROR);
+    RunScheduledWork();
+    EXPECT_EQ(mDownloader.mEndReason, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+    EXPECT_EQ(mDownloader.mFetchCount, 0u);
+
+    EXPECT_EQ(mProcessor->Finalize(), CHIP_NO_ERROR);
+    RunScheduledWork();
+    EXPECT_EQ(mProcessor->Apply(), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+}
+
+TEST_F(TestOTAImageProcessorImpl, TestUnsupportedDigestType)
+{
+    const std::vector<uint8_t> image = MakeImage(MakePayload(), OTAImageDigestType::kSha384);
+
+    EXPECT_EQ(mProcessor->PrepareDownload(), CHIP_NO_ERROR);
+    RunScheduledWork();
+
+    ByteSpan block(image.data(), kBlockSize);
+    EXPECT_EQ(mProcessor->ProcessBlock(block), CHIP_NO_ERROR);
+    RunScheduledWork();
+    EXPECT_EQ(mDownloader.mEndReason, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+    EXPECT_EQ(mDownloader.mFetchCount, 0u);
+
+    // The image can't be verified, so Finalize discards it
+    EXPECT_EQ(mProcessor->Finalize(), CHIP_NO_ERROR);
+    RunScheduledWork();
+    EXPECT_FALSE(ImageFileExists());
+    EXPECT_EQ(mProcessor->Apply(), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+}
+
+} // namespace
@@ -29,6 +29,9 @@
 #include <string.h>
 
 #include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include <pw_unit_test/framework.h>
 
@@ -219,6 +222,87 @@ TEST_F(TestPlatformMgr, TryLockChipStack)
     PlatformMgr().Shutdown();
 }
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+// The POSIX worker pool is not used along with libev
+#if !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
+namespace {
+
+struct BackgroundWorkState
+{
+    std::thread::id matterThread;
+    std::mutex lock;
+    std::set<std::thread::id> workerThreads;
+    std::atomic<size_t> started{ 0 };
+    std::atomic<size_t> concurrent{ 0 };
+    size_t finished = 0;
+};
+
+BackgroundWorkState * gBackgroundWorkState;
+
+void FinishBackgroundWork(intptr_t)
+{
+    // Back on the Matter thread
+    EXPECT_EQ(std::this_thread::get_id(), gBackgroundWorkState->matterThread);
+    if (++gBackgroundWorkState->finished == CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE)
+    {
+        EXPECT_SUCCESS(PlatformMgr().StopEventLoopTask());
+    }
+}
+
+void RunBackgroundWork(intptr_t)
+{
+    BackgroundWorkState & state = *gBackgroundWorkState;
+    {
+        std::lock_guard<std::mutex> guard(state.lock);
+        state.workerThreads.insert(std::this_thread::get_id());
+    }
+
+    // Every work item waits for all the others to start, which only happens when each one has a worker of its own
+    state.started++;
+    for (size_t t = 0; state.started != CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE && t < 1000; t++)
+        chip::test_utils::SleepMillis(1);
+    if (state.started == CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE)
+    {
+        state.concurrent++;
+    }
+
+    EXPECT_SUCCESS(PlatformMgr().ScheduleWork(FinishBackgroundWork));
+}
+
+} // namespace
+
+TEST_F(TestPlatformMgr, BackgroundEventLoopTask)
+{
+    BackgroundWorkState state;
+    state.matterThread   = std::this_thread::get_id();
+    gBackgroundWorkState = &state;
+
+    EXPECT_EQ(PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+
+    // InitChipStack() already started the workers
+    EXPECT_EQ(PlatformMgr().StartBackgroundEventLoopTask(), CHIP_ERROR_INCORRECT_STATE);
+
+    for (size_t i = 0; i < CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE; i++)
+    {
+        EXPECT_SUCCESS(PlatformMgr().ScheduleBackgroundWork(RunBackgroundWork));
+    }
+    PlatformMgr().RunEventLoop();
+
+    EXPECT_EQ(PlatformMgr().StopBackgroundEventLoopTask(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(state.finished, static_cast<size_t>(CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE));
+    EXPECT_EQ(state.concurrent, static_cast<size_t>(CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE));
+    EXPECT_EQ(state.workerThreads.size(), static_cast<size_t>(CHIP_DEVICE_CONFIG_BG_TASK_POOL_SIZE));
+    EXPECT_EQ(state.workerThreads.count(state.matterThread), 0u);
+
+    PlatformMgr().Shutdown();
+    gBackgroundWorkState = nullptr;
+}
+
+#endif // !CHIP_SYSTEM_CONFIG_USE_LIBEV
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 void DeviceEventHandler(const ChipDeviceEvent * event, intptr_t arg)
 {
     EXPECT_EQ(arg, 12345);
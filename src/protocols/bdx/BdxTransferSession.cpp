@@ -6,8 +6,10 @@
 
 #include <protocols/bdx/BdxTransferSession.h>
 
+#include <lib/core/TLV.h>
 #include <lib/support/BufferReader.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedMemoryBuffer.h>
 #include <lib/support/TypeTraits.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <protocols/Protocols.h>
@@ -22,6 +24,13 @@
 namespace {
 constexpr uint8_t kBdxVersion = 0; ///< The version of this implementation of the BDX spec
 
+/// Implementation-specific metadata element that negotiates a windowed transfer. It carries the number of BlockQuery messages
+/// that may be outstanding, and is placed before any application metadata of the TransferInit and Accept messages.
+constexpr ::chip::TLV::Tag kWindowSizeMetadataTag = ::chip::TLV::ProfileTag(::chip::Protocols::BDX::Id.ToTLVProfileId(), 0xFF01);
+
+static_assert(CHIP_CONFIG_BDX_WINDOW_SIZE >= 1 && CHIP_CONFIG_BDX_WINDOW_SIZE <= UINT8_MAX,
+              "CHIP_CONFIG_BDX_WINDOW_SIZE must fit in the window size metadata element");
+
 /**
  * @brief
  *   Allocate a new PacketBuffer and write data from a BDX message struct.
@@ -43,6 +52,60 @@ CHIP_ERROR WriteToPacketBuffer(const ::chip::bdx::BdxMessage & msgStruct, ::chip
     return CHIP_NO_ERROR;
 }
 
+/**
+ * @brief
+ *   Prepend the window size element to the metadata of a TransferInit or Accept message. On success, metadata and
+ *   metadataLength refer to buf, which must outlive their use.
+ */
+CHIP_ERROR PrependWindowSizeMetadata(uint8_t windowSize, const uint8_t *& metadata, size_t & metadataLength,
+                                     ::chip::Platform::ScopedMemoryBuffer<uint8_t> & buf)
+{
+    // Control octet, fully-qualified 6-byte tag and a 1-byte unsigned integer
+    constexpr size_t kWindowSizeElementSize = 8;
+
+    VerifyOrReturnError(buf.Alloc(kWindowSizeElementSize + metadataLength), CHIP_ERROR_NO_MEMORY);
+
+    ::chip::TLV::TLVWriter writer;
+    writer.Init(buf.Get(), kWindowSizeElementSize);
+    ReturnErrorOnFailure(writer.Put(kWindowSizeMetadataTag, windowSize));
+    ReturnErrorOnFailure(writer.Finalize());
+
+    const size_t elementSize = writer.GetLengthWritten();
+    if (metadataLength > 0)
+    {
+        memcpy(buf.Get() + elementSize, metadata, metadataLength);
+    }
+
+    metadata       = buf.Get();
+    metadataLength = elementSize + metadataLength;
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * @brief
+ *   Look for the window size element at the start of received metadata. If found, it is removed from metadata so that only
+ *   the application metadata is reported.
+ *
+ * @return CHIP_ERROR_NOT_FOUND if there is no window size element, or an error if the element is malformed
+ */
+CHIP_ERROR ExtractWindowSizeMetadata(const uint8_t *& metadata, size_t & metadataLength, uint8_t & windowSize)
+{
+    VerifyOrReturnError(metadata != nullptr && metadataLength > 0, CHIP_ERROR_NOT_FOUND);
+
+    ::chip::TLV::TLVReader reader;
+    reader.Init(metadata, metadataLength);
+    VerifyOrReturnError(reader.Next() == CHIP_NO_ERROR && reader.GetTag() == kWindowSizeMetadataTag, CHIP_ERROR_NOT_FOUND);
+    ReturnErrorOnFailure(reader.Get(windowSize));
+    VerifyOrReturnError(windowSize > 0, CHIP_ERROR_INVALID_INTEGER_VALUE);
+
+    const size_t elementSize = reader.GetLengthRead();
+    metadataLength -= elementSize;
+    metadata = (metadataLength > 0) ? metadata + elementSize : nullptr;
+
+    return CHIP_NO_ERROR;
+}
+
 template <typename MessageType>
 void PrepareOutgoingMessageEvent(MessageType messageType, chip::bdx::TransferSession::OutputEventType & pendingOutput,
                                  chip::bdx::TransferSession::MessageTypeData & outputMsgType)
@@ -82,6 +145,13 @@ void TransferSession::PollOutput(OutputEvent & event, System::Clock::Timestamp c
         return;
     }
 
+    // The queries of a windowed transfer are reported one at a time, each once the previous one has been answered
+    if (mPendingOutput == OutputEventType::kNone && HasUnreportedQuery())
+    {
+        mPendingOutput = OutputEventType::kQueryReceived;
+        mQueryReported = true;
+    }
+
     switch (mPendingOutput)
     {
     case OutputEventType::kNone:
@@ -151,6 +221,7 @@ CHIP_ERROR TransferSession::StartTransfer(TransferRole role, const TransferInitD
     mMaxSupportedBlockSize = initData.MaxBlockSize;
     mStartOffset           = initData.StartOffset;
     mTransferLength        = initData.Length;
+    mWindowSize            = initData.Windowed ? CHIP_CONFIG_BDX_WINDOW_SIZE : 0;
 
     // Prepare TransferInit message
     TransferInit initMsg;
@@ -164,6 +235,12 @@ CHIP_ERROR TransferSession::StartTransfer(TransferRole role, const TransferInitD
     initMsg.Metadata           = initData.Metadata;
     initMsg.MetadataLength     = initData.MetadataLength;
 
+    Platform::ScopedMemoryBuffer<uint8_t> metadataBuf;
+    if (initData.Windowed)
+    {
+        ReturnErrorOnFailure(PrependWindowSizeMetadata(mWindowSize, initMsg.Metadata, initMsg.MetadataLength, metadataBuf));
+    }
+
     ReturnErrorOnFailure(WriteToPacketBuffer(initMsg, mPendingMsgHandle));
 
     const MessageType msgType = (mRole == TransferRole::kSender) ? MessageType::SendInit : MessageType::ReceiveInit;
@@ -211,7 +288,22 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
     VerifyOrReturnError(proposedControlOpts.Has(acceptData.ControlMode), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(acceptData.MaxBlockSize <= mTransferRequestData.MaxBlockSize, CHIP_ERROR_INVALID_ARGUMENT);
 
+    // Only a Receiver Drive transfer can be windowed, and only if the initiator proposed it
+    VerifyOrReturnError(!acceptData.Windowed ||
+                            (mTransferRequestData.Windowed && acceptData.ControlMode == TransferControlFlags::kReceiverDrive),
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
     mTransferMaxBlockSize = acceptData.MaxBlockSize;
+    mWindowed             = acceptData.Windowed;
+    mWindowSize           = mWindowed ? std::min<uint8_t>(mWindowSize, CHIP_CONFIG_BDX_WINDOW_SIZE) : 0;
+
+    const uint8_t * metadata = acceptData.Metadata;
+    size_t metadataLength    = acceptData.MetadataLength;
+    Platform::ScopedMemoryBuffer<uint8_t> metadataBuf;
+    if (mWindowed)
+    {
+        ReturnErrorOnFailure(PrependWindowSizeMetadata(mWindowSize, metadata, metadataLength, metadataBuf));
+    }
 
     if (mRole == TransferRole::kSender)
     {
@@ -224,8 +316,8 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
         acceptMsg.MaxBlockSize   = acceptData.MaxBlockSize;
         acceptMsg.StartOffset    = acceptData.StartOffset;
         acceptMsg.Length         = acceptData.Length;
-        acceptMsg.Metadata       = acceptData.Metadata;
-        acceptMsg.MetadataLength = acceptData.MetadataLength;
+        acceptMsg.Metadata       = metadata;
+        acceptMsg.MetadataLength = metadataLength;
 
         ReturnErrorOnFailure(WriteToPacketBuffer(acceptMsg, mPendingMsgHandle));
         msgType = MessageType::ReceiveAccept;
@@ -241,8 +333,8 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
         acceptMsg.TransferCtlFlags.Set(acceptData.ControlMode);
         acceptMsg.Version        = mTransferVersion;
         acceptMsg.MaxBlockSize   = acceptData.MaxBlockSize;
-        acceptMsg.Metadata       = acceptData.Metadata;
-        acceptMsg.MetadataLength = acceptData.MetadataLength;
+        acceptMsg.Metadata       = metadata;
+        acceptMsg.MetadataLength = metadataLength;
 
         ReturnErrorOnFailure(WriteToPacketBuffer(acceptMsg, mPendingMsgHandle));
         msgType = MessageType::SendAccept;
@@ -284,7 +376,8 @@ CHIP_ERROR TransferSession::PrepareBlockQuery()
     VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mRole == TransferRole::kReceiver, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mWindowed ? (mNextQueryNum - mNextBlockNum < mWindowSize) : !mAwaitingResponse,
+                        CHIP_ERROR_INCORRECT_STATE);
 
     BlockQuery queryMsg;
     queryMsg.BlockCounter = mNextQueryNum;
@@ -327,7 +420,7 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
     VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mRole == TransferRole::kSender, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mWindowed ? mQueryReported : !mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
 
     // Verify non-zero data is provided and is no longer than MaxBlockSize (BlockEOF may contain 0 length data)
     VerifyOrReturnError((inData.Data != nullptr) && (inData.Length <= mTransferMaxBlockSize), CHIP_ERROR_INVALID_ARGUMENT);
@@ -350,8 +443,11 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
         mState = TransferState::kAwaitingEOFAck;
     }
 
-    mAwaitingResponse = true;
-    mLastBlockNum     = mNextBlockNum++;
+    mLastBlockNum = mNextBlockNum++;
+
+    // A windowed sender only waits for a response once it has answered all the queries it received
+    mAwaitingResponse = !mWindowed || (msgType == MessageType::BlockEOF) || (mNextQueryNum == mNextBlockNum);
+    mQueryReported    = false;
 
     PrepareOutgoingMessageEvent(msgType, mPendingOutput, mMsgTypeData);
 
@@ -364,6 +460,7 @@ CHIP_ERROR TransferSession::PrepareBlockAck()
     VerifyOrReturnError((mState == TransferState::kTransferInProgress) || (mState == TransferState::kReceivedEOF),
                         CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!mWindowed || (mState == TransferState::kReceivedEOF), CHIP_ERROR_INCORRECT_STATE);
 
     CounterMessage ackMsg;
     ackMsg.BlockCounter       = mLastBlockNum;
@@ -412,6 +509,8 @@ void TransferSession::Reset()
     mPendingOutput = OutputEventType::kNone;
     mState         = TransferState::kUnitialized;
     mSuppportedXferOpts.ClearAll();
+    mWindowed              = false;
+    mWindowSize            = 0;
     mTransferVersion       = 0;
     mMaxSupportedBlockSize = 0;
     mStartOffset           = 0;
@@ -430,6 +529,7 @@ void TransferSession::Reset()
     mTimeoutStartTime       = System::Clock::kZero;
     mShouldInitTimeoutStart = true;
     mAwaitingResponse       = false;
+    mQueryReported          = false;
 }
 
 CHIP_ERROR TransferSession::HandleMessageReceived(const PayloadHeader & payloadHeader, System::PacketBufferHandle msg,
@@ -459,10 +559,13 @@ CHIP_ERROR TransferSession::HandleMessageReceived(const PayloadHeader & payloadH
 CHIP_ERROR TransferSession::HandleBdxMessage(const PayloadHeader & header, System::PacketBufferHandle msg)
 {
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
 
     const MessageType msgType = static_cast<MessageType>(header.GetMessageType());
 
+    // The queries of a windowed transfer are only counted, so they may arrive while other output is pending
+    VerifyOrReturnError(mPendingOutput == OutputEventType::kNone || (mWindowed && msgType == MessageType::BlockQuery),
+                        CHIP_ERROR_INCORRECT_STATE);
+
     switch (msgType)
     {
     case MessageType::SendInit:
@@ -551,6 +654,11 @@ void TransferSession::HandleTransferInit(MessageType msgType, System::PacketBuff
     const CHIP_ERROR err = transferInit.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
+    // The initiator proposes a windowed transfer in the metadata, see TransferAcceptData::Windowed
+    const CHIP_ERROR windowErr = ExtractWindowSizeMetadata(transferInit.Metadata, transferInit.MetadataLength, mWindowSize);
+    VerifyOrReturn(windowErr == CHIP_NO_ERROR || windowErr == CHIP_ERROR_NOT_FOUND,
+                   PrepareStatusReport(StatusCode::kBadMessageContents));
+
     ResolveTransferControlOptions(transferInit.TransferCtlOptions);
     mTransferVersion      = std::min(kBdxVersion, transferInit.Version);
     mTransferMaxBlockSize = std::min(mMaxSupportedBlockSize, transferInit.MaxBlockSize);
@@ -568,6 +676,7 @@ void TransferSession::HandleTransferInit(MessageType msgType, System::PacketBuff
     mTransferRequestData.FileDesLength    = transferInit.FileDesLength;
     mTransferRequestData.Metadata         = transferInit.Metadata;
     mTransferRequestData.MetadataLength   = transferInit.MetadataLength;
+    mTransferRequestData.Windowed         = (windowErr == CHIP_NO_ERROR);
 
     mPendingMsgHandle = std::move(msgData);
     mPendingOutput    = OutputEventType::kInitReceived;
@@ -588,8 +697,14 @@ void TransferSession::HandleReceiveAccept(System::PacketBufferHandle msgData)
     const CHIP_ERROR err = rcvAcceptMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
+    uint8_t windowSize         = 0;
+    const CHIP_ERROR windowErr = ExtractWindowSizeMetadata(rcvAcceptMsg.Metadata, rcvAcceptMsg.MetadataLength, windowSize);
+    VerifyOrReturn(windowErr == CHIP_NO_ERROR || windowErr == CHIP_ERROR_NOT_FOUND,
+                   PrepareStatusReport(StatusCode::kBadMessageContents));
+
     // Verify that Accept parameters are compatible with the original proposed parameters
     ReturnOnFailure(VerifyProposedMode(rcvAcceptMsg.TransferCtlFlags));
+    ReturnOnFailure(VerifyProposedWindow(windowSize));
 
     // Per the BDX spec, the chosen Max Block Size SHALL be <= the proposed Max Block Size. Validate the received value
     // rather than adopting it unconditionally.
@@ -602,6 +717,7 @@ void TransferSession::HandleReceiveAccept(System::PacketBufferHandle msgData)
     // Note: if VerifyProposedMode() returned with no error, then mControlMode must match the proposed mode in the ReceiveAccept
     // message
     mTransferAcceptData.ControlMode    = mControlMode;
+    mTransferAcceptData.Windowed       = mWindowed;
     mTransferAcceptData.MaxBlockSize   = rcvAcceptMsg.MaxBlockSize;
     mTransferAcceptData.StartOffset    = rcvAcceptMsg.StartOffset;
     mTransferAcceptData.Length         = rcvAcceptMsg.Length;
@@ -628,8 +744,14 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
     const CHIP_ERROR err = sendAcceptMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
+    uint8_t windowSize         = 0;
+    const CHIP_ERROR windowErr = ExtractWindowSizeMetadata(sendAcceptMsg.Metadata, sendAcceptMsg.MetadataLength, windowSize);
+    VerifyOrReturn(windowErr == CHIP_NO_ERROR || windowErr == CHIP_ERROR_NOT_FOUND,
+                   PrepareStatusReport(StatusCode::kBadMessageContents));
+
     // Verify that Accept parameters are compatible with the original proposed parameters
     ReturnOnFailure(VerifyProposedMode(sendAcceptMsg.TransferCtlFlags));
+    ReturnOnFailure(VerifyProposedWindow(windowSize));
 
     // Per the BDX spec, the chosen Max Block Size SHALL be <= the proposed Max Block Size. Validate the received value here too.
     VerifyOrReturn(sendAcceptMsg.MaxBlockSize <= mMaxSupportedBlockSize, PrepareStatusReport(StatusCode::kBadMessageContents));
@@ -639,6 +761,7 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
     mTransferMaxBlockSize = sendAcceptMsg.MaxBlockSize;
 
     mTransferAcceptData.ControlMode    = mControlMode;
+    mTransferAcceptData.Windowed       = mWindowed;
     mTransferAcceptData.MaxBlockSize   = sendAcceptMsg.MaxBlockSize;
     mTransferAcceptData.StartOffset    = mStartOffset;    // Not included in SendAccept msg, so use member
     mTransferAcceptData.Length         = mTransferLength; // Not included in SendAccept msg, so use member
@@ -659,19 +782,31 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlockQuery(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    // A windowed receiver may have had queries in flight when the BlockEOF was sent, they need no answer
+    VerifyOrReturn(!mWindowed || mState != TransferState::kAwaitingEOFAck);
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mAwaitingResponse || mWindowed, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockQuery query;
     const CHIP_ERROR err = query.Parse(std::move(msgData));
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(query.BlockCounter == mNextBlockNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
-
-    mPendingOutput = OutputEventType::kQueryReceived;
+    const uint32_t expectedCounter = mWindowed ? mNextQueryNum : mNextBlockNum;
+    VerifyOrReturn(query.BlockCounter == expectedCounter, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(!mWindowed || (mNextQueryNum - mNextBlockNum < mWindowSize),
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     mAwaitingResponse = false;
     mLastQueryNum     = query.BlockCounter;
+
+    if (mWindowed)
+    {
+        // Reported by PollOutput() once the queries received before it are answered
+        mNextQueryNum++;
+        return;
+    }
+
+    mPendingOutput = OutputEventType::kQueryReceived;
 }
 
 void TransferSession::HandleBlockQueryWithSkip(System::PacketBufferHandle msgData)
@@ -691,6 +826,12 @@ void TransferSession::HandleBlockQueryWithSkip(System::PacketBufferHandle msgDat
     mAwaitingResponse        = false;
     mLastQueryNum            = query.BlockCounter;
     mBytesToSkip.BytesToSkip = query.BytesToSkip;
+
+    if (mWindowed)
+    {
+        mNextQueryNum++;
+        mQueryReported = true;
+    }
 }
 
 void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
@@ -703,7 +844,9 @@ void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
     const CHIP_ERROR err = blockMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(blockMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    // Windowed transfers answer the outstanding queries in order
+    const uint32_t expectedCounter = mWindowed ? mNextBlockNum : mLastQueryNum;
+    VerifyOrReturn(blockMsg.BlockCounter == expectedCounter, PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn((blockMsg.DataLength > 0) && (blockMsg.DataLength <= mTransferMaxBlockSize),
                    PrepareStatusReport(StatusCode::kBadMessageContents));
 
@@ -723,8 +866,9 @@ void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
 
     mNumBytesProcessed += blockMsg.DataLength;
     mLastBlockNum = blockMsg.BlockCounter;
+    mNextBlockNum = mLastBlockNum + 1;
 
-    mAwaitingResponse = false;
+    mAwaitingResponse = mWindowed && (mNextQueryNum != mNextBlockNum);
 }
 
 void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
@@ -737,7 +881,8 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
     const CHIP_ERROR err = blockEOFMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(blockEOFMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    const uint32_t expectedCounter = mWindowed ? mNextBlockNum : mLastQueryNum;
+    VerifyOrReturn(blockEOFMsg.BlockCounter == expectedCounter, PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn(blockEOFMsg.DataLength <= mTransferMaxBlockSize, PrepareStatusReport(StatusCode::kBadMessageContents));
 
     mBlockEventData.Data         = blockEOFMsg.Data;
@@ -750,6 +895,7 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
 
     mNumBytesProcessed += blockEOFMsg.DataLength;
     mLastBlockNum = blockEOFMsg.BlockCounter;
+    mNextBlockNum = mLastBlockNum + 1;
 
     mAwaitingResponse = false;
     mState            = TransferState::kReceivedEOF;
@@ -867,6 +1013,21 @@ CHIP_ERROR TransferSession::VerifyProposedMode(const BitFlags<TransferControlFla
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TransferSession::VerifyProposedWindow(uint8_t windowSize)
+{
+    // A window may only be accepted for a Receiver Drive transfer, and may not be larger than the proposed one
+    if (windowSize > 0 && (windowSize > mWindowSize || mControlMode != TransferControlFlags::kReceiverDrive))
+    {
+        PrepareStatusReport(StatusCode::kTransferMethodNotSupported);
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    mWindowed   = (windowSize > 0);
+    mWindowSize = windowSize;
+
+    return CHIP_NO_ERROR;
+}
+
 void TransferSession::PrepareStatusReport(StatusCode code)
 {
     mStatusReportData.statusCode = code;
@@ -899,6 +1060,12 @@ bool TransferSession::IsTransferLengthDefinite() const
     return (mTransferLength > 0);
 }
 
+bool TransferSession::HasUnreportedQuery() const
+{
+    return mWindowed && (mRole == TransferRole::kSender) && (mState == TransferState::kTransferInProgress) && !mQueryReported &&
+        (mNextQueryNum != mNextBlockNum);
+}
+
 const char * TransferSession::OutputEvent::ToString(OutputEventType outputEventType)
 {
     return TypeToString(outputEventType);
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <protocols/bdx/BdxMessages.h>
 #include <system/SystemClock.h>
@@ -57,6 +58,11 @@ public:
         // Additional metadata (optional, TLV format)
         const uint8_t * Metadata = nullptr;
         size_t MetadataLength    = 0;
+
+        // Propose a windowed transfer (see TransferAcceptData::Windowed) with a window of CHIP_CONFIG_BDX_WINDOW_SIZE blocks. The
+        // proposal is an implementation-specific element placed before the metadata, and peers that do not know it accept a
+        // lock-step transfer instead. On the responder, this reports whether the initiator proposed it.
+        bool Windowed = false;
     };
 
     struct TransferAcceptData
@@ -70,6 +76,11 @@ public:
         // Additional metadata (optional, TLV format)
         const uint8_t * Metadata = nullptr;
         size_t MetadataLength    = 0;
+
+        // In a windowed transfer, the receiver may have several BlockQuery messages outstanding, and the sender answers them in
+        // order. The window is the smaller of the proposed one and CHIP_CONFIG_BDX_WINDOW_SIZE. Only receiver drive transfers can
+        // be windowed, and only if the initiator proposed it.
+        bool Windowed = false;
     };
 
     struct StatusReportData
@@ -245,6 +256,9 @@ public:
      * @brief
      *   Prepare a BlockQuery message. The Block counter will be populated automatically.
      *
+     *   In a windowed transfer, this may be called while fewer queries than the negotiated window are outstanding, after the
+     *   previous message has been emitted via PollOutput().
+     *
      * @return CHIP_ERROR The result of the preparation of a BlockQuery message. May also indicate if the TransferSession object
      *                    is unable to handle this request.
      */
@@ -254,6 +268,8 @@ public:
      * @brief
      *   Prepare a BlockQueryWithSkip message. The Block counter will be populated automatically.
      *
+     *   In a windowed transfer, this may only be called while no query is outstanding.
+     *
      * @param bytesToSkip Number of bytes to seek skip
      *
      * @return CHIP_ERROR The result of the preparation of a BlockQueryWithSkip message. May also indicate if the TransferSession
@@ -265,6 +281,9 @@ public:
      * @brief
      *   Prepare a Block message. The Block counter will be populated automatically.
      *
+     *   In a windowed transfer, each kQueryReceived event must be answered with a Block before the next one is emitted. Queries
+     *   that arrive after the BlockEOF was prepared are dropped.
+     *
      * @param inData Contains data for filling out the Block message
      *
      * @return CHIP_ERROR The result of the preparation of a Block message. May also indicate if the TransferSession object
@@ -276,6 +295,8 @@ public:
      * @brief
      *   Prepare a BlockAck message. The Block counter will be populated automatically.
      *
+     *   In a windowed transfer, only the BlockEOF is acknowledged.
+     *
      * @return CHIP_ERROR The result of the preparation of a BlockAck message. May also indicate if the TransferSession object
      *                    is unable to handle this request.
      */
@@ -315,6 +336,7 @@ public:
                                      System::Clock::Timestamp curTime);
 
     TransferControlFlags GetControlMode() const { return mControlMode; }
+    bool IsWindowed() const { return mWindowed; }
     uint64_t GetStartOffset() const { return mStartOffset; }
     uint64_t GetTransferLength() const { return mTransferLength; }
     uint16_t GetTransferBlockSize() const { return mTransferMaxBlockSize; }
@@ -371,8 +393,15 @@ private:
      */
     CHIP_ERROR VerifyProposedMode(const BitFlags<TransferControlFlags> & proposed);
 
+    /**
+     * @brief
+     *   Used when handling an Accept message. Verifies that an accepted window was proposed, for a Receiver Drive transfer.
+     */
+    CHIP_ERROR VerifyProposedWindow(uint8_t windowSize);
+
     void PrepareStatusReport(StatusCode code);
     bool IsTransferLengthDefinite() const;
+    bool HasUnreportedQuery() const;
 
     OutputEventType mPendingOutput = OutputEventType::kNone;
     TransferState mState           = TransferState::kUnitialized;
@@ -384,6 +413,8 @@ private:
 
     // Used to govern transfer once it has been accepted
     TransferControlFlags mControlMode;
+    bool mWindowed                 = false;
+    uint8_t mWindowSize            = 0; ///< Proposed, then negotiated, maximum number of outstanding queries
     uint8_t mTransferVersion       = 0;
     uint64_t mStartOffset          = 0; ///< 0 represents no offset
     uint64_t mTransferLength       = 0; ///< 0 represents indefinite length
@@ -400,6 +431,8 @@ private:
 
     size_t mNumBytesProcessed = 0;
 
+    // The receiver counts the received Blocks in mNextBlockNum, and the sender of a windowed transfer counts the received
+    // queries in mNextQueryNum, so that the number of outstanding queries is mNextQueryNum - mNextBlockNum on both sides.
     uint32_t mLastBlockNum = 0;
     uint32_t mNextBlockNum = 0;
     uint32_t mLastQueryNum = 0;
@@ -409,6 +442,7 @@ private:
     System::Clock::Timestamp mTimeoutStartTime = System::Clock::kZero;
     bool mShouldInitTimeoutStart               = true;
     bool mAwaitingResponse                     = false;
+    bool mQueryReported                        = false; ///< Windowed sender emitted kQueryReceived and awaits its Block
 };
 
 } // namespace bdx
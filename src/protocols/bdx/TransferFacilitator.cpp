@@ -92,6 +92,13 @@ void TransferFacilitator::PollForOutput()
     mTransfer.PollOutput(outEvent, System::SystemClock().GetMonotonicTimestamp());
     HandleTransferSessionOutput(outEvent);
 
+    // A windowed transfer may have more queued queries or blocks to hand out, which should not wait for the next poll
+    if (mTransfer.IsWindowed() && outEvent.EventType != TransferSession::OutputEventType::kNone)
+    {
+        ScheduleImmediatePoll();
+        return;
+    }
+
     VerifyOrReturn(mSystemLayer != nullptr, ChipLogError(BDX, "%s mSystemLayer is null", __FUNCTION__));
     TEMPORARY_RETURN_IGNORED mSystemLayer->StartTimer(mPollFreq, PollTimerHandler, this);
 }
@@ -1,3 +1,4 @@
+#include <deque>
 #include <string.h>
 
 #include <pw_unit_test/framework.h>
@@ -875,3 +876,319 @@ TEST_F(TestBdxTransferSession, TestRejectTransfer)
     // Reject the transfer with a status
     SendAndVerifyRejectMsg(outEvent, respondingSender, StatusCode::kResponderBusy, initiatingReceiver);
 }
+
+// Test a windowed transfer: the receiver keeps several queries outstanding and the sender answers them in order.
+TEST_F(TestBdxTransferSession, TestWindowedReceiverDrive)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingReceiver;
+    TransferSession respondingSender;
+
+    uint16_t blockSize             = 64;
+    uint8_t fakeData[64]           = { 0 };
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+    TransferControlFlags driveMode = TransferControlFlags::kReceiverDrive;
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = blockSize;
+    initOptions.Windowed         = true;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    // The window is negotiated alongside the application metadata, which is reported unchanged
+    uint8_t tlvBuf[64]    = { 0 };
+    char metadataStr[11]  = { "hi_dad.txt" };
+    uint32_t bytesWritten = 0;
+    EXPECT_EQ(WriteTLVString(tlvBuf, sizeof(tlvBuf), metadataStr, bytesWritten), CHIP_NO_ERROR);
+    initOptions.Metadata       = tlvBuf;
+    initOptions.MetadataLength = bytesWritten;
+
+    BitFlags<TransferControlFlags> senderOpts(driveMode);
+
+    SendAndVerifyTransferInit(outEvent, timeout, initiatingReceiver, TransferRole::kReceiver, initOptions, respondingSender,
+                              senderOpts, blockSize);
+    EXPECT_TRUE(outEvent.transferInitData.Windowed);
+    EXPECT_EQ(outEvent.transferInitData.MetadataLength, bytesWritten);
+    EXPECT_EQ(ReadAndVerifyTLVString(outEvent.transferInitData.Metadata,
+                                     static_cast<uint32_t>(outEvent.transferInitData.MetadataLength), metadataStr,
+                                     strlen(metadataStr)),
+              CHIP_NO_ERROR);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode    = driveMode;
+    acceptData.MaxBlockSize   = blockSize;
+    acceptData.Metadata       = tlvBuf;
+    acceptData.MetadataLength = bytesWritten;
+    acceptData.Windowed       = true;
+
+    SendAndVerifyAcceptMsg(outEvent, respondingSender, TransferRole::kSender, acceptData, initiatingReceiver, initOptions);
+    EXPECT_TRUE(outEvent.transferAcceptData.Windowed);
+    EXPECT_EQ(outEvent.transferAcceptData.MetadataLength, bytesWritten);
+    // The Async flag is not used to negotiate windowing
+    EXPECT_EQ(outEvent.transferAcceptData.ControlMode, driveMode);
+    EXPECT_TRUE(initiatingReceiver.IsWindowed());
+    EXPECT_TRUE(respondingSender.IsWindowed());
+
+    // The receiver may fill the window, and only acknowledges the BlockEOF
+    for (uint32_t i = 0; i < CHIP_CONFIG_BDX_WINDOW_SIZE; i++)
+    {
+        EXPECT_EQ(initiatingReceiver.PrepareBlockQuery(), CHIP_NO_ERROR);
+        initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+        VerifyBdxMessageToSend(outEvent, MessageType::BlockQuery);
+        EXPECT_EQ(AttachHeaderAndSend(outEvent.msgTypeData, std::move(outEvent.MsgData), respondingSender), CHIP_NO_ERROR);
+    }
+    EXPECT_NE(initiatingReceiver.PrepareBlockQuery(), CHIP_NO_ERROR);
+    EXPECT_NE(initiatingReceiver.PrepareBlockAck(), CHIP_NO_ERROR);
+    VerifyNoMoreOutput(initiatingReceiver);
+
+    // The sender reports one query at a time, and the last Block it sends is the BlockEOF
+    for (uint32_t i = 0; i < CHIP_CONFIG_BDX_WINDOW_SIZE; i++)
+    {
+        const bool isEof = (i == CHIP_CONFIG_BDX_WINDOW_SIZE - 1);
+
+        respondingSender.PollOutput(outEvent, kNoAdvanceTime);
+        EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kQueryReceived);
+        VerifyNoMoreOutput(respondingSender);
+
+        TransferSession::BlockData blockData;
+        blockData.Data   = fakeData;
+        blockData.Length = blockSize;
+        blockData.IsEof  = isEof;
+        EXPECT_EQ(respondingSender.PrepareBlock(blockData), CHIP_NO_ERROR);
+        respondingSender.PollOutput(outEvent, kNoAdvanceTime);
+        VerifyBdxMessageToSend(outEvent, isEof ? MessageType::BlockEOF : MessageType::Block);
+
+        EXPECT_EQ(AttachHeaderAndSend(outEvent.msgTypeData, std::move(outEvent.MsgData), initiatingReceiver), CHIP_NO_ERROR);
+        initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+        EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kBlockReceived);
+        EXPECT_EQ(outEvent.blockdata.BlockCounter, i);
+        EXPECT_EQ(outEvent.blockdata.IsEof, isEof);
+        VerifyNoMoreOutput(initiatingReceiver);
+
+        if (i == 0 && !isEof)
+        {
+            // The window has room for one more query, which is still in flight when the BlockEOF is sent
+            EXPECT_EQ(initiatingReceiver.PrepareBlockQuery(), CHIP_NO_ERROR);
+            initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+            VerifyBdxMessageToSend(outEvent, MessageType::BlockQuery);
+            EXPECT_EQ(AttachHeaderAndSend(outEvent.msgTypeData, std::move(outEvent.MsgData), respondingSender), CHIP_NO_ERROR);
+        }
+    }
+
+    // The query that was outstanding when the BlockEOF was sent is not reported
+    VerifyNoMoreOutput(respondingSender);
+    SendAndVerifyBlockAck(respondingSender, initiatingReceiver, outEvent, true);
+}
+
+// Test that a windowed transfer falls back to a lock-step one when the responder does not accept windowing, and that an
+// Accept may not choose windowing unless it was proposed.
+TEST_F(TestBdxTransferSession, TestWindowedFallback)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingReceiver;
+    TransferSession respondingSender;
+
+    uint16_t blockSize             = 64;
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+    TransferControlFlags driveMode = TransferControlFlags::kReceiverDrive;
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = blockSize;
+    initOptions.Windowed         = true;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    BitFlags<TransferControlFlags> senderOpts(driveMode);
+
+    SendAndVerifyTransferInit(outEvent, timeout, initiatingReceiver, TransferRole::kReceiver, initOptions, respondingSender,
+                              senderOpts, blockSize);
+    EXPECT_EQ(respondingSender.GetControlMode(), driveMode);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = driveMode;
+    acceptData.MaxBlockSize = blockSize;
+    acceptData.Windowed     = false;
+    SendAndVerifyAcceptMsg(outEvent, respondingSender, TransferRole::kSender, acceptData, initiatingReceiver, initOptions);
+    EXPECT_FALSE(outEvent.transferAcceptData.Windowed);
+    EXPECT_FALSE(initiatingReceiver.IsWindowed());
+
+    // Lock-step: a single query may be outstanding
+    EXPECT_EQ(initiatingReceiver.PrepareBlockQuery(), CHIP_NO_ERROR);
+    initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    VerifyBdxMessageToSend(outEvent, MessageType::BlockQuery);
+    EXPECT_NE(initiatingReceiver.PrepareBlockQuery(), CHIP_NO_ERROR);
+
+    // A responder may not choose windowing unless it was proposed
+    TransferSession lockStepReceiver;
+    TransferSession lockStepSender;
+    initOptions.Windowed = false;
+
+    SendAndVerifyTransferInit(outEvent, timeout, lockStepReceiver, TransferRole::kReceiver, initOptions, lockStepSender, senderOpts,
+                              blockSize);
+    EXPECT_FALSE(outEvent.transferInitData.Windowed);
+
+    acceptData.Windowed = true;
+    EXPECT_EQ(lockStepSender.AcceptTransfer(acceptData), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // An initiator that did not propose windowing rejects an Accept that chooses it
+    TransferSession windowedReceiver;
+    TransferSession windowedSender;
+    initOptions.Windowed = true;
+
+    SendAndVerifyTransferInit(outEvent, timeout, windowedReceiver, TransferRole::kReceiver, initOptions, windowedSender, senderOpts,
+                              blockSize);
+    EXPECT_EQ(windowedSender.AcceptTransfer(acceptData), CHIP_NO_ERROR);
+    windowedSender.PollOutput(outEvent, kNoAdvanceTime);
+    VerifyBdxMessageToSend(outEvent, MessageType::ReceiveAccept);
+
+    EXPECT_EQ(AttachHeaderAndSend(outEvent.msgTypeData, std::move(outEvent.MsgData), lockStepReceiver), CHIP_NO_ERROR);
+    lockStepReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kMsgToSend);
+    VerifyStatusReport(outEvent.MsgData, StatusCode::kTransferMethodNotSupported);
+}
+
+namespace {
+
+struct InFlightMessage
+{
+    System::Clock::Timestamp deliveryTime;
+    TransferSession * destination;
+    TransferSession::MessageTypeData typeData;
+    System::PacketBufferHandle msg;
+};
+
+// Runs a receiver drive transfer of numBlocks Blocks over a simulated link that delivers every message after the given latency,
+// and returns the simulated time at which the sender received the BlockAckEOF.
+System::Clock::Timestamp RunTransferOverDelayedLink(bool windowed, uint32_t numBlocks, System::Clock::Milliseconds64 latency)
+{
+    TransferSession receiver;
+    TransferSession sender;
+    std::deque<InFlightMessage> inFlight;
+    System::Clock::Timestamp now   = System::Clock::kZero;
+    System::Clock::Timeout timeout = System::Clock::Seconds16(60);
+    uint8_t fakeData[64]           = { 0 };
+    uint32_t numBlocksReceived     = 0;
+    bool done                      = false;
+
+    // Keeps the window full, or a single query outstanding in a lock-step transfer
+    auto queryIfWindowAllows = [&]() {
+        const uint32_t maxOutstanding = windowed ? CHIP_CONFIG_BDX_WINDOW_SIZE : 1;
+        if (receiver.GetNextQueryNum() - numBlocksReceived < maxOutstanding)
+        {
+            EXPECT_EQ(receiver.PrepareBlockQuery(), CHIP_NO_ERROR);
+        }
+    };
+
+    auto handleEvent = [&](TransferSession & session, TransferSession & peer, TransferSession::OutputEvent & event) {
+        switch (event.EventType)
+        {
+        case TransferSession::OutputEventType::kMsgToSend:
+            inFlight.push_back({ now + latency, &peer, event.msgTypeData, std::move(event.MsgData) });
+            if (&session == &receiver && event.msgTypeData.HasMessageType(MessageType::BlockQuery))
+            {
+                queryIfWindowAllows();
+            }
+            break;
+        case TransferSession::OutputEventType::kInitReceived: {
+            TransferSession::TransferAcceptData acceptData;
+            acceptData.ControlMode  = TransferControlFlags::kReceiverDrive;
+            acceptData.MaxBlockSize = sender.GetTransferBlockSize();
+            acceptData.Windowed     = event.transferInitData.Windowed;
+            EXPECT_EQ(sender.AcceptTransfer(acceptData), CHIP_NO_ERROR);
+            break;
+        }
+        case TransferSession::OutputEventType::kAcceptReceived:
+            queryIfWindowAllows();
+            break;
+        case TransferSession::OutputEventType::kQueryReceived: {
+            TransferSession::BlockData blockData;
+            blockData.Data   = fakeData;
+            blockData.Length = sizeof(fakeData);
+            blockData.IsEof  = (sender.GetNextBlockNum() == numBlocks - 1);
+            EXPECT_EQ(sender.PrepareBlock(blockData), CHIP_NO_ERROR);
+            break;
+        }
+        case TransferSession::OutputEventType::kBlockReceived:
+            EXPECT_EQ(event.blockdata.BlockCounter, numBlocksReceived++);
+            if (event.blockdata.IsEof)
+            {
+                EXPECT_EQ(receiver.PrepareBlockAck(), CHIP_NO_ERROR);
+            }
+            else
+            {
+                queryIfWindowAllows();
+            }
+            break;
+        case TransferSession::OutputEventType::kAckEOFReceived:
+            done = true;
+            break;
+        default:
+            ADD_FAILURE() << "Unexpected event " << TransferSession::OutputEvent::TypeToString(event.EventType);
+            break;
+        }
+    };
+
+    auto drain = [&](TransferSession & session, TransferSession & peer) {
+        TransferSession::OutputEvent event;
+        for (session.PollOutput(event, now); event.EventType != TransferSession::OutputEventType::kNone;
+             session.PollOutput(event, now))
+        {
+            handleEvent(session, peer, event);
+            VerifyOrReturn(event.EventType != TransferSession::OutputEventType::kInternalError);
+        }
+    };
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = TransferControlFlags::kReceiverDrive;
+    initOptions.MaxBlockSize     = sizeof(fakeData);
+    initOptions.Windowed         = windowed;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    BitFlags<TransferControlFlags> senderOpts(TransferControlFlags::kReceiverDrive);
+    EXPECT_EQ(sender.WaitForTransfer(TransferRole::kSender, senderOpts, sizeof(fakeData), timeout), CHIP_NO_ERROR);
+    EXPECT_EQ(receiver.StartTransfer(TransferRole::kReceiver, initOptions, timeout), CHIP_NO_ERROR);
+    drain(receiver, sender);
+
+    // The latency is constant, so messages are delivered in the order they were sent
+    while (!inFlight.empty() && !done)
+    {
+        InFlightMessage message = std::move(inFlight.front());
+        inFlight.pop_front();
+        now = message.deliveryTime;
+
+        TransferSession & destination = *message.destination;
+        TransferSession & peer        = (message.destination == &sender) ? receiver : sender;
+
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(message.typeData.ProtocolId, message.typeData.MessageType);
+        EXPECT_EQ(destination.HandleMessageReceived(payloadHeader, std::move(message.msg), now), CHIP_NO_ERROR);
+        drain(destination, peer);
+    }
+
+    EXPECT_TRUE(done);
+    EXPECT_EQ(numBlocksReceived, numBlocks);
+    EXPECT_EQ(receiver.IsWindowed(), windowed);
+    return now;
+}
+
+} // anonymous namespace
+
+// Test that a windowed transfer over a link with latency takes one round trip per window of Blocks rather than one per Block.
+TEST_F(TestBdxTransferSession, TestWindowedThroughputWithLatency)
+{
+    constexpr uint32_t kNumBlocks                  = 8 * CHIP_CONFIG_BDX_WINDOW_SIZE;
+    constexpr System::Clock::Milliseconds64 kDelay = System::Clock::Milliseconds64(50);
+
+    // One round trip for the Init and Accept messages, and a one-way trip for the BlockAckEOF
+    const System::Clock::Timestamp lockStepTime = RunTransferOverDelayedLink(false, kNumBlocks, kDelay);
+    EXPECT_EQ(lockStepTime, kDelay * (2 * (kNumBlocks + 1) + 1));
+
+    const System::Clock::Timestamp windowedTime = RunTransferOverDelayedLink(true, kNumBlocks, kDelay);
+    EXPECT_EQ(windowedTime, kDelay * (2 * (kNumBlocks / CHIP_CONFIG_BDX_WINDOW_SIZE + 1) + 1));
+}
@@ -377,6 +377,16 @@ void CASESession::Clear()
 {
     MATTER_TRACE_SCOPE("Clear", "CASESession");
     // Cancel any outstanding work.
+    if (mSendSigma2Helper)
+    {
+        mSendSigma2Helper->CancelWork();
+        mSendSigma2Helper.reset();
+    }
+    if (mHandleSigma2Helper)
+    {
+        mHandleSigma2Helper->CancelWork();
+        mHandleSigma2Helper.reset();
+    }
     if (mSendSigma3Helper)
     {
         mSendSigma3Helper->CancelWork();
@@ -899,17 +909,8 @@ CHIP_ERROR CASESession::HandleSigma1_and_SendSigma2(System::PacketBufferHandle &
     switch (nextStep.Get<Step>())
     {
     case Step::kSendSigma2: {
-
-        System::PacketBufferHandle msgR2;
-        EncodeSigma2Inputs encodeSigma2;
-
-        SuccessOrExit(err = PrepareSigma2(encodeSigma2));
-        SuccessOrExit(err = EncodeSigma2(msgR2, encodeSigma2));
-
-        MATTER_LOG_METRIC_BEGIN(kMetricDeviceCASESessionSigma2);
-        SuccessOrExitAction(err = SendSigma2(std::move(msgR2)), MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma2, err));
-
-        mDelegate->OnSessionEstablishmentStarted();
+        // Sigma2 is sent by SendSigma2c() once the key agreement and the signature are done
+        SuccessOrExit(err = SendSigma2a());
         break;
     }
     case Step::kSendSigma2Resume: {
@@ -1166,72 +1167,120 @@ CHIP_ERROR CASESession::SendSigma2Resume(System::PacketBufferHandle && msgR2Resu
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASESession::PrepareSigma2(EncodeSigma2Inputs & outSigma2Data)
+CHIP_ERROR CASESession::SendSigma2a()
 {
-
-    MATTER_TRACE_SCOPE("PrepareSigma2", "CASESession");
+    MATTER_TRACE_SCOPE("SendSigma2", "CASESession");
 
     VerifyOrReturnError(mFabricsTable != nullptr, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mLocalMRPConfig.HasValue(), CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(GetLocalSessionId().HasValue(), CHIP_ERROR_INCORRECT_STATE);
-    outSigma2Data.responderSessionId = GetLocalSessionId().Value();
 
-    chip::Platform::ScopedMemoryBuffer<uint8_t> icacBuf;
-    VerifyOrReturnError(icacBuf.Alloc(kMaxCHIPCertLength), CHIP_ERROR_NO_MEMORY);
+    auto helper = WorkHelper<SendSigma2Data>::Create(*this, &SendSigma2b, &CASESession::SendSigma2c);
+    VerifyOrReturnError(helper, CHIP_ERROR_NO_MEMORY);
+    {
+        auto & data = helper->mData;
 
-    chip::Platform::ScopedMemoryBuffer<uint8_t> nocBuf;
-    VerifyOrReturnError(nocBuf.Alloc(kMaxCHIPCertLength), CHIP_ERROR_NO_MEMORY);
+        data.fabricIndex                     = mFabricIndex;
+        data.sessionKeystore                 = mSessionManager->GetSessionKeystore();
+        data.encodeSigma2.responderSessionId = GetLocalSessionId().Value();
 
-    MutableByteSpan icaCert{ icacBuf.Get(), kMaxCHIPCertLength };
-    ReturnErrorOnFailure(mFabricsTable->FetchICACert(mFabricIndex, icaCert));
+        const FabricInfo * fabricInfo = mFabricsTable->FindFabricWithIndex(mFabricIndex);
+        VerifyOrReturnError(fabricInfo != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        auto * keystore = mFabricsTable->GetOperationalKeystore();
+        if (!fabricInfo->HasOperationalKey() && keystore != nullptr && keystore->SupportsSignWithOpKeypairInBackground())
+        {
+            // NOTE: used to sign in background.
+            data.keystore = keystore;
+        }
 
-    MutableByteSpan nocCert{ nocBuf.Get(), kMaxCHIPCertLength };
-    ReturnErrorOnFailure(mFabricsTable->FetchNOCCert(mFabricIndex, nocCert));
+        VerifyOrReturnError(data.icacBuf.Alloc(kMaxCHIPCertLength), CHIP_ERROR_NO_MEMORY);
+        data.icaCert = MutableByteSpan{ data.icacBuf.Get(), kMaxCHIPCertLength };
 
-    // Fill in the random value
-    ReturnErrorOnFailure(DRBG_get_bytes(&outSigma2Data.responderRandom[0], sizeof(outSigma2Data.responderRandom)));
+        VerifyOrReturnError(data.nocBuf.Alloc(kMaxCHIPCertLength), CHIP_ERROR_NO_MEMORY);
+        data.nocCert = MutableByteSpan{ data.nocBuf.Get(), kMaxCHIPCertLength };
 
-    // Generate an ephemeral keypair
-    mEphemeralKey = mFabricsTable->AllocateEphemeralKeypairForCASE();
-    VerifyOrReturnError(mEphemeralKey != nullptr, CHIP_ERROR_NO_MEMORY);
-    ReturnErrorOnFailure(mEphemeralKey->Initialize(ECPKeyTarget::ECDH));
-    outSigma2Data.responderEphPubKey = &mEphemeralKey->Pubkey();
+        ReturnErrorOnFailure(mFabricsTable->FetchICACert(mFabricIndex, data.icaCert));
+        ReturnErrorOnFailure(mFabricsTable->FetchNOCCert(mFabricIndex, data.nocCert));
 
-    // Generate a Shared Secret
-    ReturnErrorOnFailure(mEphemeralKey->ECDH_derive_secret(mRemotePubKey, mSharedSecret));
+        // Fill in the random value
+        ReturnErrorOnFailure(DRBG_get_bytes(&data.encodeSigma2.responderRandom[0], sizeof(data.encodeSigma2.responderRandom)));
 
-    SensitiveDataFixedBuffer<kIPKSize + kSigmaParamRandomNumberSize + kP256_PublicKey_Length + kSHA256_Hash_Length> msgSalt;
+        // Generate an ephemeral keypair
+        mEphemeralKey = mFabricsTable->AllocateEphemeralKeypairForCASE();
+        VerifyOrReturnError(mEphemeralKey != nullptr, CHIP_ERROR_NO_MEMORY);
+        ReturnErrorOnFailure(mEphemeralKey->Initialize(ECPKeyTarget::ECDH));
 
-    MutableByteSpan saltSpan(msgSalt.Bytes(), msgSalt.Capacity());
-    ReturnErrorOnFailure(
-        ConstructSaltSigma2(ByteSpan(outSigma2Data.responderRandom), mEphemeralKey->Pubkey(), ByteSpan(mIPK), saltSpan));
+        // The key agreement is done in the background unless the ephemeral key cannot be exported
+        data.inBackground       = (CopyEphemeralKey(data.ephemeralKeyCopy) == CHIP_NO_ERROR);
+        data.ephemeralKey       = data.inBackground ? &data.ephemeralKeyCopy : mEphemeralKey;
+        data.initiatorEphPubKey = mRemotePubKey;
 
-    AutoReleaseSessionKey sr2k(*mSessionManager->GetSessionKeystore());
-    ReturnErrorOnFailure(DeriveSigmaKey(saltSpan, ByteSpan(kKDFSR2Info), sr2k));
+        // The salt only depends on Msg1 and on the ephemeral public key, not on the shared secret
+        MutableByteSpan saltSpan(data.salt.Bytes(), data.salt.Capacity());
+        ReturnErrorOnFailure(
+            ConstructSaltSigma2(ByteSpan(data.encodeSigma2.responderRandom), mEphemeralKey->Pubkey(), ByteSpan(mIPK), saltSpan));
 
-    // Construct Sigma2 TBS Data
-    P256ECDSASignature tbsData2Signature;
-    {
+        // Construct Sigma2 TBS Data
         size_t msgR2SignedLen = EstimateStructOverhead(kMaxCHIPCertLength,     // responderNoc
                                                        kMaxCHIPCertLength,     // responderICAC
                                                        kP256_PublicKey_Length, // responderEphPubKey
                                                        kP256_PublicKey_Length  // InitiatorEphPubKey
         );
 
-        chip::Platform::ScopedMemoryBuffer<uint8_t> msgR2Signed;
-        VerifyOrReturnError(msgR2Signed.Alloc(msgR2SignedLen), CHIP_ERROR_NO_MEMORY);
-        MutableByteSpan msgR2SignedSpan{ msgR2Signed.Get(), msgR2SignedLen };
+        VerifyOrReturnError(data.msgR2Signed.Alloc(msgR2SignedLen), CHIP_ERROR_NO_MEMORY);
+        data.msgR2SignedSpan = MutableByteSpan{ data.msgR2Signed.Get(), msgR2SignedLen };
 
-        ReturnErrorOnFailure(ConstructTBSData(nocCert, icaCert, ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()),
-                                              ByteSpan(mRemotePubKey, mRemotePubKey.Length()), msgR2SignedSpan));
+        ReturnErrorOnFailure(ConstructTBSData(data.nocCert, data.icaCert,
+                                              ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()),
+                                              ByteSpan(mRemotePubKey, mRemotePubKey.Length()), data.msgR2SignedSpan));
 
-        // Generate a Signature
-        ReturnErrorOnFailure(mFabricsTable->SignWithOpKeypair(mFabricIndex, msgR2SignedSpan, tbsData2Signature));
+        if (data.keystore == nullptr)
+        {
+            // Legacy case: delegate to fabric table fabric info, which is only used from the Matter thread
+            ReturnErrorOnFailure(mFabricsTable->SignWithOpKeypair(mFabricIndex, data.msgR2SignedSpan, data.tbsData2Signature));
+        }
+
+        // Generate a new resumption ID
+        ReturnErrorOnFailure(DRBG_get_bytes(mNewResumptionId.data(), mNewResumptionId.size()));
+        data.resumptionId = mNewResumptionId;
+
+        if (data.inBackground)
+        {
+            ReturnErrorOnFailure(helper->ScheduleWork());
+            mSendSigma2Helper = helper;
+            mExchangeCtxt.Value()->WillSendMessage();
+            mState = State::kSendSigma2Pending;
+        }
+        else
+        {
+            ReturnErrorOnFailure(helper->DoWork());
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASESession::SendSigma2b(SendSigma2Data & data, bool & cancel)
+{
+    // Generate a Shared Secret
+    ReturnErrorOnFailure(data.ephemeralKey->ECDH_derive_secret(data.initiatorEphPubKey, data.sharedSecret));
+
+    AutoReleaseSessionKey sr2k(*data.sessionKeystore);
+    ReturnErrorOnFailure(DeriveSigmaKey(*data.sessionKeystore, data.sharedSecret,
+                                        ByteSpan(data.salt.ConstBytes(), data.salt.Capacity()), ByteSpan(kKDFSR2Info), sr2k));
+
+    // Generate a signature
+    if (data.keystore != nullptr)
+    {
+        // Recommended case: delegate to operational keystore
+        ReturnErrorOnFailure(data.keystore->SignWithOpKeypair(data.fabricIndex, data.msgR2SignedSpan, data.tbsData2Signature));
     }
+
     // Construct Sigma2 TBE Data
-    size_t msgR2SignedEncLen = EstimateStructOverhead(nocCert.size(),                             // responderNoc
-                                                      icaCert.size(),                             // responderICAC
-                                                      tbsData2Signature.Length(),                 // signature
+    auto & outSigma2Data     = data.encodeSigma2;
+    size_t msgR2SignedEncLen = EstimateStructOverhead(data.nocCert.size(),                        // responderNoc
+                                                      data.icaCert.size(),                        // responderICAC
+                                                      data.tbsData2Signature.Length(),            // signature
                                                       SessionResumptionStorage::kResumptionIdSize // resumptionID
     );
 
@@ -1245,32 +1294,30 @@ CHIP_ERROR CASESession::PrepareSigma2(EncodeSigma2Inputs & outSigma2Data)
 
     ReturnErrorOnFailure(tlvWriter.StartContainer(AnonymousTag(), kTLVType_Structure, outerContainerType));
 
-    CHIP_FAULT_INJECT(FaultInjection::kFault_CASECorruptSigma2NOC, *nocCert.data() ^= 0xFF);
-    CHIP_FAULT_INJECT(FaultInjection::kFault_CASECorruptSigma2ICAC, *icaCert.data() ^= 0xFF);
+    CHIP_FAULT_INJECT(FaultInjection::kFault_CASECorruptSigma2NOC, *data.nocCert.data() ^= 0xFF);
+    CHIP_FAULT_INJECT(FaultInjection::kFault_CASECorruptSigma2ICAC, *data.icaCert.data() ^= 0xFF);
 
-    ReturnErrorOnFailure(tlvWriter.Put(AsTlvContextTag(TBEDataTags::kSenderNOC), nocCert));
-    if (!icaCert.empty())
+    ReturnErrorOnFailure(tlvWriter.Put(AsTlvContextTag(TBEDataTags::kSenderNOC), data.nocCert));
+    if (!data.icaCert.empty())
     {
-        ReturnErrorOnFailure(tlvWriter.Put(AsTlvContextTag(TBEDataTags::kSenderICAC), icaCert));
+        ReturnErrorOnFailure(tlvWriter.Put(AsTlvContextTag(TBEDataTags::kSenderICAC), data.icaCert));
     }
 
     // We are now done with ICAC and NOC certs so we can release the memory.
     {
-        icacBuf.Free();
-        icaCert = MutableByteSpan{};
+        data.icacBuf.Free();
+        data.icaCert = MutableByteSpan{};
 
-        nocBuf.Free();
-        nocCert = MutableByteSpan{};
+        data.nocBuf.Free();
+        data.nocCert = MutableByteSpan{};
     }
 
-    CHIP_FAULT_INJECT(FaultInjection::kFault_CASECorruptSigma2Signature, *tbsData2Signature.Bytes() ^= 0xFF);
+    CHIP_FAULT_INJECT(FaultInjection::kFault_CASECorruptSigma2Signature, *data.tbsData2Signature.Bytes() ^= 0xFF);
 
-    ReturnErrorOnFailure(tlvWriter.PutBytes(AsTlvContextTag(TBEDataTags::kSignature), tbsData2Signature.ConstBytes(),
-                                            static_cast<uint32_t>(tbsData2Signature.Length())));
+    ReturnErrorOnFailure(tlvWriter.PutBytes(AsTlvContextTag(TBEDataTags::kSignature), data.tbsData2Signature.ConstBytes(),
+                                            static_cast<uint32_t>(data.tbsData2Signature.Length())));
 
-    // Generate a new resumption ID
-    ReturnErrorOnFailure(DRBG_get_bytes(mNewResumptionId.data(), mNewResumptionId.size()));
-    ReturnErrorOnFailure(tlvWriter.Put(AsTlvContextTag(TBEDataTags::kResumptionID), mNewResumptionId));
+    ReturnErrorOnFailure(tlvWriter.Put(AsTlvContextTag(TBEDataTags::kResumptionID), data.resumptionId));
 
     ReturnErrorOnFailure(tlvWriter.EndContainer(outerContainerType));
     ReturnErrorOnFailure(tlvWriter.Finalize());
@@ -1282,11 +1329,45 @@ CHIP_ERROR CASESession::PrepareSigma2(EncodeSigma2Inputs & outSigma2Data)
                                          outSigma2Data.msgR2Encrypted.Get() + msgR2SignedEncLen,
                                          CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES));
 
-    outSigma2Data.responderMrpConfig = &mLocalMRPConfig.Value();
-
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CASESession::SendSigma2c(SendSigma2Data & data, CHIP_ERROR status)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    System::PacketBufferHandle msgR2;
+
+    VerifyOrDieWithMsg(!data.inBackground || mState == State::kSendSigma2Pending, SecureChannel, "Bad internal state.");
+
+    SuccessOrExit(err = status);
+
+    mSharedSecret = data.sharedSecret;
+
+    data.encodeSigma2.responderEphPubKey = &mEphemeralKey->Pubkey();
+    data.encodeSigma2.responderMrpConfig = &mLocalMRPConfig.Value();
+    SuccessOrExit(err = EncodeSigma2(msgR2, data.encodeSigma2));
+
+    MATTER_LOG_METRIC_BEGIN(kMetricDeviceCASESessionSigma2);
+    SuccessOrExitAction(err = SendSigma2(std::move(msgR2)), MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma2, err));
+
+    mDelegate->OnSessionEstablishmentStarted();
+
+exit:
+    mSendSigma2Helper.reset();
+
+    // If processing occurred in the background and an error occurred, need to send status report (normally occurs in
+    // HandleSigma1_and_SendSigma2), and discard exchange and abort pending establish (normally occurs in OnMessageReceived).
+    if (data.inBackground && err != CHIP_NO_ERROR)
+    {
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        DiscardExchange();
+        AbortPendingEstablish(err);
+    }
+
+    return err;
+}
+
 CHIP_ERROR CASESession::EncodeSigma2(System::PacketBufferHandle & msgR2, EncodeSigma2Inputs & input)
 {
     VerifyOrReturnError(input.responderEphPubKey != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
@@ -1444,138 +1525,97 @@ CHIP_ERROR CASESession::ParseSigma2Resume(ContiguousBufferTLVReader & tlvReader,
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASESession::HandleSigma2_and_SendSigma3(System::PacketBufferHandle && msg)
-{
-    MATTER_TRACE_SCOPE("HandleSigma2_and_SendSigma3", "CASESession");
-    CHIP_ERROR err = HandleSigma2(std::move(msg));
-    MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma1, err);
-    SuccessOrExit(err);
-
-    MATTER_LOG_METRIC_BEGIN(kMetricDeviceCASESessionSigma3);
-    err = SendSigma3a();
-    if (CHIP_NO_ERROR != err)
-    {
-        MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma3, err);
-    }
-
-exit:
-    if (CHIP_NO_ERROR != err)
-    {
-        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
-        mState = State::kInitialized;
-    }
-    return err;
-}
-
-CHIP_ERROR CASESession::HandleSigma2(System::PacketBufferHandle && msg)
+CHIP_ERROR CASESession::HandleSigma2a(System::PacketBufferHandle && msg)
 {
     MATTER_TRACE_SCOPE("HandleSigma2", "CASESession");
+    CHIP_ERROR err = CHIP_NO_ERROR;
     ChipLogProgress(SecureChannel, "Received Sigma2 msg");
 
-    VerifyOrReturnError(mEphemeralKey != nullptr, CHIP_ERROR_INTERNAL);
-
-    const uint8_t * buf = msg->Start();
-    size_t buflen       = msg->DataLength();
-    VerifyOrReturnError(buf != nullptr, CHIP_ERROR_MESSAGE_INCOMPLETE);
-
-    FabricId fabricId = kUndefinedFabricId;
+    auto helper = WorkHelper<HandleSigma2Data>::Create(*this, &HandleSigma2b, &CASESession::HandleSigma2c);
+    VerifyOrExit(helper, err = CHIP_ERROR_NO_MEMORY);
     {
-        VerifyOrReturnError(mFabricsTable != nullptr, CHIP_ERROR_INCORRECT_STATE);
-        const auto * fabricInfo = mFabricsTable->FindFabricWithIndex(mFabricIndex);
-        VerifyOrReturnError(fabricInfo != nullptr, CHIP_ERROR_INCORRECT_STATE);
-        fabricId = fabricInfo->GetFabricId();
-    }
-
-    System::PacketBufferTLVReader tlvReader;
-    tlvReader.Init(std::move(msg));
-    ParsedSigma2 parsedSigma2;
-    ReturnErrorOnFailure(ParseSigma2(tlvReader, parsedSigma2));
-
-    //  ParseSigma2 ensures that:
-    //  mRemotePubKey.Length() == responderEphPubKey.size() == kP256_PublicKey_Length.
-    memcpy(mRemotePubKey.Bytes(), parsedSigma2.responderEphPubKey.data(), mRemotePubKey.Length());
-
-    // Generate a Shared Secret
-    ReturnErrorOnFailure(mEphemeralKey->ECDH_derive_secret(mRemotePubKey, mSharedSecret));
+        auto & data = helper->mData;
 
-    // Generate the S2K key
-    AutoReleaseSessionKey sr2k(*mSessionManager->GetSessionKeystore());
-    {
-        SensitiveDataFixedBuffer<kIPKSize + kSigmaParamRandomNumberSize + kP256_PublicKey_Length + kSHA256_Hash_Length> msg_salt;
-        MutableByteSpan saltSpan(msg_salt.Bytes(), msg_salt.Capacity());
-        ReturnErrorOnFailure(ConstructSaltSigma2(parsedSigma2.responderRandom, mRemotePubKey, ByteSpan(mIPK), saltSpan));
-        ReturnErrorOnFailure(DeriveSigmaKey(saltSpan, ByteSpan(kKDFSR2Info), sr2k));
-    }
-    // Msg2 should only be added to MessageDigest after we construct SaltSigma2 that is used to derive S2K,
-    // Because constructing SaltSigma2 uses the MessageDigest at a point when it should only include Msg1.
-    ReturnErrorOnFailure(mCommissioningHash.AddData(ByteSpan{ buf, buflen }));
+        VerifyOrExit(mEphemeralKey != nullptr, err = CHIP_ERROR_INTERNAL);
 
-    ReturnErrorOnFailure(AES_CCM_decrypt(parsedSigma2.msgR2EncryptedPayload.data(), parsedSigma2.msgR2EncryptedPayload.size(),
-                                         nullptr, 0, parsedSigma2.msgR2MIC.data(), parsedSigma2.msgR2MIC.size(), sr2k.KeyHandle(),
-                                         kTBEData2_Nonce, kTBEDataNonceLength, parsedSigma2.msgR2EncryptedPayload.data()));
+        const uint8_t * buf = msg->Start();
+        size_t buflen       = msg->DataLength();
+        VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
 
-    parsedSigma2.msgR2Decrypted = std::move(parsedSigma2.msgR2Encrypted);
-    size_t msgR2DecryptedLength = parsedSigma2.msgR2EncryptedPayload.size();
+        {
+            VerifyOrExit(mFabricsTable != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+            const auto * fabricInfo = mFabricsTable->FindFabricWithIndex(mFabricIndex);
+            VerifyOrExit(fabricInfo != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+            data.fabricId = fabricInfo->GetFabricId();
+        }
 
-    ContiguousBufferTLVReader decryptedDataTlvReader;
-    decryptedDataTlvReader.Init(parsedSigma2.msgR2Decrypted.Get(), msgR2DecryptedLength);
-    ParsedSigma2TBEData parsedSigma2TBEData;
-    ReturnErrorOnFailure(ParseSigma2TBEData(decryptedDataTlvReader, parsedSigma2TBEData));
+        System::PacketBufferTLVReader tlvReader;
+        tlvReader.Init(std::move(msg));
+        ParsedSigma2 parsedSigma2;
+        SuccessOrExit(err = ParseSigma2(tlvReader, parsedSigma2));
 
-    // Validate responder identity located in msgR2Decrypted
-    // Constructing responder identity
-    P256PublicKey responderPublicKey;
-    {
-        NodeId responderNodeId;
-
-        CompressedFabricId unused;
-        FabricId responderFabricId;
-        ReturnErrorOnFailure(SetEffectiveTime());
-        ReturnErrorOnFailure(mFabricsTable->VerifyCredentials(mFabricIndex, parsedSigma2TBEData.responderNOC,
-                                                              parsedSigma2TBEData.responderICAC, mValidContext, unused,
-                                                              responderFabricId, responderNodeId, responderPublicKey));
-        VerifyOrReturnError(fabricId == responderFabricId, CHIP_ERROR_INVALID_CASE_PARAMETER);
-        // Verify that responderNodeId (from responderNOC) matches one that was included
-        // in the computation of the Destination Identifier when generating Sigma1.
-        VerifyOrReturnError(mPeerNodeId == responderNodeId, CHIP_ERROR_INVALID_CASE_PARAMETER);
-    }
-
-    // Construct msgR2Signed and validate the signature in msgR2Decrypted.
-    size_t msgR2SignedLen = EstimateStructOverhead(parsedSigma2TBEData.responderNOC.size(),  // resonderNOC
-                                                   parsedSigma2TBEData.responderICAC.size(), // responderICAC
-                                                   kP256_PublicKey_Length,                   // responderEphPubKey
-                                                   kP256_PublicKey_Length                    // initiatorEphPubKey
-    );
+        //  ParseSigma2 ensures that:
+        //  mRemotePubKey.Length() == responderEphPubKey.size() == kP256_PublicKey_Length.
+        memcpy(mRemotePubKey.Bytes(), parsedSigma2.responderEphPubKey.data(), mRemotePubKey.Length());
+        data.responderEphPubKey = mRemotePubKey;
 
-    chip::Platform::ScopedMemoryBuffer<uint8_t> msgR2Signed;
-    VerifyOrReturnError(msgR2Signed.Alloc(msgR2SignedLen), CHIP_ERROR_NO_MEMORY);
-    MutableByteSpan msgR2SignedSpan{ msgR2Signed.Get(), msgR2SignedLen };
+        // The key agreement is done in the background unless the ephemeral key cannot be exported
+        data.inBackground    = (CopyEphemeralKey(data.ephemeralKeyCopy) == CHIP_NO_ERROR);
+        data.ephemeralKey    = data.inBackground ? &data.ephemeralKeyCopy : mEphemeralKey;
+        data.sessionKeystore = mSessionManager->GetSessionKeystore();
 
-    ReturnErrorOnFailure(ConstructTBSData(parsedSigma2TBEData.responderNOC, parsedSigma2TBEData.responderICAC,
-                                          ByteSpan(mRemotePubKey, mRemotePubKey.Length()),
-                                          ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()), msgR2SignedSpan));
+        // Construct the salt of the S2K key, which does not depend on the shared secret
+        {
+            MutableByteSpan saltSpan(data.salt.Bytes(), data.salt.Capacity());
+            SuccessOrExit(err = ConstructSaltSigma2(parsedSigma2.responderRandom, mRemotePubKey, ByteSpan(mIPK), saltSpan));
+        }
+        // Msg2 should only be added to MessageDigest after we construct SaltSigma2 that is used to derive S2K,
+        // Because constructing SaltSigma2 uses the MessageDigest at a point when it should only include Msg1.
+        SuccessOrExit(err = mCommissioningHash.AddData(ByteSpan{ buf, buflen }));
 
-    // Validate signature
-    ReturnErrorOnFailure(responderPublicKey.ECDSA_validate_msg_signature(msgR2SignedSpan.data(), msgR2SignedSpan.size(),
-                                                                         parsedSigma2TBEData.tbsData2Signature));
+        // The spans parsed from the encrypted data stay valid once the buffer is moved to the work data.
+        data.msgR2Decrypted        = std::move(parsedSigma2.msgR2Encrypted);
+        data.msgR2EncryptedPayload = parsedSigma2.msgR2EncryptedPayload;
+        data.msgR2MIC              = parsedSigma2.msgR2MIC;
 
-    ChipLogDetail(SecureChannel, "Peer " ChipLogFormatScopedNodeId " assigned session ID %d", ChipLogValueScopedNodeId(GetPeer()),
-                  parsedSigma2.responderSessionId);
-    SetPeerSessionId(parsedSigma2.responderSessionId);
+        // Prepare for the validation of the responder identity
+        {
+            MutableByteSpan fabricRCAC{ data.rootCertBuf };
+            SuccessOrExit(err = mFabricsTable->FetchRootCert(mFabricIndex, fabricRCAC));
+            data.fabricRCAC = fabricRCAC;
+            SuccessOrExit(err = SetEffectiveTime());
+        }
 
-    std::copy(parsedSigma2TBEData.resumptionId.begin(), parsedSigma2TBEData.resumptionId.end(), mNewResumptionId.begin());
+        // Copy remaining needed data into work structure
+        data.validContext                       = mValidContext;
+        data.responderNodeId                    = mPeerNodeId;
+        data.responderSessionId                 = parsedSigma2.responderSessionId;
+        data.responderSessionParams             = parsedSigma2.responderSessionParams;
+        data.responderSessionParamStructPresent = parsedSigma2.responderSessionParamStructPresent;
 
-    // Retrieve peer CASE Authenticated Tags (CATs) from peer's NOC.
-    ReturnErrorOnFailure(ExtractCATsFromOpCert(parsedSigma2TBEData.responderNOC, mPeerCATs));
+        mExchangeCtxt.Value()->WillSendMessage();
+        mState = State::kHandleSigma2Pending;
+        if (data.inBackground)
+        {
+            SuccessOrExit(err = helper->ScheduleWork());
+            mHandleSigma2Helper = helper;
+        }
+        else
+        {
+            // HandleSigma2c takes care of a failure, as it does when the work is done in the background
+            RETURN_SAFELY_IGNORED helper->DoWork();
+        }
+    }
 
-    if (parsedSigma2.responderSessionParamStructPresent)
+exit:
+    if (err != CHIP_NO_ERROR)
     {
-        SetRemoteSessionParameters(parsedSigma2.responderSessionParams);
-        mExchangeCtxt.Value()->GetSessionHandle()->AsUnauthenticatedSession()->SetRemoteSessionParameters(
-            GetRemoteSessionParameters());
+        MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma1, err);
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        mState = State::kInitialized;
     }
 
-    return CHIP_NO_ERROR;
+    return err;
 }
 
 CHIP_ERROR CASESession::ParseSigma2(ContiguousBufferTLVReader & tlvReader, ParsedSigma2 & outParsedSigma2)
@@ -1687,6 +1727,119 @@ CHIP_ERROR CASESession::ParseSigma2TBEData(ContiguousBufferTLVReader & decrypted
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CASESession::HandleSigma2b(HandleSigma2Data & data, bool & cancel)
+{
+    // Generate a Shared Secret
+    ReturnErrorOnFailure(data.ephemeralKey->ECDH_derive_secret(data.responderEphPubKey, data.sharedSecret));
+
+    // Generate the S2K key and decrypt the TBE data
+    {
+        AutoReleaseSessionKey sr2k(*data.sessionKeystore);
+        ReturnErrorOnFailure(DeriveSigmaKey(*data.sessionKeystore, data.sharedSecret,
+                                            ByteSpan(data.salt.ConstBytes(), data.salt.Capacity()), ByteSpan(kKDFSR2Info), sr2k));
+
+        ReturnErrorOnFailure(AES_CCM_decrypt(data.msgR2EncryptedPayload.data(), data.msgR2EncryptedPayload.size(), nullptr, 0,
+                                             data.msgR2MIC.data(), data.msgR2MIC.size(), sr2k.KeyHandle(), kTBEData2_Nonce,
+                                             kTBEDataNonceLength, data.msgR2EncryptedPayload.data()));
+    }
+
+    ContiguousBufferTLVReader decryptedDataTlvReader;
+    decryptedDataTlvReader.Init(data.msgR2EncryptedPayload.data(), data.msgR2EncryptedPayload.size());
+    ParsedSigma2TBEData parsedSigma2TBEData;
+    ReturnErrorOnFailure(ParseSigma2TBEData(decryptedDataTlvReader, parsedSigma2TBEData));
+
+    data.responderNOC      = parsedSigma2TBEData.responderNOC;
+    data.responderICAC     = parsedSigma2TBEData.responderICAC;
+    data.resumptionId      = parsedSigma2TBEData.resumptionId;
+    data.tbsData2Signature = parsedSigma2TBEData.tbsData2Signature;
+
+    // Construct msgR2Signed
+    size_t msgR2SignedLen = EstimateStructOverhead(data.responderNOC.size(),  // resonderNOC
+                                                   data.responderICAC.size(), // responderICAC
+                                                   kP256_PublicKey_Length,    // responderEphPubKey
+                                                   kP256_PublicKey_Length     // initiatorEphPubKey
+    );
+
+    VerifyOrReturnError(data.msgR2Signed.Alloc(msgR2SignedLen), CHIP_ERROR_NO_MEMORY);
+    data.msgR2SignedSpan = MutableByteSpan{ data.msgR2Signed.Get(), msgR2SignedLen };
+
+    ReturnErrorOnFailure(ConstructTBSData(data.responderNOC, data.responderICAC,
+                                          ByteSpan(data.responderEphPubKey, data.responderEphPubKey.Length()),
+                                          ByteSpan(data.ephemeralKey->Pubkey(), data.ephemeralKey->Pubkey().Length()),
+                                          data.msgR2SignedSpan));
+
+    // Validate responder identity located in msgR2Decrypted
+    // Constructing responder identity
+    CompressedFabricId unused;
+    FabricId responderFabricId;
+    NodeId responderNodeId;
+    P256PublicKey responderPublicKey;
+    ReturnErrorOnFailure(FabricTable::VerifyCredentials(data.responderNOC, data.responderICAC, data.fabricRCAC, data.validContext,
+                                                        unused, responderFabricId, responderNodeId, responderPublicKey));
+    VerifyOrReturnError(data.fabricId == responderFabricId, CHIP_ERROR_INVALID_CASE_PARAMETER);
+    // Verify that responderNodeId (from responderNOC) matches one that was included
+    // in the computation of the Destination Identifier when generating Sigma1.
+    VerifyOrReturnError(data.responderNodeId == responderNodeId, CHIP_ERROR_INVALID_CASE_PARAMETER);
+
+    // Validate signature
+    ReturnErrorOnFailure(responderPublicKey.ECDSA_validate_msg_signature(data.msgR2SignedSpan.data(), data.msgR2SignedSpan.size(),
+                                                                         data.tbsData2Signature));
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASESession::HandleSigma2c(HandleSigma2Data & data, CHIP_ERROR status)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mState == State::kHandleSigma2Pending, err = CHIP_ERROR_INCORRECT_STATE);
+
+    SuccessOrExit(err = status);
+
+    mSharedSecret = data.sharedSecret;
+
+    ChipLogDetail(SecureChannel, "Peer " ChipLogFormatScopedNodeId " assigned session ID %d", ChipLogValueScopedNodeId(GetPeer()),
+                  data.responderSessionId);
+    SetPeerSessionId(data.responderSessionId);
+
+    std::copy(data.resumptionId.begin(), data.resumptionId.end(), mNewResumptionId.begin());
+
+    // Retrieve peer CASE Authenticated Tags (CATs) from peer's NOC.
+    SuccessOrExit(err = ExtractCATsFromOpCert(data.responderNOC, mPeerCATs));
+
+    if (data.responderSessionParamStructPresent)
+    {
+        SetRemoteSessionParameters(data.responderSessionParams);
+        mExchangeCtxt.Value()->GetSessionHandle()->AsUnauthenticatedSession()->SetRemoteSessionParameters(
+            GetRemoteSessionParameters());
+    }
+
+exit:
+    MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma1, err);
+    if (err == CHIP_NO_ERROR)
+    {
+        MATTER_LOG_METRIC_BEGIN(kMetricDeviceCASESessionSigma3);
+        err = SendSigma3a();
+        if (CHIP_NO_ERROR != err)
+        {
+            MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma3, err);
+        }
+    }
+
+    mHandleSigma2Helper.reset();
+
+    if (err != CHIP_NO_ERROR)
+    {
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        // Abort the pending establish, which is normally done by CASESession::OnMessageReceived,
+        // but in the background processing case must be done here.
+        DiscardExchange();
+        AbortPendingEstablish(err);
+    }
+
+    return err;
+}
+
 CHIP_ERROR CASESession::SendSigma3a()
 {
     MATTER_TRACE_SCOPE("SendSigma3", "CASESession");
@@ -1699,9 +1852,9 @@ CHIP_ERROR CASESession::SendSigma3a()
         auto & data = helper->mData;
 
         VerifyOrReturnError(mFabricsTable != nullptr, CHIP_ERROR_INCORRECT_STATE);
-        data.fabricIndex = mFabricIndex;
-        data.fabricTable = nullptr;
-        data.keystore    = nullptr;
+        data.fabricIndex     = mFabricIndex;
+        data.sessionKeystore = mSessionManager->GetSessionKeystore();
+        data.sharedSecret    = mSharedSecret;
 
         {
             const FabricInfo * fabricInfo = mFabricsTable->FindFabricWithIndex(mFabricIndex);
@@ -1712,11 +1865,12 @@ CHIP_ERROR CASESession::SendSigma3a()
                 // NOTE: used to sign in background.
                 data.keystore = keystore;
             }
-            else
-            {
-                // NOTE: used to sign in foreground.
-                data.fabricTable = mFabricsTable;
-            }
+        }
+
+        // The salt of the S3K key only depends on the messages so far
+        {
+            MutableByteSpan saltSpan(data.salt.Bytes(), data.salt.Capacity());
+            ReturnErrorOnFailure(ConstructSaltSigma3(ByteSpan(mIPK), saltSpan));
         }
 
         VerifyOrReturnError(mEphemeralKey != nullptr, CHIP_ERROR_INTERNAL);
@@ -1752,17 +1906,16 @@ CHIP_ERROR CASESession::SendSigma3a()
                                               ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()),
                                               ByteSpan(mRemotePubKey, mRemotePubKey.Length()), data.msgR3SignedSpan));
 
-        if (data.keystore != nullptr)
-        {
-            ReturnErrorOnFailure(helper->ScheduleWork());
-            mSendSigma3Helper = helper;
-            mExchangeCtxt.Value()->WillSendMessage();
-            mState = State::kSendSigma3Pending;
-        }
-        else
+        if (data.keystore == nullptr)
         {
-            ReturnErrorOnFailure(helper->DoWork());
+            // Legacy case: delegate to fabric table fabric info, which is only used from the Matter thread
+            ReturnErrorOnFailure(mFabricsTable->SignWithOpKeypair(mFabricIndex, data.msgR3SignedSpan, data.tbsData3Signature));
         }
+
+        ReturnErrorOnFailure(helper->ScheduleWork());
+        mSendSigma3Helper = helper;
+        mExchangeCtxt.Value()->WillSendMessage();
+        mState = State::kSendSigma3Pending;
     }
 
     return CHIP_NO_ERROR;
@@ -1776,11 +1929,6 @@ CHIP_ERROR CASESession::SendSigma3b(SendSigma3Data & data, bool & cancel)
         // Recommended case: delegate to operational keystore
         ReturnErrorOnFailure(data.keystore->SignWithOpKeypair(data.fabricIndex, data.msgR3SignedSpan, data.tbsData3Signature));
     }
-    else
-    {
-        // Legacy case: delegate to fabric table fabric info
-        ReturnErrorOnFailure(data.fabricTable->SignWithOpKeypair(data.fabricIndex, data.msgR3SignedSpan, data.tbsData3Signature));
-    }
 
     CHIP_FAULT_INJECT(FaultInjection::kFault_CASECorruptSigma3Signature, *data.tbsData3Signature.Bytes() ^= 0xFF);
 
@@ -1819,6 +1967,17 @@ CHIP_ERROR CASESession::SendSigma3b(SendSigma3Data & data, bool & cancel)
         data.msg_r3_encrypted_len = static_cast<size_t>(tlvWriter.GetLengthWritten());
     }
 
+    // Generate S3K key
+    AutoReleaseSessionKey sr3k(*data.sessionKeystore);
+    ReturnErrorOnFailure(DeriveSigmaKey(*data.sessionKeystore, data.sharedSecret,
+                                        ByteSpan(data.salt.ConstBytes(), data.salt.Capacity()), ByteSpan(kKDFSR3Info), sr3k));
+
+    // Generated Encrypted data blob
+    ReturnErrorOnFailure(AES_CCM_encrypt(data.msg_R3_Encrypted.Get(), data.msg_r3_encrypted_len, nullptr, 0, sr3k.KeyHandle(),
+                                         kTBEData3_Nonce, kTBEDataNonceLength, data.msg_R3_Encrypted.Get(),
+                                         data.msg_R3_Encrypted.Get() + data.msg_r3_encrypted_len,
+                                         CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES));
+
     return CHIP_NO_ERROR;
 }
 
@@ -1829,27 +1988,10 @@ CHIP_ERROR CASESession::SendSigma3c(SendSigma3Data & data, CHIP_ERROR status)
     System::PacketBufferHandle msg_R3;
     size_t data_len;
 
-    SensitiveDataFixedBuffer<kIPKSize + kSHA256_Hash_Length> msg_salt;
-
-    AutoReleaseSessionKey sr3k(*mSessionManager->GetSessionKeystore());
-
-    VerifyOrDieWithMsg(data.keystore == nullptr || mState == State::kSendSigma3Pending, SecureChannel, "Bad internal state.");
+    VerifyOrDieWithMsg(mState == State::kSendSigma3Pending, SecureChannel, "Bad internal state.");
 
     SuccessOrExit(err = status);
 
-    // Generate S3K key
-    {
-        MutableByteSpan saltSpan(msg_salt.Bytes(), msg_salt.Capacity());
-        SuccessOrExit(err = ConstructSaltSigma3(ByteSpan(mIPK), saltSpan));
-        SuccessOrExit(err = DeriveSigmaKey(saltSpan, ByteSpan(kKDFSR3Info), sr3k));
-    }
-
-    // Generated Encrypted data blob
-    SuccessOrExit(err =
-                      AES_CCM_encrypt(data.msg_R3_Encrypted.Get(), data.msg_r3_encrypted_len, nullptr, 0, sr3k.KeyHandle(),
-                                      kTBEData3_Nonce, kTBEDataNonceLength, data.msg_R3_Encrypted.Get(),
-                                      data.msg_R3_Encrypted.Get() + data.msg_r3_encrypted_len, CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES));
-
     // Generate Sigma3 Msg
     data_len = TLV::EstimateStructOverhead(CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES, data.msg_r3_encrypted_len);
 
@@ -1893,10 +2035,10 @@ CHIP_ERROR CASESession::SendSigma3c(SendSigma3Data & data, CHIP_ERROR status)
 exit:
     mSendSigma3Helper.reset();
 
-    // If data.keystore is set, processing occurred in the background, so if an error occurred,
-    // need to send status report (normally occurs in SendSigma3a), and discard exchange and
-    // abort pending establish (normally occurs in OnMessageReceived).
-    if (data.keystore != nullptr && err != CHIP_NO_ERROR)
+    // Processing occurred in the background, so if an error occurred, need to send status report
+    // (normally occurs in SendSigma3a), and discard exchange and abort pending establish (normally
+    // occurs in OnMessageReceived).
+    if (err != CHIP_NO_ERROR)
     {
         SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
         DiscardExchange();
@@ -1910,16 +2052,10 @@ CHIP_ERROR CASESession::HandleSigma3a(System::PacketBufferHandle && msg)
 {
     MATTER_TRACE_SCOPE("HandleSigma3", "CASESession");
     CHIP_ERROR err = CHIP_NO_ERROR;
-    ContiguousBufferTLVReader decryptedDataTlvReader;
-    TLVType containerType = kTLVType_Structure;
 
     const uint8_t * buf = msg->Start();
     const size_t bufLen = msg->DataLength();
 
-    AutoReleaseSessionKey sr3k(*mSessionManager->GetSessionKeystore());
-
-    SensitiveDataFixedBuffer<kIPKSize + kSHA256_Hash_Length> msg_salt;
-
     ChipLogProgress(SecureChannel, "Received Sigma3 msg");
     MATTER_TRACE_COUNTER("Sigma3");
     MATTER_LOG_METRIC_END(kMetricDeviceCASESessionSigma2, err);
@@ -1939,45 +2075,26 @@ CHIP_ERROR CASESession::HandleSigma3a(System::PacketBufferHandle && msg)
         VerifyOrExit(mEphemeralKey != nullptr, err = CHIP_ERROR_INTERNAL);
 
         // Step 1
-        // msgR3Encrypted will be allocated and initialised within ParseSigma3()
-        Platform::ScopedMemoryBufferWithSize<uint8_t> msgR3Encrypted;
-        // both msgR3EncryptedPayload and msgR3MIC will become backed by msgR3Encrypted in ParseSigma3()
-        MutableByteSpan msgR3EncryptedPayload;
-        ByteSpan msgR3MIC;
+        // data.msgR3Encrypted will be allocated and initialised within ParseSigma3(), both data.msgR3EncryptedPayload
+        // and data.msgR3MIC will become backed by it.
         {
             System::PacketBufferTLVReader tlvReader;
             tlvReader.Init(std::move(msg));
-            SuccessOrExit(err = ParseSigma3(tlvReader, msgR3Encrypted, msgR3EncryptedPayload, msgR3MIC));
+            SuccessOrExit(err = ParseSigma3(tlvReader, data.msgR3Encrypted, data.msgR3EncryptedPayload, data.msgR3MIC));
 
-            // Generate the S3K key
-            MutableByteSpan saltSpan(msg_salt.Bytes(), msg_salt.Capacity());
+            // Construct the salt of the S3K key, which is derived in the background
+            MutableByteSpan saltSpan(data.salt.Bytes(), data.salt.Capacity());
             SuccessOrExit(err = ConstructSaltSigma3(ByteSpan(mIPK), saltSpan));
-            SuccessOrExit(err = DeriveSigmaKey(saltSpan, ByteSpan(kKDFSR3Info), sr3k));
+            data.sessionKeystore = mSessionManager->GetSessionKeystore();
+            data.sharedSecret    = mSharedSecret;
 
             // Add Sigma3 to the TranscriptHash which will be used to generate the Session Encryption Keys
             SuccessOrExit(err = mCommissioningHash.AddData(ByteSpan{ buf, bufLen }));
         }
-        // Step 2 - Decrypt data blob
-        SuccessOrExit(err = AES_CCM_decrypt(msgR3EncryptedPayload.data(), msgR3EncryptedPayload.size(), nullptr, 0, msgR3MIC.data(),
-                                            msgR3MIC.size(), sr3k.KeyHandle(), kTBEData3_Nonce, kTBEDataNonceLength,
-                                            msgR3EncryptedPayload.data()));
-
-        decryptedDataTlvReader.Init(msgR3EncryptedPayload.data(), msgR3EncryptedPayload.size());
-        SuccessOrExit(err = ParseSigma3TBEData(decryptedDataTlvReader, data));
-
-        // Step 3 - Construct Sigma3 TBS Data
-        size_t msgR3SignedLen = TLV::EstimateStructOverhead(data.initiatorNOC.size(),  // initiatorNOC
-                                                            data.initiatorICAC.size(), // initiatorICAC
-                                                            kP256_PublicKey_Length,    // initiatorEphPubKey
-                                                            kP256_PublicKey_Length     // responderEphPubKey
-        );
 
-        VerifyOrExit(data.msgR3Signed.Alloc(msgR3SignedLen), err = CHIP_ERROR_NO_MEMORY);
-        data.msgR3SignedSpan = MutableByteSpan{ data.msgR3Signed.Get(), msgR3SignedLen };
-
-        SuccessOrExit(err = ConstructTBSData(data.initiatorNOC, data.initiatorICAC, ByteSpan(mRemotePubKey, mRemotePubKey.Length()),
-                                             ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()),
-                                             data.msgR3SignedSpan));
+        // Inputs of the Sigma3 TBS Data, which is constructed in the background
+        data.initiatorEphPubKey = mRemotePubKey;
+        data.responderEphPubKey = mEphemeralKey->Pubkey();
 
         // Prepare for Step 4/5
         {
@@ -1989,28 +2106,7 @@ CHIP_ERROR CASESession::HandleSigma3a(System::PacketBufferHandle && msg)
         }
 
         // Copy remaining needed data into work structure
-        {
-            data.validContext = mValidContext;
-
-            // initiatorNOC and initiatorICAC are spans into msgR3Encrypted
-            // which is going away, so to save memory, redirect them to their
-            // copies in msgR3Signed, which is staying around
-            TLV::ContiguousBufferTLVReader signedDataTlvReader;
-            signedDataTlvReader.Init(data.msgR3SignedSpan);
-            SuccessOrExit(err = signedDataTlvReader.Next(containerType, AnonymousTag()));
-            SuccessOrExit(err = signedDataTlvReader.EnterContainer(containerType));
-
-            SuccessOrExit(err = signedDataTlvReader.Next(AsTlvContextTag(TBSDataTags::kSenderNOC)));
-            SuccessOrExit(err = signedDataTlvReader.GetByteView(data.initiatorNOC));
-
-            if (!data.initiatorICAC.empty())
-            {
-                SuccessOrExit(err = signedDataTlvReader.Next(AsTlvContextTag(TBSDataTags::kSenderICAC)));
-                SuccessOrExit(err = signedDataTlvReader.GetByteView(data.initiatorICAC));
-            }
-
-            SuccessOrExit(err = signedDataTlvReader.ExitContainer(containerType));
-        }
+        data.validContext = mValidContext;
 
         SuccessOrExit(err = helper->ScheduleWork());
         mHandleSigma3Helper = helper;
@@ -2097,6 +2193,61 @@ CHIP_ERROR CASESession::ParseSigma3TBEData(ContiguousBufferTLVReader & decrypted
 
 CHIP_ERROR CASESession::HandleSigma3b(HandleSigma3Data & data, bool & cancel)
 {
+    // Step 2 - Decrypt data blob
+    {
+        AutoReleaseSessionKey sr3k(*data.sessionKeystore);
+        ReturnErrorOnFailure(DeriveSigmaKey(*data.sessionKeystore, data.sharedSecret,
+                                            ByteSpan(data.salt.ConstBytes(), data.salt.Capacity()), ByteSpan(kKDFSR3Info), sr3k));
+
+        ReturnErrorOnFailure(AES_CCM_decrypt(data.msgR3EncryptedPayload.data(), data.msgR3EncryptedPayload.size(), nullptr, 0,
+                                             data.msgR3MIC.data(), data.msgR3MIC.size(), sr3k.KeyHandle(), kTBEData3_Nonce,
+                                             kTBEDataNonceLength, data.msgR3EncryptedPayload.data()));
+    }
+
+    ContiguousBufferTLVReader decryptedDataTlvReader;
+    decryptedDataTlvReader.Init(data.msgR3EncryptedPayload.data(), data.msgR3EncryptedPayload.size());
+    ReturnErrorOnFailure(ParseSigma3TBEData(decryptedDataTlvReader, data));
+
+    // Step 3 - Construct Sigma3 TBS Data
+    size_t msgR3SignedLen = TLV::EstimateStructOverhead(data.initiatorNOC.size(),  // initiatorNOC
+                                                        data.initiatorICAC.size(), // initiatorICAC
+                                                        kP256_PublicKey_Length,    // initiatorEphPubKey
+                                                        kP256_PublicKey_Length     // responderEphPubKey
+    );
+
+    VerifyOrReturnError(data.msgR3Signed.Alloc(msgR3SignedLen), CHIP_ERROR_NO_MEMORY);
+    data.msgR3SignedSpan = MutableByteSpan{ data.msgR3Signed.Get(), msgR3SignedLen };
+
+    ReturnErrorOnFailure(ConstructTBSData(data.initiatorNOC, data.initiatorICAC,
+                                          ByteSpan(data.initiatorEphPubKey, data.initiatorEphPubKey.Length()),
+                                          ByteSpan(data.responderEphPubKey, data.responderEphPubKey.Length()),
+                                          data.msgR3SignedSpan));
+
+    // initiatorNOC and initiatorICAC are spans into msgR3Encrypted
+    // which is going away, so to save memory, redirect them to their
+    // copies in msgR3Signed, which is staying around
+    {
+        TLVType containerType = kTLVType_Structure;
+        TLV::ContiguousBufferTLVReader signedDataTlvReader;
+        signedDataTlvReader.Init(data.msgR3SignedSpan);
+        ReturnErrorOnFailure(signedDataTlvReader.Next(containerType, AnonymousTag()));
+        ReturnErrorOnFailure(signedDataTlvReader.EnterContainer(containerType));
+
+        ReturnErrorOnFailure(signedDataTlvReader.Next(AsTlvContextTag(TBSDataTags::kSenderNOC)));
+        ReturnErrorOnFailure(signedDataTlvReader.GetByteView(data.initiatorNOC));
+
+        if (!data.initiatorICAC.empty())
+        {
+            ReturnErrorOnFailure(signedDataTlvReader.Next(AsTlvContextTag(TBSDataTags::kSenderICAC)));
+            ReturnErrorOnFailure(signedDataTlvReader.GetByteView(data.initiatorICAC));
+        }
+
+        ReturnErrorOnFailure(signedDataTlvReader.ExitContainer(containerType));
+    }
+    data.msgR3Encrypted.Free();
+    data.msgR3EncryptedPayload = MutableByteSpan{};
+    data.msgR3MIC              = ByteSpan{};
+
     // Step 5/6
     // Validate initiator identity located in msg->Start()
     // Constructing responder identity
@@ -2166,7 +2317,21 @@ exit:
 
 CHIP_ERROR CASESession::DeriveSigmaKey(const ByteSpan & salt, const ByteSpan & info, AutoReleaseSessionKey & key) const
 {
-    return mSessionManager->GetSessionKeystore()->DeriveKey(mSharedSecret, salt, info, key.KeyHandle());
+    return DeriveSigmaKey(*mSessionManager->GetSessionKeystore(), mSharedSecret, salt, info, key);
+}
+
+CHIP_ERROR CASESession::DeriveSigmaKey(SessionKeystore & keystore, const P256ECDHDerivedSecret & sharedSecret,
+                                       const ByteSpan & salt, const ByteSpan & info, AutoReleaseSessionKey & key)
+{
+    return keystore.DeriveKey(sharedSecret, salt, info, key.KeyHandle());
+}
+
+CHIP_ERROR CASESession::CopyEphemeralKey(P256Keypair & outKey) const
+{
+    VerifyOrReturnError(mEphemeralKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    P256SerializedKeypair serializedKey;
+    ReturnErrorOnFailure(mEphemeralKey->Serialize(serializedKey));
+    return outKey.Deserialize(serializedKey);
 }
 
 CHIP_ERROR CASESession::ConstructSaltSigma2(const ByteSpan & rand, const Crypto::P256PublicKey & pubkey, const ByteSpan & ipk,
@@ -2531,7 +2696,7 @@ CHIP_ERROR CASESession::OnMessageReceived(ExchangeContext * ec, const PayloadHea
         switch (static_cast<Protocols::SecureChannel::MsgType>(payloadHeader.GetMessageType()))
         {
         case Protocols::SecureChannel::MsgType::CASE_Sigma2:
-            err = HandleSigma2_and_SendSigma3(std::move(msg));
+            err = HandleSigma2a(std::move(msg));
             break;
 
         case MsgType::StatusReport:
@@ -2548,7 +2713,7 @@ CHIP_ERROR CASESession::OnMessageReceived(ExchangeContext * ec, const PayloadHea
         switch (static_cast<Protocols::SecureChannel::MsgType>(payloadHeader.GetMessageType()))
         {
         case Protocols::SecureChannel::MsgType::CASE_Sigma2:
-            err = HandleSigma2_and_SendSigma3(std::move(msg));
+            err = HandleSigma2a(std::move(msg));
             break;
 
         case Protocols::SecureChannel::MsgType::CASE_Sigma2Resume:
@@ -2657,6 +2822,20 @@ bool CASESession::InvokeBackgroundWorkWatchdog()
 {
     bool watchdogFired = false;
 
+    if (mSendSigma2Helper && mSendSigma2Helper->UnableToScheduleAfterWorkCallback())
+    {
+        ChipLogError(SecureChannel, "SendSigma2Helper was unable to schedule the AfterWorkCallback");
+        mSendSigma2Helper->DoAfterWork();
+        watchdogFired = true;
+    }
+
+    if (mHandleSigma2Helper && mHandleSigma2Helper->UnableToScheduleAfterWorkCallback())
+    {
+        ChipLogError(SecureChannel, "HandleSigma2Helper was unable to schedule the AfterWorkCallback");
+        mHandleSigma2Helper->DoAfterWork();
+        watchdogFired = true;
+    }
+
     if (mSendSigma3Helper && mSendSigma3Helper->UnableToScheduleAfterWorkCallback())
     {
         ChipLogError(SecureChannel, "SendSigma3Helper was unable to schedule the AfterWorkCallback");
@@ -2684,9 +2863,12 @@ SessionEstablishmentStage CASESession::MapCASEStateToSessionEstablishmentStage(S
     case State::kSentSigma1:
     case State::kSentSigma1Resume:
         return SessionEstablishmentStage::kSentSigma1;
+    case State::kSendSigma2Pending:
+        return SessionEstablishmentStage::kReceivedSigma1;
     case State::kSentSigma2:
     case State::kSentSigma2Resume:
         return SessionEstablishmentStage::kSentSigma2;
+    case State::kHandleSigma2Pending:
     case State::kSendSigma3Pending:
         return SessionEstablishmentStage::kReceivedSigma2;
     case State::kSentSigma3:
@@ -182,6 +182,8 @@ public:
         kFinishedViaResume   = 7,
         kSendSigma3Pending   = 8,
         kHandleSigma3Pending = 9,
+        kHandleSigma2Pending = 10,
+        kSendSigma2Pending   = 11,
     };
 
     State GetState() { return mState; }
@@ -201,6 +203,11 @@ protected:
     // the next Sigma step to send) or a CHIP_ERROR (indicating a failure that will trigger
     // a Status Report).
     using NextStep = Variant<Step, CHIP_ERROR>;
+
+    static constexpr size_t kSaltSigma2Length =
+        kIPKSize + kSigmaParamRandomNumberSize + Crypto::kP256_PublicKey_Length + Crypto::kSHA256_Hash_Length;
+    static constexpr size_t kSaltSigma3Length = kIPKSize + Crypto::kSHA256_Hash_Length;
+
     // This struct only serves as a base struct for EncodeSigma1Inputs and ParsedSigma1
     struct Sigma1Param
     {
@@ -242,9 +249,9 @@ protected:
     };
     struct ParsedSigma2
     {
-        // Below ByteSpans are Backed by: Sigma2 PacketBuffer passed to the method HandleSigma2()
-        // Lifetime: Valid for the lifetime of the TLVReader, which takes ownership of the Sigma2 PacketBuffer in the HandleSigma2()
-        // method.
+        // Below ByteSpans are Backed by: Sigma2 PacketBuffer passed to the method HandleSigma2a()
+        // Lifetime: Valid for the lifetime of the TLVReader, which takes ownership of the Sigma2 PacketBuffer in the
+        // HandleSigma2a() method.
         ByteSpan responderRandom;
         ByteSpan responderEphPubKey;
 
@@ -290,13 +297,50 @@ protected:
         bool responderSessionParamStructPresent = false;
     };
 
+    struct SendSigma2Data
+    {
+        FabricIndex fabricIndex;
+
+        // Set if the keystore can sign in the background, otherwise tbsData2Signature is generated before the work is scheduled
+        const Crypto::OperationalKeystore * keystore = nullptr;
+
+        Crypto::SessionKeystore * sessionKeystore = nullptr;
+
+        // The work uses its own copy of the ephemeral key when it runs in the background, since the session releases
+        // its key when it is cleared.
+        Crypto::P256Keypair ephemeralKeyCopy;
+        const Crypto::P256Keypair * ephemeralKey = nullptr;
+        bool inBackground                        = false;
+
+        Crypto::P256PublicKey initiatorEphPubKey;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        Crypto::SensitiveDataFixedBuffer<kSaltSigma2Length> salt;
+
+        chip::Platform::ScopedMemoryBuffer<uint8_t> msgR2Signed;
+        MutableByteSpan msgR2SignedSpan;
+
+        chip::Platform::ScopedMemoryBuffer<uint8_t> icacBuf;
+        MutableByteSpan icaCert;
+
+        chip::Platform::ScopedMemoryBuffer<uint8_t> nocBuf;
+        MutableByteSpan nocCert;
+
+        Crypto::P256ECDSASignature tbsData2Signature;
+        SessionResumptionStorage::ResumptionIdStorage resumptionId;
+
+        EncodeSigma2Inputs encodeSigma2;
+    };
+
     struct SendSigma3Data
     {
         FabricIndex fabricIndex;
 
-        // Use one or the other
-        const FabricTable * fabricTable;
-        const Crypto::OperationalKeystore * keystore;
+        // Set if the keystore can sign in the background, otherwise tbsData3Signature is generated before the work is scheduled
+        const Crypto::OperationalKeystore * keystore = nullptr;
+
+        Crypto::SessionKeystore * sessionKeystore = nullptr;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        Crypto::SensitiveDataFixedBuffer<kSaltSigma3Length> salt;
 
         chip::Platform::ScopedMemoryBuffer<uint8_t> msgR3Signed;
         MutableByteSpan msgR3SignedSpan;
@@ -313,12 +357,66 @@ protected:
         Crypto::P256ECDSASignature tbsData3Signature;
     };
 
+    struct HandleSigma2Data
+    {
+        Crypto::SessionKeystore * sessionKeystore = nullptr;
+
+        // The work uses its own copy of the ephemeral key when it runs in the background, since the session releases
+        // its key when it is cleared.
+        Crypto::P256Keypair ephemeralKeyCopy;
+        const Crypto::P256Keypair * ephemeralKey = nullptr;
+        bool inBackground                        = false;
+
+        Crypto::P256PublicKey responderEphPubKey;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        Crypto::SensitiveDataFixedBuffer<kSaltSigma2Length> salt;
+
+        chip::Platform::ScopedMemoryBuffer<uint8_t> msgR2Signed;
+        MutableByteSpan msgR2SignedSpan;
+
+        // Moved here from the ParsedSigma2 local to the HandleSigma2a() method, and decrypted in place by HandleSigma2b().
+        // Below ByteSpans are Backed by: msgR2Decrypted Buffer
+        Platform::ScopedMemoryBufferWithSize<uint8_t> msgR2Decrypted;
+        MutableByteSpan msgR2EncryptedPayload;
+        ByteSpan msgR2MIC;
+        ByteSpan responderNOC;
+        ByteSpan responderICAC;
+        ByteSpan resumptionId;
+
+        uint8_t rootCertBuf[Credentials::kMaxCHIPCertLength];
+        ByteSpan fabricRCAC;
+
+        Crypto::P256ECDSASignature tbsData2Signature;
+
+        FabricId fabricId;
+        NodeId responderNodeId;
+
+        Credentials::ValidationContext validContext;
+
+        SessionParameters responderSessionParams;
+        uint16_t responderSessionId;
+        bool responderSessionParamStructPresent = false;
+    };
+
     struct HandleSigma3Data
     {
+        Crypto::SessionKeystore * sessionKeystore = nullptr;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        Crypto::SensitiveDataFixedBuffer<kSaltSigma3Length> salt;
+
+        Crypto::P256PublicKey initiatorEphPubKey;
+        Crypto::P256PublicKey responderEphPubKey;
+
+        // Allocated by ParseSigma3() in the HandleSigma3a() method, and decrypted in place by HandleSigma3b().
+        // msgR3EncryptedPayload and msgR3MIC are Backed by: msgR3Encrypted Buffer
+        Platform::ScopedMemoryBufferWithSize<uint8_t> msgR3Encrypted;
+        MutableByteSpan msgR3EncryptedPayload;
+        ByteSpan msgR3MIC;
+
         chip::Platform::ScopedMemoryBuffer<uint8_t> msgR3Signed;
         MutableByteSpan msgR3SignedSpan;
 
-        // Below ByteSpans are Backed by: msgR3Encrypted Buffer, local to the HandleSigma3a() method,
+        // Below ByteSpans are Backed by: msgR3Encrypted Buffer,
         // The Spans are later modified to point to the msgR3Signed member of this struct.
         ByteSpan initiatorNOC;
         ByteSpan initiatorICAC;
@@ -493,13 +591,16 @@ private:
     CHIP_ERROR TryResumeSession(SessionResumptionStorage::ConstResumptionIdView resumptionId, ByteSpan resume1MIC,
                                 ByteSpan initiatorRandom);
 
-    CHIP_ERROR PrepareSigma2(EncodeSigma2Inputs & output);
+    CHIP_ERROR SendSigma2a();
+    static CHIP_ERROR SendSigma2b(SendSigma2Data & data, bool & cancel);
+    CHIP_ERROR SendSigma2c(SendSigma2Data & data, CHIP_ERROR status);
     CHIP_ERROR PrepareSigma2Resume(EncodeSigma2ResumeInputs & output);
     CHIP_ERROR SendSigma2(System::PacketBufferHandle && msg_R2);
     CHIP_ERROR SendSigma2Resume(System::PacketBufferHandle && msg_R2_resume);
 
-    CHIP_ERROR HandleSigma2_and_SendSigma3(System::PacketBufferHandle && msg);
-    CHIP_ERROR HandleSigma2(System::PacketBufferHandle && msg);
+    CHIP_ERROR HandleSigma2a(System::PacketBufferHandle && msg);
+    static CHIP_ERROR HandleSigma2b(HandleSigma2Data & data, bool & cancel);
+    CHIP_ERROR HandleSigma2c(HandleSigma2Data & data, CHIP_ERROR status);
     CHIP_ERROR HandleSigma2Resume(System::PacketBufferHandle && msg);
 
     CHIP_ERROR SendSigma3a();
@@ -512,10 +613,14 @@ private:
     CHIP_ERROR SendSigma2Resume();
 
     CHIP_ERROR DeriveSigmaKey(const ByteSpan & salt, const ByteSpan & info, AutoReleaseSessionKey & key) const;
+    static CHIP_ERROR DeriveSigmaKey(Crypto::SessionKeystore & keystore, const Crypto::P256ECDHDerivedSecret & sharedSecret,
+                                     const ByteSpan & salt, const ByteSpan & info, AutoReleaseSessionKey & key);
     CHIP_ERROR ConstructSaltSigma2(const ByteSpan & rand, const Crypto::P256PublicKey & pubkey, const ByteSpan & ipk,
                                    MutableByteSpan & salt);
-    CHIP_ERROR ConstructTBSData(const ByteSpan & senderNOC, const ByteSpan & senderICAC, const ByteSpan & senderPubKey,
-                                const ByteSpan & receiverPubKey, MutableByteSpan & outTbsData);
+    static CHIP_ERROR ConstructTBSData(const ByteSpan & senderNOC, const ByteSpan & senderICAC, const ByteSpan & senderPubKey,
+                                       const ByteSpan & receiverPubKey, MutableByteSpan & outTbsData);
+    // Copies the ephemeral key for use by background work, fails if the key cannot be exported.
+    CHIP_ERROR CopyEphemeralKey(Crypto::P256Keypair & outKey) const;
     CHIP_ERROR ConstructSaltSigma3(const ByteSpan & ipk, MutableByteSpan & salt);
 
     CHIP_ERROR ConstructSigmaResumeKey(const ByteSpan & initiatorRandom, const ByteSpan & resumptionID, const ByteSpan & skInfo,
@@ -585,6 +690,8 @@ private:
 
     template <class DATA>
     class WorkHelper;
+    Platform::SharedPtr<WorkHelper<SendSigma2Data>> mSendSigma2Helper;
+    Platform::SharedPtr<WorkHelper<HandleSigma2Data>> mHandleSigma2Helper;
     Platform::SharedPtr<WorkHelper<SendSigma3Data>> mSendSigma3Helper;
     Platform::SharedPtr<WorkHelper<HandleSigma3Data>> mHandleSigma3Helper;
 
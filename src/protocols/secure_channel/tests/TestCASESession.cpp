@@ -22,7 +22,12 @@
  *      This file implements unit tests for the CASESession implementation.
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <stdarg.h>
+#include <thread>
 
 #include <pw_unit_test/framework.h>
 
@@ -110,8 +115,9 @@ public:
 void TestCASESession::ServiceEvents()
 {
     // Takes a few rounds of this because handling IO messages may schedule work,
-    // and scheduled work may queue messages for sending...
-    for (int i = 0; i < 3; ++i)
+    // and scheduled work may queue messages for sending... Sigma2 and Sigma3 are built
+    // and checked in scheduled work, so this takes about a round per Sigma message.
+    for (int i = 0; i < 5; ++i)
     {
         DrainAndServiceIO();
 
@@ -241,6 +247,9 @@ public:
         return mKeypair->ECDSA_sign_msg(message.data(), message.size(), outSignature);
     }
 
+    // The keypair is only read once it is set up, so signing from the background workers is safe
+    bool SupportsSignWithOpKeypairInBackground() const override { return true; }
+
     Crypto::P256Keypair * AllocateEphemeralKeypairForCASE() override { return Platform::New<Crypto::P256Keypair>(); }
 
     void ReleaseEphemeralKeypair(Crypto::P256Keypair * keypair) override { Platform::Delete<Crypto::P256Keypair>(keypair); }
@@ -379,6 +388,9 @@ void TestCASESession::SetUpTestSuite()
     LoopbackMessagingContext::SetUpTestSuite();
 
     ASSERT_EQ(chip::DeviceLayer::PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+    // ServiceEvents() steps the handshakes on this thread, so keep the background work here too unless a test starts the
+    // workers itself.
+    ASSERT_EQ(chip::DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask(), CHIP_NO_ERROR);
 
     ASSERT_EQ(
         InitFabricTable(gCommissionerFabrics, &gCommissionerStorageDelegate, /* opKeyStore = */ nullptr, &gCommissionerOpCertStore),
@@ -643,6 +655,187 @@ TEST_F(TestCASESession, ClientReceivesBusyTest)
     gPairingServer.Shutdown();
 }
 
+// Number of handshakes the benchmark runs at once. Each handshake holds an exchange and an unauthenticated session on
+// either side of the loopback, so the default is what the pools allow; the host_gcc_case_benchmark_tests build raises both.
+#ifndef CHIP_CASE_BENCHMARK_SESSION_COUNT
+#define CHIP_CASE_BENCHMARK_SESSION_COUNT                                                                                          \
+    (std::min(CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, CHIP_CONFIG_UNAUTHENTICATED_CONNECTION_POOL_SIZE) / 2)
+#endif // CHIP_CASE_BENCHMARK_SESSION_COUNT
+
+constexpr size_t kBenchmarkSessionCount = CHIP_CASE_BENCHMARK_SESSION_COUNT;
+static_assert(kBenchmarkSessionCount > 0, "CHIP_CASE_BENCHMARK_SESSION_COUNT must allow at least one handshake");
+static_assert(2 * kBenchmarkSessionCount <= CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS &&
+                  2 * kBenchmarkSessionCount <= CHIP_CONFIG_UNAUTHENTICATED_CONNECTION_POOL_SIZE,
+              "CHIP_CASE_BENCHMARK_SESSION_COUNT handshakes do not fit in the exchange and unauthenticated session pools");
+
+// Applies the default certificate validity policy, counting whether the certificate chains were checked on the Matter
+// thread or on a background worker.
+class ThreadRecordingValidityPolicy : public CertificateValidityPolicy
+{
+public:
+    ThreadRecordingValidityPolicy() : mMatterThread(std::this_thread::get_id()) {}
+
+    CHIP_ERROR ApplyCertificateValidityPolicy(const ChipCertificateData * cert, uint8_t depth,
+                                              CertificateValidityResult result) override
+    {
+        (std::this_thread::get_id() == mMatterThread ? mChecksOnMatterThread : mChecksInBackground)++;
+        return ApplyDefaultPolicy(cert, depth, result);
+    }
+
+    std::atomic<size_t> mChecksOnMatterThread{ 0 };
+    std::atomic<size_t> mChecksInBackground{ 0 };
+
+private:
+    const std::thread::id mMatterThread;
+};
+
+// Hands every Sigma1 to a fresh responder, so that several handshakes are in flight at once (CASEServer only serves
+// one at a time).
+class ConcurrentCASEResponder : public Messaging::UnsolicitedMessageHandler
+{
+public:
+    ConcurrentCASEResponder(SessionManager & sessionManager, CertificateValidityPolicy * policy) :
+        mSessionManager(sessionManager), mPolicy(policy)
+    {}
+
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        VerifyOrReturnError(mSessionCount < kBenchmarkSessionCount, CHIP_ERROR_NO_MEMORY);
+
+        CASESession & session = mSessions[mSessionCount];
+        session.SetGroupDataProvider(&gDeviceGroupDataProvider);
+        ReturnErrorOnFailure(session.PrepareForSessionEstablishment(mSessionManager, &gDeviceFabrics, nullptr, mPolicy,
+                                                                    &mDelegates[mSessionCount], ScopedNodeId(), NullOptional));
+        mSessionCount++;
+        return session.OnUnsolicitedMessageReceived(payloadHeader, newDelegate);
+    }
+
+    size_t GetCompletedCount() const
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < mSessionCount; i++)
+        {
+            count += mDelegates[i].mNumPairingComplete;
+        }
+        return count;
+    }
+
+private:
+    SessionManager & mSessionManager;
+    CertificateValidityPolicy * mPolicy;
+    CASESession mSessions[kBenchmarkSessionCount];
+    TestCASESecurePairingDelegate mDelegates[kBenchmarkSessionCount];
+    size_t mSessionCount = 0;
+};
+
+// Stops the event loop once a condition holds, checking it every millisecond.
+struct CompletionWait
+{
+    std::function<bool()> isDone;
+    uint32_t ticksLeft;
+
+    static void Check(System::Layer * systemLayer, void * appState)
+    {
+        auto * wait = static_cast<CompletionWait *>(appState);
+        if (wait->isDone() || wait->ticksLeft-- == 0)
+        {
+            LogErrorOnFailure(DeviceLayer::PlatformMgr().StopEventLoopTask());
+            return;
+        }
+        LogErrorOnFailure(systemLayer->StartTimer(System::Clock::Milliseconds32(1), Check, appState));
+    }
+};
+
+TEST_F(TestCASESession, BenchmarkConcurrentEstablishment)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    static constexpr size_t kSessionCounts[] = { 1, kBenchmarkSessionCount };
+    // Leave every handshake a generous 20ms of the event loop on top of a fixed 10s.
+    static constexpr uint32_t kMaxWaitTicks = static_cast<uint32_t>(10000 + 20 * kBenchmarkSessionCount);
+
+    // Runs the storm on the Matter thread alone, then with the Sigma key agreement, encryption and signature checks
+    // handed to the background workers (if the platform has any).
+    for (bool background : { false, true })
+    {
+        if (background)
+        {
+            ASSERT_EQ(DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask(), CHIP_NO_ERROR);
+        }
+
+        for (size_t sessionCount : kSessionCounts)
+        {
+            TemporarySessionManager sessionManager(*this);
+            ThreadRecordingValidityPolicy policy;
+            auto * responder  = Platform::New<ConcurrentCASEResponder>(sessionManager, &policy);
+            auto * initiators = Platform::New<std::array<CASESession, kBenchmarkSessionCount>>();
+            auto * delegates  = Platform::New<std::array<TestCASESecurePairingDelegate, kBenchmarkSessionCount>>();
+            ASSERT_NE(responder, nullptr);
+            ASSERT_NE(initiators, nullptr);
+            ASSERT_NE(delegates, nullptr);
+
+            EXPECT_SUCCESS(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                Protocols::SecureChannel::MsgType::CASE_Sigma1, responder));
+
+            chip::Testing::BenchmarkTimer timer;
+            for (size_t i = 0; i < sessionCount; i++)
+            {
+                CASESession & initiator = (*initiators)[i];
+                initiator.SetGroupDataProvider(&gCommissionerGroupDataProvider);
+                EXPECT_SUCCESS(initiator.EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                          ScopedNodeId{ Node01_01, gCommissionerFabricIndex },
+                                                          NewUnauthenticatedExchangeToBob(&initiator), nullptr, &policy,
+                                                          &(*delegates)[i], NullOptional));
+            }
+            // Background work completes asynchronously, so run the event loop until both sides of every handshake are done.
+            auto isDone = [&]() {
+                size_t completed = responder->GetCompletedCount();
+                for (size_t i = 0; i < sessionCount; i++)
+                {
+                    completed += (*delegates)[i].mNumPairingComplete + (*delegates)[i].mNumPairingErrors;
+                }
+                return completed >= 2 * sessionCount;
+            };
+            CompletionWait wait{ isDone, kMaxWaitTicks };
+            EXPECT_SUCCESS(GetSystemLayer().StartTimer(System::Clock::kZero, CompletionWait::Check, &wait));
+            DeviceLayer::PlatformMgr().RunEventLoop();
+            const uint64_t elapsed = timer.Elapsed().count();
+
+            EXPECT_EQ(responder->GetCompletedCount(), sessionCount);
+            for (size_t i = 0; i < sessionCount; i++)
+            {
+                EXPECT_EQ((*delegates)[i].mNumPairingComplete, 1u);
+                EXPECT_EQ((*delegates)[i].mNumPairingErrors, 0u);
+            }
+            // Both sides check the chain of their peer in a background step, which only leaves the Matter thread once
+            // the workers are running.
+            EXPECT_GE(policy.mChecksOnMatterThread + policy.mChecksInBackground, 2 * sessionCount);
+            if (background)
+            {
+                EXPECT_EQ(policy.mChecksOnMatterThread, 0u);
+            }
+            else
+            {
+                EXPECT_EQ(policy.mChecksInBackground, 0u);
+            }
+            ChipLogProgress(Test, "%u concurrent handshakes%s: %u us in total, %u us per handshake",
+                            static_cast<unsigned>(sessionCount), background ? " (background crypto)" : "",
+                            static_cast<unsigned>(elapsed), static_cast<unsigned>(elapsed / sessionCount));
+
+            EXPECT_SUCCESS(
+                GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1));
+            Platform::Delete(delegates);
+            Platform::Delete(initiators);
+            Platform::Delete(responder);
+        }
+
+        if (background)
+        {
+            EXPECT_SUCCESS(DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask());
+        }
+    }
+}
+
 #if CHIP_WITH_NLFAULTINJECTION
 
 /* This tests that Corrupting Signature during a CASE Handshake will lead to CASE Failing and to the Correct Error returned.
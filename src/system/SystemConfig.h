@@ -127,6 +127,10 @@
 #error "FORBIDDEN: CHIP_SYSTEM_CONFIG_MULTICAST_HOMING WAS NOT TESTED WITH ZEPHYR"
 #endif
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL && (!CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_LIBEV)
+#error "FORBIDDEN: CHIP_SYSTEM_CONFIG_USE_EPOLL REQUIRES CHIP_SYSTEM_CONFIG_USE_SOCKETS AND CANNOT BE USED WITH LIBEV"
+#endif
+
 // clang-format off
 
 /**
@@ -288,6 +292,19 @@
 #define CHIP_SYSTEM_CONFIG_POOL_USE_HEAP 0
 #endif /* CHIP_SYSTEM_CONFIG_POOL_USE_HEAP */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+ *
+ *  @brief
+ *      Keep a second-level bitmap of the non-empty usage words of each static (bitmap) pool, so that iterating over a
+ *      sparse pool skips whole runs of empty words and its cost follows the number of live objects rather than the pool
+ *      size. Costs one extra word per 4096 entries (with 64-bit words) and an extra atomic operation whenever a usage word
+ *      becomes empty or non-empty. Only worthwhile for pools much larger than the width of a usage word (unsigned long).
+ */
+#ifndef CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY
+#define CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY 0
+#endif /* CHIP_SYSTEM_CONFIG_POOL_ACTIVE_WORD_SUMMARY */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_NO_LOCKING
  *
@@ -394,6 +411,53 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+ *
+ *  @brief
+ *      The number of small packet buffers, of CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY bytes, to keep in addition to
+ *      the CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE full-size ones in the BSD sockets pool configuration.
+ *
+ *      Allocations are served by the smallest size class that fits and has a free buffer, so that standalone
+ *      acknowledgements and short status responses do not take a full-size buffer. Ignored when packet buffers come
+ *      from the heap or from LwIP.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+ *
+ *  @brief
+ *      The allocation size, including the header reserve, of small pool packet buffers.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY 128
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+ *
+ *  @brief
+ *      The number of medium packet buffers, of CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY bytes, to keep in
+ *      addition to the full-size ones in the BSD sockets pool configuration. See
+ *      CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *
+ *  @brief
+ *      The allocation size, including the header reserve, of medium pool packet buffers.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY 512
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
@@ -531,6 +595,41 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_TIMER_HEAP
+ *
+ *  @brief
+ *      Defines whether (1) or not (0) the select-based System Layer keeps its timers in a chip::System::TimerHeap
+ *      instead of a sorted chip::System::TimerList.
+ *
+ *  @details
+ *      The heap makes starting and cancelling timers O(log n) instead of O(n), which matters when many timers are
+ *      active at once, at the cost of heap-allocated storage that grows with the number of timers. It has no effect
+ *      when libev is used.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_TIMER_HEAP
+#define CHIP_SYSTEM_CONFIG_TIMER_HEAP 0
+#endif /* CHIP_SYSTEM_CONFIG_TIMER_HEAP */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      This is the maximum number of ready events retrieved by a single epoll_wait() call in the epoll-based System Layer.
+ *      Additional ready events are picked up on the next event loop iteration.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif /* CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_MAX_SOCKET_WATCHES
+ *
+ *  @brief
+ *      This is the number of sockets the select- and epoll-based System Layers can watch at once. When not defined, it is
+ *      the number of INET TCP and UDP endpoints.
+ */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_THREAD_LOCAL_STORAGE
  *
@@ -0,0 +1,336 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using epoll() and timerfd.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+CriticalFailure LayerImplEpoll::Init()
+{
+    ReturnErrorOnFailure(LayerImplSelect::Init());
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    struct epoll_event event;
+
+    for (auto & registered : mWatchRegistered)
+    {
+        registered = false;
+    }
+
+    mEpollFD = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrExit(mEpollFD >= 0, err = CHIP_ERROR_POSIX(errno));
+
+    mTimerFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrExit(mTimerFD >= 0, err = CHIP_ERROR_POSIX(errno));
+
+    // The wake event and the timer are told apart from socket watches by their data pointer.
+    event          = {};
+    event.events   = EPOLLIN;
+    event.data.ptr = &mWakeEvent;
+    VerifyOrExit(epoll_ctl(mEpollFD, EPOLL_CTL_ADD, mWakeEvent.GetReadFD(), &event) == 0, err = CHIP_ERROR_POSIX(errno));
+
+    event.data.ptr = &mTimerFD;
+    VerifyOrExit(epoll_ctl(mEpollFD, EPOLL_CTL_ADD, mTimerFD, &event) == 0, err = CHIP_ERROR_POSIX(errno));
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "epoll event loop init failed: %" CHIP_ERROR_FORMAT, err.Format());
+        CloseDescriptors();
+        LayerImplSelect::Shutdown();
+    }
+    return err;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(IsInitialized());
+
+    CloseDescriptors();
+    LayerImplSelect::Shutdown();
+}
+
+void LayerImplEpoll::CloseDescriptors()
+{
+    if (mTimerFD >= 0)
+    {
+        close(mTimerFD);
+        mTimerFD = kInvalidFd;
+    }
+    if (mEpollFD >= 0)
+    {
+        // Closing the epoll descriptor drops all registrations with it.
+        close(mEpollFD);
+        mEpollFD = kInvalidFd;
+    }
+    for (auto & registered : mWatchRegistered)
+    {
+        registered = false;
+    }
+    mEventCount = 0;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    ReturnErrorOnFailure(LayerImplSelect::RequestCallbackOnPendingRead(token));
+    return UpdateWatch(*reinterpret_cast<SocketWatch *>(token));
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    ReturnErrorOnFailure(LayerImplSelect::RequestCallbackOnPendingWrite(token));
+    return UpdateWatch(*reinterpret_cast<SocketWatch *>(token));
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    ReturnErrorOnFailure(LayerImplSelect::ClearCallbackOnPendingRead(token));
+    return UpdateWatch(*reinterpret_cast<SocketWatch *>(token));
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    ReturnErrorOnFailure(LayerImplSelect::ClearCallbackOnPendingWrite(token));
+    return UpdateWatch(*reinterpret_cast<SocketWatch *>(token));
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    VerifyOrReturnError(tokenInOut != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    if (watch != nullptr && watch->mFD >= 0)
+    {
+        watch->mPendingIO.ClearAll();
+        // The socket may already have been closed, which removes it from the epoll set; ignore errors here.
+        (void) UpdateWatch(*watch);
+    }
+
+    return LayerImplSelect::StopWatchingSocket(tokenInOut);
+}
+
+CHIP_ERROR LayerImplEpoll::UpdateWatch(SocketWatch & watch)
+{
+    VerifyOrReturnError(mEpollFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    const size_t index = static_cast<size_t>(&watch - mSocketWatchPool);
+    VerifyOrReturnError(index < MATTER_ARRAY_SIZE(mSocketWatchPool), CHIP_ERROR_INVALID_ARGUMENT);
+
+    struct epoll_event event = {};
+    event.data.ptr           = &watch;
+    if (watch.mPendingIO.Has(SocketEventFlags::kRead))
+    {
+        event.events |= EPOLLIN;
+    }
+    if (watch.mPendingIO.Has(SocketEventFlags::kWrite))
+    {
+        event.events |= EPOLLOUT;
+    }
+
+    // A watch with no pending I/O is removed from the epoll set rather than registered with an empty
+    // mask, since epoll always reports EPOLLERR and EPOLLHUP and would otherwise keep waking the loop.
+    int op;
+    if (event.events == 0)
+    {
+        VerifyOrReturnError(mWatchRegistered[index], CHIP_NO_ERROR);
+        op = EPOLL_CTL_DEL;
+    }
+    else
+    {
+        op = mWatchRegistered[index] ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    }
+
+    if (epoll_ctl(mEpollFD, op, watch.mFD, &event) != 0)
+    {
+        // A failed removal still leaves the descriptor out of the set (e.g. it was already closed).
+        const CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+        if (op == EPOLL_CTL_DEL)
+        {
+            mWatchRegistered[index] = false;
+        }
+        return err;
+    }
+
+    mWatchRegistered[index] = (op != EPOLL_CTL_DEL);
+    return CHIP_NO_ERROR;
+}
+
+SocketEvents LayerImplEpoll::SocketEventsFromEpoll(const SocketWatch & watch, uint32_t events)
+{
+    SocketEvents res;
+
+    // Like select(), report an error or hang-up as readiness for whatever I/O is pending, so that
+    // the subsequent read or write surfaces the error to the endpoint.
+    if (watch.mPendingIO.Has(SocketEventFlags::kRead) && (events & (EPOLLIN | EPOLLERR | EPOLLHUP)))
+    {
+        res.Set(SocketEventFlags::kRead);
+    }
+    if (watch.mPendingIO.Has(SocketEventFlags::kWrite) && (events & (EPOLLOUT | EPOLLERR | EPOLLHUP)))
+    {
+        res.Set(SocketEventFlags::kWrite);
+    }
+
+    return res;
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    mSleepTime       = PrepareTimersAndLoopHandlers();
+    mSelectOnSources = !mSources.Empty();
+
+    // Arming the timer also resets any expiration left over from a previous iteration. A zero
+    // it_value disarms it: a zero sleep time is handled by polling in WaitForEvents(), and when
+    // waiting in select() the timeout is passed there directly.
+    struct itimerspec spec = {};
+    if (!mSelectOnSources && mSleepTime > Clock::kZero)
+    {
+        const uint64_t sleepMs = mSleepTime.count();
+        spec.it_value.tv_sec   = static_cast<time_t>(sleepMs / 1000);
+        spec.it_value.tv_nsec  = static_cast<long>((sleepMs % 1000) * 1000000);
+    }
+    if (timerfd_settime(mTimerFD, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+    }
+
+    VerifyOrReturn(mSelectOnSources);
+
+    // EventSources speak fd_sets, so wait in select() on their descriptors and on the epoll
+    // descriptor, which reports readable whenever one of the watched sockets is ready.
+    Clock::ToTimeval(mSleepTime, mNextTimeout);
+
+    // NOLINTBEGIN(clang-analyzer-security.insecureAPI.bzero)
+    FD_ZERO(&mSelected.mReadSet);
+    FD_ZERO(&mSelected.mWriteSet);
+    FD_ZERO(&mSelected.mErrorSet);
+    // NOLINTEND(clang-analyzer-security.insecureAPI.bzero)
+
+    FD_SET(mEpollFD, &mSelected.mReadSet);
+    mMaxFd = mEpollFD;
+
+    for (auto & source : mSources)
+    {
+        source.PrepareEvents(mMaxFd, mSelected.mReadSet, mSelected.mWriteSet, mSelected.mErrorSet, mNextTimeout);
+    }
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    mEventCount = 0;
+
+    if (mSelectOnSources)
+    {
+        mSelectResult = select(mMaxFd + 1, &mSelected.mReadSet, &mSelected.mWriteSet, &mSelected.mErrorSet, &mNextTimeout);
+        if (mSelectResult > 0 && FD_ISSET(mEpollFD, &mSelected.mReadSet))
+        {
+            mEventCount = std::max(epoll_wait(mEpollFD, mEvents, kMaxEpollEvents, 0), 0);
+        }
+        return;
+    }
+
+    mSelectResult = epoll_wait(mEpollFD, mEvents, kMaxEpollEvents, (mSleepTime > Clock::kZero) ? -1 : 0);
+    mEventCount   = std::max(mSelectResult, 0);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsSelectResultValid())
+    {
+        VerifyOrReturn(errno != EINTR); // EINTR is not really an error (and we don't use it for signal handling)
+        ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        return;
+    }
+
+    for (int i = 0; i < mEventCount; i++)
+    {
+        if (mEvents[i].data.ptr == &mWakeEvent)
+        {
+            mWakeEvent.Confirm();
+        }
+        else if (mEvents[i].data.ptr == &mTimerFD)
+        {
+            uint64_t expirations;
+            (void) read(mTimerFD, &expirations, sizeof(expirations));
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    HandleExpiredTimers();
+
+    for (int i = 0; i < mEventCount; i++)
+    {
+        void * ptr = mEvents[i].data.ptr;
+        if (ptr == &mWakeEvent || ptr == &mTimerFD)
+        {
+            continue;
+        }
+
+        // A callback earlier in this batch may have stopped watching this socket; in that case the
+        // watch no longer has a callback or pending I/O and the stale event is dropped.
+        SocketWatch & w = *static_cast<SocketWatch *>(ptr);
+        if (w.mFD != kInvalidFd && w.mCallback != nullptr)
+        {
+            SocketEvents events = SocketEventsFromEpoll(w, mEvents[i].events);
+            if (events.HasAny())
+            {
+                w.mCallback(events, w.mCallbackData);
+            }
+        }
+    }
+
+    if (mSelectOnSources && mSelectResult >= 0)
+    {
+        for (auto & source : mSources)
+        {
+            source.ProcessEvents(mSelected.mReadSet, mSelected.mWriteSet, mSelected.mErrorSet);
+        }
+    }
+
+    HandleLoopHandlers();
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+} // namespace System
+} // namespace chip
@@ -0,0 +1,95 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an implementation of System::Layer using epoll() and timerfd.
+ *
+ *      LayerImplEpoll keeps the socket watches registered with the kernel instead of
+ *      rebuilding fd_sets on every iteration, so the cost of an event loop iteration
+ *      depends on the number of ready descriptors rather than the number of watched ones,
+ *      and descriptors above FD_SETSIZE can be watched.
+ *
+ *      EventSources registered through LayerImplSelect::EventSourceAdd() keep working:
+ *      when any are present, the loop select()s on their descriptors plus the epoll
+ *      descriptor itself, which becomes readable whenever a watched socket is ready.
+ */
+
+#pragma once
+
+#include <system/SystemConfig.h>
+
+#if !CHIP_SYSTEM_CONFIG_USE_EPOLL
+#error "SystemLayerImplEpoll.h requires CHIP_SYSTEM_CONFIG_USE_EPOLL"
+#endif
+
+#include <sys/epoll.h>
+
+#include <system/SystemLayerImplSelect.h>
+
+namespace chip {
+namespace System {
+
+class LayerImplEpoll : public LayerImplSelect
+{
+public:
+    LayerImplEpoll() = default;
+    ~LayerImplEpoll() override = default;
+
+    // Layer overrides.
+    CriticalFailure Init() override;
+    void Shutdown() override;
+
+    // LayerSocket overrides.
+    CHIP_ERROR RequestCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR RequestCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR StopWatchingSocket(SocketWatchToken * tokenInOut) override;
+
+    // LayerSelectLoop overrides.
+    void PrepareEvents() override;
+    void WaitForEvents() override;
+    void HandleEvents() override;
+
+private:
+    static constexpr int kMaxEpollEvents = CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS;
+
+    // Bring the kernel registration of a socket watch in line with its pending I/O flags.
+    CHIP_ERROR UpdateWatch(SocketWatch & watch);
+    static SocketEvents SocketEventsFromEpoll(const SocketWatch & watch, uint32_t events);
+
+    void CloseDescriptors();
+
+    int mEpollFD = kInvalidFd;
+    int mTimerFD = kInvalidFd;
+
+    // Whether the watch at the same index in mSocketWatchPool is currently registered with mEpollFD.
+    bool mWatchRegistered[kSocketWatchMax] = {};
+
+    // True when EventSources were present in PrepareEvents() and the wait goes through select().
+    bool mSelectOnSources = false;
+    Clock::Timeout mSleepTime;
+
+    struct epoll_event mEvents[kMaxEpollEvents];
+    int mEventCount = 0;
+};
+
+using LayerImpl = LayerImplEpoll;
+
+} // namespace System
+} // namespace chip
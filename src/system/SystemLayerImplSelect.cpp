@@ -150,7 +150,7 @@ CriticalFailure LayerImplSelect::StartTimer(Clock::Timeout delay, TimerCompleteC
 
     CancelTimer(onComplete, appState);
 
-    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
     VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
 
 #if CHIP_SYSTEM_CONFIG_USE_LIBEV
@@ -169,7 +169,13 @@ CriticalFailure LayerImplSelect::StartTimer(Clock::Timeout delay, TimerCompleteC
     (void) mTimerList.Add(timer);
     ev_timer_start(mLibEvLoopP, &timer->mLibEvTimer);
 #else
-    if (mTimerList.Add(timer) == timer)
+    TimerQueue::Node * earliest = mTimerList.Add(timer);
+    if (earliest == nullptr)
+    {
+        mTimerPool.Release(timer);
+        return CHIP_ERROR_NO_MEMORY;
+    }
+    if (earliest == timer)
     {
         // The new timer is the earliest, so the time until the next event has probably changed.
         Signal();
@@ -226,14 +232,14 @@ void LayerImplSelect::CancelTimer(TimerCompleteCallback onComplete, void * appSt
 
     VerifyOrReturn(mLayerState.IsInitialized());
 
-    TimerList::Node * timer = mTimerList.Remove(onComplete, appState);
+    TimerQueue::Node * timer = mTimerList.Remove(onComplete, appState);
     if (timer == nullptr)
     {
         // The timer was not in our "will fire in the future" list, but it might
         // be in the "we're about to fire these" chunk we already grabbed from
         // that list.  Check for it there too, and if found there we still want
         // to cancel it.
-        timer = mExpiredTimers.Remove(onComplete, appState);
+        timer = static_cast<TimerQueue::Node *>(mExpiredTimers.Remove(onComplete, appState));
     }
     VerifyOrReturn(timer != nullptr);
 
@@ -292,10 +298,16 @@ CriticalFailure LayerImplSelect::ScheduleWork(TimerCompleteCallback onComplete,
     // timer, but just make sure we don't cancel existing timers with the same
     // callback and appState, so ScheduleWork invocations don't stomp on each
     // other.
-    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
     VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
 
-    if (mTimerList.Add(timer) == timer)
+    TimerQueue::Node * earliest = mTimerList.Add(timer);
+    if (earliest == nullptr)
+    {
+        mTimerPool.Release(timer);
+        return CHIP_ERROR_NO_MEMORY;
+    }
+    if (earliest == timer)
     {
         // The new timer is the earliest, so the time until the next event has probably changed.
         Signal();
@@ -546,14 +558,12 @@ void LayerImplSelect::EventSourceClear()
     mSources.Clear();
 }
 
-void LayerImplSelect::PrepareEvents()
+Clock::Timeout LayerImplSelect::PrepareTimersAndLoopHandlers()
 {
-    assertChipStackLockedByCurrentThread();
-
     const Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
     Clock::Timestamp awakenTime        = currentTime + kDefaultMinSleepPeriod;
 
-    TimerList::Node * timer = mTimerList.Earliest();
+    TimerQueue::Node * timer = mTimerList.Earliest();
     if (timer)
     {
         awakenTime = std::min(awakenTime, timer->AwakenTime());
@@ -576,7 +586,14 @@ void LayerImplSelect::PrepareEvents()
     }
 
     const Clock::Timestamp sleepTime = (awakenTime > currentTime) ? (awakenTime - currentTime) : Clock::kZero;
-    Clock::ToTimeval(sleepTime, mNextTimeout);
+    return std::chrono::duration_cast<Clock::Timeout>(std::min<Clock::Timestamp>(sleepTime, kDefaultMinSleepPeriod));
+}
+
+void LayerImplSelect::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    Clock::ToTimeval(PrepareTimersAndLoopHandlers(), mNextTimeout);
 
     mMaxFd = -1;
 
@@ -647,15 +664,7 @@ void LayerImplSelect::HandleEvents()
     mHandleSelectThread = pthread_self();
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
-    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
-    // since that could result in infinite handling of new timers blocking any other progress.
-    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
-    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
-    TimerList::Node * timer = nullptr;
-    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
-    {
-        mTimerPool.Invoke(timer);
-    }
+    HandleExpiredTimers();
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     // Process socket events, if any
@@ -683,6 +692,28 @@ void LayerImplSelect::HandleEvents()
         }
     }
 
+    HandleLoopHandlers();
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+void LayerImplSelect::HandleExpiredTimers()
+{
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(static_cast<TimerQueue::Node *>(timer));
+    }
+}
+
+void LayerImplSelect::HandleLoopHandlers()
+{
     // Call HandleEvents for active loop handlers
     auto loopIter = mLoopHandlers.begin();
     while (loopIter != mLoopHandlers.end())
@@ -693,10 +724,6 @@ void LayerImplSelect::HandleEvents()
             loop.HandleEvents();
         }
     }
-
-#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
-    mHandleSelectThread = PTHREAD_NULL;
-#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 }
 
 #if CHIP_SYSTEM_CONFIG_USE_LIBEV
@@ -206,12 +206,32 @@ public:
     void EventSourceClear();
 
 protected:
+    /**
+     * Activate pending EventLoopHandlers and compute how long the loop may sleep before the earliest
+     * timer or EventLoopHandler needs servicing.
+     */
+    Clock::Timeout PrepareTimersAndLoopHandlers();
+
+    /**
+     * Invoke all timers that have expired as of now.
+     */
+    void HandleExpiredTimers();
+
+    /**
+     * Call HandleEvents() on all active EventLoopHandlers.
+     */
+    void HandleLoopHandlers();
+
     IntrusiveList<EventSource> mSources;
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     static SocketEvents SocketEventsFromFDs(int socket, const fd_set & readfds, const fd_set & writefds, const fd_set & exceptfds);
 
+#ifdef CHIP_SYSTEM_CONFIG_MAX_SOCKET_WATCHES
+    static constexpr int kSocketWatchMax = CHIP_SYSTEM_CONFIG_MAX_SOCKET_WATCHES;
+#else
     static constexpr int kSocketWatchMax = (INET_CONFIG_ENABLE_TCP_ENDPOINT ? INET_CONFIG_NUM_TCP_ENDPOINTS : 0) +
         (INET_CONFIG_ENABLE_UDP_ENDPOINT ? INET_CONFIG_NUM_UDP_ENDPOINTS : 0);
+#endif
 
     struct SocketWatch
     {
@@ -230,8 +250,13 @@ protected:
     SocketWatch mSocketWatchPool[kSocketWatchMax];
 #endif
 
-    TimerPool<TimerList::Node> mTimerPool;
-    TimerList mTimerList;
+#if CHIP_SYSTEM_CONFIG_TIMER_HEAP && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    using TimerQueue = TimerHeap;
+#else
+    using TimerQueue = TimerList;
+#endif
+    TimerPool<TimerQueue::Node> mTimerPool;
+    TimerQueue mTimerList;
     // List of expired timers being processed right now.  Stored in a member so
     // we can cancel them.
     TimerList mExpiredTimers;
@@ -265,7 +290,9 @@ protected:
 #endif
 };
 
+#if !CHIP_SYSTEM_CONFIG_USE_EPOLL
 using LayerImpl = LayerImplSelect;
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 
 } // namespace System
 } // namespace chip
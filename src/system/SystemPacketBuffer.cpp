@@ -104,6 +104,128 @@ PacketBuffer * PacketBuffer::BuildFreeList()
     return static_cast<PacketBuffer *>(lHead);
 }
 
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+
+class PacketBuffer::SizeClass
+{
+public:
+    SizeClass(uint8_t * aBlocks, size_t aAllocSize, size_t aCount, int aStatsEntry) :
+        mBlocks(aBlocks), mAllocSize(aAllocSize), mCount(aCount), mStatsEntry(aStatsEntry)
+    {}
+
+    static constexpr size_t BlockSize(size_t aAllocSize)
+    {
+        return CHIP_SYSTEM_ALIGN_SIZE(PacketBuffer::kStructureSize + aAllocSize, alignof(pbuf));
+    }
+
+    size_t AllocSize() const { return mAllocSize; }
+
+    bool Contains(const PacketBuffer * aPacket) const
+    {
+        const uint8_t * lBlock = reinterpret_cast<const uint8_t *>(aPacket);
+        return lBlock >= mBlocks && lBlock < mBlocks + mCount * BlockSize(mAllocSize);
+    }
+
+    // Blocks that were never allocated are handed out in order, so the free list needs no initialization.
+    PacketBuffer * Allocate()
+    {
+        PacketBuffer * lPacket = mFreeList;
+        if (lPacket != nullptr)
+        {
+            mFreeList = lPacket->ChainedBuffer();
+        }
+        else if (mUnusedIndex < mCount)
+        {
+            lPacket = reinterpret_cast<PacketBuffer *>(mBlocks + BlockSize(mAllocSize) * mUnusedIndex++);
+        }
+        else
+        {
+            return nullptr;
+        }
+        SYSTEM_STATS_INCREMENT(mStatsEntry);
+        return lPacket;
+    }
+
+    void Release(PacketBuffer * aPacket)
+    {
+        SYSTEM_STATS_DECREMENT(mStatsEntry);
+        aPacket->next = mFreeList;
+        mFreeList     = aPacket;
+    }
+
+    // Storage of the blocks of all size classes.
+    static uint8_t sBlocks[];
+
+private:
+    uint8_t * const mBlocks;
+    const size_t mAllocSize;
+    const size_t mCount;
+    const int mStatsEntry;
+    size_t mUnusedIndex      = 0;
+    PacketBuffer * mFreeList = nullptr;
+};
+
+alignas(pbuf) uint8_t PacketBuffer::SizeClass::sBlocks[CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL *
+                                                            BlockSize(CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY) +
+                                                        CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM *
+                                                            BlockSize(CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY)];
+
+// Ordered by increasing size.
+PacketBuffer::SizeClass PacketBuffer::sSizeClasses[] = {
+    { SizeClass::sBlocks, CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY, CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL,
+      Stats::kSystemLayer_NumSmallPacketBufs },
+    { SizeClass::sBlocks +
+          CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL * SizeClass::BlockSize(CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY),
+      CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY, CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM,
+      Stats::kSystemLayer_NumMediumPacketBufs },
+};
+
+// Must be called with the pool locked.
+PacketBuffer * PacketBuffer::AllocateFromSizeClass(size_t aAllocSize)
+{
+    for (auto & sizeClass : sSizeClasses)
+    {
+        if (aAllocSize <= sizeClass.AllocSize())
+        {
+            PacketBuffer * lPacket = sizeClass.Allocate();
+            if (lPacket != nullptr)
+            {
+                return lPacket;
+            }
+        }
+    }
+    return nullptr;
+}
+
+// Must be called with the pool locked.
+void PacketBuffer::ReleaseToPool(PacketBuffer * aPacket)
+{
+    for (auto & sizeClass : sSizeClasses)
+    {
+        if (sizeClass.Contains(aPacket))
+        {
+            sizeClass.Release(aPacket);
+            return;
+        }
+    }
+    aPacket->next = sFreeList;
+    sFreeList     = aPacket;
+}
+
+size_t PacketBuffer::PoolAllocSize(const PacketBuffer * aPacket)
+{
+    for (const auto & sizeClass : sSizeClasses)
+    {
+        if (sizeClass.Contains(aPacket))
+        {
+            return sizeClass.AllocSize();
+        }
+    }
+    return kMaxSizeWithoutReserve;
+}
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 //
 // Heap allocation for PacketBuffer objects.
@@ -305,6 +427,15 @@ const uint8_t * PacketBuffer::ReserveStart() const
     return reinterpret_cast<const uint8_t *>(this) + kStructureSize;
 }
 
+bool PacketBuffer::HasInlinePayload() const
+{
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    return PBUF_STRUCT_DATA_CONTIGUOUS(this);
+#else
+    return true;
+#endif
+}
+
 void PacketBuffer::AddToEnd(PacketBufferHandle && aPacketHandle)
 {
     // Ownership of aPacketHandle's buffer is transferred to the end of the chain.
@@ -631,11 +762,17 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 #endif
     LOCK_BUF_POOL();
 
-    lPacket = PacketBuffer::sFreeList;
-    if (lPacket != nullptr)
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+    lPacket = PacketBuffer::AllocateFromSizeClass(lAllocSize);
+    if (lPacket == nullptr)
+#endif // CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
     {
-        PacketBuffer::sFreeList = lPacket->ChainedBuffer();
-        SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+        lPacket = PacketBuffer::sFreeList;
+        if (lPacket != nullptr)
+        {
+            PacketBuffer::sFreeList = lPacket->ChainedBuffer();
+            SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+        }
     }
 
     UNLOCK_BUF_POOL();
@@ -727,7 +864,9 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
 #endif
             aPacket->Clear();
-#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+            ReleaseToPool(aPacket);
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
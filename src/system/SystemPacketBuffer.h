@@ -150,13 +150,13 @@ public:
 
     /**
      * Unified constant(both regular and large buffers) for the maximum size that an application can allocate with no
-     * protocol header reserve.
+     * protocol header reserve. The internal pool only holds regular buffers.
      */
-#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT && !CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
     static constexpr size_t kMaxAllocSize = kLargeBufMaxSizeWithoutReserve;
 #else
     static constexpr size_t kMaxAllocSize          = kMaxSizeWithoutReserve;
-#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT && !CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
 
     /**
      * Return the size of the allocation including the reserved and payload data spaces but not including space
@@ -168,7 +168,9 @@ public:
      */
     size_t AllocSize() const
     {
-#if CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_STANDARD_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+        return PoolAllocSize(this);
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_STANDARD_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
         return kMaxSizeWithoutReserve;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
         return this->alloc_size;
@@ -264,6 +266,14 @@ public:
      */
     bool HasChainedBuffer() const { return ChainedBuffer() != nullptr; }
 
+    /**
+     * Determine whether the payload of the current buffer is stored inline with the buffer structure, and so can be
+     * modified in place. This is always the case unless the buffer is an LwIP pbuf referencing external memory.
+     *
+     *  @return \c true if the payload is stored inline.
+     */
+    bool HasInlinePayload() const;
+
     /**
      * Add the given packet buffer to the end of the buffer chain, adjusting the total length of each buffer in the chain
      * accordingly.
@@ -389,6 +399,15 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+    // Pools of buffers smaller than kBlockSize; see CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL.
+    class SizeClass;
+    static SizeClass sSizeClasses[];
+    static PacketBuffer * AllocateFromSizeClass(size_t aAllocSize);
+    static void ReleaseToPool(PacketBuffer * aPacket);
+    static size_t PoolAllocSize(const PacketBuffer * aPacket);
+#endif // CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
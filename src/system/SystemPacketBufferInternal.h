@@ -49,6 +49,18 @@
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+ *
+ * True if the internal pool also has small and/or medium packet buffers.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL &&                                                                                     \
+    (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL > 0 || CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM > 0)
+#define CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_POOL
  *
@@ -123,6 +135,12 @@
 #error "Inconsistent PacketBuffer allocation configuration"
 #endif
 
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES &&                                                                              \
+    (CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY > CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY ||                           \
+     CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY > CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX)
+#error "PacketBuffer size class capacities must increase up to CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX"
+#endif
+
 #if (CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_STANDARD_POOL + CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_CUSTOM_POOL) !=                         \
     CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_POOL
 #error "Inconsistent PacketBuffer LwIP pool configuration"
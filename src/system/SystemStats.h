@@ -28,6 +28,7 @@
 #include <inet/InetConfig.h>
 #include <lib/core/CHIPConfig.h>
 #include <system/SystemConfig.h>
+#include <system/SystemPacketBufferInternal.h>
 
 // Include dependent headers
 #include <lib/support/DLLUtil.h>
@@ -54,6 +55,10 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+    kSystemLayer_NumSmallPacketBufs,
+    kSystemLayer_NumMediumPacketBufs,
+#endif // CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -93,6 +98,37 @@ void UpdateLwipPbufCounts(void);
 typedef const char * Label;
 const Label * GetStrings();
 
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+// The receive workers of UDP endpoints allocate and free packet buffers off the Matter thread, so the counters they
+// touch are updated atomically.
+inline count_t AddResourcesInUse(int entry, int delta)
+{
+    return __atomic_add_fetch(&GetResourcesInUse()[entry], static_cast<count_t>(delta), __ATOMIC_RELAXED);
+}
+
+inline void RaiseHighWatermark(int entry, count_t value)
+{
+    count_t current = __atomic_load_n(&GetHighWatermarks()[entry], __ATOMIC_RELAXED);
+    while (current < value &&
+           !__atomic_compare_exchange_n(&GetHighWatermarks()[entry], &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+#else
+inline count_t AddResourcesInUse(int entry, int delta)
+{
+    return GetResourcesInUse()[entry] = static_cast<count_t>(GetResourcesInUse()[entry] + delta);
+}
+
+inline void RaiseHighWatermark(int entry, count_t value)
+{
+    if (GetHighWatermarks()[entry] < value)
+    {
+        GetHighWatermarks()[entry] = value;
+    }
+}
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
 } // namespace Stats
 } // namespace System
 } // namespace chip
@@ -102,23 +138,19 @@ const Label * GetStrings();
 #define SYSTEM_STATS_INCREMENT(entry)                                                                                              \
     do                                                                                                                             \
     {                                                                                                                              \
-        chip::System::Stats::count_t new_value = ++(chip::System::Stats::GetResourcesInUse()[entry]);                              \
-        if (chip::System::Stats::GetHighWatermarks()[entry] < new_value)                                                           \
-        {                                                                                                                          \
-            chip::System::Stats::GetHighWatermarks()[entry] = new_value;                                                           \
-        }                                                                                                                          \
+        chip::System::Stats::RaiseHighWatermark(entry, chip::System::Stats::AddResourcesInUse(entry, 1));                          \
     } while (0)
 
 #define SYSTEM_STATS_DECREMENT(entry)                                                                                              \
     do                                                                                                                             \
     {                                                                                                                              \
-        chip::System::Stats::GetResourcesInUse()[entry]--;                                                                         \
+        chip::System::Stats::AddResourcesInUse(entry, -1);                                                                         \
     } while (0)
 
 #define SYSTEM_STATS_DECREMENT_BY_N(entry, count)                                                                                  \
     do                                                                                                                             \
     {                                                                                                                              \
-        chip::System::Stats::GetResourcesInUse()[entry] -= (count);                                                                \
+        chip::System::Stats::AddResourcesInUse(entry, -(count));                                                                   \
     } while (0)
 
 #define SYSTEM_STATS_SET(entry, count)                                                                                             \
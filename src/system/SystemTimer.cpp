@@ -33,6 +33,7 @@
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 
 namespace chip {
@@ -178,5 +179,249 @@ Clock::Timeout TimerList::GetRemainingTime(TimerCompleteCallback aOnComplete, vo
     return Clock::kZero;
 }
 
+TimerHeap::~TimerHeap()
+{
+    Platform::MemoryFree(mHeap);
+    Platform::MemoryFree(mBuckets);
+}
+
+TimerHeap::Node * TimerHeap::Add(TimerHeap::Node * add)
+{
+    VerifyOrDie(add->mHeapIndex == kNotInHeap);
+    VerifyOrReturnValue(Reserve(mCount + 1), nullptr);
+
+    add->mSequence = mNextSequence++;
+    LinkBucket(add);
+    Place(add, mCount++);
+    SiftUp(mCount - 1);
+    return mHeap[0];
+}
+
+TimerHeap::Node * TimerHeap::Remove(TimerHeap::Node * remove)
+{
+    if (remove != nullptr && remove->mHeapIndex < mCount && mHeap[remove->mHeapIndex] == remove)
+    {
+        RemoveAt(remove->mHeapIndex);
+    }
+    return Earliest();
+}
+
+TimerHeap::Node * TimerHeap::Remove(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    TimerHeap::Node * timer = Find(aOnComplete, aAppState);
+    return (timer != nullptr) ? RemoveAt(timer->mHeapIndex) : nullptr;
+}
+
+TimerHeap::Node * TimerHeap::PopEarliest()
+{
+    return (mCount > 0) ? RemoveAt(0) : nullptr;
+}
+
+TimerHeap::Node * TimerHeap::PopIfEarlier(Clock::Timestamp t)
+{
+    if ((mCount == 0) || !(mHeap[0]->AwakenTime() < t))
+    {
+        return nullptr;
+    }
+    return RemoveAt(0);
+}
+
+TimerList TimerHeap::ExtractEarlier(Clock::Timestamp t)
+{
+    TimerList out;
+    TimerList::Node * end = nullptr;
+
+    for (TimerHeap::Node * timer = PopIfEarlier(t); timer != nullptr; timer = PopIfEarlier(t))
+    {
+        if (end == nullptr)
+        {
+            out.mEarliestTimer = timer;
+        }
+        else
+        {
+            end->mNextTimer = timer;
+        }
+        end = timer;
+    }
+
+    return out;
+}
+
+void TimerHeap::Clear()
+{
+    for (size_t i = 0; i < mCount; i++)
+    {
+        mHeap[i]->mHeapIndex    = kNotInHeap;
+        mHeap[i]->mNextInBucket = nullptr;
+    }
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        mBuckets[i] = nullptr;
+    }
+    mCount = 0;
+}
+
+Clock::Timeout TimerHeap::GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    TimerHeap::Node * timer = Find(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+
+        if (currentTime < timer->AwakenTime())
+        {
+            return Clock::Timeout(timer->AwakenTime() - currentTime);
+        }
+    }
+    return Clock::kZero;
+}
+
+bool TimerHeap::IsEarlier(const TimerHeap::Node * a, const TimerHeap::Node * b)
+{
+    if (a->AwakenTime() != b->AwakenTime())
+    {
+        return a->AwakenTime() < b->AwakenTime();
+    }
+    return a->mSequence < b->mSequence;
+}
+
+size_t TimerHeap::BucketOf(TimerCompleteCallback onComplete, void * appState) const
+{
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(appState)) ^
+        (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(onComplete)) << 1);
+    hash *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 32) & (mCapacity - 1);
+}
+
+TimerHeap::Node * TimerHeap::Find(TimerCompleteCallback onComplete, void * appState) const
+{
+    VerifyOrReturnValue(mCount > 0, nullptr);
+
+    // Several timers may share a callback and state (ScheduleWork does not cancel earlier ones), so pick the one that
+    // expires first, as the list would.
+    TimerHeap::Node * found = nullptr;
+    for (TimerHeap::Node * timer = mBuckets[BucketOf(onComplete, appState)]; timer != nullptr; timer = timer->mNextInBucket)
+    {
+        if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState &&
+            (found == nullptr || IsEarlier(timer, found)))
+        {
+            found = timer;
+        }
+    }
+    return found;
+}
+
+bool TimerHeap::Reserve(size_t count)
+{
+    VerifyOrReturnValue(count > mCapacity, true);
+
+    size_t capacity = (mCapacity == 0) ? kInitialCapacity : mCapacity * 2;
+    VerifyOrReturnValue(capacity > mCapacity && capacity <= SIZE_MAX / sizeof(Node *), false);
+
+    Node ** heap = static_cast<Node **>(Platform::MemoryRealloc(mHeap, capacity * sizeof(Node *)));
+    VerifyOrReturnValue(heap != nullptr, false);
+    mHeap = heap;
+
+    Node ** buckets = static_cast<Node **>(Platform::MemoryCalloc(capacity, sizeof(Node *)));
+    VerifyOrReturnValue(buckets != nullptr, false);
+    Platform::MemoryFree(mBuckets);
+    mBuckets  = buckets;
+    mCapacity = capacity;
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        LinkBucket(mHeap[i]);
+    }
+    return true;
+}
+
+void TimerHeap::LinkBucket(TimerHeap::Node * timer)
+{
+    Node *& head         = mBuckets[BucketOf(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())];
+    timer->mNextInBucket = head;
+    head                 = timer;
+}
+
+void TimerHeap::UnlinkBucket(TimerHeap::Node * timer)
+{
+    Node ** link = &mBuckets[BucketOf(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())];
+    while (*link != timer)
+    {
+        link = &(*link)->mNextInBucket;
+    }
+    *link                = timer->mNextInBucket;
+    timer->mNextInBucket = nullptr;
+}
+
+void TimerHeap::Place(TimerHeap::Node * timer, size_t index)
+{
+    mHeap[index]      = timer;
+    timer->mHeapIndex = index;
+}
+
+void TimerHeap::SiftUp(size_t index)
+{
+    TimerHeap::Node * timer = mHeap[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / kArity;
+        if (!IsEarlier(timer, mHeap[parent]))
+        {
+            break;
+        }
+        Place(mHeap[parent], index);
+        index = parent;
+    }
+    Place(timer, index);
+}
+
+void TimerHeap::SiftDown(size_t index)
+{
+    TimerHeap::Node * timer = mHeap[index];
+    while (index * kArity + 1 < mCount)
+    {
+        size_t first    = index * kArity + 1;
+        size_t earliest = first;
+        for (size_t child = first + 1; child < first + kArity && child < mCount; child++)
+        {
+            if (IsEarlier(mHeap[child], mHeap[earliest]))
+            {
+                earliest = child;
+            }
+        }
+        if (!IsEarlier(mHeap[earliest], timer))
+        {
+            break;
+        }
+        Place(mHeap[earliest], index);
+        index = earliest;
+    }
+    Place(timer, index);
+}
+
+TimerHeap::Node * TimerHeap::RemoveAt(size_t index)
+{
+    TimerHeap::Node * timer = mHeap[index];
+    UnlinkBucket(timer);
+
+    mCount--;
+    if (index < mCount)
+    {
+        Place(mHeap[mCount], index);
+        if (index > 0 && IsEarlier(mHeap[index], mHeap[(index - 1) / kArity]))
+        {
+            SiftUp(index);
+        }
+        else
+        {
+            SiftDown(index);
+        }
+    }
+
+    timer->mHeapIndex = kNotInHeap;
+    timer->mNextTimer = nullptr;
+    return timer;
+}
+
 } // namespace System
 } // namespace chip
@@ -36,6 +36,9 @@
 #include <system/SystemLayer.h>
 #include <system/SystemStats.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
 #include <dispatch/dispatch.h>
 #endif
@@ -186,9 +189,135 @@ public:
     Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
 
 private:
+    friend class TimerHeap;
     Node * mEarliestTimer;
 };
 
+/**
+ * Collection of `Timer`s ordered by expiration time, kept in a 4-ary min-heap.
+ *
+ * This offers the same operations as TimerList, for layers that keep many timers active at once. Adding a timer and
+ * removing any timer cost O(log n) instead of O(n), and timers are found by callback and application state through a
+ * hash index instead of a scan. Timers with the same expiration time expire in the order they were added, as with
+ * TimerList.
+ *
+ * The heap and the index are allocated with Platform::MemoryRealloc and grow as needed, so Add() can fail.
+ */
+class TimerHeap
+{
+    static constexpr size_t kNotInHeap = SIZE_MAX;
+
+public:
+    class Node : public TimerList::Node
+    {
+    public:
+        Node(Layer & systemLayer, System::Clock::Timestamp awakenTime, TimerCompleteCallback onComplete, void * appState) :
+            TimerList::Node(systemLayer, awakenTime, onComplete, appState)
+        {}
+
+    private:
+        friend class TimerHeap;
+        size_t mHeapIndex    = kNotInHeap;
+        uint64_t mSequence   = 0;
+        Node * mNextInBucket = nullptr;
+    };
+
+    TimerHeap() = default;
+    ~TimerHeap();
+
+    /**
+     * Add a timer to the heap
+     *
+     * @return  The new earliest timer in the heap, or nullptr if there is not enough memory to add the timer.
+     */
+    Node * Add(Node * timer);
+
+    /**
+     * Remove the given timer from the heap, if present. It is not an error for the timer not to be present.
+     *
+     * @return  The new earliest timer in the heap, or nullptr if the heap is empty.
+     */
+    Node * Remove(Node * remove);
+
+    /**
+     * Remove the earliest timer with the given properties, if present. It is not an error for no such timer to be
+     * present.
+     *
+     * @return  The removed timer, or nullptr if the heap contains no matching timer.
+     */
+    Node * Remove(TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Remove and return the earliest timer in the heap.
+     *
+     * @return  The earliest timer, or nullptr if the heap is empty.
+     */
+    Node * PopEarliest();
+
+    /**
+     * Remove and return the earliest timer in the heap, provided it expires earlier than the given time @a t.
+     *
+     * @return  The earliest timer expiring before @a t, or nullptr if there is no such timer.
+     */
+    Node * PopIfEarlier(Clock::Timestamp t);
+
+    /**
+     * Get the earliest timer in the heap.
+     *
+     * @return  The earliest timer, or nullptr if there are no timers.
+     */
+    Node * Earliest() const { return mCount > 0 ? mHeap[0] : nullptr; }
+
+    /**
+     * Test whether there are any timers.
+     */
+    bool Empty() const { return mCount == 0; }
+
+    /**
+     * Remove and return all timers that expire before the given time @a t, as a list in expiration order.
+     */
+    TimerList ExtractEarlier(Clock::Timestamp t);
+
+    /**
+     * Remove all timers.
+     */
+    void Clear();
+
+    /**
+     * Find the earliest timer with the given properties, if present, and return its remaining time
+     *
+     * @return The remaining time on this particular timer or 0 if not found.
+     */
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
+
+private:
+    static constexpr size_t kArity           = 4;
+    static constexpr size_t kInitialCapacity = 16;
+
+    static bool IsEarlier(const Node * a, const Node * b);
+    size_t BucketOf(TimerCompleteCallback onComplete, void * appState) const;
+    Node * Find(TimerCompleteCallback onComplete, void * appState) const;
+    bool Reserve(size_t count);
+    void LinkBucket(Node * timer);
+    void UnlinkBucket(Node * timer);
+    void Place(Node * timer, size_t index);
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+    Node * RemoveAt(size_t index);
+
+    Node ** mHeap          = nullptr;
+    size_t mCount          = 0;
+    size_t mCapacity       = 0;
+    uint64_t mNextSequence = 0;
+
+    // Chains of timers by callback and application state. There are always mCapacity buckets, a power of two.
+    Node ** mBuckets = nullptr;
+
+    // Not defined
+    TimerHeap(const TimerHeap &)             = delete;
+    TimerHeap & operator=(const TimerHeap &) = delete;
+};
+
 /**
  * ObjectPool wrapper that keeps System Timer statistics.
  */
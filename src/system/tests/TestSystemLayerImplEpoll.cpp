@@ -0,0 +1,364 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::System::LayerImplEpoll</tt>,
+ *      including a micro-benchmark comparing LayerImplSelect and LayerImplEpoll
+ *      wakeups with many idle socket watches.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
+#include <system/SystemConfig.h>
+#include <system/SystemLayerImpl.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::System;
+using namespace chip::System::Clock::Literals;
+
+// The fake PlatformManagerImpl does not drive the system layer event loop
+#if !CHIP_DEVICE_LAYER_TARGET_FAKE
+
+namespace {
+
+struct Pipe
+{
+    Pipe()
+    {
+        int fds[2];
+        if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) == 0)
+        {
+            mRead  = fds[0];
+            mWrite = fds[1];
+        }
+    }
+    Pipe(const Pipe &)             = delete;
+    Pipe & operator=(const Pipe &) = delete;
+    ~Pipe()
+    {
+        if (mRead >= 0)
+        {
+            close(mRead);
+        }
+        if (mWrite >= 0)
+        {
+            close(mWrite);
+        }
+    }
+
+    bool IsOpen() const { return mRead >= 0 && mWrite >= 0; }
+    bool Notify() const
+    {
+        const uint8_t byte = 1;
+        return write(mWrite, &byte, 1) == 1;
+    }
+    void Confirm() const
+    {
+        uint8_t byte;
+        while (read(mRead, &byte, 1) == 1)
+        {
+        }
+    }
+
+    int mRead  = kInvalidFd;
+    int mWrite = kInvalidFd;
+};
+
+struct WatchState
+{
+    int calls = 0;
+    SocketEvents lastEvents;
+};
+
+void OnSocketEvent(SocketEvents events, intptr_t data)
+{
+    auto * state = reinterpret_cast<WatchState *>(data);
+    state->calls++;
+    state->lastEvents = events;
+}
+
+void OnTimer(Layer *, void * appState)
+{
+    (*static_cast<int *>(appState))++;
+}
+
+class TestSystemLayerImplEpoll : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(DeviceLayer::PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+    }
+
+    static void TearDownTestSuite()
+    {
+        DeviceLayer::PlatformMgr().Shutdown();
+        Platform::MemoryShutdown();
+    }
+
+    static LayerImplEpoll & Impl() { return static_cast<LayerImplEpoll &>(DeviceLayer::SystemLayer()); }
+
+    // Runs one loop iteration, bounded by a short timer so that the test never blocks.
+    static void RunOnce()
+    {
+        int fired = 0;
+        EXPECT_EQ(Impl().StartTimer(1_ms, OnTimer, &fired), CHIP_NO_ERROR);
+        Impl().PrepareEvents();
+        Impl().WaitForEvents();
+        Impl().HandleEvents();
+        Impl().CancelTimer(OnTimer, &fired);
+    }
+};
+
+TEST_F(TestSystemLayerImplEpoll, ReadCallbackFollowsRequestAndClear)
+{
+    Pipe pipe;
+    ASSERT_TRUE(pipe.IsOpen());
+
+    WatchState state;
+    SocketWatchToken token;
+    ASSERT_EQ(Impl().StartWatchingSocket(pipe.mRead, &token), CHIP_NO_ERROR);
+    ASSERT_EQ(Impl().SetCallback(token, OnSocketEvent, reinterpret_cast<intptr_t>(&state)), CHIP_NO_ERROR);
+    ASSERT_EQ(Impl().RequestCallbackOnPendingRead(token), CHIP_NO_ERROR);
+
+    // Nothing to read yet.
+    RunOnce();
+    EXPECT_EQ(state.calls, 0);
+
+    ASSERT_TRUE(pipe.Notify());
+    RunOnce();
+    EXPECT_EQ(state.calls, 1);
+    EXPECT_TRUE(state.lastEvents.Has(SocketEventFlags::kRead));
+
+    // Level-triggered: still readable until drained.
+    RunOnce();
+    EXPECT_EQ(state.calls, 2);
+    pipe.Confirm();
+
+    ASSERT_EQ(Impl().ClearCallbackOnPendingRead(token), CHIP_NO_ERROR);
+    ASSERT_TRUE(pipe.Notify());
+    RunOnce();
+    EXPECT_EQ(state.calls, 2);
+
+    ASSERT_EQ(Impl().StopWatchingSocket(&token), CHIP_NO_ERROR);
+    RunOnce();
+    EXPECT_EQ(state.calls, 2);
+}
+
+TEST_F(TestSystemLayerImplEpoll, WriteCallback)
+{
+    Pipe pipe;
+    ASSERT_TRUE(pipe.IsOpen());
+
+    WatchState state;
+    SocketWatchToken token;
+    ASSERT_EQ(Impl().StartWatchingSocket(pipe.mWrite, &token), CHIP_NO_ERROR);
+    ASSERT_EQ(Impl().SetCallback(token, OnSocketEvent, reinterpret_cast<intptr_t>(&state)), CHIP_NO_ERROR);
+    ASSERT_EQ(Impl().RequestCallbackOnPendingWrite(token), CHIP_NO_ERROR);
+
+    RunOnce();
+    EXPECT_EQ(state.calls, 1);
+    EXPECT_TRUE(state.lastEvents.Has(SocketEventFlags::kWrite));
+    EXPECT_FALSE(state.lastEvents.Has(SocketEventFlags::kRead));
+
+    ASSERT_EQ(Impl().StopWatchingSocket(&token), CHIP_NO_ERROR);
+}
+
+TEST_F(TestSystemLayerImplEpoll, WatchDescriptorAboveFdSetSize)
+{
+    Pipe pipe;
+    ASSERT_TRUE(pipe.IsOpen());
+
+    struct rlimit limit;
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &limit), 0);
+    if (limit.rlim_cur <= FD_SETSIZE + 1)
+    {
+        GTEST_SKIP() << "RLIMIT_NOFILE too low to open a descriptor above FD_SETSIZE";
+    }
+
+    const int highFd = fcntl(pipe.mRead, F_DUPFD_CLOEXEC, FD_SETSIZE + 1);
+    ASSERT_GT(highFd, FD_SETSIZE);
+
+    WatchState state;
+    SocketWatchToken token;
+    ASSERT_EQ(Impl().StartWatchingSocket(highFd, &token), CHIP_NO_ERROR);
+    ASSERT_EQ(Impl().SetCallback(token, OnSocketEvent, reinterpret_cast<intptr_t>(&state)), CHIP_NO_ERROR);
+    ASSERT_EQ(Impl().RequestCallbackOnPendingRead(token), CHIP_NO_ERROR);
+
+    ASSERT_TRUE(pipe.Notify());
+    RunOnce();
+    EXPECT_EQ(state.calls, 1);
+
+    ASSERT_EQ(Impl().StopWatchingSocket(&token), CHIP_NO_ERROR);
+    close(highFd);
+}
+
+TEST_F(TestSystemLayerImplEpoll, TimerFiresThroughTimerFd)
+{
+    int fired = 0;
+
+    const auto start = SystemClock().GetMonotonicTimestamp();
+    ASSERT_EQ(Impl().StartTimer(20_ms, OnTimer, &fired), CHIP_NO_ERROR);
+    while (fired == 0)
+    {
+        Impl().PrepareEvents();
+        Impl().WaitForEvents();
+        Impl().HandleEvents();
+    }
+    const auto elapsed = SystemClock().GetMonotonicTimestamp() - start;
+
+    EXPECT_EQ(fired, 1);
+    EXPECT_GE(elapsed, 20_ms);
+    EXPECT_LT(elapsed, 1000_ms);
+}
+
+Clock::Microseconds64 ProcessCpuTime()
+{
+    struct timespec now;
+    VerifyOrDie(clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) == 0);
+    return Clock::Microseconds64(static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_nsec) / 1000);
+}
+
+// Watches up to maxIdleWatches unbound UDP sockets, which never become readable, then runs loop iterations that are
+// each woken by the same ready pipe. Stops registering idle sockets early, and leaves the times unset, when the watch
+// pool of the layer is full or a descriptor would not fit in an fd_set; idleWatches reports how many were registered.
+void BenchmarkWakeups(LayerImplSelect & layer, size_t maxIdleWatches, int iterations, size_t & idleWatches,
+                      Clock::Microseconds64 & elapsed, Clock::Microseconds64 & cpuTime)
+{
+    Pipe wake;
+    ASSERT_TRUE(wake.IsOpen());
+    WatchState wakeState;
+    SocketWatchToken wakeToken;
+    ASSERT_EQ(layer.StartWatchingSocket(wake.mRead, &wakeToken), CHIP_NO_ERROR);
+    ASSERT_EQ(layer.SetCallback(wakeToken, OnSocketEvent, reinterpret_cast<intptr_t>(&wakeState)), CHIP_NO_ERROR);
+    ASSERT_EQ(layer.RequestCallbackOnPendingRead(wakeToken), CHIP_NO_ERROR);
+
+    WatchState idleState;
+    std::vector<int> idleSockets;
+    std::vector<SocketWatchToken> idleTokens;
+    while (idleTokens.size() < maxIdleWatches)
+    {
+        const int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            break;
+        }
+        idleSockets.push_back(fd);
+        SocketWatchToken token;
+        if (fd >= FD_SETSIZE || layer.StartWatchingSocket(fd, &token) != CHIP_NO_ERROR)
+        {
+            break;
+        }
+        idleTokens.push_back(token);
+        ASSERT_EQ(layer.SetCallback(token, OnSocketEvent, reinterpret_cast<intptr_t>(&idleState)), CHIP_NO_ERROR);
+        ASSERT_EQ(layer.RequestCallbackOnPendingRead(token), CHIP_NO_ERROR);
+    }
+    idleWatches = idleTokens.size();
+
+    if (idleWatches == maxIdleWatches)
+    {
+        const Clock::Microseconds64 cpuStart = ProcessCpuTime();
+        chip::Testing::BenchmarkTimer timer;
+        for (int i = 0; i < iterations; i++)
+        {
+            ASSERT_TRUE(wake.Notify());
+            layer.PrepareEvents();
+            layer.WaitForEvents();
+            layer.HandleEvents();
+            wake.Confirm();
+        }
+        elapsed = timer.Elapsed();
+        cpuTime = ProcessCpuTime() - cpuStart;
+
+        EXPECT_EQ(wakeState.calls, iterations);
+        EXPECT_EQ(idleState.calls, 0);
+    }
+
+    for (auto & token : idleTokens)
+    {
+        EXPECT_EQ(layer.StopWatchingSocket(&token), CHIP_NO_ERROR);
+    }
+    for (int fd : idleSockets)
+    {
+        close(fd);
+    }
+    EXPECT_EQ(layer.StopWatchingSocket(&wakeToken), CHIP_NO_ERROR);
+}
+
+// Compares the cost of one wakeup of LayerImplSelect, which rebuilds its fd_sets on every iteration, with LayerImplEpoll,
+// both watching 1000 idle sockets. The watch pool must be sized for them, as in the epoll_benchmark host build.
+TEST_F(TestSystemLayerImplEpoll, BenchmarkWakeupWithIdleWatches)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    constexpr size_t kIdleWatches = 1000;
+    constexpr int kIterations     = 2000;
+
+    LayerImplSelect selectLayer;
+    ASSERT_EQ(selectLayer.Init(), CHIP_NO_ERROR);
+    size_t selectIdleWatches = 0;
+    Clock::Microseconds64 selectElapsed;
+    Clock::Microseconds64 selectCpuTime;
+    BenchmarkWakeups(selectLayer, kIdleWatches, kIterations, selectIdleWatches, selectElapsed, selectCpuTime);
+    selectLayer.Shutdown();
+    VerifyOrReturn(!HasFailure());
+    if (selectIdleWatches < kIdleWatches)
+    {
+        GTEST_SKIP() << "Only " << selectIdleWatches << " idle sockets could be watched; build with "
+                     << "chip_system_config_max_socket_watches above " << kIdleWatches << " and enough descriptors";
+    }
+
+    LayerImplEpoll epollLayer;
+    ASSERT_EQ(epollLayer.Init(), CHIP_NO_ERROR);
+    size_t epollIdleWatches = 0;
+    Clock::Microseconds64 epollElapsed;
+    Clock::Microseconds64 epollCpuTime;
+    BenchmarkWakeups(epollLayer, kIdleWatches, kIterations, epollIdleWatches, epollElapsed, epollCpuTime);
+    epollLayer.Shutdown();
+    VerifyOrReturn(!HasFailure());
+    ASSERT_EQ(epollIdleWatches, kIdleWatches);
+
+    ChipLogProgress(Test, "%u idle socket watches, %d wakeups:", static_cast<unsigned>(kIdleWatches), kIterations);
+    ChipLogProgress(Test, "  LayerImplSelect %u ns/wakeup, %u ns CPU/wakeup",
+                    static_cast<unsigned>(selectElapsed.count() * 1000 / kIterations),
+                    static_cast<unsigned>(selectCpuTime.count() * 1000 / kIterations));
+    ChipLogProgress(Test, "  LayerImplEpoll  %u ns/wakeup, %u ns CPU/wakeup",
+                    static_cast<unsigned>(epollElapsed.count() * 1000 / kIterations),
+                    static_cast<unsigned>(epollCpuTime.count() * 1000 / kIterations));
+}
+
+} // namespace
+
+#endif // !CHIP_DEVICE_LAYER_TARGET_FAKE
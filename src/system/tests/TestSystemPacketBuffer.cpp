@@ -39,6 +39,7 @@
 #include <lib/support/tests/ExtraPwTestMacros.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -1744,5 +1745,46 @@ TEST_F(TestSystemPacketBuffer, CheckPacketBufferWriter)
     EXPECT_EQ(memcmp(yayBuffer->Start(), kPayload, sizeof kPayload), 0);
 }
 
+#if CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+TEST_F(TestSystemPacketBuffer, CheckPoolSizeClasses)
+{
+    constexpr size_t kSmallCapacity  = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY;
+    constexpr size_t kMediumCapacity = CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY;
+    constexpr size_t kSmallCount     = CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_SMALL;
+    constexpr size_t kMediumCount    = CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE_MEDIUM;
+
+    // Requests are served by the smallest class that fits.
+    {
+        PacketBufferHandle small = PacketBufferHandle::New(kSmallCapacity, 0);
+        ASSERT_FALSE(small.IsNull());
+        EXPECT_EQ(small->AllocSize(), kSmallCount > 0 ? kSmallCapacity : kMediumCapacity);
+        EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumSmallPacketBufs, kSmallCount > 0 ? 1 : 0));
+
+        PacketBufferHandle full = PacketBufferHandle::New(kMediumCapacity + 1, 0);
+        ASSERT_FALSE(full.IsNull());
+        EXPECT_EQ(full->AllocSize(), PacketBuffer::kMaxSizeWithoutReserve);
+    }
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumSmallPacketBufs, 0));
+
+    // Once a class is exhausted, requests move on to the next larger one.
+    std::vector<PacketBufferHandle> buffers;
+    for (size_t i = 0; i < kSmallCount + kMediumCount; ++i)
+    {
+        buffers.push_back(PacketBufferHandle::New(0, 0));
+        ASSERT_FALSE(buffers.back().IsNull());
+        EXPECT_EQ(buffers.back()->AllocSize(), (i < kSmallCount) ? kSmallCapacity : kMediumCapacity);
+    }
+    PacketBufferHandle overflow = PacketBufferHandle::New(0, 0);
+    ASSERT_FALSE(overflow.IsNull());
+    EXPECT_EQ(overflow->AllocSize(), PacketBuffer::kMaxSizeWithoutReserve);
+
+    // Released buffers go back to their own class.
+    buffers.clear();
+    PacketBufferHandle reused = PacketBufferHandle::New(0, 0);
+    ASSERT_FALSE(reused.IsNull());
+    EXPECT_LT(reused->AllocSize(), PacketBuffer::kMaxSizeWithoutReserve);
+}
+#endif // CHIP_SYSTEM_PACKETBUFFER_POOL_HAS_SIZE_CLASSES
+
 } // namespace System
 } // namespace chip
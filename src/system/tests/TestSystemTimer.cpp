@@ -26,14 +26,17 @@
 #include <errno.h>
 #include <stdint.h>
 #include <string.h>
+#include <vector>
 
 #include <pw_unit_test/framework.h>
 
 #include <lib/core/ErrorStr.h>
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/tests/ExtraPwTestMacros.h>
 #include <system/RAIIMockClock.h>
+#include <system/SystemClock.h>
 #include <system/SystemConfig.h>
 #include <system/SystemError.h>
 #include <system/SystemLayerImpl.h>
@@ -565,6 +568,183 @@ TEST_F(TestSystemTimer, CheckTimerPool)
     EXPECT_TRUE(SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumTimers, 4));
 }
 
+// Test TimerHeap, which must behave like TimerList.
+TEST_F(TestSystemTimer, CheckTimerHeap)
+{
+    using Timer = TimerHeap::Node;
+    struct TestState
+    {
+        static void A(Layer * layer, void * state) {}
+        static void B(Layer * layer, void * state) {}
+    };
+    TestState testState;
+
+    using namespace Clock::Literals;
+    struct
+    {
+        Clock::Timestamp awakenTime;
+        TimerCompleteCallback onComplete;
+        Timer * timer;
+    } testTimer[] = {
+        { 111_ms, TestState::A }, // 0
+        { 100_ms, TestState::A }, // 1
+        { 202_ms, TestState::B }, // 2
+        { 303_ms, TestState::A }, // 3
+        { 111_ms, TestState::B }, // 4
+    };
+
+    TimerPool<Timer> pool;
+    for (auto & timer : testTimer)
+    {
+        timer.timer = pool.Create(mLayer, timer.awakenTime, timer.onComplete, &testState);
+        ASSERT_NE(timer.timer, nullptr);
+    }
+
+    TimerHeap heap;
+    EXPECT_EQ(heap.Remove(nullptr), nullptr);
+    EXPECT_EQ(heap.Remove(nullptr, nullptr), nullptr);
+    EXPECT_EQ(heap.PopEarliest(), nullptr);
+    EXPECT_EQ(heap.PopIfEarlier(500_ms), nullptr);
+    EXPECT_EQ(heap.Earliest(), nullptr);
+    EXPECT_TRUE(heap.Empty());
+
+    Timer * earliest = heap.Add(testTimer[0].timer); // heap: () → (0) returns: 0
+    EXPECT_EQ(earliest, testTimer[0].timer);
+    EXPECT_EQ(heap.PopIfEarlier(10_ms), nullptr);
+    EXPECT_EQ(heap.Earliest(), testTimer[0].timer);
+    EXPECT_FALSE(heap.Empty());
+
+    earliest = heap.Add(testTimer[1].timer); // heap: (0) → (1 0) returns: 1
+    EXPECT_EQ(earliest, testTimer[1].timer);
+
+    earliest = heap.Add(testTimer[2].timer); // heap: (1 0) → (1 0 2) returns: 1
+    EXPECT_EQ(earliest, testTimer[1].timer);
+
+    earliest = heap.Add(testTimer[3].timer); // heap: (1 0 2) → (1 0 2 3) returns: 1
+    EXPECT_EQ(earliest, testTimer[1].timer);
+    EXPECT_EQ(heap.Earliest(), testTimer[1].timer);
+
+    earliest = heap.Remove(earliest); // heap: (1 0 2 3) → (0 2 3) returns: 0
+    EXPECT_EQ(earliest, testTimer[0].timer);
+
+    earliest = heap.Remove(earliest); // heap: (0 2 3) → (2 3) returns: 2
+    EXPECT_EQ(earliest, testTimer[2].timer);
+    EXPECT_EQ(heap.Remove(testTimer[0].timer), testTimer[2].timer); // not present
+
+    earliest = heap.Remove(TestState::B, &testState); // heap: (2 3) → (3) returns: 2
+    EXPECT_EQ(earliest, testTimer[2].timer);
+    EXPECT_EQ(heap.Earliest(), testTimer[3].timer);
+    EXPECT_EQ(heap.Remove(TestState::B, &testState), nullptr);
+
+    earliest = heap.PopIfEarlier(10_ms); // heap: (3) → (3) returns: nullptr
+    EXPECT_EQ(earliest, nullptr);
+
+    earliest = heap.PopIfEarlier(500_ms); // heap: (3) → () returns: 3
+    EXPECT_EQ(earliest, testTimer[3].timer);
+    EXPECT_TRUE(heap.Empty());
+
+    earliest = heap.Add(testTimer[3].timer); // heap: () → (3) returns: 3
+    heap.Clear();                            // heap: (3) → ()
+    EXPECT_EQ(earliest, testTimer[3].timer);
+    EXPECT_TRUE(heap.Empty());
+
+    // Timers that expire at the same time stay in the order they were added, and the earliest matching timer is the
+    // one removed or queried by callback and state.
+    for (auto & timer : testTimer)
+    {
+        heap.Add(timer.timer);
+    }
+    TimerList early = heap.ExtractEarlier(200_ms); // heap: (1 0 4 2 3) → (2 3) returns: (1 0 4)
+    EXPECT_EQ(early.PopEarliest(), testTimer[1].timer);
+    EXPECT_EQ(early.PopEarliest(), testTimer[0].timer);
+    EXPECT_EQ(early.PopEarliest(), testTimer[4].timer);
+    EXPECT_EQ(early.PopEarliest(), nullptr);
+    EXPECT_EQ(heap.Remove(TestState::B, &testState), testTimer[2].timer);
+    EXPECT_EQ(heap.PopEarliest(), testTimer[3].timer);
+    EXPECT_EQ(heap.PopEarliest(), nullptr);
+
+    heap.Add(testTimer[4].timer);
+    heap.Add(testTimer[2].timer);
+    EXPECT_EQ(heap.Remove(TestState::B, &testState), testTimer[4].timer);
+    EXPECT_EQ(heap.Remove(TestState::B, &testState), testTimer[2].timer);
+    EXPECT_TRUE(heap.Empty());
+
+    pool.ReleaseAll();
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+namespace {
+
+// Starts kTimerCount timers with shuffled expiration times, cancels every other one by callback and state, the way
+// Layer::CancelTimer does, and fires the rest the way LayerImplSelect::HandleExpiredTimers does.
+template <typename Queue>
+void BenchmarkTimerQueue(Layer & layer, const char * name)
+{
+    using Timer                  = typename Queue::Node;
+    constexpr size_t kTimerCount = 10000;
+
+    struct TestState
+    {
+        static void Fire(Layer * aLayer, void * state) { ++*static_cast<size_t *>(state); }
+    };
+    std::vector<size_t> fired(kTimerCount, 0);
+
+    TimerPool<Timer> pool;
+    Queue queue;
+
+    chip::Testing::BenchmarkTimer benchmarkTimer;
+    for (size_t i = 0; i < kTimerCount; i++)
+    {
+        Clock::Timestamp awakenTime = Clock::Milliseconds64((i * 7919) % kTimerCount);
+        Timer * timer               = pool.Create(layer, awakenTime, TestState::Fire, &fired[i]);
+        ASSERT_NE(timer, nullptr);
+        ASSERT_NE(queue.Add(timer), nullptr);
+    }
+    const Clock::Microseconds64 startElapsed = benchmarkTimer.Elapsed();
+
+    benchmarkTimer.Restart();
+    for (size_t i = 0; i < kTimerCount; i += 2)
+    {
+        Timer * timer = static_cast<Timer *>(queue.Remove(TestState::Fire, &fired[i]));
+        ASSERT_NE(timer, nullptr);
+        pool.Release(timer);
+    }
+    const Clock::Microseconds64 cancelElapsed = benchmarkTimer.Elapsed();
+
+    benchmarkTimer.Restart();
+    TimerList expired       = queue.ExtractEarlier(Clock::Milliseconds64(kTimerCount));
+    TimerList::Node * timer = nullptr;
+    while ((timer = expired.PopEarliest()) != nullptr)
+    {
+        pool.Invoke(static_cast<Timer *>(timer));
+    }
+    const Clock::Microseconds64 fireElapsed = benchmarkTimer.Elapsed();
+
+    EXPECT_TRUE(queue.Empty());
+    for (size_t i = 0; i < kTimerCount; i++)
+    {
+        EXPECT_EQ(fired[i], i % 2);
+    }
+
+    ChipLogProgress(Test, "%s: %u timers, %u ns per start, %u ns per cancel, %u ns per fire", name,
+                    static_cast<unsigned>(kTimerCount), static_cast<unsigned>(startElapsed.count() * 1000 / kTimerCount),
+                    static_cast<unsigned>(cancelElapsed.count() * 1000 / (kTimerCount / 2)),
+                    static_cast<unsigned>(fireElapsed.count() * 1000 / (kTimerCount / 2)));
+}
+
+} // namespace
+
+TEST_F(TestSystemTimer, BenchmarkTimerQueues)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    BenchmarkTimerQueue<TimerList>(mLayer, "TimerList");
+    BenchmarkTimerQueue<TimerHeap>(mLayer, "TimerHeap");
+}
+
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 TEST_F(TestSystemTimer, ExtendTimerToTest)
 {
     if (!LayerEvents<LayerImpl>::HasServiceEvents())
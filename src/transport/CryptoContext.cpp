@@ -55,6 +55,9 @@ CryptoContext::CryptoContext() : mKeyAvailable(false) {}
 
 CryptoContext::~CryptoContext()
 {
+    mEncryptionCipher.Release();
+    mDecryptionCipher.Release();
+
     if (mKeystore)
     {
         mKeystore->DestroyKey(mEncryptionKey);
@@ -86,6 +89,7 @@ CHIP_ERROR CryptoContext::InitFromSecret(SessionKeystore & keystore, const ByteS
     mKeyAvailable = true;
     mSessionRole  = role;
     mKeystore     = &keystore;
+    PrepareCiphers();
 
     return CHIP_NO_ERROR;
 }
@@ -111,10 +115,22 @@ CHIP_ERROR CryptoContext::InitFromSecret(Crypto::SessionKeystore & keystore, con
     mKeyAvailable = true;
     mSessionRole  = role;
     mKeystore     = &keystore;
+    PrepareCiphers();
 
     return CHIP_NO_ERROR;
 }
 
+void CryptoContext::PrepareCiphers()
+{
+    // The keys can still be used directly, so failing to prepare the ciphers only costs performance.
+    if (mEncryptionCipher.Init(mEncryptionKey) != CHIP_NO_ERROR || mDecryptionCipher.Init(mDecryptionKey) != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Failed to prepare session ciphers, falling back to one-shot AES-CCM");
+        mEncryptionCipher.Release();
+        mDecryptionCipher.Release();
+    }
+}
+
 CHIP_ERROR CryptoContext::InitFromKeyPair(SessionKeystore & keystore, const Crypto::P256Keypair & local_keypair,
                                           const Crypto::P256PublicKey & remote_public_key, const ByteSpan & salt,
                                           SessionInfoType infoType, SessionRole role)
@@ -219,8 +235,16 @@ CHIP_ERROR CryptoContext::Encrypt(const uint8_t * input, size_t input_length, ui
     else
     {
         VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
-        ReturnErrorOnFailure(
-            AES_CCM_encrypt(input, input_length, AAD, aadLen, mEncryptionKey, nonce.data(), nonce.size(), output, tag, taglen));
+        if (mEncryptionCipher.IsInitialized())
+        {
+            ReturnErrorOnFailure(
+                mEncryptionCipher.Encrypt(input, input_length, AAD, aadLen, nonce.data(), nonce.size(), output, tag, taglen));
+        }
+        else
+        {
+            ReturnErrorOnFailure(AES_CCM_encrypt(input, input_length, AAD, aadLen, mEncryptionKey, nonce.data(), nonce.size(),
+                                                 output, tag, taglen));
+        }
     }
 
     mac.SetTag(tag, taglen);
@@ -254,12 +278,37 @@ CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, ui
     else
     {
         VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
-        ReturnErrorOnFailure(
-            AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(), nonce.size(), output));
+        if (mDecryptionCipher.IsInitialized())
+        {
+            ReturnErrorOnFailure(
+                mDecryptionCipher.Decrypt(input, input_length, AAD, aadLen, tag, taglen, nonce.data(), nonce.size(), output));
+        }
+        else
+        {
+            ReturnErrorOnFailure(AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(),
+                                                 nonce.size(), output));
+        }
     }
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CryptoContext::DecryptConcurrently(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
+                                              const PacketHeader & header, const MessageAuthenticationCode & mac) const
+{
+    const size_t taglen = header.MICTagLength();
+    const uint8_t * tag = mac.GetTag();
+    uint8_t AAD[kMaxAADLen];
+    uint16_t aadLen = sizeof(AAD);
+
+    VerifyOrReturnError(input != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(input_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(output != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mKeyContext == nullptr && mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+    ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+    return AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(), nonce.size(), output);
+}
+
 CHIP_ERROR CryptoContext::PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                                          MessageAuthenticationCode & mac) const
 {
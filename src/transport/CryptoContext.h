@@ -146,6 +146,14 @@ public:
     CHIP_ERROR Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
                        const PacketHeader & header, const MessageAuthenticationCode & mac) const;
 
+    /**
+     * @brief
+     *   Same as Decrypt, but without the cipher kept prepared for the session keys, so that other threads can use it
+     *   alongside the thread the context belongs to. Only available for session keys.
+     */
+    CHIP_ERROR DecryptConcurrently(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
+                                   const PacketHeader & header, const MessageAuthenticationCode & mac) const;
+
     CHIP_ERROR PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                               MessageAuthenticationCode & mac) const;
 
@@ -161,11 +169,16 @@ public:
 private:
     CHIP_ERROR InitTestMode(Crypto::SessionKeystore & keystore, Crypto::Aes128KeyHandle & i2rKey, Crypto::Aes128KeyHandle & r2iKey);
 
+    void PrepareCiphers();
+
     SessionRole mSessionRole;
 
     bool mKeyAvailable;
     Crypto::Aes128KeyHandle mEncryptionKey;
     Crypto::Aes128KeyHandle mDecryptionKey;
+    // Ciphers kept prepared for the session keys, so messages do not have to set the keys up again.
+    Crypto::AesCcm128Cipher mEncryptionCipher;
+    Crypto::AesCcm128Cipher mDecryptionCipher;
     Crypto::AttestationChallenge mAttestationChallenge;
     Crypto::SessionKeystore * mKeystore       = nullptr;
     Crypto::SymmetricKeyContext * mKeyContext = nullptr;
@@ -25,6 +25,11 @@ struct MessageStats
 {
     uint32_t interactionModelMessagesReceived = 0;
     uint32_t interactionModelMessagesSent     = 0;
+    // Secure unicast messages whose payload was decrypted in the buffer it was received in, or had to be copied.
+    uint32_t secureMessagesDecryptedInPlace  = 0;
+    uint32_t secureMessagesDecryptedWithCopy = 0;
+    // Secure unicast messages that the receive workers of a transport had decrypted already.
+    uint32_t secureMessagesDecryptedOnWorker = 0;
 };
 
 } // namespace chip
@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <transport/ReceiveWorkerDecryptor.h>
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <transport/SecureSession.h>
+#include <transport/raw/MessageHeader.h>
+
+#include <mutex>
+
+namespace chip {
+namespace Transport {
+
+void ReceiveWorkerDecryptor::AddSession(const SecureSession & session)
+{
+    VerifyOrReturn(mCount < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE);
+
+    size_t index = HomeOf(session.GetLocalSessionId());
+    while (mEntries[index].mSession != nullptr)
+    {
+        index = (index + 1) & kMask;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mLock);
+
+    Entry & entry        = mEntries[index];
+    entry.mSession       = &session;
+    entry.mCryptoContext = &session.GetCryptoContext();
+    // PASE sessions use the undefined node ID in their nonces, see SessionManager::SecureUnicastMessageDispatch.
+    entry.mNonceNodeId = session.GetSecureSessionType() == SecureSession::Type::kCASE ? session.GetPeerNodeId() : kUndefinedNodeId;
+    entry.mLocalSessionId = session.GetLocalSessionId();
+    entry.mGeneration     = mNextGeneration;
+    mCount++;
+
+    // 0 is the result for messages that were not decrypted.
+    mNextGeneration = (mNextGeneration == UINT32_MAX) ? 1 : mNextGeneration + 1;
+}
+
+void ReceiveWorkerDecryptor::RemoveSession(const SecureSession & session)
+{
+    const size_t index = IndexOf(session);
+    VerifyOrReturn(index < kCapacity);
+
+    std::unique_lock<std::shared_mutex> lock(mLock);
+
+    // Shift later entries of the probe sequence back into the hole, unless their home slot lies after the hole.
+    size_t hole = index;
+    for (size_t next = (hole + 1) & kMask; mEntries[next].mSession != nullptr; next = (next + 1) & kMask)
+    {
+        if (((next - HomeOf(mEntries[next].mLocalSessionId)) & kMask) >= ((next - hole) & kMask))
+        {
+            mEntries[hole] = mEntries[next];
+            hole           = next;
+        }
+    }
+    mEntries[hole] = Entry();
+    mCount--;
+}
+
+void ReceiveWorkerDecryptor::RemoveAllSessions()
+{
+    std::unique_lock<std::shared_mutex> lock(mLock);
+    for (auto & entry : mEntries)
+    {
+        entry = Entry();
+    }
+    mCount = 0;
+}
+
+bool ReceiveWorkerDecryptor::DecryptedBy(const SecureSession & session, uint32_t workerResult) const
+{
+    const size_t index = IndexOf(session);
+    return index < kCapacity && mEntries[index].mGeneration == workerResult;
+}
+
+size_t ReceiveWorkerDecryptor::IndexOf(const SecureSession & session) const
+{
+    for (size_t i = HomeOf(session.GetLocalSessionId()); mEntries[i].mSession != nullptr; i = (i + 1) & kMask)
+    {
+        if (mEntries[i].mSession == &session)
+        {
+            return i;
+        }
+    }
+    return kCapacity;
+}
+
+uint32_t ReceiveWorkerDecryptor::PreprocessMessage(const PeerAddress & source, System::PacketBufferHandle & msg)
+{
+    // Messages are decrypted in place, so the whole of them has to be in a single buffer of ours.
+    VerifyOrReturnValue(!msg.IsNull() && !msg->HasChainedBuffer() && msg->HasInlinePayload(), 0);
+
+    PacketHeader packetHeader;
+    uint16_t headerSize = 0;
+    VerifyOrReturnValue(packetHeader.Decode(msg->Start(), msg->DataLength(), &headerSize) == CHIP_NO_ERROR, 0);
+    VerifyOrReturnValue(packetHeader.IsEncrypted() && !packetHeader.IsGroupSession() && !packetHeader.HasPrivacyFlag(), 0);
+
+    MessageAuthenticationCode mac;
+    uint8_t * data           = msg->Start() + headerSize;
+    size_t len               = msg->DataLength() - headerSize;
+    const uint16_t footerLen = packetHeader.MICTagLength();
+    uint16_t taglen          = 0;
+    VerifyOrReturnValue(footerLen < len, 0);
+    VerifyOrReturnValue(mac.Decode(packetHeader, &data[len - footerLen], footerLen, &taglen) == CHIP_NO_ERROR, 0);
+    VerifyOrReturnValue(taglen == footerLen, 0);
+    len -= taglen;
+
+    std::shared_lock<std::shared_mutex> lock(mLock);
+
+    const Entry * entry = nullptr;
+    for (size_t i = HomeOf(packetHeader.GetSessionId()); mEntries[i].mSession != nullptr; i = (i + 1) & kMask)
+    {
+        if (mEntries[i].mLocalSessionId == packetHeader.GetSessionId())
+        {
+            entry = &mEntries[i];
+            break;
+        }
+    }
+    VerifyOrReturnValue(entry != nullptr, 0);
+
+    CryptoContext::NonceStorage nonce;
+    CHIP_ERROR err = CryptoContext::BuildNonce(nonce, packetHeader.GetSecurityFlags(), packetHeader.GetMessageCounter(),
+                                               entry->mNonceNodeId);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = entry->mCryptoContext->DecryptConcurrently(data, len, data, nonce, packetHeader, mac);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Secure transport received message, but failed to decode/authenticate it, discarding");
+        msg = nullptr;
+        return 0;
+    }
+
+    msg->SetDataLength(headerSize + len);
+    return entry->mGeneration;
+}
+
+} // namespace Transport
+} // namespace chip
+
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
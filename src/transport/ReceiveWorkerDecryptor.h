@@ -0,0 +1,98 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <inet/InetConfig.h>
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/NodeId.h>
+#include <transport/CryptoContext.h>
+#include <transport/SecureSessionIndex.h>
+#include <transport/raw/Base.h>
+
+#include <shared_mutex>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Decrypts secure unicast messages on the receive workers of a transport, off the Matter thread.
+ *
+ * The Matter thread adds a session once it is active and removes it before it is released, under an exclusive lock,
+ * while the workers find sessions and decrypt with their keys under a shared lock, so the keys outlive every
+ * decryption that uses them. A worker decrypts a message in place, leaving the packet header in front of it and
+ * dropping the MIC, and returns the generation of the entry it used. The Matter thread then checks the generation
+ * with DecryptedBy(), so that a message is never taken for one of a later session with the same id, and does the
+ * rest, message counter included, as usual.
+ *
+ * Group messages, messages with privacy, and messages for sessions that were not added are left alone, with a
+ * result of 0. Messages that fail to authenticate are dropped, as the Matter thread would do.
+ *
+ * The entries are kept in an open-addressing table keyed by local session id, sized and probed like the one of
+ * SecureSessionIndex, so that finding the session of a message does not depend on the number of sessions.
+ */
+class ReceiveWorkerDecryptor : public ReceiveWorkerDelegate
+{
+public:
+    /**
+     * Add an active session. Sessions beyond CHIP_CONFIG_SECURE_SESSION_POOL_SIZE are left to the Matter thread.
+     */
+    void AddSession(const SecureSession & session);
+    void RemoveSession(const SecureSession & session);
+    void RemoveAllSessions();
+
+    /**
+     * Whether a message that a worker returned @p workerResult for was decrypted with the keys of @p session.
+     */
+    bool DecryptedBy(const SecureSession & session, uint32_t workerResult) const;
+
+    uint32_t PreprocessMessage(const PeerAddress & source, System::PacketBufferHandle & msg) override;
+
+private:
+    struct Entry
+    {
+        const SecureSession * mSession       = nullptr;
+        const CryptoContext * mCryptoContext = nullptr;
+        NodeId mNonceNodeId                  = kUndefinedNodeId;
+        uint32_t mGeneration                 = 0;
+        uint16_t mLocalSessionId             = 0;
+    };
+
+    static constexpr size_t kCapacity = SecureSessionIndex<CHIP_CONFIG_SECURE_SESSION_POOL_SIZE>::kCapacity;
+    static constexpr size_t kMask     = kCapacity - 1;
+
+    static size_t HomeOf(uint16_t localSessionId) { return localSessionId & kMask; }
+
+    // Index of the entry of the session, or kCapacity if it was not added.
+    size_t IndexOf(const SecureSession & session) const;
+
+    // Only the Matter thread changes the entries, so it reads them without the lock.
+    mutable std::shared_mutex mLock;
+    Entry mEntries[kCapacity];
+    size_t mCount            = 0;
+    uint32_t mNextGeneration = 1;
+};
+
+} // namespace Transport
+} // namespace chip
+
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
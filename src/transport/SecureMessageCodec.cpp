@@ -62,19 +62,21 @@ CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView
                    const PacketHeader & packetHeader, System::PacketBufferHandle & msg)
 {
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+    // The message is decrypted in place, so the whole of it has to be in a single buffer.
+    VerifyOrReturnError(!msg->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
     uint8_t * data = msg->Start();
     size_t len     = msg->DataLength();
 
     PacketBufferHandle origMsg;
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    /* This is a workaround for the case where PacketBuffer payload is not
-        allocated as an inline buffer to PacketBuffer structure */
-    origMsg = std::move(msg);
-    msg     = PacketBufferHandle::New(len);
-    VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
-    msg->SetDataLength(len);
-#endif
+    if (!msg->HasInlinePayload())
+    {
+        // The payload may live in memory that is not ours to write, so decrypt it into a new buffer instead.
+        origMsg = std::move(msg);
+        msg     = PacketBufferHandle::New(len);
+        VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
+        msg->SetDataLength(len);
+    }
 
     uint16_t footerLen = packetHeader.MICTagLength();
     VerifyOrReturnError(footerLen <= len, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
@@ -0,0 +1,218 @@
+/*
+ *
+ *    Copyright (c) 2026 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+#include <transport/SecureSession.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Open-addressing indexes over the sessions of a SecureSessionTable, by local session id and by peer.
+ *
+ * Both indexes use linear probing with backward-shift deletion, so lookups never need tombstones and stay O(1) on
+ * average as long as the load factor is kept at or below 50%. The peer index may hold several sessions for the same
+ * peer; they are all found in the probe sequence of that peer.
+ *
+ * The index does not own the sessions. The owner must Insert() a session once it is allocated, call UpdatePeer()
+ * whenever its peer changes, and Remove() it before it is released. If more than kMaxSessions sessions are inserted,
+ * the index becomes unusable until it is cleared, and the owner has to fall back to scanning its sessions.
+ */
+template <size_t kMaxSessions>
+class SecureSessionIndex
+{
+    static constexpr size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+public:
+    static constexpr size_t kCapacity = RoundUpToPowerOfTwo(2 * kMaxSessions);
+
+    bool IsUsable() const { return !mOverflow; }
+
+    size_t Count() const { return mCount; }
+
+    void Clear()
+    {
+        for (size_t i = 0; i < kCapacity; i++)
+        {
+            mByLocalSessionId[i] = LocalSessionIdSlot();
+            mByPeer[i]           = PeerSlot();
+        }
+        mCount    = 0;
+        mOverflow = false;
+    }
+
+    /**
+     * @retval CHIP_ERROR_NO_MEMORY if the index is full; it is then unusable until the next Clear().
+     */
+    CHIP_ERROR Insert(SecureSession & session)
+    {
+        VerifyOrReturnError(!mOverflow, CHIP_ERROR_INCORRECT_STATE);
+        if (mCount >= kMaxSessions)
+        {
+            mOverflow = true;
+            return CHIP_ERROR_NO_MEMORY;
+        }
+
+        InsertSlot(mByLocalSessionId, LocalSessionIdSlot{ &session, session.GetLocalSessionId() });
+        InsertSlot(mByPeer, PeerSlot{ &session, session.GetPeer() });
+        mCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void Remove(SecureSession & session)
+    {
+        VerifyOrReturn(!mOverflow);
+
+        if (EraseSlot(mByLocalSessionId, HomeOf(session.GetLocalSessionId()), &session))
+        {
+            VerifyOrDie(EraseSlot(mByPeer, HomeOf(session.GetPeer()), &session));
+            mCount--;
+        }
+    }
+
+    /**
+     * Move a session that used to be indexed under @p previousPeer to its current peer.
+     */
+    void UpdatePeer(SecureSession & session, const ScopedNodeId & previousPeer)
+    {
+        VerifyOrReturn(!mOverflow);
+
+        if (EraseSlot(mByPeer, HomeOf(previousPeer), &session))
+        {
+            InsertSlot(mByPeer, PeerSlot{ &session, session.GetPeer() });
+        }
+    }
+
+    SecureSession * FindByLocalSessionId(uint16_t localSessionId) const
+    {
+        VerifyOrDie(!mOverflow);
+
+        for (size_t i = HomeOf(localSessionId); mByLocalSessionId[i].mSession != nullptr; i = (i + 1) & kMask)
+        {
+            if (mByLocalSessionId[i].mLocalSessionId == localSessionId)
+            {
+                return mByLocalSessionId[i].mSession;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Invoke @p fn for every session whose peer is @p peer. @p fn returns Loop::Continue or Loop::Break, and must not
+     * release sessions or change their peer.
+     */
+    template <typename Function>
+    Loop ForEachWithPeer(const ScopedNodeId & peer, Function && fn) const
+    {
+        VerifyOrDie(!mOverflow);
+
+        for (size_t i = HomeOf(peer); mByPeer[i].mSession != nullptr; i = (i + 1) & kMask)
+        {
+            if (mByPeer[i].mPeer == peer)
+            {
+                VerifyOrReturnValue(fn(mByPeer[i].mSession) == Loop::Continue, Loop::Break);
+            }
+        }
+        return Loop::Finish;
+    }
+
+private:
+    static constexpr size_t kMask = kCapacity - 1;
+
+    struct LocalSessionIdSlot
+    {
+        SecureSession * mSession = nullptr;
+        uint16_t mLocalSessionId = 0;
+    };
+
+    struct PeerSlot
+    {
+        SecureSession * mSession = nullptr;
+        ScopedNodeId mPeer;
+    };
+
+    // Local session ids are handed out sequentially, so they spread evenly over the slots as they are.
+    static size_t HomeOf(uint16_t localSessionId) { return localSessionId & kMask; }
+
+    static size_t HomeOf(const ScopedNodeId & peer)
+    {
+        uint64_t hash = peer.GetNodeId() ^ (static_cast<uint64_t>(peer.GetFabricIndex()) << 56);
+        hash *= 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> 32) & kMask;
+    }
+
+    static size_t HomeOf(const LocalSessionIdSlot & slot) { return HomeOf(slot.mLocalSessionId); }
+    static size_t HomeOf(const PeerSlot & slot) { return HomeOf(slot.mPeer); }
+
+    template <typename Slot>
+    static void InsertSlot(Slot (&slots)[kCapacity], const Slot & slot)
+    {
+        size_t i = HomeOf(slot);
+        while (slots[i].mSession != nullptr)
+        {
+            i = (i + 1) & kMask;
+        }
+        slots[i] = slot;
+    }
+
+    template <typename Slot>
+    static bool EraseSlot(Slot (&slots)[kCapacity], size_t index, const SecureSession * session)
+    {
+        while (slots[index].mSession != session)
+        {
+            VerifyOrReturnValue(slots[index].mSession != nullptr, false);
+            index = (index + 1) & kMask;
+        }
+
+        // Shift later entries of the probe sequence back into the hole, unless their home slot lies after the hole.
+        size_t hole = index;
+        for (size_t next = (hole + 1) & kMask; slots[next].mSession != nullptr; next = (next + 1) & kMask)
+        {
+            if (((next - HomeOf(slots[next])) & kMask) >= ((next - hole) & kMask))
+            {
+                slots[hole] = slots[next];
+                hole        = next;
+            }
+        }
+        slots[hole] = Slot();
+        return true;
+    }
+
+    LocalSessionIdSlot mByLocalSessionId[kCapacity];
+    PeerSlot mByPeer[kCapacity];
+    size_t mCount  = 0;
+    bool mOverflow = false;
+};
+
+} // namespace Transport
+} // namespace chip
@@ -51,8 +51,8 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
         }
     }
 
-    SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
-                                                   peerSessionId, fabricIndex, config);
+    SecureSession * result = CreateSessionObject(secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs, peerSessionId,
+                                                 fabricIndex, config);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
@@ -72,7 +72,7 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     //
     if (mEntries.Allocated() < GetMaxSessionTableSize())
     {
-        allocated = mEntries.CreateObject(*this, secureSessionType, sessionId.Value());
+        allocated = CreateSessionObject(secureSessionType, sessionId.Value());
     }
     else
     {
@@ -215,7 +215,7 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         if (newCount < prevCount)
         {
             ChipLogProgress(SecureChannel, "Successfully evicted a session!");
-            auto * retSession = mEntries.CreateObject(*this, secureSessionType, localSessionId);
+            auto * retSession = CreateSessionObject(secureSessionType, localSessionId);
             VerifyOrDie(session != nullptr);
             return retSession;
         }
@@ -336,9 +336,46 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
     });
 }
 
+void SecureSessionTable::ReleaseSession(SecureSession * session)
+{
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    // Before the session, and its keys, go away.
+    mReceiveWorkerDecryptor.RemoveSession(*session);
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mIndex.Remove(*session);
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
+    mEntries.ReleaseObject(session);
+
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    if (!mIndex.IsUsable() && mEntries.Allocated() <= CHIP_CONFIG_SECURE_SESSION_POOL_SIZE)
+    {
+        RebuildIndex();
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+}
+
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+void SecureSessionTable::RebuildIndex()
+{
+    mIndex.Clear();
+    mEntries.ForEachActiveObject([this](SecureSession * session) {
+        return mIndex.Insert(*session) == CHIP_NO_ERROR ? Loop::Continue : Loop::Break;
+    });
+}
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
 {
     SecureSession * result = nullptr;
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    if (mIndex.IsUsable())
+    {
+        result = mIndex.FindByLocalSessionId(localSessionId);
+        return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
     mEntries.ForEachActiveObject([&](auto session) {
         if (session->GetLocalSessionId() == localSessionId)
         {
@@ -352,6 +389,21 @@ Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t
 
 Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
 {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    if (mIndex.IsUsable())
+    {
+        for (uint32_t i = 0; i <= kMaxSessionID; i++)
+        {
+            uint16_t candidate = static_cast<uint16_t>(mNextSessionId + i);
+            if (candidate != kUnsecuredSessionId && mIndex.FindByLocalSessionId(candidate) == nullptr)
+            {
+                return MakeOptional<uint16_t>(candidate);
+            }
+        }
+        return NullOptional;
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
     uint16_t candidate_base = 0;
     uint64_t candidate_mask = 0;
     for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
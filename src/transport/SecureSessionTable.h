@@ -21,7 +21,9 @@
 #include <lib/support/Pool.h>
 #include <lib/support/SortUtils.h>
 #include <system/TimeSource.h>
+#include <transport/ReceiveWorkerDecryptor.h>
 #include <transport/SecureSession.h>
+#include <transport/SecureSessionIndex.h>
 
 namespace chip {
 namespace Transport {
@@ -39,7 +41,16 @@ inline constexpr uint16_t kUnsecuredSessionId = 0;
 class SecureSessionTable
 {
 public:
-    ~SecureSessionTable() { mEntries.ReleaseAll(); }
+    ~SecureSessionTable()
+    {
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+        mReceiveWorkerDecryptor.RemoveAllSessions();
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+        mEntries.ReleaseAll();
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        mIndex.Clear();
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    }
 
     void Init() { mNextSessionId = chip::Crypto::GetRandU16(); }
 
@@ -76,7 +87,7 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session);
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -94,6 +105,51 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> FindSecureSessionByLocalKey(uint16_t localSessionId);
 
+    /**
+     * Iterate over the sessions whose peer is the given node. The function must not release sessions.
+     */
+    template <typename Function>
+    Loop ForEachSessionWithPeer(const ScopedNodeId & peer, Function && function)
+    {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        if (mIndex.IsUsable())
+        {
+            return mIndex.ForEachWithPeer(peer, std::forward<Function>(function));
+        }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        return mEntries.ForEachActiveObject([&peer, &function](SecureSession * session) {
+            return session->GetPeer() == peer ? function(session) : Loop::Continue;
+        });
+    }
+
+    /**
+     * Must be called by a session of this table whenever its peer changes, so that ForEachSessionWithPeer keeps
+     * finding it.
+     */
+    void OnSessionPeerChanged(SecureSession * session, const ScopedNodeId & previousPeer)
+    {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        mIndex.UpdatePeer(*session, previousPeer);
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    }
+
+    /**
+     * Must be called by a session of this table once it is active, with its keys and peer set.
+     */
+    void OnSessionActivated(SecureSession * session)
+    {
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+        mReceiveWorkerDecryptor.AddSession(*session);
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    }
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    /**
+     * Decrypts messages for the active sessions of this table on the receive workers of a UDP transport.
+     */
+    ReceiveWorkerDecryptor & GetReceiveWorkerDecryptor() { return mReceiveWorkerDecryptor; }
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
     // Select SessionHolders which are pointing to a session with the same peer as the given session. Shift them to the given
     // session.
     // This is an internal API, using raw pointer to a session is allowed here.
@@ -248,17 +304,46 @@ private:
      * from the starting mNextSessionId clue.
      *
      * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  When the
+     * session index is available, candidate IDs are checked against it directly instead.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    /**
+     * Allocate a session out of the pool and add it to the index.
+     */
+    template <typename... Args>
+    SecureSession * CreateSessionObject(Args &&... args)
+    {
+        SecureSession * session = mEntries.CreateObject(*this, std::forward<Args>(args)...);
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        if (session != nullptr && mIndex.IsUsable())
+        {
+            // On failure the index stays unusable, and lookups scan the pool, until the table shrinks again.
+            RETURN_SAFELY_IGNORED mIndex.Insert(*session);
+        }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        return session;
+    }
+
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    void RebuildIndex();
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
 
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    SecureSessionIndex<CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mIndex;
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    ReceiveWorkerDecryptor mReceiveWorkerDecryptor;
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
     size_t GetMaxSessionTableSize() const
     {
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
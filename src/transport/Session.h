@@ -25,6 +25,7 @@
 #include <lib/support/IntrusiveList.h>
 #include <lib/support/ReferenceCountedHandle.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
+#include <messaging/ReliableMessageRttEstimator.h>
 #include <messaging/SessionParameters.h>
 #include <platform/LockTracker.h>
 #include <transport/SessionDelegate.h>
@@ -283,6 +284,12 @@ public:
 
     FabricIndex GetFabricIndex() const { return mFabricIndex; }
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    // The round-trip time of the reliable messages sent on the session, as measured by the ReliableMessageMgr.
+    ReliableMessageRttEstimator & GetRttEstimator() { return mRttEstimator; }
+    const ReliableMessageRttEstimator & GetRttEstimator() const { return mRttEstimator; }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
     SecureSession * AsSecureSession();
     UnauthenticatedSession * AsUnauthenticatedSession();
     IncomingGroupSession * AsIncomingGroupSession();
@@ -345,6 +352,9 @@ protected:
 
 private:
     FabricIndex mFabricIndex = kUndefinedFabricIndex;
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    ReliableMessageRttEstimator mRttEstimator;
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     // The underlying TCP connection object over which the session is
     // established.
@@ -645,9 +645,8 @@ void SessionManager::ExpireAllSecureSessions()
 
 void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Optional<Transport::SecureSession::Type> & type)
 {
-    mSecureSessions.ForEachSession([&node, &type](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == node &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionWithPeer(node, [&type](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             session->MarkAsDefunct();
         }
@@ -657,10 +656,10 @@ void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Opti
 
 void SessionManager::UpdateAllSessionsPeerAddress(const ScopedNodeId & node, const Transport::PeerAddress & addr)
 {
-    mSecureSessions.ForEachSession([&node, &addr](auto session) {
+    mSecureSessions.ForEachSessionWithPeer(node, [&addr](auto session) {
         // Arguably we should only be updating active and defunct sessions, but there is no harm
         // in updating evicted sessions.
-        if (session->GetPeer() == node && Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
+        if (Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
         {
             session->SetPeerAddress(addr);
         }
@@ -692,6 +691,8 @@ CHIP_ERROR SessionManager::InjectPaseSessionWithTestKey(SessionHolder & sessionH
     ReturnErrorOnFailure(secureSession->GetCryptoContext().InitFromSecret(
         *mSessionKeystore, secret, ByteSpan(), CryptoContext::SessionInfoType::kSessionEstablishment, role));
     secureSession->GetSessionMessageCounter().GetPeerMessageCounter().SetCounter(Transport::PeerMessageCounter::kInitialSyncValue);
+    // Test sessions are created active, so let the table know once their keys are set.
+    mSecureSessions.OnSessionActivated(secureSession);
     sessionHolder.Grab(session.Value());
     return CHIP_NO_ERROR;
 }
@@ -713,6 +714,7 @@ CHIP_ERROR SessionManager::InjectCaseSessionWithTestKey(SessionHolder & sessionH
     ReturnErrorOnFailure(secureSession->GetCryptoContext().InitFromSecret(
         *mSessionKeystore, secret, ByteSpan(), CryptoContext::SessionInfoType::kSessionEstablishment, role));
     secureSession->GetSessionMessageCounter().GetPeerMessageCounter().SetCounter(Transport::PeerMessageCounter::kInitialSyncValue);
+    mSecureSessions.OnSessionActivated(secureSession);
     sessionHolder.Grab(session.Value());
     return CHIP_NO_ERROR;
 }
@@ -1023,18 +1025,48 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
         return;
     }
 
-    // Decrypt and verify the message before message counter verification or any further processing.
-    CryptoContext::NonceStorage nonce;
-    // PASE Sessions use the undefined node ID of all zeroes, since there is no node ID to use
-    // and the key is short-lived and always different for each PASE session.
-    CHIP_ERROR nonceResult = CryptoContext::BuildNonce(
-        nonce, packetHeader.GetSecurityFlags(), packetHeader.GetMessageCounter(),
-        secureSession->GetSecureSessionType() == SecureSession::Type::kCASE ? secureSession->GetPeerNodeId() : kUndefinedNodeId);
-    if ((nonceResult != CHIP_NO_ERROR) ||
-        SecureMessageCodec::Decrypt(secureSession->GetCryptoContext(), nonce, payloadHeader, packetHeader, msg) != CHIP_NO_ERROR)
-    {
-        ChipLogError(Inet, "Secure transport received message, but failed to decode/authenticate it, discarding");
-        return;
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    if (ctxt != nullptr && ctxt->workerResult != 0)
+    {
+        // A receive worker decrypted and verified the message already, with the keys of the session it was
+        // registered for, which may have been released and its id reused since.
+        if (!mSecureSessions.GetReceiveWorkerDecryptor().DecryptedBy(*secureSession, ctxt->workerResult) ||
+            payloadHeader.DecodeAndConsume(msg) != CHIP_NO_ERROR)
+        {
+            ChipLogError(Inet, "Secure transport received message decrypted for another session, discarding");
+            return;
+        }
+        mMessageStats.secureMessagesDecryptedOnWorker++;
+    }
+    else
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    {
+        // Decrypt and verify the message before message counter verification or any further processing.
+        CryptoContext::NonceStorage nonce;
+        // PASE Sessions use the undefined node ID of all zeroes, since there is no node ID to use
+        // and the key is short-lived and always different for each PASE session.
+        CHIP_ERROR nonceResult = CryptoContext::BuildNonce(nonce, packetHeader.GetSecurityFlags(), packetHeader.GetMessageCounter(),
+                                                           secureSession->GetSecureSessionType() == SecureSession::Type::kCASE
+                                                               ? secureSession->GetPeerNodeId()
+                                                               : kUndefinedNodeId);
+        const uint8_t * cipherText = msg->Start();
+        if ((nonceResult != CHIP_NO_ERROR) ||
+            SecureMessageCodec::Decrypt(secureSession->GetCryptoContext(), nonce, payloadHeader, packetHeader, msg) !=
+                CHIP_NO_ERROR)
+        {
+            ChipLogError(Inet, "Secure transport received message, but failed to decode/authenticate it, discarding");
+            return;
+        }
+
+        // When decrypted in place, the payload directly follows the consumed payload header in the received buffer.
+        if (msg->Start() == cipherText + payloadHeader.EncodeSizeBytes())
+        {
+            mMessageStats.secureMessagesDecryptedInPlace++;
+        }
+        else
+        {
+            mMessageStats.secureMessagesDecryptedWithCopy++;
+        }
     }
 
     err =
@@ -1094,13 +1126,22 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
 
 /**
  * Helper function to implement a single attempt to decrypt a groupcast message
- * using the given group key and privacy setting.
+ * using the given group key and privacy setting, without copying the message.
+ *
+ * The privacy header is deobfuscated in place, and obfuscated again if the key
+ * turns out not to match. The payload is decrypted in place when no other key
+ * will be tried after this one, and into @p scratch otherwise, so that the
+ * ciphertext stays available to the next attempts.
  *
  * @param[in] partialPacketHeader The partial packet header with non-obfuscated message fields (result of calling DecodeFixed).
  * @param[out] packetHeaderCopy A copy of the packet header, to be filled with privacy decrypted fields
  * @param[out] payloadHeader The payload header of the decrypted message
  * @param[in] applyPrivacy Whether to apply privacy deobfuscation
- * @param[out] msgCopy A copy of the message, to be filled with the decrypted message
+ * @param[in,out] msg The message, in a single buffer with an inline payload. On success, it holds the decrypted
+ *                    message, after the payload header.
+ * @param[in,out] scratch Buffer to decrypt into when the ciphertext has to be kept, allocated by the first attempt that
+ *                        needs it and reused by the next ones.
+ * @param[in] lastAttempt Whether no other key will be tried after this one
  * @param[in] mac The MAC of the message
  * @param[in] groupContext The group context to use for decryption key material
  *
@@ -1108,22 +1149,19 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
  * @return false if the message could not be decrypted
  */
 static bool GroupKeyDecryptAttempt(const PacketHeader & partialPacketHeader, PacketHeader & packetHeaderCopy,
-                                   PayloadHeader & payloadHeader, bool applyPrivacy, System::PacketBufferHandle & msgCopy,
-                                   const MessageAuthenticationCode & mac,
+                                   PayloadHeader & payloadHeader, bool applyPrivacy, System::PacketBufferHandle & msg,
+                                   System::PacketBufferHandle & scratch, bool lastAttempt, const MessageAuthenticationCode & mac,
                                    const Credentials::GroupDataProvider::GroupSession & groupContext)
 {
-    bool decrypted = false;
     CryptoContext context(groupContext.keyContext);
+    uint8_t * privacyHeader = partialPacketHeader.PrivacyHeader(msg->Start());
+    size_t privacyLength    = partialPacketHeader.PrivacyHeaderLength();
 
     if (applyPrivacy)
     {
-        // Perform privacy deobfuscation, if applicable.
-        uint8_t * privacyHeader = partialPacketHeader.PrivacyHeader(msgCopy->Start());
-        size_t privacyLength    = partialPacketHeader.PrivacyHeaderLength();
-
         // Bounds check: we decrypt in place a privacy header located inside the packet.
         // Validate that we are still within the packet as the length is based on header flags.
-        VerifyOrReturnValue((privacyHeader + privacyLength) <= (msgCopy->Start() + msgCopy->TotalLength()), false);
+        VerifyOrReturnValue((privacyHeader + privacyLength) <= (msg->Start() + msg->DataLength()), false);
 
         if (CHIP_NO_ERROR != context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac))
         {
@@ -1131,27 +1169,65 @@ static bool GroupKeyDecryptAttempt(const PacketHeader & partialPacketHeader, Pac
         }
     }
 
-    if (packetHeaderCopy.DecodeAndConsume(msgCopy) != CHIP_NO_ERROR)
+    // Privacy obfuscation is AES-CTR, so deobfuscating the header again puts it back as it was received.
+    auto rejectKey = [&]() {
+        if (applyPrivacy)
+        {
+            LogErrorOnFailure(context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac));
+        }
+        return false;
+    };
+
+    uint16_t headerSize = 0;
+    if (packetHeaderCopy.Decode(msg->Start(), msg->DataLength(), &headerSize) != CHIP_NO_ERROR)
     {
         ChipLogError(Inet, "Failed to decode Groupcast packet header. Discarding.");
-        return false;
+        return rejectKey();
     }
 
     // Optimization to reduce number of decryption attempts
     GroupId groupId = packetHeaderCopy.GetDestinationGroupId().Value();
     if (groupId != groupContext.group_id)
     {
-        return false;
+        return rejectKey();
     }
 
+    const uint16_t footerLen = packetHeaderCopy.MICTagLength();
+    VerifyOrReturnValue(static_cast<size_t>(headerSize) + footerLen <= msg->DataLength(), rejectKey());
+    const size_t len           = msg->DataLength() - headerSize - footerLen;
+    const uint8_t * cipherText = msg->Start() + headerSize;
+
     CryptoContext::NonceStorage nonce;
-    CHIP_ERROR nonceResult =
-        CryptoContext::BuildNonce(nonce, packetHeaderCopy.GetSecurityFlags(), packetHeaderCopy.GetMessageCounter(),
-                                  packetHeaderCopy.GetSourceNodeId().Value());
-    decrypted = (nonceResult == CHIP_NO_ERROR) &&
-        (CHIP_NO_ERROR == SecureMessageCodec::Decrypt(context, nonce, payloadHeader, packetHeaderCopy, msgCopy));
+    ReturnValueOnFailure(CryptoContext::BuildNonce(nonce, packetHeaderCopy.GetSecurityFlags(),
+                                                   packetHeaderCopy.GetMessageCounter(),
+                                                   packetHeaderCopy.GetSourceNodeId().Value()),
+                         rejectKey());
+
+    if (lastAttempt)
+    {
+        uint8_t * plainText = msg->Start() + headerSize;
+        VerifyOrReturnValue(context.Decrypt(cipherText, len, plainText, nonce, packetHeaderCopy, mac) == CHIP_NO_ERROR, false);
+        msg->ConsumeHead(headerSize);
+        msg->SetDataLength(len);
+        return payloadHeader.DecodeAndConsume(msg) == CHIP_NO_ERROR;
+    }
 
-    return decrypted;
+    // The headers are the same for all the keys, and so is the length of the payload.
+    if (scratch.IsNull())
+    {
+        scratch = System::PacketBufferHandle::New(len);
+        VerifyOrReturnValue(!scratch.IsNull(), rejectKey());
+    }
+    VerifyOrReturnValue(context.Decrypt(cipherText, len, scratch->Start(), nonce, packetHeaderCopy, mac) == CHIP_NO_ERROR,
+                        rejectKey());
+    scratch->SetDataLength(len);
+    if (payloadHeader.DecodeAndConsume(scratch) != CHIP_NO_ERROR)
+    {
+        scratch = nullptr;
+        return rejectKey();
+    }
+    msg = std::move(scratch);
+    return true;
 }
 
 void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPacketHeader,
@@ -1166,7 +1242,7 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
 
     PayloadHeader payloadHeader;
     PacketHeader packetHeaderCopy; /// Packet header decoded per group key, with privacy decrypted fields
-    System::PacketBufferHandle msgCopy;
+    System::PacketBufferHandle scratch;
     Credentials::GroupDataProvider * groups = Credentials::GetGroupDataProvider();
     VerifyOrReturn(nullptr != groups);
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -1209,6 +1285,19 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     // Groupcast Testing
     auto & testing = chip::Groupcast::GetTesting();
 
+    // The attempts decrypt the message in place, so it has to be in memory of ours.
+    if (!msg->HasInlinePayload())
+    {
+        msg = msg.CloneData();
+        if (msg.IsNull())
+        {
+            ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
+            return;
+        }
+    }
+
+    const size_t keyCount             = iter->Count();
+    size_t attempts                   = 0;
     bool decrypted                    = false;
     bool hasAnyKeysForFabricUnderTest = false;
     while (!decrypted && iter->Next(groupContext))
@@ -1217,17 +1306,16 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
         {
             hasAnyKeysForFabricUnderTest = true;
         }
-        CryptoContext context(groupContext.keyContext);
-        msgCopy = msg.CloneData();
-        if (msgCopy.IsNull())
+
+        bool privacy     = partialPacketHeader.HasPrivacyFlag();
+        bool lastAttempt = (++attempts >= keyCount);
+        decrypted = GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msg, scratch, lastAttempt,
+                                           mac, groupContext);
+        if (lastAttempt)
         {
-            ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
-            return;
+            // The last attempt decrypts in place, so the message cannot be tried again.
+            break;
         }
-
-        bool privacy = partialPacketHeader.HasPrivacyFlag();
-        decrypted =
-            GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msgCopy, mac, groupContext);
     }
     iter.Release();
 
@@ -1258,7 +1346,6 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
         ChipLogError(Inet, "Failed to decrypt group message. Discarding everything");
         return;
     }
-    msg = std::move(msgCopy);
 
     // MCSP check
     if (packetHeaderCopy.IsValidMCSPMsg())
@@ -1369,13 +1456,12 @@ Optional<SessionHandle> SessionManager::FindSecureSessionForNode(ScopedNodeId pe
     SecureSession * tcpSession = nullptr;
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
-    mSecureSessions.ForEachSession([&peerNodeId, &type, &mrpSession,
+    mSecureSessions.ForEachSessionWithPeer(peerNodeId, [&type, &mrpSession,
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &tcpSession,
+                                                        &tcpSession,
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &transportPayloadCapability](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == peerNodeId &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+                                                        &transportPayloadCapability](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             if (transportPayloadCapability == TransportPayloadCapability::kMRPOrTCPCompatiblePayload ||
                 transportPayloadCapability == TransportPayloadCapability::kLargePayload)
@@ -461,6 +461,14 @@ public:
     TransportMgrBase * GetTransportManager() const { return mTransportMgr; }
     Transport::SecureSessionTable & GetSecureSessions() { return mSecureSessions; }
 
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+    /**
+     * The delegate to give the receive workers of UDP transports (see UdpListenParameters::SetReceiveWorkers), so that
+     * they decrypt the messages of secure unicast sessions. It can be given before the SessionManager is initialized.
+     */
+    Transport::ReceiveWorkerDelegate * GetReceiveWorkerDelegate() { return &mSecureSessions.GetReceiveWorkerDecryptor(); }
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
     /**
      * @brief
      *   Handle received secure message. Implements TransportMgrDelegate
@@ -42,6 +42,27 @@ struct MessageTransportContext
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     ActiveTCPConnectionHandle conn;
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+    // What ReceiveWorkerDelegate::PreprocessMessage returned for the message, or 0 if it was not preprocessed.
+    uint32_t workerResult = 0;
+};
+
+/**
+ * Processing that the receive workers of a transport run on each message, on their own threads, before the
+ * message is handed to the transport's delegate on the Matter thread.
+ */
+class ReceiveWorkerDelegate
+{
+public:
+    virtual ~ReceiveWorkerDelegate() {}
+
+    /**
+     * Process a received message in place, or release it to drop it.
+     *
+     * Implementations must be safe to call from several threads at once, and alongside the Matter thread.
+     *
+     * @return a value for the delegate of the transport, passed in MessageTransportContext::workerResult.
+     */
+    virtual uint32_t PreprocessMessage(const PeerAddress & source, System::PacketBufferHandle & msg) = 0;
 };
 
 class RawTransportDelegate
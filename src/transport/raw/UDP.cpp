@@ -48,6 +48,28 @@ CHIP_ERROR UDP::Init(UdpListenParameters & params)
 
     mUDPEndPoint->SetNativeParams(params.GetNativeParams());
 
+    if (params.GetBatchedIO())
+    {
+        // Batching is only an optimization, so carry on without it where the endpoint does not support it.
+        CHIP_ERROR batchErr = mUDPEndPoint->SetBatchedIO(true);
+        if (batchErr != CHIP_NO_ERROR)
+        {
+            ChipLogProgress(Inet, "UDP batched I/O not enabled: %" CHIP_ERROR_FORMAT, batchErr.Format());
+        }
+    }
+
+    if (params.GetReceiveWorkers() > 0 && params.GetReceiveWorkerDelegate() != nullptr)
+    {
+        // Like batching, receive workers are only an optimization.
+        mReceiveWorkerDelegate = params.GetReceiveWorkerDelegate();
+        CHIP_ERROR workersErr =
+            mUDPEndPoint->SetReceiveWorkers(params.GetReceiveWorkers(), OnUdpReceiveOnWorker, OnUdpWorkerReceive);
+        if (workersErr != CHIP_NO_ERROR)
+        {
+            ChipLogProgress(Inet, "UDP receive workers not enabled: %" CHIP_ERROR_FORMAT, workersErr.Format());
+        }
+    }
+
     ChipLogDetail(Inet, "UDP::Init bind&listen port=%d", params.GetListenPort());
 
     err = mUDPEndPoint->Bind(params.GetAddressType(), Inet::IPAddress::Any, params.GetListenPort(), params.GetInterfaceId());
@@ -105,7 +127,12 @@ CHIP_ERROR UDP::SendMessage(const Transport::PeerAddress & address, System::Pack
 
 void UDP::OnUdpReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer, const Inet::IPPacketInfo * pktInfo)
 {
-    CHIP_ERROR err          = CHIP_NO_ERROR;
+    HandleUdpMessage(endPoint, std::move(buffer), pktInfo, nullptr);
+}
+
+void UDP::HandleUdpMessage(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer, const Inet::IPPacketInfo * pktInfo,
+                           MessageTransportContext * ctxt)
+{
     UDP * udp               = reinterpret_cast<UDP *>(endPoint->mAppState);
     PeerAddress peerAddress = PeerAddress::UDP(pktInfo->SrcAddress, pktInfo->SrcPort, pktInfo->Interface);
 
@@ -119,12 +146,24 @@ void UDP::OnUdpReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle
 
     CHIP_FAULT_INJECT(FaultInjection::kFault_DropIncomingUDPMsg, buffer = nullptr; return;);
 
-    udp->HandleMessageReceived(peerAddress, std::move(buffer));
+    udp->HandleMessageReceived(peerAddress, std::move(buffer), ctxt);
+}
+
+uint32_t UDP::OnUdpReceiveOnWorker(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle & buffer,
+                                   const Inet::IPPacketInfo * pktInfo)
+{
+    UDP * udp               = reinterpret_cast<UDP *>(endPoint->mAppState);
+    PeerAddress peerAddress = PeerAddress::UDP(pktInfo->SrcAddress, pktInfo->SrcPort, pktInfo->Interface);
 
-    if (err != CHIP_NO_ERROR)
-    {
-        ChipLogError(Inet, "Failed to receive UDP message: %" CHIP_ERROR_FORMAT, err.Format());
-    }
+    return udp->mReceiveWorkerDelegate->PreprocessMessage(peerAddress, buffer);
+}
+
+void UDP::OnUdpWorkerReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer, const Inet::IPPacketInfo * pktInfo,
+                             uint32_t workerResult)
+{
+    MessageTransportContext context;
+    context.workerResult = workerResult;
+    HandleUdpMessage(endPoint, std::move(buffer), pktInfo, &context);
 }
 
 void UDP::OnUdpError(Inet::UDPEndPoint * endPoint, CHIP_ERROR err, const Inet::IPPacketInfo * pktInfo)
@@ -86,12 +86,40 @@ public:
         return *this;
     }
 
+    /**
+     * Batch the datagrams received or sent in one event into as few system calls as possible (optional)
+     */
+    bool GetBatchedIO() const { return mBatchedIO; }
+    UdpListenParameters & SetBatchedIO(bool enable)
+    {
+        mBatchedIO = enable;
+
+        return *this;
+    }
+
+    /**
+     * Receive messages on worker threads, which run the given delegate on each of them before they are handed to
+     * the Matter thread (optional)
+     */
+    uint8_t GetReceiveWorkers() const { return mReceiveWorkers; }
+    ReceiveWorkerDelegate * GetReceiveWorkerDelegate() const { return mReceiveWorkerDelegate; }
+    UdpListenParameters & SetReceiveWorkers(uint8_t count, ReceiveWorkerDelegate * delegate)
+    {
+        mReceiveWorkers        = count;
+        mReceiveWorkerDelegate = delegate;
+
+        return *this;
+    }
+
 private:
     Inet::EndPointManager<Inet::UDPEndPoint> * mEndPointManager;   ///< Associated endpoint factory
     Inet::IPAddressType mAddressType = Inet::IPAddressType::kIPv6; ///< type of listening socket
     uint16_t mListenPort             = CHIP_PORT;                  ///< UDP listen port
     Inet::InterfaceId mInterfaceId   = Inet::InterfaceId::Null();  ///< Interface to listen on
     void * mNativeParams             = nullptr;
+    bool mBatchedIO                  = false;                      ///< See UDPEndPoint::SetBatchedIO
+    uint8_t mReceiveWorkers          = 0;                          ///< See UDPEndPoint::SetReceiveWorkers
+    ReceiveWorkerDelegate * mReceiveWorkerDelegate = nullptr;
 };
 
 /** Implements a transport using UDP. */
@@ -149,9 +177,19 @@ private:
 
     static void OnUdpError(Inet::UDPEndPoint * endPoint, CHIP_ERROR err, const Inet::IPPacketInfo * pktInfo);
 
+    static void HandleUdpMessage(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer,
+                                 const Inet::IPPacketInfo * pktInfo, MessageTransportContext * ctxt);
+
+    // Handlers for the messages received by the receive workers, on the workers and then on the Matter thread.
+    static uint32_t OnUdpReceiveOnWorker(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle & buffer,
+                                         const Inet::IPPacketInfo * pktInfo);
+    static void OnUdpWorkerReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer,
+                                   const Inet::IPPacketInfo * pktInfo, uint32_t workerResult);
+
     Inet::UDPEndPointHandle mUDPEndPoint;                                 ///< UDP socket used by the transport
     Inet::IPAddressType mUDPEndpointType = Inet::IPAddressType::kUnknown; ///< Socket listening type
     State mState                         = State::kNotReady;              ///< State of the UDP transport
+    ReceiveWorkerDelegate * mReceiveWorkerDelegate = nullptr;             ///< Run by the receive workers, if any
 };
 
 } // namespace Transport
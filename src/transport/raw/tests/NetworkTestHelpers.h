@@ -16,7 +16,9 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 
 #include <inet/TCPEndPoint.h>
 #include <inet/UDPEndPoint.h>
@@ -28,6 +30,8 @@
 #include <transport/raw/PeerAddress.h>
 
 #include <nlbyteorder.h>
+#include <list>
+#include <map>
 #include <queue>
 
 namespace chip {
@@ -99,12 +103,13 @@ public:
         // Make sure no one left packets hanging out that they thought got
         // delivered but actually didn't.
         VerifyOrDie(mPendingMessageQueue.empty());
+        VerifyOrDie(mDelayedMessages.empty());
     }
 
     /// Transports are required to have a constructor that takes exactly one argument
     CHIP_ERROR Init(const char *) { return CHIP_NO_ERROR; }
 
-    bool HasPendingMessages() { return !mPendingMessageQueue.empty(); }
+    bool HasPendingMessages() { return !mPendingMessageQueue.empty() || !mDelayedMessages.empty(); }
 
     void SetLoopbackTransportDelegate(LoopbackTransportDelegate * delegate) { mDelegate = delegate; }
 
@@ -120,6 +125,36 @@ public:
         }
     }
 
+    static void OnDelayedMessageTimeout(System::Layer * aSystemLayer, void * aAppState)
+    {
+        LoopbackTransport * _this = static_cast<LoopbackTransport *>(aAppState);
+
+        // Messages sent in response to these ones have delivery times past now, so they are left to a later timeout.
+        System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+        while (!_this->mDelayedMessages.empty() && _this->mDelayedMessages.front().mDeliveryTime <= now)
+        {
+            auto item = std::move(_this->mDelayedMessages.front());
+            _this->mDelayedMessages.pop_front();
+            _this->HandleMessageReceived(LoopbackPeer(item.mDestinationAddress), std::move(item.mPendingMessage));
+        }
+        _this->StartDelayedMessageTimer();
+    }
+
+    /**
+     * Delay the delivery of the messages sent to @p destination by @p latency, independently of the messages sent
+     * the other way.  Latencies set this way take precedence over mMessageLatency.
+     */
+    void SetMessageLatency(const Transport::PeerAddress & destination, System::Clock::Timeout latency)
+    {
+        mMessageLatencies[destination.GetPort()] = latency;
+    }
+
+    System::Clock::Timeout GetMessageLatency(const Transport::PeerAddress & destination) const
+    {
+        auto it = mMessageLatencies.find(destination.GetPort());
+        return it != mMessageLatencies.end() ? it->second : mMessageLatency;
+    }
+
     static constexpr uint32_t kUnlimitedMessageCount = std::numeric_limits<uint32_t>::max();
 
     CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override
@@ -162,6 +197,20 @@ public:
         }
 
         System::PacketBufferHandle receivedMessage = msgBuf.CloneData();
+        System::Clock::Timeout latency             = GetMessageLatency(address);
+        if (latency > System::Clock::kZero)
+        {
+            // Each message is delivered once its own latency has elapsed, whatever else is in flight.
+            PendingMessageItem item(address, std::move(receivedMessage));
+            item.mDeliveryTime = System::SystemClock().GetMonotonicTimestamp() + latency;
+            auto it            = mDelayedMessages.end();
+            while (it != mDelayedMessages.begin() && std::prev(it)->mDeliveryTime > item.mDeliveryTime)
+            {
+                --it;
+            }
+            mDelayedMessages.insert(it, std::move(item));
+            return StartDelayedMessageTimer();
+        }
         mPendingMessageQueue.push(PendingMessageItem(address, std::move(receivedMessage)));
         return mSystemLayer->ScheduleWork(OnMessageReceived, this);
     }
@@ -170,6 +219,12 @@ public:
 
     void Reset()
     {
+        if (mSystemLayer != nullptr)
+        {
+            mSystemLayer->CancelTimer(OnDelayedMessageTimeout, this);
+        }
+        mDelayedMessages.clear();
+        mMessageLatencies.clear();
         mPendingMessageQueue              = std::queue<PendingMessageItem>();
         mNumMessagesToDrop                = 0;
         mDroppedMessageCount              = 0;
@@ -177,6 +232,7 @@ public:
         mNumMessagesToAllowBeforeDropping = 0;
         mNumMessagesToAllowBeforeError    = 0;
         mMessageSendError                 = CHIP_NO_ERROR;
+        mMessageLatency                   = System::Clock::kZero;
     }
 
     struct PendingMessageItem
@@ -187,16 +243,29 @@ public:
 
         const Transport::PeerAddress mDestinationAddress;
         System::PacketBufferHandle mPendingMessage;
+        System::Clock::Timestamp mDeliveryTime = System::Clock::kZero;
     };
 
+    CHIP_ERROR StartDelayedMessageTimer()
+    {
+        VerifyOrReturnError(!mDelayedMessages.empty(), CHIP_NO_ERROR);
+        System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+        System::Clock::Timestamp due = std::max(mDelayedMessages.front().mDeliveryTime, now);
+        return mSystemLayer->StartTimer(std::chrono::duration_cast<System::Clock::Timeout>(due - now), OnDelayedMessageTimeout,
+                                        this);
+    }
+
     System::Layer * mSystemLayer = nullptr;
     std::queue<PendingMessageItem> mPendingMessageQueue;
+    std::list<PendingMessageItem> mDelayedMessages;
+    std::map<uint16_t, System::Clock::Timeout> mMessageLatencies;
     uint32_t mNumMessagesToDrop                = 0;
     uint32_t mDroppedMessageCount              = 0;
     uint32_t mSentMessageCount                 = 0;
     uint32_t mNumMessagesToAllowBeforeDropping = 0;
     uint32_t mNumMessagesToAllowBeforeError    = 0;
     CHIP_ERROR mMessageSendError               = CHIP_NO_ERROR;
+    System::Clock::Timeout mMessageLatency     = System::Clock::kZero;
     LoopbackTransportDelegate * mDelegate      = nullptr;
 };
 
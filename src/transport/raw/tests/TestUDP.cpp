@@ -23,6 +23,7 @@
 
 #include "NetworkTestHelpers.h"
 
+#include <atomic>
 #include <errno.h>
 
 #include <pw_unit_test/framework.h>
@@ -44,8 +45,9 @@ constexpr NodeId kSourceNodeId      = 123654;
 constexpr NodeId kDestinationNodeId = 111222333;
 constexpr uint32_t kMessageCounter  = 18;
 
-const char PAYLOAD[]        = "Hello!";
-int ReceiveHandlerCallCount = 0;
+const char PAYLOAD[]          = "Hello!";
+int ReceiveHandlerCallCount   = 0;
+uint32_t ExpectedWorkerResult = 0;
 
 class MockTransportMgrDelegate : public TransportMgrDelegate
 {
@@ -68,10 +70,27 @@ public:
         size_t data_len = msgBuf->DataLength();
         EXPECT_EQ(0, memcmp(msgBuf->Start(), PAYLOAD, data_len));
 
+        EXPECT_EQ((transCtxt != nullptr) ? transCtxt->workerResult : 0u, ExpectedWorkerResult);
+
         ReceiveHandlerCallCount++;
     }
 };
 
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+class MockReceiveWorkerDelegate : public Transport::ReceiveWorkerDelegate
+{
+public:
+    uint32_t PreprocessMessage(const Transport::PeerAddress & source, System::PacketBufferHandle & msg) override
+    {
+        EXPECT_FALSE(msg.IsNull());
+        mCallCount++;
+        return ExpectedWorkerResult;
+    }
+
+    std::atomic<int> mCallCount{ 0 };
+};
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
 } // namespace
 
 class TestUDP : public ::testing::Test
@@ -112,19 +131,20 @@ protected:
         EXPECT_EQ(err, CHIP_NO_ERROR);
     }
 
-    void CheckMessageTest(const IPAddress & addr)
+    void CheckMessageTest(const IPAddress & addr, bool batchedIO = false, int messageCount = 1, uint8_t receiveWorkers = 0,
+                          Transport::ReceiveWorkerDelegate * receiveWorkerDelegate = nullptr)
     {
         uint16_t payload_len = sizeof(PAYLOAD);
 
-        chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, payload_len);
-        EXPECT_FALSE(buffer.IsNull());
-
         CHIP_ERROR err = CHIP_NO_ERROR;
 
         Transport::UDP udp;
 
-        err = udp.Init(
-            Transport::UdpListenParameters(mIOContext->GetUDPEndPointManager()).SetAddressType(addr.Type()).SetListenPort(0));
+        err = udp.Init(Transport::UdpListenParameters(mIOContext->GetUDPEndPointManager())
+                           .SetAddressType(addr.Type())
+                           .SetListenPort(0)
+                           .SetBatchedIO(batchedIO)
+                           .SetReceiveWorkers(receiveWorkers, receiveWorkerDelegate));
         EXPECT_EQ(err, CHIP_NO_ERROR);
 
         MockTransportMgrDelegate gMockTransportMgrDelegate;
@@ -137,16 +157,23 @@ protected:
         PacketHeader header;
         header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
 
-        err = header.EncodeBeforeData(buffer);
-        EXPECT_EQ(err, CHIP_NO_ERROR);
+        for (int i = 0; i < messageCount; i++)
+        {
+            chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, payload_len);
+            EXPECT_FALSE(buffer.IsNull());
 
-        // Should be able to send a message to itself by just calling send.
-        err = udp.SendMessage(Transport::PeerAddress::UDP(addr, udp.GetBoundPort()), std::move(buffer));
-        EXPECT_EQ(err, CHIP_NO_ERROR);
+            err = header.EncodeBeforeData(buffer);
+            EXPECT_EQ(err, CHIP_NO_ERROR);
 
-        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(1), []() { return ReceiveHandlerCallCount != 0; });
+            // Should be able to send a message to itself by just calling send.
+            err = udp.SendMessage(Transport::PeerAddress::UDP(addr, udp.GetBoundPort()), std::move(buffer));
+            EXPECT_EQ(err, CHIP_NO_ERROR);
+        }
+
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(1),
+                                 [messageCount]() { return ReceiveHandlerCallCount >= messageCount; });
 
-        EXPECT_EQ(ReceiveHandlerCallCount, 1);
+        EXPECT_EQ(ReceiveHandlerCallCount, messageCount);
     }
 };
 
@@ -164,6 +191,13 @@ TEST_F(TestUDP, CheckMessageTest4)
     IPAddress::FromString("127.0.0.1", addr);
     CheckMessageTest(addr);
 }
+
+TEST_F(TestUDP, CheckBatchedMessageTest4)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckMessageTest(addr, /* batchedIO = */ true, /* messageCount = */ 20);
+}
 #endif
 
 TEST_F(TestUDP, CheckSimpleInitTest6)
@@ -177,3 +211,25 @@ TEST_F(TestUDP, CheckMessageTest6)
     IPAddress::FromString("::1", addr);
     CheckMessageTest(addr);
 }
+
+TEST_F(TestUDP, CheckBatchedMessageTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckMessageTest(addr, /* batchedIO = */ true, /* messageCount = */ 20);
+}
+
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+TEST_F(TestUDP, CheckReceiveWorkerMessageTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockReceiveWorkerDelegate delegate;
+    ExpectedWorkerResult = 42;
+    CheckMessageTest(addr, /* batchedIO = */ false, /* messageCount = */ 20, /* receiveWorkers = */ 4, &delegate);
+    ExpectedWorkerResult = 0;
+
+    EXPECT_EQ(delegate.mCallCount.load(), 20);
+}
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
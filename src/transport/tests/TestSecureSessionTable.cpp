@@ -22,6 +22,7 @@
  */
 
 #include <errno.h>
+#include <memory>
 #include <vector>
 
 #include <pw_unit_test/framework.h>
@@ -29,7 +30,9 @@
 #include <lib/core/CHIPCore.h>
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
 #include <system/SystemClock.h>
+#include <transport/SecureSessionIndex.h>
 #include <transport/SecureSessionTable.h>
 #include <transport/SessionHolder.h>
 
@@ -43,6 +46,7 @@ public:
     static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
 
     void ValidateSessionSorting();
+    void ValidateSessionIndex();
 
 private:
     struct SessionParameters
@@ -461,5 +465,183 @@ TEST_F(TestSecureSessionTable, ValidateSessionSorting)
     ValidateSessionSorting();
 }
 
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
+namespace {
+
+const ReliableMessageProtocolConfig kTestMRPConfig(System::Clock::Milliseconds32(0), System::Clock::Milliseconds32(0),
+                                                   System::Clock::Milliseconds16(0));
+
+size_t CountSessionsWithPeer(SecureSessionTable & table, const ScopedNodeId & peer)
+{
+    size_t count = 0;
+    table.ForEachSessionWithPeer(peer, [&count](auto *) {
+        count++;
+        return Loop::Continue;
+    });
+    return count;
+}
+
+} // namespace
+
+void TestSecureSessionTable::ValidateSessionIndex()
+{
+    SecureSessionTable table;
+    table.Init();
+    EXPECT_TRUE(table.mIndex.IsUsable());
+
+    // Local session ids chosen so that several of them share a home slot in the index.
+    const uint16_t kLocalSessionIds[] = { 1, 2, 3, 1 + SecureSessionIndex<CHIP_CONFIG_SECURE_SESSION_POOL_SIZE>::kCapacity };
+    for (uint16_t localSessionId : kLocalSessionIds)
+    {
+        auto session = table.CreateNewSecureSessionForTest(SecureSession::Type::kCASE, localSessionId, 1, 2, CATValues(),
+                                                           localSessionId, kFabric1, kTestMRPConfig);
+        ASSERT_TRUE(session.HasValue());
+    }
+    EXPECT_EQ(table.mIndex.Count(), MATTER_ARRAY_SIZE(kLocalSessionIds));
+
+    for (uint16_t localSessionId : kLocalSessionIds)
+    {
+        auto session = table.FindSecureSessionByLocalKey(localSessionId);
+        ASSERT_TRUE(session.HasValue());
+        EXPECT_EQ(session.Value()->AsSecureSession()->GetLocalSessionId(), localSessionId);
+    }
+    EXPECT_FALSE(table.FindSecureSessionByLocalKey(4).HasValue());
+    EXPECT_EQ(CountSessionsWithPeer(table, ScopedNodeId(2, kFabric1)), MATTER_ARRAY_SIZE(kLocalSessionIds));
+    EXPECT_EQ(CountSessionsWithPeer(table, ScopedNodeId(2, kFabric2)), 0u);
+
+    // Releasing a session that others probed past must keep them reachable.
+    table.FindSecureSessionByLocalKey(1).Value()->AsSecureSession()->MarkForEviction();
+    EXPECT_FALSE(table.FindSecureSessionByLocalKey(1).HasValue());
+    EXPECT_TRUE(table.FindSecureSessionByLocalKey(kLocalSessionIds[3]).HasValue());
+    EXPECT_EQ(CountSessionsWithPeer(table, ScopedNodeId(2, kFabric1)), MATTER_ARRAY_SIZE(kLocalSessionIds) - 1);
+
+    // A newly allocated session is indexed under its local session id right away, and under its peer once activated.
+    auto session = table.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+    ASSERT_TRUE(session.HasValue());
+    SecureSession * secureSession = session.Value()->AsSecureSession();
+    EXPECT_EQ(table.FindSecureSessionByLocalKey(secureSession->GetLocalSessionId()).Value()->AsSecureSession(), secureSession);
+
+    secureSession->Activate(ScopedNodeId(1, kFabric2), ScopedNodeId(3, kFabric2), CATValues(), 10, kTestMRPConfig);
+    EXPECT_EQ(CountSessionsWithPeer(table, ScopedNodeId(3, kFabric2)), 1u);
+    EXPECT_EQ(CountSessionsWithPeer(table, ScopedNodeId()), 0u);
+
+    // Session ids handed out must not collide with the ones in use.
+    for (size_t i = 0; i < 8; i++)
+    {
+        auto id = table.FindUnusedSessionId();
+        ASSERT_TRUE(id.HasValue());
+        EXPECT_NE(id.Value(), 0);
+        EXPECT_FALSE(table.FindSecureSessionByLocalKey(id.Value()).HasValue());
+    }
+}
+
+TEST_F(TestSecureSessionTable, ValidateSessionIndex)
+{
+    ValidateSessionIndex();
+}
+
+TEST_F(TestSecureSessionTable, PaseSessionAdoptsFabricIndex)
+{
+    SecureSessionTable table;
+    table.Init();
+
+    const ScopedNodeId unassociatedPeer(kUndefinedNodeId, kUndefinedFabricIndex);
+    const ScopedNodeId commissionedPeer(kUndefinedNodeId, 1);
+    {
+        auto session = table.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+        ASSERT_TRUE(session.HasValue());
+        SecureSession * secureSession = session.Value()->AsSecureSession();
+        secureSession->Activate(unassociatedPeer, unassociatedPeer, CATValues(), 1, kTestMRPConfig);
+        EXPECT_EQ(CountSessionsWithPeer(table, unassociatedPeer), 1u);
+
+        // AddNOC moves the PASE session to the new fabric, and lookups by peer follow it.
+        EXPECT_EQ(secureSession->AdoptFabricIndex(1), CHIP_NO_ERROR);
+        EXPECT_EQ(CountSessionsWithPeer(table, unassociatedPeer), 0u);
+        EXPECT_EQ(CountSessionsWithPeer(table, commissionedPeer), 1u);
+
+        secureSession->MarkForEviction();
+    }
+
+    // The session is released once the last handle goes away, and must leave the index clean.
+    EXPECT_EQ(CountSessionsWithPeer(table, commissionedPeer), 0u);
+    size_t sessionCount = 0;
+    table.ForEachSession([&](auto * session) {
+        sessionCount++;
+        return Loop::Continue;
+    });
+    EXPECT_EQ(sessionCount, 0u);
+}
+
+namespace {
+
+template <size_t kSessionCount>
+void BenchmarkLocalSessionIdLookup()
+{
+    SecureSessionTable table;
+    table.Init();
+
+    // The table's own index is sized for CHIP_CONFIG_SECURE_SESSION_POOL_SIZE, so measure a separate index of the
+    // requested size over the same sessions against the linear scan the table does without one.
+    auto index = std::make_unique<SecureSessionIndex<kSessionCount>>();
+    index->Clear();
+
+    for (size_t i = 0; i < kSessionCount; i++)
+    {
+        const uint16_t localSessionId = static_cast<uint16_t>(i + 1);
+        auto session = table.CreateNewSecureSessionForTest(SecureSession::Type::kCASE, localSessionId, 1, 2 + i, CATValues(),
+                                                           localSessionId, 1, kTestMRPConfig);
+        if (!session.HasValue())
+        {
+            ChipLogProgress(SecureChannel, "Session pool cannot hold %u sessions, skipping", static_cast<unsigned>(kSessionCount));
+            return;
+        }
+        ASSERT_EQ(index->Insert(*session.Value()->AsSecureSession()), CHIP_NO_ERROR);
+    }
+
+    constexpr size_t kLookups = 100000;
+    size_t found              = 0;
+
+    Testing::BenchmarkTimer timer;
+    for (size_t i = 0; i < kLookups; i++)
+    {
+        const uint16_t localSessionId = static_cast<uint16_t>(i % kSessionCount + 1);
+        table.ForEachSession([&](auto * session) {
+            if (session->GetLocalSessionId() == localSessionId)
+            {
+                found++;
+                return Loop::Break;
+            }
+            return Loop::Continue;
+        });
+    }
+    const System::Clock::Microseconds64 scanTime = timer.Elapsed();
+
+    timer.Restart();
+    for (size_t i = 0; i < kLookups; i++)
+    {
+        found += (index->FindByLocalSessionId(static_cast<uint16_t>(i % kSessionCount + 1)) != nullptr) ? 1 : 0;
+    }
+    const System::Clock::Microseconds64 indexTime = timer.Elapsed();
+
+    EXPECT_EQ(found, 2 * kLookups);
+    ChipLogProgress(SecureChannel, "Local session id lookup with %u sessions: scan %u ns, index %u ns per message",
+                    static_cast<unsigned>(kSessionCount), static_cast<unsigned>(scanTime.count() * 1000 / kLookups),
+                    static_cast<unsigned>(indexTime.count() * 1000 / kLookups));
+}
+
+} // namespace
+
+TEST_F(TestSecureSessionTable, BenchmarkLocalSessionIdLookup)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    BenchmarkLocalSessionIdLookup<10>();
+    BenchmarkLocalSessionIdLookup<1000>();
+    BenchmarkLocalSessionIdLookup<10000>();
+}
+
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
 } // namespace Transport
 } // namespace chip
@@ -22,6 +22,7 @@
  */
 
 #include <errno.h>
+#include <memory>
 
 #include <pw_unit_test/framework.h>
 
@@ -37,11 +38,13 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
 #include <protocols/Protocols.h>
 #include <protocols/echo/Echo.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
 #include <protocols/secure_channel/PASESession.h>
 #include <transport/MessageStats.h>
+#include <transport/SecureSessionIndex.h>
 #include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
 #include <transport/tests/LoopbackTransportManager.h>
@@ -1080,6 +1083,8 @@ TEST_F(TestSessionManager, TestMessageStats)
     MessageStats messageStatistics = sessionManager.GetMessageStats();
     EXPECT_EQ(messageStatistics.interactionModelMessagesSent, static_cast<uint32_t>(0));
     EXPECT_EQ(messageStatistics.interactionModelMessagesReceived, static_cast<uint32_t>(0));
+    EXPECT_EQ(messageStatistics.secureMessagesDecryptedInPlace, static_cast<uint32_t>(0));
+    EXPECT_EQ(messageStatistics.secureMessagesDecryptedWithCopy, static_cast<uint32_t>(0));
 
     PayloadHeader payloadHeader;
 
@@ -1103,9 +1108,288 @@ TEST_F(TestSessionManager, TestMessageStats)
     messageStatistics = sessionManager.GetMessageStats();
     EXPECT_EQ(messageStatistics.interactionModelMessagesSent, static_cast<uint32_t>(1));
     EXPECT_EQ(messageStatistics.interactionModelMessagesReceived, static_cast<uint32_t>(1));
+    EXPECT_EQ(messageStatistics.secureMessagesDecryptedInPlace, static_cast<uint32_t>(1));
+    EXPECT_EQ(messageStatistics.secureMessagesDecryptedWithCopy, static_cast<uint32_t>(0));
 
     // Shutdown
     sessionManager.Shutdown();
 }
 
+#if INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+TEST_F(TestSessionManager, TestReceiveWorkerDecryption)
+{
+    uint16_t payload_len = sizeof(PAYLOAD);
+
+    TestSessMgrCallback callback;
+    callback.LargeMessageSent = false;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SessionManager sessionManager;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+    chip::TestPersistentStorageDelegate deviceStorage;
+    chip::Crypto::DefaultSessionKeystore sessionKeystore;
+    FabricTableHolder fabricTableHolder;
+
+    EXPECT_EQ(CHIP_NO_ERROR, fabricTableHolder.Init());
+    EXPECT_EQ(CHIP_NO_ERROR,
+              sessionManager.Init(&mContext.GetSystemLayer(), &mContext.GetTransportMgr(), &gMessageCounterManager, &deviceStorage,
+                                  &fabricTableHolder.GetFabricTable(), sessionKeystore));
+
+    sessionManager.SetMessageDelegate(&callback);
+
+    Transport::PeerAddress peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+    NodeId pakeNodeId = NodeIdFromPAKEKeyId(kDefaultCommissioningPasscodeId);
+
+    SessionHolder aliceToBobSession;
+    err = sessionManager.InjectPaseSessionWithTestKey(aliceToBobSession, 2, pakeNodeId, 1, kUndefinedFabricIndex, peer,
+                                                      CryptoContext::SessionRole::kInitiator);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    SessionHolder bobToAliceSession;
+    err = sessionManager.InjectPaseSessionWithTestKey(bobToAliceSession, 1, pakeNodeId, 2, kUndefinedFabricIndex, peer,
+                                                      CryptoContext::SessionRole::kResponder);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    Transport::ReceiveWorkerDelegate * worker = sessionManager.GetReceiveWorkerDelegate();
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(0);
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+
+    // Encrypts PAYLOAD for Bob, and has it decrypted as a receive worker would.
+    auto prepareAndPreprocess = [&](System::PacketBufferHandle & msg) -> uint32_t {
+        EncryptedPacketBufferHandle preparedMessage;
+        EXPECT_EQ(sessionManager.PrepareMessage(aliceToBobSession.Get().Value(), payloadHeader,
+                                                chip::MessagePacketBuffer::NewWithData(PAYLOAD, payload_len), preparedMessage),
+                  CHIP_NO_ERROR);
+        msg = preparedMessage.CastToWritable();
+        return worker->PreprocessMessage(peer, msg);
+    };
+
+    // A message decrypted on a worker is handed to the delegate without being decrypted again.
+    System::PacketBufferHandle msg;
+    Transport::MessageTransportContext ctxt;
+    ctxt.workerResult = prepareAndPreprocess(msg);
+    EXPECT_NE(ctxt.workerResult, 0u);
+    ASSERT_FALSE(msg.IsNull());
+
+    sessionManager.OnMessageReceived(peer, std::move(msg), &ctxt);
+    EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
+    EXPECT_EQ(sessionManager.GetMessageStats().secureMessagesDecryptedOnWorker, static_cast<uint32_t>(1));
+
+    // A message that fails to authenticate is dropped by the worker.
+    {
+        EncryptedPacketBufferHandle preparedMessage;
+        EXPECT_EQ(sessionManager.PrepareMessage(aliceToBobSession.Get().Value(), payloadHeader,
+                                                chip::MessagePacketBuffer::NewWithData(PAYLOAD, payload_len), preparedMessage),
+                  CHIP_NO_ERROR);
+        msg = preparedMessage.CastToWritable();
+        msg->Start()[msg->DataLength() - 1] ^= 0x01;
+        EXPECT_EQ(worker->PreprocessMessage(peer, msg), 0u);
+        EXPECT_TRUE(msg.IsNull());
+    }
+
+    // A message decrypted with the keys of a session that was released since is not taken for one of the session
+    // that reused its id.
+    ctxt.workerResult = prepareAndPreprocess(msg);
+    EXPECT_NE(ctxt.workerResult, 0u);
+    ASSERT_FALSE(msg.IsNull());
+
+    bobToAliceSession->AsSecureSession()->MarkForEviction();
+    EXPECT_FALSE(bobToAliceSession);
+
+    SessionHolder newBobToAliceSession;
+    err = sessionManager.InjectPaseSessionWithTestKey(newBobToAliceSession, 1, pakeNodeId, 2, kUndefinedFabricIndex, peer,
+                                                      CryptoContext::SessionRole::kResponder);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    sessionManager.OnMessageReceived(peer, std::move(msg), &ctxt);
+    EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
+    EXPECT_EQ(sessionManager.GetMessageStats().secureMessagesDecryptedOnWorker, static_cast<uint32_t>(1));
+
+    // While messages decrypted for the new session are accepted.
+    ctxt.workerResult = prepareAndPreprocess(msg);
+    EXPECT_NE(ctxt.workerResult, 0u);
+    ASSERT_FALSE(msg.IsNull());
+
+    sessionManager.OnMessageReceived(peer, std::move(msg), &ctxt);
+    EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
+    EXPECT_EQ(sessionManager.GetMessageStats().secureMessagesDecryptedOnWorker, static_cast<uint32_t>(2));
+
+    sessionManager.Shutdown();
+}
+
+TEST_F(TestSessionManager, TestReceiveWorkerDecryptionWithCollidingSessionIds)
+{
+    TestSessMgrCallback callback;
+    callback.LargeMessageSent = false;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    SessionManager sessionManager;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+    chip::TestPersistentStorageDelegate deviceStorage;
+    chip::Crypto::DefaultSessionKeystore sessionKeystore;
+    FabricTableHolder fabricTableHolder;
+
+    EXPECT_EQ(CHIP_NO_ERROR, fabricTableHolder.Init());
+    EXPECT_EQ(CHIP_NO_ERROR,
+              sessionManager.Init(&mContext.GetSystemLayer(), &mContext.GetTransportMgr(), &gMessageCounterManager, &deviceStorage,
+                                  &fabricTableHolder.GetFabricTable(), sessionKeystore));
+
+    sessionManager.SetMessageDelegate(&callback);
+
+    Transport::PeerAddress peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+    NodeId pakeNodeId = NodeIdFromPAKEKeyId(kDefaultCommissioningPasscodeId);
+
+    // The sessions of Bob all have the same home slot in the table of the receive workers, which is sized like the
+    // SecureSessionIndex of the session table.
+    constexpr uint16_t kCapacity           = SecureSessionIndex<CHIP_CONFIG_SECURE_SESSION_POOL_SIZE>::kCapacity;
+    constexpr uint16_t kBobSessionIds[]    = { 1, 1 + kCapacity, 1 + 2 * kCapacity, 1 + 3 * kCapacity };
+    constexpr uint16_t kAliceSessionIdBase = 2;
+    constexpr size_t kPairs                = MATTER_ARRAY_SIZE(kBobSessionIds);
+
+    SessionHolder aliceToBobSessions[kPairs];
+    SessionHolder bobToAliceSessions[kPairs];
+    for (size_t i = 0; i < kPairs; i++)
+    {
+        const uint16_t aliceSessionId = static_cast<uint16_t>(kAliceSessionIdBase + i);
+        EXPECT_EQ(sessionManager.InjectPaseSessionWithTestKey(aliceToBobSessions[i], aliceSessionId, pakeNodeId, kBobSessionIds[i],
+                                                              kUndefinedFabricIndex, peer, CryptoContext::SessionRole::kInitiator),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(sessionManager.InjectPaseSessionWithTestKey(bobToAliceSessions[i], kBobSessionIds[i], pakeNodeId, aliceSessionId,
+                                                              kUndefinedFabricIndex, peer, CryptoContext::SessionRole::kResponder),
+                  CHIP_NO_ERROR);
+    }
+
+    Transport::ReceiveWorkerDelegate * worker = sessionManager.GetReceiveWorkerDelegate();
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(0);
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+
+    // Encrypts PAYLOAD for the given session of Bob, and has it decrypted as a receive worker would.
+    auto prepareAndPreprocess = [&](size_t pair, System::PacketBufferHandle & msg) -> uint32_t {
+        EncryptedPacketBufferHandle preparedMessage;
+        EXPECT_EQ(sessionManager.PrepareMessage(aliceToBobSessions[pair].Get().Value(), payloadHeader,
+                                                chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)), preparedMessage),
+                  CHIP_NO_ERROR);
+        msg = preparedMessage.CastToWritable();
+        return worker->PreprocessMessage(peer, msg);
+    };
+
+    System::PacketBufferHandle msg;
+    for (size_t i = 0; i < kPairs; i++)
+    {
+        EXPECT_NE(prepareAndPreprocess(i, msg), 0u);
+    }
+
+    // Removing a session from the middle of the probe sequence leaves the sessions after it reachable.
+    bobToAliceSessions[1]->AsSecureSession()->MarkForEviction();
+    EXPECT_FALSE(bobToAliceSessions[1]);
+
+    EXPECT_EQ(prepareAndPreprocess(1, msg), 0u);
+    EXPECT_FALSE(msg.IsNull());
+    for (size_t i = 0; i < kPairs; i++)
+    {
+        if (i != 1)
+        {
+            EXPECT_NE(prepareAndPreprocess(i, msg), 0u);
+        }
+    }
+
+    // And the Matter thread still takes their messages as decrypted by their entry.
+    Transport::MessageTransportContext ctxt;
+    ctxt.workerResult = prepareAndPreprocess(kPairs - 1, msg);
+    ASSERT_FALSE(msg.IsNull());
+    sessionManager.OnMessageReceived(peer, std::move(msg), &ctxt);
+    EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
+    EXPECT_EQ(sessionManager.GetMessageStats().secureMessagesDecryptedOnWorker, static_cast<uint32_t>(1));
+
+    sessionManager.Shutdown();
+}
+
+// Times the decryption of messages on a receive worker with the session table full, for the session added first and
+// the one added last. The host_gcc_case_benchmark build runs it with a pool of more than 2000 sessions.
+TEST_F(TestSessionManager, BenchmarkReceiveWorkerSessionLookup)
+{
+    SKIP_UNLESS_BENCHMARKS_ENABLED();
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    SessionManager sessionManager;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+    chip::TestPersistentStorageDelegate deviceStorage;
+    chip::Crypto::DefaultSessionKeystore sessionKeystore;
+    FabricTableHolder fabricTableHolder;
+
+    EXPECT_EQ(CHIP_NO_ERROR, fabricTableHolder.Init());
+    EXPECT_EQ(CHIP_NO_ERROR,
+              sessionManager.Init(&mContext.GetSystemLayer(), &mContext.GetTransportMgr(), &gMessageCounterManager, &deviceStorage,
+                                  &fabricTableHolder.GetFabricTable(), sessionKeystore));
+
+    Transport::PeerAddress peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+    NodeId pakeNodeId = NodeIdFromPAKEKeyId(kDefaultCommissioningPasscodeId);
+
+    // Alice has the first half of the session ids, Bob the second.
+    constexpr size_t kPairs   = CHIP_CONFIG_SECURE_SESSION_POOL_SIZE / 2;
+    constexpr int kIterations = 2000;
+
+    auto aliceToBobSessions = std::make_unique<SessionHolder[]>(kPairs);
+    auto bobToAliceSessions = std::make_unique<SessionHolder[]>(kPairs);
+    for (size_t i = 0; i < kPairs; i++)
+    {
+        const uint16_t aliceSessionId = static_cast<uint16_t>(1 + i);
+        const uint16_t bobSessionId   = static_cast<uint16_t>(1 + kPairs + i);
+        ASSERT_EQ(sessionManager.InjectPaseSessionWithTestKey(aliceToBobSessions[i], aliceSessionId, pakeNodeId, bobSessionId,
+                                                              kUndefinedFabricIndex, peer, CryptoContext::SessionRole::kInitiator),
+                  CHIP_NO_ERROR);
+        ASSERT_EQ(sessionManager.InjectPaseSessionWithTestKey(bobToAliceSessions[i], bobSessionId, pakeNodeId, aliceSessionId,
+                                                              kUndefinedFabricIndex, peer, CryptoContext::SessionRole::kResponder),
+                  CHIP_NO_ERROR);
+    }
+
+    Transport::ReceiveWorkerDelegate * worker = sessionManager.GetReceiveWorkerDelegate();
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(0);
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+
+    // Decrypts copies of one message for the given session of Bob, timing only the worker.
+    auto timeDecryption = [&](size_t pair) {
+        System::Clock::Microseconds64 total(0);
+        EncryptedPacketBufferHandle preparedMessage;
+        EXPECT_EQ(sessionManager.PrepareMessage(aliceToBobSessions[pair].Get().Value(), payloadHeader,
+                                                chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)), preparedMessage),
+                  CHIP_NO_ERROR);
+        VerifyOrReturnValue(!preparedMessage.IsNull(), total);
+
+        chip::Testing::BenchmarkTimer timer;
+        for (int i = 0; i < kIterations; i++)
+        {
+            System::PacketBufferHandle msg = preparedMessage.CloneData().CastToWritable();
+            timer.Restart();
+            const uint32_t workerResult = worker->PreprocessMessage(peer, msg);
+            total += timer.Elapsed();
+            EXPECT_NE(workerResult, 0u);
+        }
+        return total;
+    };
+
+    const System::Clock::Microseconds64 firstTime = timeDecryption(0);
+    const System::Clock::Microseconds64 lastTime  = timeDecryption(kPairs - 1);
+
+    ChipLogProgress(Test, "Receive worker decryption with %u sessions: first session %u ns/message, last session %u ns/message",
+                    static_cast<unsigned>(2 * kPairs), static_cast<unsigned>(firstTime.count() * 1000 / kIterations),
+                    static_cast<unsigned>(lastTime.count() * 1000 / kIterations));
+
+    sessionManager.Shutdown();
+}
+#endif // INET_CONFIG_UDP_RECEIVE_WORKERS > 0
+
 } // namespace
@@ -793,6 +793,78 @@ TEST_F(TestSessionManagerDispatch, TestGroupIncomingPrivacyBoundsCheck)
     sessionManager.Shutdown();
 }
 
+TEST_F(TestSessionManagerDispatch, TestGroupIncomingSharedSessionId)
+{
+    using namespace chip::TestCerts;
+
+    SessionManager sessionManager;
+    TestGroupPrivacyMessageDelegate delegate;
+    TestSessionManagerInit(mContext, sessionManager, *mResources);
+    sessionManager.SetMessageDelegate(&delegate);
+
+    // Loads test parameters for GroupId 2
+    const MessageTestEntry & testEntry = theMessageTestVector[7];
+
+    FabricIndex fabricIndex = kUndefinedFabricIndex;
+    SetupGroupKeys(sessionManager, fabricIndex, testEntry.groupId, testEntry.epochKey);
+
+    uint8_t compressedFabricBuf[sizeof(uint64_t)];
+    MutableByteSpan compressedFabricSpan(compressedFabricBuf);
+    EXPECT_EQ(CHIP_NO_ERROR,
+              sessionManager.GetFabricTable()->FindFabricWithIndex(fabricIndex)->GetCompressedFabricIdBytes(compressedFabricSpan));
+
+    // Earlier tests received group messages from the same node, with counters that may be ahead of this one's.
+    sessionManager.FabricRemoved(fabricIndex);
+
+    // A second keyset with the same key, so the same session id. The test group is mapped to it after another group that
+    // uses the first keyset, so that incoming messages are tried against the other group, then decrypted while keys remain.
+    constexpr uint16_t kTestKeysetId   = 0x0123;
+    constexpr uint16_t kSharedKeysetId = 0x0124;
+    const GroupId otherGroupId         = static_cast<GroupId>(testEntry.groupId + 1);
+    KeySet keySet(kSharedKeysetId, GroupDataProvider::SecurityPolicy::kTrustFirst, 1);
+    memcpy(keySet.epoch_keys[0].key, testEntry.epochKey, 16);
+    keySet.epoch_keys[0].start_time = 0;
+
+    GroupDataProvider * provider = GetGroupDataProvider();
+    ASSERT_NE(nullptr, provider);
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetKeySet(fabricIndex, compressedFabricSpan, keySet));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetGroupKeyAt(fabricIndex, 0, GroupKey(otherGroupId, kTestKeysetId)));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetGroupKeyAt(fabricIndex, 1, GroupKey(testEntry.groupId, kSharedKeysetId)));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->SetGroupKeyAt(fabricIndex, 2, GroupKey(testEntry.groupId, kTestKeysetId)));
+
+    Transport::OutgoingGroupSession outgoingSession(testEntry.groupId, fabricIndex);
+    SessionHandle outgoingHandle(outgoingSession);
+    SessionHolder outgoingHolder(outgoingHandle);
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetMessageType(chip::Protocols::InteractionModel::MsgType::InvokeCommandRequest);
+    const char testPayload[] = "SharedSessionIdTest";
+    System::PacketBufferHandle payloadBuf =
+        MessagePacketBuffer::NewWithData(reinterpret_cast<const uint8_t *>(testPayload), sizeof(testPayload));
+    ASSERT_FALSE(payloadBuf.IsNull());
+
+    EncryptedPacketBufferHandle preparedMessage;
+    EXPECT_EQ(CHIP_NO_ERROR,
+              sessionManager.PrepareMessage(outgoingHolder.Get().Value(), payloadHeader, std::move(payloadBuf), preparedMessage));
+
+    System::PacketBufferHandle writableMsg = preparedMessage.CastToWritable();
+    ASSERT_FALSE(writableMsg.IsNull());
+
+    IPAddress loopbackAddress;
+    IPAddress::FromString("::1", loopbackAddress);
+    const PeerAddress peerAddress = PeerAddress::UDP(loopbackAddress, CHIP_PORT);
+    sessionManager.OnMessageReceived(peerAddress, std::move(writableMsg));
+
+    EXPECT_TRUE(delegate.mMessageReceived);
+    EXPECT_EQ(delegate.mHeader.GetDestinationGroupId().Value(), testEntry.groupId);
+
+    // The group data outlives the test, so leave only the mapping that SetupGroupKeys expects to overwrite.
+    EXPECT_EQ(CHIP_NO_ERROR, provider->RemoveGroupKeys(fabricIndex));
+    EXPECT_EQ(CHIP_NO_ERROR, provider->RemoveKeySet(fabricIndex, kSharedKeysetId));
+
+    sessionManager.Shutdown();
+}
+
 TEST_F(TestSessionManagerDispatch, TestGroupPrepareMessageChainedBufferFailure)
 {
     using namespace chip::TestCerts;